@@ -0,0 +1,1785 @@
+/*
+ * ReversiBenchmark.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBenchmark.cpp
+ * @brief Implements perft and the micro-benchmarks of the rules core.
+ *
+ * Every micro-benchmark repeats its operation until a minimum time has elapsed and
+ * reports nanoseconds per operation and heap allocations per operation. The
+ * allocations are counted by replacing the global operator new of the bench binary.
+ * Console output of the measured methods is sent to the null device, so the cost
+ * of formatting and of the write system calls is included.
+ */
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <stdio.h>
+#include <sstream>
+#include <string.h>
+
+#include "ReversiBenchmark.h"
+#include "../myCode/ReversiArchive.h"
+#include "../myCode/ReversiBoardBatch.h"
+#include "../myCode/ReversiBoardPool.h"
+#include "../myCode/ReversiBook.h"
+#include "../myCode/ReversiConsoleView.h"
+#include "../myCode/ReversiEndgame.h"
+#include "../myCode/ReversiMcts.h"
+#include "../myCode/ReversiParallelSearch.h"
+#include "../myCode/ReversiPatternEval.h"
+#include "../myCode/ReversiRules.h"
+#include "../myCode/ReversiSearch.h"
+#include "../myCode/ReversiSelfPlay.h"
+#include "../myCode/ReversiServer.h"
+#include "../myCode/ReversiSparseBoard.h"
+#include "../myCode/ReversiSymmetry.h"
+
+using namespace std;
+
+static atomic<uint64_t> allocationCount(0);
+
+// The replacement operators are not inlined, so that GCC does not pair the
+// malloc() or free() with the caller and report a mismatched new/delete
+__attribute__((noinline)) void* operator new(size_t size)
+{
+	allocationCount.fetch_add(1, memory_order_relaxed);
+	void *p = malloc(size ? size : 1);
+	if (!p)
+	{
+		throw bad_alloc();
+	}
+	return p;
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept
+{
+	free(p);
+}
+
+#ifdef _WIN32
+static const char nullDevice[] = "NUL";
+#else
+static const char nullDevice[] = "/dev/null";
+#endif
+
+/// Sink for benchmark results, keeps the compiler from removing the measured code.
+static volatile uint64_t benchSink;
+
+/**
+ * @brief Repeats a measured body until the minimum time has elapsed.
+ *
+ * The body returns the number of operations it performed. The number of calls per
+ * time check doubles, so the clock is read rarely for fast operations.
+ */
+template<typename Body>
+static void benchMeasure(double minSeconds, Body body, uint64_t &operations,
+		double &seconds, uint64_t &allocations)
+{
+	uint64_t allocationsBefore = ReversiBenchmark::benchAllocations();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	uint64_t calls = 1;
+
+	operations = 0;
+	do
+	{
+		for (uint64_t i = 0; i < calls; i++)
+		{
+			operations += body();
+		}
+		calls *= 2;
+		seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	} while (seconds < minSeconds);
+
+	allocations = ReversiBenchmark::benchAllocations() - allocationsBefore;
+}
+
+/**
+ * @brief Lists the legal moves of a player as (row, column) pairs.
+ */
+static vector<pair<unsigned int, unsigned int> > benchMoves(
+		const ReversiBoard &board, char coin)
+{
+	vector<pair<unsigned int, unsigned int> > list;
+	ReversiMask moves = board.generateMoves(coin);
+
+	for (unsigned int bit = 0; moves.maskNext(bit); bit++)
+	{
+		list.push_back(make_pair(bit / board.boardColumns(), bit % board.boardColumns()));
+	}
+	return list;
+}
+
+/**
+ * @brief Applies a move through the public board methods.
+ */
+static void benchPlay(ReversiBoard &board, unsigned int row,
+		unsigned int column, char coin)
+{
+	board.boardSet(row, column, coin);
+	if (coin == 'x')
+	{
+		board.flipOtoX(row, column, coin);
+	}
+	else
+	{
+		board.flipXtoO(row, column, coin);
+	}
+}
+
+/**
+ * @brief Constructs a benchmark runner.
+ *
+ * @param minSeconds Minimum measuring time of every micro-benchmark.
+ */
+ReversiBenchmark::ReversiBenchmark(double minSeconds) :
+		minSeconds(minSeconds)
+{
+}
+
+/**
+ * @brief Returns the number of heap allocations made by the process so far.
+ */
+uint64_t ReversiBenchmark::benchAllocations()
+{
+	return allocationCount.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Stores a result computed from the counters of one measurement.
+ */
+void ReversiBenchmark::benchRecord(const string &name,
+		const ReversiBoard &board, uint64_t operations, double seconds,
+		uint64_t allocations)
+{
+	benchRecord(name, board.boardRows(), board.boardColumns(), operations,
+			seconds, allocations);
+}
+
+/**
+ * @brief Stores a result of a board that is not a ReversiBoard.
+ */
+void ReversiBenchmark::benchRecord(const string &name, unsigned int rows,
+		unsigned int columns, uint64_t operations, double seconds,
+		uint64_t allocations)
+{
+	ReversiBenchResult result;
+
+	result.name = name;
+	result.rows = rows;
+	result.columns = columns;
+	result.operations = operations;
+	result.seconds = seconds;
+	result.nsPerOp = operations ? seconds * 1e9 / operations : 0;
+	result.opsPerSecond = (seconds > 0) ? operations / seconds : 0;
+	result.allocsPerOp = operations ? (double) allocations / operations : 0;
+	results.push_back(result);
+}
+
+/**
+ * @brief Counts the leaf nodes of the game tree up to a fixed depth.
+ *
+ * @param board The position to start from.
+ * @param coin The player to move ('x' or 'o').
+ * @param depth Remaining depth in plies.
+ * @param passed true if the previous ply was a pass.
+ * @return The number of leaf nodes.
+ */
+uint64_t ReversiBenchmark::benchPerftCount(ReversiBoard &board, char coin,
+		unsigned int depth, bool passed)
+{
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	char other = (coin == 'x') ? 'o' : 'x';
+	ReversiMask moves = board.generateMoves(coin);
+
+	if (!moves.maskAny())
+	{
+		// Two passes in a row end the game
+		if (passed)
+		{
+			return 1;
+		}
+		board.makePass(coin);
+		uint64_t nodes = benchPerftCount(board, other, depth - 1, true);
+		board.unmakeMove();
+		return nodes;
+	}
+
+	uint64_t nodes = 0;
+	for (unsigned int bit = 0; moves.maskNext(bit); bit++)
+	{
+		board.makeMove(bit, coin);
+		nodes += benchPerftCount(board, other, depth - 1, false);
+		board.unmakeMove();
+	}
+	return nodes;
+}
+
+/**
+ * @brief Runs perft from the initial position and records nodes per second.
+ *
+ * For 4x4, 6x6, 8x8 and 10x10 the count is repeated on the ReversiFixedBoard
+ * of that size and recorded as "perft(depth) fixed".
+ *
+ * @param rows Board rows.
+ * @param columns Board columns.
+ * @param depth Depth in plies.
+ * @param nodes Receives the number of leaf nodes.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+ *         too small to hold the initial position, RC_ERROR if the fixed board
+ *         counts a different number of nodes.
+ */
+RC_t ReversiBenchmark::benchPerft(unsigned int rows, unsigned int columns,
+		unsigned int depth, uint64_t &nodes)
+{
+	if (rows < 2 || columns < 2)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiBoard board(rows, columns);
+	board.boardInitialState(rows, columns);
+
+	uint64_t allocationsBefore = benchAllocations();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	nodes = benchPerftCount(board, 'x', depth, false);
+	double seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	benchRecord("perft(" + to_string(depth) + ")", board, nodes, seconds,
+			benchAllocations() - allocationsBefore);
+
+	// Same count on the compile-time sized board, if there is one for this size
+	unique_ptr<ReversiRules> rules = ReversiRules::rulesCreate(rows, columns);
+	if (rules && rules->rulesSpecialized())
+	{
+		allocationsBefore = benchAllocations();
+		start = chrono::steady_clock::now();
+		uint64_t fixedNodes = rules->rulesPerft(depth);
+		seconds = chrono::duration<double>(
+				chrono::steady_clock::now() - start).count();
+
+		benchRecord("perft(" + to_string(depth) + ") fixed", board, fixedNodes,
+				seconds, benchAllocations() - allocationsBefore);
+		if (fixedNodes != nodes)
+		{
+			return RC_ERROR;
+		}
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Searches the initial position for a fixed time and records nodes per second.
+ *
+ * The transposition table (64 MB) is allocated before the measurement starts.
+ *
+ * @param rows Board rows.
+ * @param columns Board columns.
+ * @param milliseconds Time budget of the search.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+ *         too small to hold the initial position.
+ */
+RC_t ReversiBenchmark::benchSearch(unsigned int rows, unsigned int columns,
+		unsigned int milliseconds)
+{
+	if (rows < 2 || columns < 2)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiBoard board(rows, columns);
+	ReversiTransTable tt(64);
+	ReversiSearch search(tt);
+	ReversiSearchLimits limits;
+	ReversiSearchResult result;
+
+	board.boardInitialState(rows, columns);
+	limits.maxTime = milliseconds;
+
+	uint64_t allocationsBefore = benchAllocations();
+	search.searchRun(board, limits, result);
+
+	benchRecord("search(" + to_string(milliseconds) + "ms) depth "
+			+ to_string(result.depth), board, result.nodes, result.seconds,
+			benchAllocations() - allocationsBefore);
+	return RC_OK;
+}
+
+/**
+ * @brief Measures the time to reach a fixed depth with 1, 2, 4, ... threads.
+ *
+ * The thread counts are the powers of two below maxThreads and maxThreads itself.
+ *
+ * @param rows Board rows.
+ * @param columns Board columns.
+ * @param depth Depth of the search.
+ * @param maxThreads Largest thread count measured.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+ *         too small to hold the initial position.
+ */
+RC_t ReversiBenchmark::benchParallel(unsigned int rows, unsigned int columns,
+		unsigned int depth, unsigned int maxThreads)
+{
+	if (rows < 2 || columns < 2 || depth == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiBoard board(rows, columns);
+	ReversiTransTable tt(256);
+	ReversiSearchLimits limits;
+	double single = 0;
+
+	board.boardInitialState(rows, columns);
+	limits.maxDepth = depth;
+
+	vector<unsigned int> counts;
+	for (unsigned int threads = 1; threads < maxThreads; threads *= 2)
+	{
+		counts.push_back(threads);
+	}
+	counts.push_back(maxThreads);
+
+	for (unsigned int i = 0; i < counts.size(); i++)
+	{
+		unsigned int threads = counts[i];
+		ReversiParallelSearch search(tt, threads);
+		ReversiSearchResult result;
+
+		tt.ttClear();
+		uint64_t allocationsBefore = benchAllocations();
+		search.parallelRun(board, limits, result);
+		if (threads == 1)
+		{
+			single = result.seconds;
+		}
+
+		ostringstream name;
+		name << "lazy-smp(" << depth << ") " << threads << "T x" << fixed
+				<< setprecision(2) << ((result.seconds > 0) ? single / result.seconds : 0);
+		benchRecord(name.str(), board, result.nodes, result.seconds,
+				benchAllocations() - allocationsBefore);
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Measures MCTS playouts per second with 1, 2, 4, ... threads.
+ *
+ * @param rows Board rows.
+ * @param columns Board columns.
+ * @param milliseconds Time per run.
+ * @param maxThreads Largest thread count measured.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+ *         too small to hold the initial position.
+ */
+RC_t ReversiBenchmark::benchMcts(unsigned int rows, unsigned int columns,
+		unsigned int milliseconds, unsigned int maxThreads)
+{
+	if (rows < 2 || columns < 2 || milliseconds == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiBoard board(rows, columns);
+	ReversiMctsLimits limits;
+	double single = 0;
+
+	board.boardInitialState(rows, columns);
+	limits.maxTime = milliseconds;
+
+	vector<unsigned int> counts;
+	for (unsigned int threads = 1; threads < maxThreads; threads *= 2)
+	{
+		counts.push_back(threads);
+	}
+	counts.push_back(maxThreads);
+	counts.push_back(maxThreads);
+
+	for (unsigned int i = 0; i < counts.size(); i++)
+	{
+		ReversiMctsConfig config;
+		ReversiMctsResult result;
+
+		config.threads = counts[i];
+		config.puct = (i + 1 == counts.size());
+		ReversiMcts mcts(config);
+
+		uint64_t allocationsBefore = benchAllocations();
+		mcts.mctsRun(board, limits, result);
+		if (i == 0)
+		{
+			single = result.playoutsPerSecond;
+		}
+
+		ostringstream name;
+		name << "mcts " << (config.puct ? "puct " : "uct ") << config.threads
+				<< "T x" << fixed << setprecision(2)
+				<< ((single > 0) ? result.playoutsPerSecond / single : 0);
+		benchRecord(name.str(), board, result.playouts, result.seconds,
+				benchAllocations() - allocationsBefore);
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Plays a random game seeded with seed until empties cells are left.
+ *
+ * @param board The board to play on; it is reset to the initial position first.
+ * @param empties Number of empty cells of the position.
+ * @param seed Seed of the random moves.
+ * @return true if the position was reached, false if the game ended before.
+ */
+static bool benchEndgamePosition(ReversiBoard &board, unsigned int empties,
+		uint32_t seed)
+{
+	unsigned int rows = board.boardRows();
+	unsigned int columns = board.boardColumns();
+	mt19937 rng(seed);
+	unsigned int filled = 4;
+
+	board.boardClear();
+	board.boardInitialState(rows, columns);
+	while (filled + empties < rows * columns)
+	{
+		char coin = board.boardSideToMove();
+		ReversiMask moves = board.generateMoves(coin);
+		unsigned int count = moves.maskCount();
+
+		if (count == 0)
+		{
+			if (!board.generateMoves((coin == 'x') ? 'o' : 'x').maskAny())
+			{
+				return false;
+			}
+			board.makePass(coin);
+			continue;
+		}
+
+		unsigned int pick = rng() % count;
+		unsigned int bit = 0;
+		moves.maskNext(bit);
+		while (pick--)
+		{
+			bit++;
+			moves.maskNext(bit);
+		}
+		board.makeMove(bit, coin);
+		filled++;
+	}
+	return filled + empties == rows * columns;
+}
+
+/**
+ * @brief Solves a position by plain negamax over all moves, as a reference.
+ *
+ * @param board The position; restored before returning.
+ * @return The final disc difference from the view of the side to move.
+ */
+static int benchNegamax(ReversiBoard &board)
+{
+	char coin = board.boardSideToMove();
+	char other = (coin == 'x') ? 'o' : 'x';
+	ReversiMask moves = board.generateMoves(coin);
+
+	if (!moves.maskAny())
+	{
+		if (!board.generateMoves(other).maskAny())
+		{
+			return (int) board.boardCount(coin) - (int) board.boardCount(other);
+		}
+		board.makePass(coin);
+		int score = -benchNegamax(board);
+		board.unmakeMove();
+		return score;
+	}
+
+	int best = -65;
+	for (unsigned int bit = 0; moves.maskNext(bit); bit++)
+	{
+		board.makeMove(bit, coin);
+		int score = -benchNegamax(board);
+		board.unmakeMove();
+		if (score > best)
+		{
+			best = score;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Solves seeded random endgames exactly and win/loss/draw only.
+ *
+ * Position i is reached by a random game seeded with i; games that end before
+ * the requested number of empty cells are skipped.
+ *
+ * @param rows Board rows.
+ * @param columns Board columns (rows * columns must not exceed 64).
+ * @param empties Number of empty cells of the positions.
+ * @param positions Number of positions to solve.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for
+ *         unsupported board sizes.
+ */
+RC_t ReversiBenchmark::benchEndgame(unsigned int rows, unsigned int columns,
+		unsigned int empties, unsigned int positions)
+{
+	if (rows < 2 || columns < 2 || (uint64_t) rows * columns > 64
+			|| empties + 4 > rows * columns)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiTransTable tt(64);
+	ReversiEndgame solver(&tt);
+	vector<ReversiBoard> boards;
+
+	for (unsigned int seed = 1; boards.size() < positions; seed++)
+	{
+		ReversiBoard board(rows, columns);
+
+		if (benchEndgamePosition(board, empties, seed))
+		{
+			boards.push_back(board);
+		}
+	}
+
+	const EndgameMode_t modes[2] =
+	{ ENDGAME_EXACT, ENDGAME_WLD };
+	for (unsigned int m = 0; m < 2; m++)
+	{
+		uint64_t nodes = 0;
+		double seconds = 0;
+		uint64_t allocationsBefore = benchAllocations();
+
+		for (unsigned int i = 0; i < boards.size(); i++)
+		{
+			ReversiEndgameResult result;
+
+			tt.ttClear();
+			solver.endgameSolve(boards[i], modes[m], result);
+			nodes += result.nodes;
+			seconds += result.seconds;
+		}
+
+		ostringstream name;
+		name << "endgame(" << empties << ") " << ((m == 0) ? "exact" : "wld")
+				<< " " << fixed << setprecision(3)
+				<< seconds / boards.size() << " s/pos";
+		benchRecord(name.str(), boards[0], nodes, seconds,
+				benchAllocations() - allocationsBefore);
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Checks the endgame solver against a plain negamax.
+ *
+ * Seeded random positions of several board shapes with 2 to 10 empty cells
+ * are solved exactly and win/loss/draw only, with and without a transposition
+ * table. Every score has to match the negamax score, and the best move has to
+ * reach it.
+ *
+ * @param positions Number of positions per shape.
+ * @return RC_OK if all results match, RC_ERROR on the first difference.
+ */
+RC_t ReversiBenchmark::benchEndgameCheck(unsigned int positions)
+{
+	// Square and oblong shapes, a thin one and a full 64-cell one
+	const unsigned int shapes[][2] =
+	{
+	{ 4, 4 },
+	{ 4, 5 },
+	{ 5, 5 },
+	{ 3, 8 },
+	{ 3, 7 },
+	{ 6, 6 },
+	{ 5, 8 },
+	{ 4, 16 },
+	{ 8, 8 } };
+	const unsigned int shapeCount = sizeof(shapes) / sizeof(shapes[0]);
+	ReversiTransTable tt(16);
+	ReversiEndgame plain;
+	ReversiEndgame cached(&tt);
+	uint64_t compared = 0;
+	uint64_t allocationsBefore = benchAllocations();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (unsigned int s = 0; s < shapeCount; s++)
+	{
+		unsigned int rows = shapes[s][0];
+		unsigned int columns = shapes[s][1];
+		ReversiBoard board(rows, columns);
+		uint32_t seed = 1;
+
+		for (unsigned int i = 0; i < positions; i++)
+		{
+			unsigned int empties = 2 + i % 9;
+			if (empties + 4 > rows * columns)
+			{
+				empties = rows * columns - 4;
+			}
+
+			// Random games may end early; give up on a shape after many tries
+			unsigned int tries = 0;
+			while (!benchEndgamePosition(board, empties, seed++))
+			{
+				if (++tries == 1000)
+				{
+					cerr << "No endgame with " << empties << " empty cells on "
+							<< rows << "x" << columns << endl;
+					return RC_ERROR;
+				}
+			}
+
+			int expected = benchNegamax(board);
+			tt.ttClear();
+			for (unsigned int run = 0; run < 4; run++)
+			{
+				ReversiEndgame &solver = (run & 1) ? cached : plain;
+				EndgameMode_t mode = (run & 2) ? ENDGAME_WLD : ENDGAME_EXACT;
+				int target = (mode == ENDGAME_WLD) ?
+						(expected > 0) - (expected < 0) : expected;
+				ReversiEndgameResult result;
+
+				if (solver.endgameSolve(board, mode, result) != RC_OK)
+				{
+					cerr << "Endgame solver failed on " << rows << "x" << columns
+							<< endl;
+					return RC_ERROR;
+				}
+
+				// The best move must reach the score, or the game must be over
+				int reached;
+				char coin = board.boardSideToMove();
+				if (result.bestMove == ReversiEndgame::NO_MOVE)
+				{
+					reached = board.boardGameOver() ? expected : -65;
+				}
+				else
+				{
+					if (result.bestMove == ReversiUndo::PASS)
+					{
+						board.makePass(coin);
+					}
+					else
+					{
+						board.makeMove(result.bestMove, coin);
+					}
+					reached = -benchNegamax(board);
+					board.unmakeMove();
+				}
+				if (mode == ENDGAME_WLD)
+				{
+					reached = (reached > 0) - (reached < 0);
+				}
+
+				if (result.score != target || reached != target)
+				{
+					cerr << "Endgame mismatch on " << rows << "x" << columns
+							<< " with " << empties << " empty cells (seed "
+							<< seed - 1 << ", " << ((mode == ENDGAME_WLD) ? "wld" : "exact")
+							<< ((&solver == &cached) ? ", table" : "")
+							<< "): score " << result.score << ", move reaches "
+							<< reached << ", negamax " << target << endl;
+					return RC_ERROR;
+				}
+				compared++;
+			}
+		}
+	}
+
+	double seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	benchRecord("endgame check (" + to_string(shapeCount) + " shapes)", 0, 0,
+			compared, seconds, benchAllocations() - allocationsBefore);
+	return RC_OK;
+}
+
+/**
+ * @brief Builds an opening book from random self-play games and measures it.
+ *
+ * @param rows Board rows.
+ * @param columns Board columns.
+ * @param games Number of self-play games.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+ *         too small to hold the initial position, RC_ERROR if the temporary
+ *         files cannot be written.
+ */
+RC_t ReversiBenchmark::benchBook(unsigned int rows, unsigned int columns,
+		uint64_t games)
+{
+	static const char archivePath[] = "reversi_bench.rvg";
+	static const char bookPath[] = "reversi_bench.rvb";
+	static const unsigned int BOOK_PLIES = 12;
+
+	if (rows < 2 || columns < 2)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiSelfPlayConfig config;
+	ReversiSelfPlayStats stats;
+	ReversiArchiveWriter writer;
+
+	config.rows = rows;
+	config.columns = columns;
+	config.games = games;
+	config.threads = 1;
+
+	ReversiSelfPlay selfPlay(config);
+	if (writer.archiveCreate(archivePath) != RC_OK)
+	{
+		return RC_ERROR;
+	}
+	selfPlay.selfPlaySetCallback([&writer](uint64_t game, const ReversiBoard &board)
+	{
+		writer.archiveAppend(board, (uint32_t) game);
+	});
+	if (selfPlay.selfPlayRun(stats) != RC_OK)
+	{
+		writer.archiveClose();
+		return RC_ERROR;
+	}
+	writer.archiveClose();
+
+	ReversiArchiveReader archive;
+	ReversiBookBuilder builder;
+	size_t entries = 0;
+	uint64_t allocationsBefore = benchAllocations();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	RC_t rc = archive.archiveOpen(archivePath);
+
+	if (rc == RC_OK)
+	{
+		rc = builder.bookAddArchive(archive, BOOK_PLIES);
+	}
+	if (rc == RC_OK)
+	{
+		rc = builder.bookWrite(bookPath, 1, entries);
+	}
+	double seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	if (rc != RC_OK)
+	{
+		remove(archivePath);
+		remove(bookPath);
+		return RC_ERROR;
+	}
+
+	ReversiBoard board(rows, columns);
+	ostringstream name;
+	name << "book build " << entries << " entries";
+	benchRecord(name.str(), board, builder.bookSamples(), seconds,
+			benchAllocations() - allocationsBefore);
+
+	// Positions of the archived games at all book plies, probed in turn
+	vector<ReversiBoard> positions;
+	for (size_t i = 0; i < archive.archiveGames() && positions.size() < 4096; i++)
+	{
+		archive.archiveReplay(i, board, i % (BOOK_PLIES + 1));
+		positions.push_back(board);
+	}
+	archive.archiveClose();
+
+	ReversiBook book;
+	uint64_t operations, allocations;
+	benchMeasure(minSeconds, [&]()
+	{
+		book.bookOpen(bookPath);
+		benchSink += book.bookEntries();
+		book.bookClose();
+		return 1;
+	}, operations, seconds, allocations);
+	benchRecord("book open", board, operations, seconds, allocations);
+
+	size_t next = 0;
+	book.bookOpen(bookPath);
+	benchMeasure(minSeconds, [&]()
+	{
+		unsigned int move;
+		int score;
+		benchSink += (book.bookProbe(positions[next], move, score) == RC_OK) ? move : 0;
+		next = (next + 1) % positions.size();
+		return 1;
+	}, operations, seconds, allocations);
+	benchRecord("book probe", board, operations, seconds, allocations);
+	book.bookClose();
+
+	remove(archivePath);
+	remove(bookPath);
+	return RC_OK;
+}
+
+/**
+ * @brief Plays engine-against-engine self-play games and counts distinct games.
+ *
+ * Every game is reduced to a hash of its moves. The hashes are stored by game
+ * number, so the workers never write the same entry.
+ *
+ * @param rows Board rows.
+ * @param columns Board columns.
+ * @param games Number of self-play games.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+ *         too small to hold the initial position, RC_ERROR if all games are the same.
+ */
+RC_t ReversiBenchmark::benchSelfPlay(unsigned int rows, unsigned int columns,
+		uint64_t games)
+{
+	if (rows < 2 || columns < 2)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiSelfPlayConfig config;
+	ReversiSelfPlayStats stats;
+	vector<uint64_t> hashes(games);
+
+	config.rows = rows;
+	config.columns = columns;
+	config.games = games;
+	config.playerX = SELFPLAY_ENGINE;
+	config.playerO = SELFPLAY_ENGINE;
+
+	ReversiSelfPlay selfPlay(config);
+	selfPlay.selfPlaySetCallback([&hashes](uint64_t game, const ReversiBoard &board)
+	{
+		uint64_t hash = 0xCBF29CE484222325ULL;
+		for (unsigned int i = 0; i < board.boardHistorySize(); i++)
+		{
+			hash = (hash ^ board.boardHistory(i).index) * 0x100000001B3ULL;
+		}
+		hashes[game] = hash;
+	});
+
+	uint64_t allocationsBefore = benchAllocations();
+	if (selfPlay.selfPlayRun(stats) != RC_OK)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	sort(hashes.begin(), hashes.end());
+	size_t distinct = unique(hashes.begin(), hashes.end()) - hashes.begin();
+	benchRecord("selfplay engine, " + to_string(distinct) + " distinct",
+			rows, columns, stats.games, stats.seconds,
+			benchAllocations() - allocationsBefore);
+	return (games > 1 && distinct == 1) ? RC_ERROR : RC_OK;
+}
+
+/**
+ * @brief Measures evaluations per second of the 8x8 pattern evaluation.
+ *
+ * @param pWeights Weight file to load, or 0 for zero weights (same speed).
+ * @return RC_OK if the operation was successful, RC_ERROR if the weight file
+ *         cannot be read.
+ */
+RC_t ReversiBenchmark::benchEval(const char *pWeights)
+{
+	ReversiPatternEval eval;
+
+	if (pWeights && eval.evalLoad(pWeights) != RC_OK)
+	{
+		return RC_ERROR;
+	}
+
+	// Positions (side to move first) of seeded random games
+	vector<pair<uint64_t, uint64_t> > positions;
+	ReversiBoard board(8, 8);
+	mt19937_64 rng(1);
+	while (positions.size() < 1024)
+	{
+		ReversiSelfPlay::selfPlayGame(board, rng, 0, 0, 0);
+		while (board.boardHistorySize() > 0)
+		{
+			char side = board.boardSideToMove();
+			positions.push_back(
+					make_pair(board.boardDiscs(side).maskWord(0),
+							board.boardDiscs((side == 'x') ? 'o' : 'x').maskWord(0)));
+			board.unmakeMove();
+		}
+	}
+
+	uint64_t operations, allocations;
+	double seconds;
+	for (unsigned int pass = 0; pass < 2; pass++)
+	{
+		// Second pass: the scalar implementation, if AVX2 is in use
+		string name = "pattern eval";
+		if (pass == 1)
+		{
+			if (!ReversiPatternEval::evalHasAvx2())
+			{
+				break;
+			}
+			ReversiPatternEval::evalUseSimd(false);
+			name += " (scalar)";
+		}
+
+		benchMeasure(minSeconds, [&]()
+		{
+			int sum = 0;
+			for (unsigned int i = 0; i < positions.size(); i++)
+			{
+				sum += eval.evalScore(positions[i].first, positions[i].second);
+			}
+			benchSink = sum;
+			return (uint64_t) positions.size();
+		}, operations, seconds, allocations);
+		benchRecord(name, board, operations, seconds, allocations);
+	}
+	ReversiPatternEval::evalUseSimd(true);
+	return RC_OK;
+}
+
+/**
+ * @brief Measures random play on the sparse board of a large size.
+ *
+ * @param rows Board rows.
+ * @param columns Board columns.
+ * @param plies Number of plies to play.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+ *         too small to hold the initial position.
+ */
+RC_t ReversiBenchmark::benchSparse(unsigned int rows, unsigned int columns,
+		unsigned int plies)
+{
+	ReversiSparseBoard sparse(rows, columns);
+	if (sparse.sparseInitialState() != RC_OK)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	vector<ReversiSparseCell_t> moves;
+	vector<ReversiSparseCell_t> game;
+	mt19937 rng(1);
+	char coin = 'x';
+
+	uint64_t allocationsBefore = benchAllocations();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (unsigned int ply = 0; ply < plies; ply++)
+	{
+		sparse.sparseMoves(coin, moves);
+		if (moves.empty())
+		{
+			ReversiSparseCell_t pass =
+			{ ReversiUndo::PASS, ReversiUndo::PASS };
+			game.push_back(pass);
+			sparse.sparseMakePass(coin);
+		}
+		else
+		{
+			ReversiSparseCell_t move = moves[rng() % moves.size()];
+			game.push_back(move);
+			sparse.sparseMakeMove(move.row, move.column, coin);
+		}
+		coin = (coin == 'x') ? 'o' : 'x';
+	}
+	double seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	benchRecord("sparse ply (" + to_string(sparse.sparseTiles()) + "/"
+			+ to_string(sparse.sparseFrontierTiles()) + " tiles)",
+			rows, columns, plies, seconds,
+			benchAllocations() - allocationsBefore);
+
+	if ((uint64_t) rows * columns > 128 * 128)
+	{
+		return RC_OK;
+	}
+
+	// The same game on the dense board
+	ReversiBoard dense(rows, columns);
+	dense.boardInitialState(rows, columns);
+	coin = 'x';
+
+	allocationsBefore = benchAllocations();
+	start = chrono::steady_clock::now();
+	for (unsigned int ply = 0; ply < plies; ply++)
+	{
+		ReversiMask denseMoves = dense.generateMoves(coin);
+		if (game[ply].row == ReversiUndo::PASS)
+		{
+			dense.makePass(coin);
+		}
+		else
+		{
+			benchSink += denseMoves.maskCount();
+			dense.makeMove(game[ply].row, game[ply].column, coin);
+		}
+		coin = (coin == 'x') ? 'o' : 'x';
+	}
+	seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	benchRecord("dense ply", dense, plies, seconds,
+			benchAllocations() - allocationsBefore);
+	return RC_OK;
+}
+
+/**
+ * @brief Picks the move of a random game: one of the set bits, chosen by a xorshift generator.
+ */
+static unsigned int benchRandomCell(uint64_t moves, uint64_t &random)
+{
+	random ^= random << 13;
+	random ^= random >> 7;
+	random ^= random << 17;
+
+	for (unsigned int n = random % __builtin_popcountll(moves); n > 0; n--)
+	{
+		moves &= moves - 1;
+	}
+	return __builtin_ctzll(moves);
+}
+
+/**
+ * @brief Plays a seeded random game on every board of a batch, in lockstep.
+ *
+ * Boards whose game is over pass until the last game has ended.
+ *
+ * @return The number of moves and passes played before the games ended.
+ */
+static uint64_t benchBatchGames(ReversiBoardBatch &batch, size_t boards,
+		vector<uint64_t> &random, vector<uint64_t> &moves,
+		vector<uint64_t> &replies, vector<uint32_t> &cells, uint64_t &checksum)
+{
+	uint64_t plies = 0;
+	bool running = true;
+
+	batch.batchReset(boards);
+	for (size_t b = 0; b < boards; b++)
+	{
+		random[b] = b + 1;
+	}
+	while (running)
+	{
+		running = false;
+		batch.batchMoves(moves.data(), replies.data());
+		for (size_t b = 0; b < boards; b++)
+		{
+			cells[b] = ReversiBoardBatch::PASS;
+			if (moves[b] || replies[b])
+			{
+				if (moves[b])
+				{
+					cells[b] = benchRandomCell(moves[b], random[b]);
+				}
+				running = true;
+				plies++;
+			}
+		}
+		if (running)
+		{
+			batch.batchPlay(cells.data(), 0);
+		}
+	}
+
+	checksum = 0;
+	for (size_t b = 0; b < boards; b++)
+	{
+		uint64_t x = (batch.batchSide(b) == 'x') ?
+				batch.batchPlayer(b) : batch.batchOpponent(b);
+		checksum += x * (2 * b + 1);
+	}
+	return plies;
+}
+
+/**
+ * @brief Measures random games played in lockstep on a batch of boards.
+ *
+ * Board b plays the game seeded with b + 1 in every run, so all instruction
+ * sets and ReversiBoard must end with the same discs.
+ *
+ * @param rows Board rows.
+ * @param columns Board columns (rows * columns must not exceed 64).
+ * @param boards Number of boards in the batch.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for
+ *         unsupported board sizes, RC_ERROR if an instruction set or
+ *         ReversiBoard ends the games with different discs.
+ */
+RC_t ReversiBenchmark::benchBatch(unsigned int rows, unsigned int columns,
+		size_t boards)
+{
+	if (!ReversiBoardBatch::batchSupports(rows, columns) || boards == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiBoardBatch batch(rows, columns);
+	vector<uint64_t> random(boards);
+	vector<uint64_t> moves(boards);
+	vector<uint64_t> replies(boards);
+	vector<uint32_t> cells(boards);
+	uint64_t operations;
+	double seconds;
+	uint64_t allocations;
+	uint64_t checksum = 0;
+
+	// The same games, one board at a time
+	ReversiBoard board(rows, columns);
+	uint64_t reference = 0;
+	benchMeasure(minSeconds, [&]() -> uint64_t
+	{
+		uint64_t plies = 0;
+		reference = 0;
+		for (size_t b = 0; b < boards; b++)
+		{
+			uint64_t state = b + 1;
+			board.boardClear();
+			board.boardInitialState(rows, columns);
+			while (!board.boardGameOver())
+			{
+				char coin = board.boardSideToMove();
+				uint64_t legal = board.generateMoves(coin).maskWord(0);
+				if (legal)
+				{
+					board.makeMove(benchRandomCell(legal, state), coin);
+				}
+				else
+				{
+					board.makePass(coin);
+				}
+				plies++;
+			}
+			reference += board.boardDiscs('x').maskWord(0) * (2 * b + 1);
+		}
+		return plies;
+	}, operations, seconds, allocations);
+	benchRecord("board ply", board, operations, seconds, allocations);
+
+	const ReversiBatchSimd_t levels[] =
+	{ BATCH_SIMD_SCALAR, BATCH_SIMD_AVX2, BATCH_SIMD_AVX512 };
+	const char *names[] =
+	{ "scalar", "avx2", "avx512" };
+	ReversiBatchSimd_t selected = ReversiBoardBatch::batchSimd();
+	RC_t result = RC_OK;
+
+	for (unsigned int i = 0; i < sizeof(levels) / sizeof(levels[0]); i++)
+	{
+		if (ReversiBoardBatch::batchUseSimd(levels[i]) != levels[i])
+		{
+			continue;
+		}
+
+		benchMeasure(minSeconds, [&]()
+		{
+			return benchBatchGames(batch, boards, random, moves, replies, cells,
+					checksum);
+		}, operations, seconds, allocations);
+		benchRecord(string("batch ply ") + names[i] + " (" + to_string(boards)
+				+ " boards)", rows, columns, operations, seconds, allocations);
+		if (checksum != reference)
+		{
+			result = RC_ERROR;
+		}
+
+		batch.batchReset(boards);
+		benchMeasure(minSeconds, [&]() -> uint64_t
+		{
+			batch.batchMoves(moves.data());
+			benchSink += moves[0];
+			return boards;
+		}, operations, seconds, allocations);
+		benchRecord(string("batchMoves ") + names[i], rows, columns, operations,
+				seconds, allocations);
+	}
+	ReversiBoardBatch::batchUseSimd(selected);
+	return result;
+}
+
+/**
+ * @brief Client side of one connection of benchServer().
+ */
+struct ReversiBenchClient
+{
+	int fd;
+	char phase;       ///< Next request: 'N'ew, 'L'ist moves, 'M'ove or 'E'nd.
+	bool waiting;     ///< A request has been sent and is not answered yet.
+	unsigned int game;
+	std::string input; ///< Received text, or the chosen move before a MOVE.
+};
+
+/**
+ * @brief Compares the dispatched flip kernel bit for bit with the scalar one.
+ *
+ * Every board shape of up to 64 cells (including single rows and columns) gets
+ * random positions of varying density and a random empty cell.
+ *
+ * @param positions Number of positions per shape.
+ * @return RC_OK if all masks are identical, RC_ERROR on the first difference.
+ */
+RC_t ReversiBenchmark::benchFlips(uint64_t positions)
+{
+	mt19937_64 rng(1);
+	uint64_t compared = 0;
+	unsigned int shapes = 0;
+	uint64_t allocationsBefore = benchAllocations();
+	bool simd = ReversiFlipKernel::flipKernelUseSimd(true);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (unsigned int rows = 1; rows <= 64; rows++)
+	{
+		for (unsigned int columns = 1; rows * columns <= 64; columns++)
+		{
+			ReversiFlipKernel kernel(rows, columns);
+			unsigned int cells = rows * columns;
+			uint64_t all = (cells == 64) ? ~(uint64_t) 0 :
+							((uint64_t) 1 << cells) - 1;
+
+			shapes++;
+			for (uint64_t i = 0; i < positions; i++)
+			{
+				// Densities from a quarter to all but one cell occupied
+				uint64_t occupied = rng() | rng();
+				if (i & 1)
+				{
+					occupied |= rng();
+				}
+				uint64_t own = occupied & rng() & all;
+				uint64_t opp = occupied & ~own & all;
+				uint64_t empty = all & ~own & ~opp;
+				if (empty == 0)
+				{
+					continue;
+				}
+
+				for (uint64_t n = rng() % __builtin_popcountll(empty); n > 0; n--)
+				{
+					empty &= empty - 1;
+				}
+				unsigned int index = __builtin_ctzll(empty);
+				if (kernel.flipKernelFlips(index, own, opp)
+						!= kernel.flipKernelFlipsScalar(index, own, opp))
+				{
+					cerr << "Flip kernel mismatch on " << rows << "x" << columns
+							<< " at cell " << index << endl;
+					return RC_ERROR;
+				}
+				compared++;
+			}
+		}
+	}
+
+	double seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	benchRecord(string("flip check ") + (simd ? "avx2" : "scalar") + " ("
+			+ to_string(shapes) + " shapes)", 0, 0, compared, seconds,
+			benchAllocations() - allocationsBefore);
+	return RC_OK;
+}
+
+/**
+ * @brief Plays random 8x8 games against an in-process game server.
+ *
+ * @param connections Number of client connections.
+ * @param games Number of games to finish.
+ * @param threads Number of server threads.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for zero
+ *         connections or games, RC_ERROR if the server or a connection cannot
+ *         be set up.
+ */
+RC_t ReversiBenchmark::benchServer(unsigned int connections, uint64_t games,
+		unsigned int threads)
+{
+	if (connections == 0 || games == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+#ifdef __linux__
+	// Every connection needs a descriptor on both ends
+	struct rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+	{
+		if (limit.rlim_cur < limit.rlim_max)
+		{
+			limit.rlim_cur = limit.rlim_max;
+			setrlimit(RLIMIT_NOFILE, &limit);
+		}
+		if (limit.rlim_cur != RLIM_INFINITY
+				&& 2 * (rlim_t) connections + 64 > limit.rlim_cur)
+		{
+			cerr << "At most " << (limit.rlim_cur - 64) / 2
+					<< " connections fit into the descriptor limit." << endl;
+			return RC_ERROR_BAD_PARAM;
+		}
+	}
+
+	ReversiServerConfig config;
+	config.listenTcp = false;
+	config.socketPath = "/tmp/reversi_bench_" + to_string(getpid()) + ".sock";
+	config.threads = threads;
+
+	ReversiServer server(config);
+	if (server.serverStart() != RC_OK)
+	{
+		return RC_ERROR;
+	}
+
+	unique_ptr<ReversiBenchClient[]> clients(new ReversiBenchClient[connections]);
+	sockaddr_un address;
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, config.socketPath.c_str(),
+			sizeof(address.sun_path) - 1);
+	for (unsigned int i = 0; i < connections; i++)
+	{
+		clients[i].fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		clients[i].phase = 'N';
+		clients[i].waiting = false;
+		clients[i].game = 0;
+		if (clients[i].fd < 0
+				|| connect(clients[i].fd, (sockaddr*) &address, sizeof(address))
+						!= 0)
+		{
+			for (unsigned int j = 0; j <= i; j++)
+			{
+				if (clients[j].fd >= 0)
+				{
+					close(clients[j].fd);
+				}
+			}
+			return RC_ERROR;
+		}
+	}
+
+	mt19937 rng(1);
+	uint64_t started = 0;
+	uint64_t finished = 0;
+	uint64_t requests = 0;
+	bool failed = false;
+	char buffer[4096];
+
+	uint64_t allocationsBefore = benchAllocations();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	while (finished < games && !failed)
+	{
+		// Send one request on every connection that still has work
+		for (unsigned int i = 0; i < connections; i++)
+		{
+			ReversiBenchClient &client = clients[i];
+			int length = 0;
+
+			if (client.phase == 'N' && started < games)
+			{
+				length = snprintf(buffer, sizeof(buffer), "NEW 8 8\n");
+				started++;
+			}
+			else if (client.phase == 'L')
+			{
+				length = snprintf(buffer, sizeof(buffer), "MOVES %u\n",
+						client.game);
+			}
+			else if (client.phase == 'M')
+			{
+				length = snprintf(buffer, sizeof(buffer), "MOVE %u %s\n",
+						client.game, client.input.c_str());
+			}
+			else if (client.phase == 'E')
+			{
+				length = snprintf(buffer, sizeof(buffer), "END %u\n",
+						client.game);
+			}
+			else
+			{
+				continue;
+			}
+			if (send(client.fd, buffer, length, MSG_NOSIGNAL) != length)
+			{
+				failed = true;
+			}
+			client.input.clear();
+			client.waiting = true;
+			requests++;
+		}
+
+		// Wait for the answers and pick the next requests
+		for (unsigned int i = 0; i < connections && !failed; i++)
+		{
+			ReversiBenchClient &client = clients[i];
+			if (!client.waiting)
+			{
+				continue;
+			}
+
+			size_t end;
+			while ((end = client.input.find('\n')) == string::npos)
+			{
+				ssize_t length = recv(client.fd, buffer, sizeof(buffer), 0);
+				if (length <= 0)
+				{
+					failed = true;
+					break;
+				}
+				client.input.append(buffer, length);
+			}
+			if (failed)
+			{
+				break;
+			}
+
+			string line = client.input.substr(0, end);
+			client.input.clear();
+			client.waiting = false;
+			if (line.compare(0, 2, "OK") != 0 && line.compare(0, 4, "OVER") != 0)
+			{
+				failed = true;
+			}
+			else if (client.phase == 'N')
+			{
+				client.game = strtoul(line.c_str() + 3, 0, 10);
+				client.phase = 'L';
+			}
+			else if (client.phase == 'L')
+			{
+				// "OK <side> <n> <row> <column> ...": keep one of the moves
+				istringstream fields(line.substr(5));
+				unsigned int count = 0;
+				unsigned int row;
+				unsigned int column;
+
+				fields >> count;
+				unsigned int pick = count ? rng() % count : 0;
+				for (unsigned int m = 0; m <= pick && fields >> row >> column; m++)
+				{
+					client.input = to_string(row) + " " + to_string(column);
+				}
+				client.phase = count ? 'M' : 'E';
+			}
+			else if (client.phase == 'M')
+			{
+				client.phase = (line[1] == 'V') ? 'E' : 'L';
+			}
+			else
+			{
+				finished++;
+				client.phase = 'N';
+			}
+		}
+	}
+	double seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	uint64_t allocations = benchAllocations() - allocationsBefore;
+
+	for (unsigned int i = 0; i < connections; i++)
+	{
+		close(clients[i].fd);
+	}
+	server.serverStop();
+	if (failed)
+	{
+		return RC_ERROR;
+	}
+
+	ReversiServerStats stats;
+	ostringstream name;
+	server.serverStats(stats);
+	name << "server request (" << connections << " connections, p50 "
+			<< stats.p50Micros << " us, p99 " << stats.p99Micros << " us)";
+	benchRecord(name.str(), 8, 8, requests, seconds, allocations);
+	return RC_OK;
+#else
+	(void) threads;
+	return RC_ERROR;
+#endif
+}
+
+/**
+ * @brief Runs the micro-benchmarks of the rules core for one board size.
+ *
+ * The measured position is reached by a seeded random game of rows*columns/3
+ * plies, so that all methods see a realistic midgame board.
+ *
+ * @param rows Board rows.
+ * @param columns Board columns.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+ *         too small to hold the initial position.
+ */
+RC_t ReversiBenchmark::benchMicro(unsigned int rows, unsigned int columns)
+{
+	if (rows < 2 || columns < 2)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiBoard position(rows, columns);
+	mt19937 rng(1);
+	char coin = 'x';
+
+	position.boardInitialState(rows, columns);
+	for (unsigned int ply = 0; ply < rows * columns / 3; ply++)
+	{
+		vector<pair<unsigned int, unsigned int> > moves = benchMoves(position,
+				coin);
+		if (moves.empty())
+		{
+			coin = (coin == 'x') ? 'o' : 'x';
+			if (benchMoves(position, coin).empty())
+			{
+				break;
+			}
+			continue;
+		}
+		pair<unsigned int, unsigned int> move = moves[rng() % moves.size()];
+		benchPlay(position, move.first, move.second, coin);
+		coin = (coin == 'x') ? 'o' : 'x';
+	}
+
+	vector<pair<unsigned int, unsigned int> > movesX = benchMoves(position, 'x');
+	vector<pair<unsigned int, unsigned int> > movesO = benchMoves(position, 'o');
+	unsigned int cells = rows * columns;
+	uint64_t operations;
+	uint64_t allocations;
+	double seconds;
+
+	benchMeasure(minSeconds, [&]()
+	{
+		uint64_t valid = 0;
+		for (unsigned int r = 0; r < rows; r++)
+		{
+			for (unsigned int c = 0; c < columns; c++)
+			{
+				valid += position.boardValidPositionX(r, c, 'x');
+			}
+		}
+		benchSink = valid;
+		return (uint64_t) cells;
+	}, operations, seconds, allocations);
+	benchRecord("boardValidPositionX", position, operations, seconds,
+			allocations);
+
+	benchMeasure(minSeconds, [&]()
+	{
+		uint64_t valid = 0;
+		for (unsigned int r = 0; r < rows; r++)
+		{
+			for (unsigned int c = 0; c < columns; c++)
+			{
+				valid += position.boardValidPositionO(r, c, 'o');
+			}
+		}
+		benchSink = valid;
+		return (uint64_t) cells;
+	}, operations, seconds, allocations);
+	benchRecord("boardValidPositionO", position, operations, seconds,
+			allocations);
+
+	// Console output of the view goes to the null device
+	FILE *pNull = fopen(nullDevice, "w");
+	if (pNull)
+	{
+		ReversiConsoleView view(&position);
+		view.viewSetOutput(pNull);
+		benchMeasure(minSeconds, [&]()
+		{
+			view.boardPrint(&position);
+			return (uint64_t) 1;
+		}, operations, seconds, allocations);
+		benchRecord("boardPrint", position, operations, seconds, allocations);
+
+		// One move and its take-back per two frames, as when watching a game
+		if (!movesX.empty())
+		{
+			view.viewSetMode(VIEW_DIFF);
+			view.boardPrint(&position);
+			benchMeasure(minSeconds, [&]()
+			{
+				position.makeMove(movesX[0].first, movesX[0].second, 'x');
+				view.boardPrint(&position);
+				position.unmakeMove();
+				view.boardPrint(&position);
+				return (uint64_t) 2;
+			}, operations, seconds, allocations);
+			benchRecord("boardPrint diff", position, operations, seconds,
+					allocations);
+		}
+		fclose(pNull);
+	}
+
+	ReversiMask moves(cells);
+	benchMeasure(minSeconds, [&]()
+	{
+		position.generateMoves('x', moves);
+		benchSink = moves.maskWord(0);
+		return (uint64_t) 1;
+	}, operations, seconds, allocations);
+	benchRecord("generateMoves", position, operations, seconds, allocations);
+
+	// Applying a move needs a fresh copy of the position; its cost is reported separately
+	ReversiBoard work(position);
+	benchMeasure(minSeconds, [&]()
+	{
+		work = position;
+		benchSink = work.boardGet(0, 0);
+		return (uint64_t) 1;
+	}, operations, seconds, allocations);
+	benchRecord("boardCopy", position, operations, seconds, allocations);
+
+	for (unsigned int pass = 0; pass < 2; pass++)
+	{
+		// Second pass: the same flips with the scalar kernel, if AVX2 is in use
+		string suffix = "";
+		if (pass == 1)
+		{
+			if (cells > 64 || !ReversiFlipKernel::flipKernelHasAvx2())
+			{
+				break;
+			}
+			ReversiFlipKernel::flipKernelUseSimd(false);
+			suffix = " (scalar)";
+		}
+
+		if (!movesX.empty())
+		{
+			benchMeasure(minSeconds, [&]()
+			{
+				for (unsigned int i = 0; i < movesX.size(); i++)
+				{
+					work = position;
+					work.boardSet(movesX[i].first, movesX[i].second, 'x');
+					work.flipOtoX(movesX[i].first, movesX[i].second, 'x');
+				}
+				benchSink = work.boardGet(0, 0);
+				return (uint64_t) movesX.size();
+			}, operations, seconds, allocations);
+			benchRecord("flipOtoX" + suffix, position, operations, seconds,
+					allocations);
+		}
+
+		if (!movesO.empty())
+		{
+			benchMeasure(minSeconds, [&]()
+			{
+				for (unsigned int i = 0; i < movesO.size(); i++)
+				{
+					work = position;
+					work.boardSet(movesO[i].first, movesO[i].second, 'o');
+					work.flipXtoO(movesO[i].first, movesO[i].second, 'o');
+				}
+				benchSink = work.boardGet(0, 0);
+				return (uint64_t) movesO.size();
+			}, operations, seconds, allocations);
+			benchRecord("flipXtoO" + suffix, position, operations, seconds,
+					allocations);
+		}
+	}
+	ReversiFlipKernel::flipKernelUseSimd(true);
+
+	benchMeasure(minSeconds, [&]()
+	{
+		work.boardClear();
+		benchSink = work.boardGet(0, 0);
+		return (uint64_t) 1;
+	}, operations, seconds, allocations);
+	benchRecord("boardClear", position, operations, seconds, allocations);
+
+	// Short-lived boards: constructed each time, taken from a pool, snapshot
+	benchMeasure(minSeconds, [&]()
+	{
+		ReversiBoard board(rows, columns);
+		board.boardInitialState(rows, columns);
+		benchSink = board.boardHash();
+		return (uint64_t) 1;
+	}, operations, seconds, allocations);
+	benchRecord("board construct", position, operations, seconds, allocations);
+
+	ReversiBoardPool pool;
+	benchMeasure(minSeconds, [&]()
+	{
+		ReversiBoardPool::Handle board = pool.poolAcquire(rows, columns);
+		benchSink = board->boardHash();
+		return (uint64_t) 1;
+	}, operations, seconds, allocations);
+	benchRecord("pool acquire", position, operations, seconds, allocations);
+
+	benchMeasure(minSeconds, [&]()
+	{
+		ReversiBoardSnapshot snapshot = position.boardSnapshot();
+		benchSink = snapshot.snapshotHash();
+		return (uint64_t) 1;
+	}, operations, seconds, allocations);
+	benchRecord("boardSnapshot", position, operations, seconds, allocations);
+
+	benchMeasure(minSeconds, [&]()
+	{
+		ReversiSymmetry_t transform;
+		benchSink = ReversiSymmetry::symmetryKey(position, transform);
+		return (uint64_t) 1;
+	}, operations, seconds, allocations);
+	benchRecord("symmetryKey", position, operations, seconds, allocations);
+
+	return RC_OK;
+}
+
+/**
+ * @brief Writes all recorded results as a table or as JSON.
+ *
+ * @param out The stream to write to.
+ * @param json true for JSON output, false for a text table.
+ * @return RC_OK if the operation was successful.
+ */
+RC_t ReversiBenchmark::benchReport(ostream &out, bool json) const
+{
+	if (json)
+	{
+		out << "{\n  \"simd\": "
+				<< (ReversiFlipKernel::flipKernelHasAvx2() ? "\"avx2\"" : "\"none\"")
+				<< ",\n  \"results\": [";
+		for (unsigned int i = 0; i < results.size(); i++)
+		{
+			const ReversiBenchResult &r = results[i];
+			out << (i ? "," : "") << "\n    { \"name\": \"" << r.name
+					<< "\", \"rows\": " << r.rows << ", \"columns\": "
+					<< r.columns << ", \"operations\": " << r.operations
+					<< ", \"seconds\": " << r.seconds << ", \"ns_per_op\": "
+					<< r.nsPerOp << ", \"ops_per_second\": " << r.opsPerSecond
+					<< ", \"allocs_per_op\": " << r.allocsPerOp << " }";
+		}
+		out << "\n  ]\n}" << endl;
+		return RC_OK;
+	}
+
+	out << left << setw(32) << "benchmark" << setw(8) << "size" << right
+			<< setw(14) << "ops" << setw(12) << "ns/op" << setw(16) << "ops/s"
+			<< setw(12) << "allocs/op" << endl;
+	for (unsigned int i = 0; i < results.size(); i++)
+	{
+		const ReversiBenchResult &r = results[i];
+		out << left << setw(32) << r.name << setw(8)
+				<< (to_string(r.rows) + "x" + to_string(r.columns)) << right
+				<< setw(14) << r.operations << setw(12) << fixed
+				<< setprecision(2) << r.nsPerOp << setw(16) << setprecision(0)
+				<< r.opsPerSecond << setw(12) << setprecision(3)
+				<< r.allocsPerOp << endl;
+		out.unsetf(ios::floatfield);
+	}
+	return RC_OK;
+}
@@ -0,0 +1,314 @@
+/*
+ * ReversiBenchmark.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBenchmark.h
+ * @brief Declares the perft counter and the micro-benchmarks of the rules core.
+ *
+ * This file is part of the `reversi_bench` target (Eclipse configuration "Bench"),
+ * which links the board sources without the interactive main.cpp.
+ */
+
+#ifndef REVERSIBENCHMARK_H_
+#define REVERSIBENCHMARK_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "../myCode/global.h"
+#include "../myCode/ReversiBoard.h"
+
+/**
+ * @brief One line of benchmark output.
+ */
+struct ReversiBenchResult
+{
+	std::string name;      ///< Name of the measured operation.
+	unsigned int rows;     ///< Board rows.
+	unsigned int columns;  ///< Board columns.
+	uint64_t operations;   ///< Number of operations (or perft nodes) measured.
+	double seconds;        ///< Wall-clock time of the measurement.
+	double nsPerOp;        ///< Nanoseconds per operation.
+	double opsPerSecond;   ///< Operations (nodes) per second.
+	double allocsPerOp;    ///< Heap allocations per operation.
+};
+
+/**
+ * @class ReversiBenchmark
+ * @brief Runs perft and micro-benchmarks and collects their results.
+ */
+class ReversiBenchmark
+{
+private:
+	double minSeconds;
+	std::vector<ReversiBenchResult> results;
+
+	/**
+	 * @brief Stores a result computed from the counters of one measurement.
+	 */
+	void benchRecord(const std::string &name, const ReversiBoard &board,
+			uint64_t operations, double seconds, uint64_t allocations);
+
+	/**
+	 * @brief Stores a result of a board that is not a ReversiBoard.
+	 */
+	void benchRecord(const std::string &name, unsigned int rows,
+			unsigned int columns, uint64_t operations, double seconds,
+			uint64_t allocations);
+
+public:
+	/**
+	 * @brief Constructs a benchmark runner.
+	 *
+	 * @param minSeconds Minimum measuring time of every micro-benchmark.
+	 */
+	ReversiBenchmark(double minSeconds);
+
+	/**
+	 * @brief Counts the leaf nodes of the game tree up to a fixed depth.
+	 *
+	 * A player without a legal move passes, which counts as one ply. Positions in
+	 * which neither player can move are counted as leaves, even above depth 0.
+	 * Moves are played with makeMove() / unmakeMove(), so the board is restored
+	 * on return and no board is copied.
+	 *
+	 * @param board The position to start from.
+	 * @param coin The player to move ('x' or 'o').
+	 * @param depth Remaining depth in plies.
+	 * @param passed true if the previous ply was a pass.
+	 * @return The number of leaf nodes.
+	 */
+	static uint64_t benchPerftCount(ReversiBoard &board, char coin,
+			unsigned int depth, bool passed);
+
+	/**
+	 * @brief Runs perft from the initial position and records nodes per second.
+	 *
+	 * Sizes with a specialized board are also counted with ReversiFixedBoard.
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns.
+	 * @param depth Depth in plies.
+	 * @param nodes Receives the number of leaf nodes.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+	 *         too small to hold the initial position, RC_ERROR if the two boards
+	 *         count different numbers of nodes.
+	 */
+	RC_t benchPerft(unsigned int rows, unsigned int columns, unsigned int depth,
+			uint64_t &nodes);
+
+	/**
+	 * @brief Searches the initial position for a fixed time and records nodes per second.
+	 *
+	 * The result name contains the depth of the last completed iteration.
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns.
+	 * @param milliseconds Time budget of the search.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+	 *         too small to hold the initial position.
+	 */
+	RC_t benchSearch(unsigned int rows, unsigned int columns,
+			unsigned int milliseconds);
+
+	/**
+	 * @brief Measures the time to reach a fixed depth with 1, 2, 4, ... threads.
+	 *
+	 * Every run starts with a cleared transposition table. The result names contain
+	 * the thread count and the speedup over one thread; the node rate is the sum
+	 * over all threads.
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns.
+	 * @param depth Depth of the search.
+	 * @param maxThreads Largest thread count measured.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+	 *         too small to hold the initial position.
+	 */
+	RC_t benchParallel(unsigned int rows, unsigned int columns,
+			unsigned int depth, unsigned int maxThreads);
+
+	/**
+	 * @brief Measures MCTS playouts per second with 1, 2, 4, ... threads.
+	 *
+	 * Every run searches the initial position for the given time with UCT; a
+	 * last run uses PUCT with the largest thread count. The result names contain
+	 * the thread count and the speedup of the playout rate over one thread.
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns.
+	 * @param milliseconds Time per run.
+	 * @param maxThreads Largest thread count measured.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+	 *         too small to hold the initial position.
+	 */
+	RC_t benchMcts(unsigned int rows, unsigned int columns,
+			unsigned int milliseconds, unsigned int maxThreads);
+
+	/**
+	 * @brief Solves seeded random endgames exactly and win/loss/draw only.
+	 *
+	 * The operations of the results are solver nodes; the names contain the
+	 * number of positions and their average solving time.
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns (rows * columns must not exceed 64).
+	 * @param empties Number of empty cells of the positions.
+	 * @param positions Number of positions to solve.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for
+	 *         unsupported board sizes.
+	 */
+	RC_t benchEndgame(unsigned int rows, unsigned int columns,
+			unsigned int empties, unsigned int positions);
+
+	/**
+	 * @brief Checks the endgame solver against a plain negamax.
+	 *
+	 * Random positions of several board shapes with 2 to 10 empty cells are
+	 * solved exactly and win/loss/draw only, with and without a transposition
+	 * table; the result counts the compared solves.
+	 *
+	 * @param positions Number of random positions per shape.
+	 * @return RC_OK if all scores and best moves match, RC_ERROR on a mismatch.
+	 */
+	RC_t benchEndgameCheck(unsigned int positions);
+
+	/**
+	 * @brief Builds an opening book from random self-play games and measures it.
+	 *
+	 * The games are written to a temporary archive, the book is built from their
+	 * first 12 plies, and opening the book and probing positions of the games are
+	 * measured. The temporary files are removed afterwards.
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns.
+	 * @param games Number of self-play games.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+	 *         too small to hold the initial position, RC_ERROR if the temporary
+	 *         files cannot be written.
+	 */
+	RC_t benchBook(unsigned int rows, unsigned int columns, uint64_t games);
+
+	/**
+	 * @brief Measures engine-against-engine self-play and checks that the games differ.
+	 *
+	 * Both players are alpha-beta engines with the default node budget and random
+	 * opening plies (ReversiSelfPlayConfig). The number of distinct games is
+	 * reported with the games per second.
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns.
+	 * @param games Number of self-play games.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+	 *         too small to hold the initial position, RC_ERROR if all games are the same.
+	 */
+	RC_t benchSelfPlay(unsigned int rows, unsigned int columns, uint64_t games);
+
+	/**
+	 * @brief Measures evaluations per second of the 8x8 pattern evaluation.
+	 *
+	 * Positions of seeded random games are evaluated in turn, with the dispatched
+	 * implementation and, if AVX2 is in use, with the scalar one.
+	 *
+	 * @param pWeights Weight file to load, or 0 for zero weights (same speed).
+	 * @return RC_OK if the operation was successful, RC_ERROR if the weight file
+	 *         cannot be read.
+	 */
+	RC_t benchEval(const char *pWeights);
+
+	/**
+	 * @brief Measures random play on the sparse board of a large size.
+	 *
+	 * A seeded random game is played from the initial position; every ply generates
+	 * all moves with ReversiSparseBoard::sparseMoves() and plays one of them. Up to
+	 * 128x128 the same game is also played on ReversiBoard for comparison (larger
+	 * dense boards do not fit into memory with their undo stack).
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns.
+	 * @param plies Number of plies to play.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+	 *         too small to hold the initial position.
+	 */
+	RC_t benchSparse(unsigned int rows, unsigned int columns,
+			unsigned int plies);
+
+	/**
+	 * @brief Measures random games played in lockstep on a batch of boards.
+	 *
+	 * Every board plays a game seeded with its number until all games are over,
+	 * once per batch instruction set available on the CPU; the same games are
+	 * then played one by one on ReversiBoard. Also measures the move generation
+	 * kernel of the batch alone.
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns (rows * columns must not exceed 64).
+	 * @param boards Number of boards in the batch.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for
+	 *         unsupported board sizes, RC_ERROR if an instruction set or
+	 *         ReversiBoard ends the games with different discs.
+	 */
+	RC_t benchBatch(unsigned int rows, unsigned int columns, size_t boards);
+
+	/**
+	 * @brief Checks the dispatched flip kernel bit for bit against the scalar one.
+	 *
+	 * Random positions of every board shape of up to 64 cells are compared; the
+	 * result counts the compared positions. Without AVX2 both sides are scalar.
+	 *
+	 * @param positions Number of random positions per shape.
+	 * @return RC_OK if all flip masks are identical, RC_ERROR on a mismatch.
+	 */
+	RC_t benchFlips(uint64_t positions);
+
+	/**
+	 * @brief Plays random 8x8 games against an in-process game server.
+	 *
+	 * The server listens on a temporary Unix domain socket. The client keeps one
+	 * request outstanding on every connection (NEW, MOVES, MOVE, END in turn) and
+	 * sends the next round once all connections have answered. The operations of
+	 * the result are requests; the name contains the server's move latency
+	 * percentiles. Linux only.
+	 *
+	 * @param connections Number of client connections.
+	 * @param games Number of games to finish.
+	 * @param threads Number of server threads.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for zero
+	 *         connections or games, RC_ERROR if the server or a connection cannot
+	 *         be set up.
+	 */
+	RC_t benchServer(unsigned int connections, uint64_t games,
+			unsigned int threads);
+
+	/**
+	 * @brief Runs the micro-benchmarks of the rules core for one board size.
+	 *
+	 * @param rows Board rows.
+	 * @param columns Board columns.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+	 *         too small to hold the initial position.
+	 */
+	RC_t benchMicro(unsigned int rows, unsigned int columns);
+
+	/**
+	 * @brief Writes all recorded results as a table or as JSON.
+	 *
+	 * @param out The stream to write to.
+	 * @param json true for JSON output, false for a text table.
+	 * @return RC_OK if the operation was successful.
+	 */
+	RC_t benchReport(std::ostream &out, bool json) const;
+
+	/**
+	 * @brief Returns the number of heap allocations made by the process so far.
+	 */
+	static uint64_t benchAllocations();
+};
+
+#endif /* REVERSIBENCHMARK_H_ */
@@ -0,0 +1,283 @@
+/*
+ * benchMain.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file benchMain.cpp
+ * @brief Entry point of the `reversi_bench` target.
+ *
+ * Usage:
+ *   reversi_bench perft <rows> <columns> <depth> [--json]
+ *   reversi_bench micro [<rows>x<columns> ...] [--time <seconds>] [--json]
+ *   reversi_bench search <rows> <columns> <milliseconds> [--json]
+ *   reversi_bench smp <rows> <columns> <depth> [<threads>] [--json]
+ *   reversi_bench mcts <rows> <columns> <milliseconds> [<threads>] [--json]
+ *   reversi_bench endgame <rows> <columns> <empties> [<positions>] [--json]
+ *   reversi_bench endgamecheck [<positions>] [--json]
+ *   reversi_bench book <rows> <columns> [<games>] [--json]
+ *   reversi_bench selfplay <rows> <columns> [<games>] [--json]
+ *   reversi_bench eval [<weights>] [--json]
+ *   reversi_bench sparse <rows> <columns> [<plies>] [--json]
+ *   reversi_bench batch <rows> <columns> [<boards>] [--json]
+ *   reversi_bench flips [<positions>] [--json]
+ *   reversi_bench server <connections> [<games>] [<threads>] [--json]
+ *
+ * Without arguments the flip kernel check runs first, then the micro-benchmarks
+ * for 6x6, 8x8, 10x10 and 16x16, followed by perft(8), a 100 ms search and the
+ * pattern evaluation on 8x8.
+ */
+
+// Standard (system) header files
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Project header files
+#include "ReversiBenchmark.h"
+
+/**
+ * @brief Parses a board size given as "<rows>x<columns>".
+ */
+static bool parseSize(const char *text, unsigned int &rows,
+		unsigned int &columns)
+{
+	char *end;
+	rows = strtoul(text, &end, 10);
+	if (*end != 'x')
+	{
+		return false;
+	}
+	columns = strtoul(end + 1, &end, 10);
+	return *end == '\0' && rows >= 2 && columns >= 2;
+}
+
+static int usage()
+{
+	cerr << "Usage: reversi_bench perft <rows> <columns> <depth> [--json]" << endl
+			<< "       reversi_bench micro [<rows>x<columns> ...] [--time <seconds>] [--json]"
+			<< endl
+			<< "       reversi_bench search <rows> <columns> <milliseconds> [--json]"
+			<< endl
+			<< "       reversi_bench smp <rows> <columns> <depth> [<threads>] [--json]"
+			<< endl
+			<< "       reversi_bench mcts <rows> <columns> <milliseconds> [<threads>] [--json]"
+			<< endl
+			<< "       reversi_bench endgame <rows> <columns> <empties> [<positions>] [--json]"
+			<< endl
+			<< "       reversi_bench endgamecheck [<positions>] [--json]" << endl
+			<< "       reversi_bench book <rows> <columns> [<games>] [--json]" << endl
+			<< "       reversi_bench selfplay <rows> <columns> [<games>] [--json]"
+			<< endl
+			<< "       reversi_bench eval [<weights>] [--json]" << endl
+			<< "       reversi_bench sparse <rows> <columns> [<plies>] [--json]"
+			<< endl
+			<< "       reversi_bench batch <rows> <columns> [<boards>] [--json]"
+			<< endl
+			<< "       reversi_bench flips [<positions>] [--json]" << endl
+			<< "       reversi_bench server <connections> [<games>] [<threads>] [--json]"
+			<< endl;
+	return 1;
+}
+
+// Main program
+int main(int argc, char *argv[])
+{
+	bool json = false;
+	double seconds = 0.2;
+	vector<string> args;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--json") == 0)
+		{
+			json = true;
+		}
+		else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc)
+		{
+			seconds = atof(argv[++i]);
+		}
+		else
+		{
+			args.push_back(argv[i]);
+		}
+	}
+
+	ReversiBenchmark bench(seconds);
+	uint64_t nodes;
+
+	if (args.empty())
+	{
+		const unsigned int sizes[] =
+		{ 6, 8, 10, 16 };
+		if (bench.benchFlips(1000) != RC_OK)
+		{
+			return 1;
+		}
+		for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+		{
+			bench.benchMicro(sizes[i], sizes[i]);
+		}
+		bench.benchPerft(8, 8, 8, nodes);
+		bench.benchSearch(8, 8, 100);
+		bench.benchEval(0);
+	}
+	else if (args[0] == "perft" && args.size() == 4)
+	{
+		if (bench.benchPerft(atoi(args[1].c_str()), atoi(args[2].c_str()),
+				atoi(args[3].c_str()), nodes) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "search" && args.size() == 4)
+	{
+		if (bench.benchSearch(atoi(args[1].c_str()), atoi(args[2].c_str()),
+				atoi(args[3].c_str())) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "smp" && (args.size() == 4 || args.size() == 5))
+	{
+		unsigned int threads = thread::hardware_concurrency();
+		if (args.size() == 5)
+		{
+			threads = atoi(args[4].c_str());
+		}
+		if (bench.benchParallel(atoi(args[1].c_str()), atoi(args[2].c_str()),
+				atoi(args[3].c_str()), threads ? threads : 1) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "mcts" && (args.size() == 4 || args.size() == 5))
+	{
+		unsigned int threads = thread::hardware_concurrency();
+		if (args.size() == 5)
+		{
+			threads = atoi(args[4].c_str());
+		}
+		if (bench.benchMcts(atoi(args[1].c_str()), atoi(args[2].c_str()),
+				atoi(args[3].c_str()), threads ? threads : 1) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "endgame" && (args.size() == 4 || args.size() == 5))
+	{
+		unsigned int positions = (args.size() == 5) ? atoi(args[4].c_str()) : 10;
+		if (bench.benchEndgame(atoi(args[1].c_str()), atoi(args[2].c_str()),
+				atoi(args[3].c_str()), positions ? positions : 1) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "endgamecheck" && args.size() <= 2)
+	{
+		unsigned int positions = (args.size() == 2) ? atoi(args[1].c_str()) : 50;
+		if (bench.benchEndgameCheck(positions) != RC_OK)
+		{
+			return 1;
+		}
+	}
+	else if (args[0] == "book" && (args.size() == 3 || args.size() == 4))
+	{
+		uint64_t games = (args.size() == 4) ? strtoull(args[3].c_str(), 0, 10) : 100000;
+		if (bench.benchBook(atoi(args[1].c_str()), atoi(args[2].c_str()),
+				games ? games : 1) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "selfplay" && (args.size() == 3 || args.size() == 4))
+	{
+		uint64_t games = (args.size() == 4) ? strtoull(args[3].c_str(), 0, 10) : 100;
+		RC_t rc = bench.benchSelfPlay(atoi(args[1].c_str()),
+				atoi(args[2].c_str()), games ? games : 1);
+		if (rc == RC_ERROR)
+		{
+			cerr << "All self-play games are the same." << endl;
+			bench.benchReport(cout, json);
+			return 1;
+		}
+		if (rc != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "eval" && args.size() <= 2)
+	{
+		if (bench.benchEval((args.size() == 2) ? args[1].c_str() : 0) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "sparse" && (args.size() == 3 || args.size() == 4))
+	{
+		unsigned int plies = (args.size() == 4) ? atoi(args[3].c_str()) : 2000;
+		if (bench.benchSparse(strtoul(args[1].c_str(), 0, 10),
+				strtoul(args[2].c_str(), 0, 10), plies) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "batch" && (args.size() == 3 || args.size() == 4))
+	{
+		size_t boards = (args.size() == 4) ? strtoul(args[3].c_str(), 0, 10) : 1024;
+		if (bench.benchBatch(atoi(args[1].c_str()), atoi(args[2].c_str()),
+				boards) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "flips" && args.size() <= 2)
+	{
+		uint64_t positions = (args.size() == 2) ? strtoull(args[1].c_str(), 0, 10) : 10000;
+		if (bench.benchFlips(positions) != RC_OK)
+		{
+			return 1;
+		}
+	}
+	else if (args[0] == "server" && args.size() >= 2 && args.size() <= 4)
+	{
+		uint64_t games = (args.size() >= 3) ? strtoull(args[2].c_str(), 0, 10) : 10000;
+		unsigned int threads = (args.size() == 4) ? atoi(args[3].c_str()) : 0;
+		if (bench.benchServer(atoi(args[1].c_str()), games, threads) != RC_OK)
+		{
+			return usage();
+		}
+	}
+	else if (args[0] == "micro")
+	{
+		unsigned int rows = 8;
+		unsigned int columns = 8;
+
+		if (args.size() == 1)
+		{
+			bench.benchMicro(rows, columns);
+		}
+		for (unsigned int i = 1; i < args.size(); i++)
+		{
+			if (!parseSize(args[i].c_str(), rows, columns))
+			{
+				return usage();
+			}
+			bench.benchMicro(rows, columns);
+		}
+	}
+	else
+	{
+		return usage();
+	}
+
+	bench.benchReport(cout, json);
+	return 0;
+}
@@ -0,0 +1,401 @@
+/*
+ * ReversiArchive.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiArchive.cpp
+ * @brief Implements the binary game archive writer and the memory-mapped reader.
+ */
+
+#include <string.h>
+
+#include "ReversiArchive.h"
+
+using namespace std;
+
+static const unsigned char fileMagic[4] =
+{ 'R', 'V', 'G', 'A' };
+static const unsigned char indexMagic[4] =
+{ 'R', 'V', 'G', 'I' };
+static const unsigned int FORMAT_VERSION = 1;
+static const size_t FILE_HEADER_SIZE = 16;
+static const size_t RECORD_HEADER_SIZE = 16;
+static const size_t TRAILER_SIZE = 24;
+
+// Largest board a record can hold: moves are stored in at most two bytes, and
+// 65535 is the pass code
+static const unsigned int MAX_CELLS = 65535;
+
+// Size of the stdio buffer of the writer
+static const size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+/**
+ * @brief Stores a number of 1..8 bytes in little-endian order.
+ */
+static inline void putLittle(unsigned char *p, uint64_t value, unsigned int bytes)
+{
+	for (unsigned int i = 0; i < bytes; i++)
+	{
+		p[i] = (unsigned char) (value >> (8 * i));
+	}
+}
+
+/**
+ * @brief Loads a number of 1..8 bytes in little-endian order.
+ */
+static inline uint64_t getLittle(const unsigned char *p, unsigned int bytes)
+{
+	uint64_t value = 0;
+	for (unsigned int i = 0; i < bytes; i++)
+	{
+		value |= (uint64_t) p[i] << (8 * i);
+	}
+	return value;
+}
+
+/**
+ * @brief Constructs a writer without an open file.
+ */
+ReversiArchiveWriter::ReversiArchiveWriter() :
+		pFile(0), offset(0)
+{
+}
+
+/**
+ * @brief Closes the file, writing the index block.
+ */
+ReversiArchiveWriter::~ReversiArchiveWriter()
+{
+	archiveClose();
+}
+
+/**
+ * @brief Creates (or truncates) an archive file and writes the file header.
+ *
+ * @param path The file name.
+ * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be written.
+ */
+RC_t ReversiArchiveWriter::archiveCreate(const char *path)
+{
+	unsigned char header[FILE_HEADER_SIZE];
+
+	archiveClose();
+	pFile = fopen(path, "wb");
+	if (!pFile)
+	{
+		return RC_ERROR;
+	}
+	setvbuf(pFile, 0, _IOFBF, WRITE_BUFFER_SIZE);
+
+	memset(header, 0, sizeof(header));
+	memcpy(header, fileMagic, 4);
+	putLittle(header + 4, FORMAT_VERSION, 2);
+	if (fwrite(header, 1, sizeof(header), pFile) != sizeof(header))
+	{
+		fclose(pFile);
+		pFile = 0;
+		return RC_ERROR;
+	}
+
+	offset = FILE_HEADER_SIZE;
+	offsets.clear();
+	return RC_OK;
+}
+
+/**
+ * @brief Appends the game recorded in the history of a board.
+ *
+ * The record is encoded into a buffer owned by the writer, which is reused for
+ * every game, and handed to the stdio buffer with a single write.
+ *
+ * @param board The board holding the game.
+ * @param metadata A free value stored with the game (e.g. a game number).
+ * @return RC_OK if the operation was successful, RC_ERROR if no file is open
+ *         or writing failed, RC_ERROR_BAD_PARAM for a board of more than
+ *         MAX_CELLS cells.
+ */
+RC_t ReversiArchiveWriter::archiveAppend(const ReversiBoard &board,
+		uint32_t metadata)
+{
+	lock_guard<mutex> guard(lock);
+
+	if (!pFile)
+	{
+		return RC_ERROR;
+	}
+
+	// Rows and columns are stored in two bytes each; a board of more cells
+	// would need wider moves, so it is refused rather than truncated
+	uint64_t cells = (uint64_t) board.boardRows() * board.boardColumns();
+	if (cells > MAX_CELLS || board.boardRows() > 0xFFFF
+			|| board.boardColumns() > 0xFFFF)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	unsigned int plies = board.boardHistorySize();
+	unsigned int bytesPerMove = (cells <= 255) ? 1 : 2;
+	int result = (int) board.boardCount('x') - (int) board.boardCount('o');
+
+	record.resize(RECORD_HEADER_SIZE + plies * bytesPerMove);
+	unsigned char *p = &record[0];
+
+	putLittle(p, board.boardRows(), 2);
+	putLittle(p + 2, board.boardColumns(), 2);
+	putLittle(p + 4, plies, 4);
+	putLittle(p + 8, (uint32_t) result, 4);
+	putLittle(p + 12, metadata, 4);
+	p += RECORD_HEADER_SIZE;
+
+	for (unsigned int i = 0; i < plies; i++)
+	{
+		unsigned int move = board.boardHistory(i).index;
+		if (move == ReversiUndo::PASS)
+		{
+			move = (bytesPerMove == 1) ? 0xFF : 0xFFFF;
+		}
+		putLittle(p, move, bytesPerMove);
+		p += bytesPerMove;
+	}
+
+	if (fwrite(&record[0], 1, record.size(), pFile) != record.size())
+	{
+		return RC_ERROR;
+	}
+
+	offsets.push_back(offset);
+	offset += record.size();
+	return RC_OK;
+}
+
+/**
+ * @brief Writes the index block and the trailer and closes the file.
+ *
+ * @return RC_OK if the operation was successful, RC_ERROR if no file is open
+ *         or writing failed.
+ */
+RC_t ReversiArchiveWriter::archiveClose()
+{
+	lock_guard<mutex> guard(lock);
+
+	if (!pFile)
+	{
+		return RC_ERROR;
+	}
+
+	bool ok = true;
+	unsigned char entry[8];
+	unsigned char trailer[TRAILER_SIZE];
+
+	for (size_t i = 0; i < offsets.size() && ok; i++)
+	{
+		putLittle(entry, offsets[i], 8);
+		ok = fwrite(entry, 1, 8, pFile) == 8;
+	}
+
+	memset(trailer, 0, sizeof(trailer));
+	putLittle(trailer, offset, 8);
+	putLittle(trailer + 8, offsets.size(), 8);
+	memcpy(trailer + 16, indexMagic, 4);
+	ok = ok && fwrite(trailer, 1, sizeof(trailer), pFile) == sizeof(trailer);
+	ok = (fclose(pFile) == 0) && ok;
+
+	pFile = 0;
+	return ok ? RC_OK : RC_ERROR;
+}
+
+/**
+ * @brief Constructs a reader without an open file.
+ */
+ReversiArchiveReader::ReversiArchiveReader() :
+		pData(0), size(0), pIndex(0), games(0)
+{
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+ReversiArchiveReader::~ReversiArchiveReader()
+{
+	archiveClose();
+}
+
+/**
+ * @brief Maps an archive file.
+ *
+ * The index block is used in place if the trailer is valid; otherwise the
+ * records are scanned once.
+ *
+ * @param path The file name.
+ * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be
+ *         mapped or is not an archive.
+ */
+RC_t ReversiArchiveReader::archiveOpen(const char *path)
+{
+	archiveClose();
+
+	if (file.mapOpen(path) != RC_OK || file.mapSize() < FILE_HEADER_SIZE)
+	{
+		file.mapClose();
+		return RC_ERROR;
+	}
+	pData = file.mapData();
+	size = file.mapSize();
+
+	if (memcmp(pData, fileMagic, 4) != 0
+			|| getLittle(pData + 4, 2) != FORMAT_VERSION)
+	{
+		archiveClose();
+		return RC_ERROR;
+	}
+
+	// Use the index block if the trailer is intact and consistent
+	if (size >= FILE_HEADER_SIZE + TRAILER_SIZE
+			&& memcmp(pData + size - TRAILER_SIZE + 16, indexMagic, 4) == 0)
+	{
+		uint64_t indexOffset = getLittle(pData + size - TRAILER_SIZE, 8);
+		uint64_t count = getLittle(pData + size - TRAILER_SIZE + 8, 8);
+
+		if (indexOffset >= FILE_HEADER_SIZE && count <= size / 8
+				&& indexOffset + 8 * count + TRAILER_SIZE == size)
+		{
+			pIndex = pData + indexOffset;
+			games = count;
+			return RC_OK;
+		}
+	}
+
+	archiveScan();
+	return RC_OK;
+}
+
+/**
+ * @brief Builds the offset list by walking the records from the file header on.
+ *
+ * The scan stops at the first record that does not fit into the file, so a
+ * partly written last record is ignored.
+ */
+void ReversiArchiveReader::archiveScan()
+{
+	uint64_t offset = FILE_HEADER_SIZE;
+
+	scanned.clear();
+	while (offset + RECORD_HEADER_SIZE <= size)
+	{
+		const unsigned char *p = pData + offset;
+		uint64_t cells = getLittle(p, 2) * getLittle(p + 2, 2);
+		uint64_t length = RECORD_HEADER_SIZE
+				+ getLittle(p + 4, 4) * ((cells <= 255) ? 1 : 2);
+
+		if (cells == 0 || offset + length > size)
+		{
+			break;
+		}
+		scanned.push_back(offset);
+		offset += length;
+	}
+	games = scanned.size();
+}
+
+/**
+ * @brief Unmaps the file; games returned before become invalid.
+ */
+void ReversiArchiveReader::archiveClose()
+{
+	file.mapClose();
+	pData = 0;
+	pIndex = 0;
+	size = 0;
+	games = 0;
+	scanned.clear();
+}
+
+/**
+ * @brief Returns a game without copying its moves.
+ *
+ * @param index Number of the game (smaller than archiveGames()).
+ * @param game Receives the game.
+ * @return RC_OK if the operation was successful, RC_ERROR_PARAM_OUTOFRANGE for
+ *         an invalid number, RC_ERROR for a damaged record.
+ */
+RC_t ReversiArchiveReader::archiveGame(size_t index,
+		ReversiArchiveGame &game) const
+{
+	if (index >= games)
+	{
+		return RC_ERROR_PARAM_OUTOFRANGE;
+	}
+
+	uint64_t offset = pIndex ? getLittle(pIndex + 8 * index, 8) : scanned[index];
+	if (offset + RECORD_HEADER_SIZE > size)
+	{
+		return RC_ERROR;
+	}
+
+	const unsigned char *p = pData + offset;
+	game.rows = getLittle(p, 2);
+	game.columns = getLittle(p + 2, 2);
+	game.plies = getLittle(p + 4, 4);
+	game.result = (int32_t) getLittle(p + 8, 4);
+	game.metadata = getLittle(p + 12, 4);
+	game.bytesPerMove = (game.rows * game.columns <= 255) ? 1 : 2;
+	game.pMoves = p + RECORD_HEADER_SIZE;
+
+	if (offset + RECORD_HEADER_SIZE + (uint64_t) game.plies * game.bytesPerMove
+			> size)
+	{
+		return RC_ERROR;
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Replays a game on a board of the same size.
+ *
+ * @param index Number of the game.
+ * @param board The board; it is cleared and set to the initial position first.
+ * @param plies Number of plies to replay (a larger number replays the whole game).
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM if the board
+ *         size differs, RC_ERROR for an illegal move in the record.
+ */
+RC_t ReversiArchiveReader::archiveReplay(size_t index, ReversiBoard &board,
+		unsigned int plies) const
+{
+	ReversiArchiveGame game;
+	RC_t rc = archiveGame(index, game);
+
+	if (rc != RC_OK)
+	{
+		return rc;
+	}
+	if (game.rows != board.boardRows() || game.columns != board.boardColumns())
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	board.boardClear();
+	board.boardInitialState(game.rows, game.columns);
+
+	if (plies > game.plies)
+	{
+		plies = game.plies;
+	}
+	for (unsigned int i = 0; i < plies; i++)
+	{
+		unsigned int move = game.gameMove(i);
+		char coin = board.boardSideToMove();
+
+		if (move == ReversiUndo::PASS)
+		{
+			board.makePass(coin);
+		}
+		else if (!board.makeMove(move, coin))
+		{
+			return RC_ERROR;
+		}
+	}
+	return RC_OK;
+}
@@ -0,0 +1,220 @@
+/*
+ * ReversiArchive.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiArchive.h
+ * @brief Declares the binary game archive: a streaming writer and a memory-mapped reader.
+ *
+ * File layout (all numbers little-endian):
+ * - file header, 16 bytes: magic "RVGA", version (u16), flags (u16), 8 reserved bytes,
+ * - one record per game: record header of 16 bytes (rows u16, columns u16,
+ *   plies u32, result i32 = 'x' discs minus 'o' discs, metadata u32), followed by
+ *   one byte per ply (cell index, 255 = pass) on boards of up to 255 cells and
+ *   two bytes per ply (65535 = pass) on boards of up to 65535 cells; larger
+ *   boards cannot be stored,
+ * - index block: the file offset (u64) of every record,
+ * - trailer, 24 bytes: offset of the index block (u64), number of games (u64),
+ *   magic "RVGI", 4 reserved bytes.
+ *
+ * The index block and trailer are written when the writer is closed. The reader
+ * rebuilds the index by scanning the records if a file has no valid trailer,
+ * e.g. after the writing process was killed.
+ */
+
+#ifndef REVERSIARCHIVE_H_
+#define REVERSIARCHIVE_H_
+
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#include "global.h"
+#include "ReversiBoard.h"
+#include "ReversiMappedFile.h"
+
+/**
+ * @brief A game inside a mapped archive. The moves point into the mapping.
+ */
+struct ReversiArchiveGame
+{
+	unsigned int rows;           ///< Board rows.
+	unsigned int columns;        ///< Board columns.
+	unsigned int plies;          ///< Number of moves and passes.
+	int result;                  ///< Final 'x' discs minus 'o' discs.
+	uint32_t metadata;           ///< Value given to archiveAppend().
+	const unsigned char *pMoves; ///< Encoded moves, bytesPerMove bytes each.
+	unsigned int bytesPerMove;   ///< 1 for boards of up to 255 cells, 2 otherwise.
+
+	/**
+	 * @brief Decodes a move.
+	 *
+	 * @param ply Number of the move (smaller than plies).
+	 * @return The cell index, or ReversiUndo::PASS.
+	 */
+	unsigned int gameMove(unsigned int ply) const
+	{
+		if (bytesPerMove == 1)
+		{
+			return (pMoves[ply] == 0xFF) ? ReversiUndo::PASS : pMoves[ply];
+		}
+		unsigned int move = pMoves[2 * ply] | (pMoves[2 * ply + 1] << 8);
+		return (move == 0xFFFF) ? ReversiUndo::PASS : move;
+	}
+};
+
+/**
+ * @class ReversiArchiveWriter
+ * @brief Appends games to a new archive file through a large write buffer.
+ *
+ * archiveAppend() may be called from several threads at once.
+ */
+class ReversiArchiveWriter
+{
+private:
+	FILE *pFile;
+	uint64_t offset;                ///< File offset of the next record.
+	std::vector<uint64_t> offsets;  ///< Offsets of all records written so far.
+	std::vector<unsigned char> record; ///< Encoding buffer of one record.
+	std::mutex lock;
+
+	ReversiArchiveWriter(const ReversiArchiveWriter&);
+	ReversiArchiveWriter& operator=(const ReversiArchiveWriter&);
+
+public:
+	/**
+	 * @brief Constructs a writer without an open file.
+	 */
+	ReversiArchiveWriter();
+
+	/**
+	 * @brief Closes the file, writing the index block.
+	 */
+	~ReversiArchiveWriter();
+
+	/**
+	 * @brief Creates (or truncates) an archive file and writes the file header.
+	 *
+	 * @param path The file name.
+	 * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be written.
+	 */
+	RC_t archiveCreate(const char *path);
+
+	/**
+	 * @brief Appends the game recorded in the history of a board.
+	 *
+	 * The game must have been played from boardInitialState() with makeMove()
+	 * and makePass().
+	 *
+	 * @param board The board holding the game.
+	 * @param metadata A free value stored with the game (e.g. a game number).
+	 * @return RC_OK if the operation was successful, RC_ERROR if no file is open
+	 *         or writing failed, RC_ERROR_BAD_PARAM for a board of more than
+	 *         65535 cells.
+	 */
+	RC_t archiveAppend(const ReversiBoard &board, uint32_t metadata);
+
+	/**
+	 * @brief Writes the index block and the trailer and closes the file.
+	 *
+	 * @return RC_OK if the operation was successful, RC_ERROR if no file is open
+	 *         or writing failed.
+	 */
+	RC_t archiveClose();
+
+	/**
+	 * @brief Returns the number of games written so far.
+	 */
+	size_t archiveGames() const
+	{
+		return offsets.size();
+	}
+};
+
+/**
+ * @class ReversiArchiveReader
+ * @brief Maps an archive file into memory and gives direct access to its games.
+ *
+ * No game data is copied: the games returned point into the mapping, which stays
+ * valid until the reader is closed.
+ */
+class ReversiArchiveReader
+{
+private:
+	ReversiMappedFile file;        ///< The mapped archive.
+	const unsigned char *pData;    ///< Start of the mapping.
+	size_t size;                   ///< Length of the file.
+	const unsigned char *pIndex;   ///< Index block inside the mapping, or 0.
+	std::vector<uint64_t> scanned; ///< Offsets found by scanning if there is no index block.
+	size_t games;                  ///< Number of games.
+
+	/**
+	 * @brief Builds the offset list by walking the records from the file header on.
+	 */
+	void archiveScan();
+
+	ReversiArchiveReader(const ReversiArchiveReader&);
+	ReversiArchiveReader& operator=(const ReversiArchiveReader&);
+
+public:
+	/**
+	 * @brief Constructs a reader without an open file.
+	 */
+	ReversiArchiveReader();
+
+	/**
+	 * @brief Unmaps the file.
+	 */
+	~ReversiArchiveReader();
+
+	/**
+	 * @brief Maps an archive file.
+	 *
+	 * @param path The file name.
+	 * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be
+	 *         mapped or is not an archive.
+	 */
+	RC_t archiveOpen(const char *path);
+
+	/**
+	 * @brief Unmaps the file; games returned before become invalid.
+	 */
+	void archiveClose();
+
+	/**
+	 * @brief Returns the number of games in the archive.
+	 */
+	size_t archiveGames() const
+	{
+		return games;
+	}
+
+	/**
+	 * @brief Returns a game without copying its moves.
+	 *
+	 * @param index Number of the game (smaller than archiveGames()).
+	 * @param game Receives the game.
+	 * @return RC_OK if the operation was successful, RC_ERROR_PARAM_OUTOFRANGE for
+	 *         an invalid number, RC_ERROR for a damaged record.
+	 */
+	RC_t archiveGame(size_t index, ReversiArchiveGame &game) const;
+
+	/**
+	 * @brief Replays a game on a board of the same size.
+	 *
+	 * @param index Number of the game.
+	 * @param board The board; it is cleared and set to the initial position first.
+	 * @param plies Number of plies to replay (a larger number replays the whole game).
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM if the board
+	 *         size differs, RC_ERROR for an illegal move in the record.
+	 */
+	RC_t archiveReplay(size_t index, ReversiBoard &board,
+			unsigned int plies = 0xFFFFFFFFu) const;
+};
+
+#endif /* REVERSIARCHIVE_H_ */
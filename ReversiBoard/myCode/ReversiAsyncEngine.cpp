@@ -0,0 +1,298 @@
+/*
+ * ReversiAsyncEngine.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiAsyncEngine.cpp
+ * @brief Implements the asynchronous engine with pondering.
+ */
+
+#include "ReversiAsyncEngine.h"
+#include "ReversiUndo.h"
+
+using namespace std;
+
+/**
+ * @brief Starts the engine thread.
+ *
+ * @param ttMegabytes Size of the transposition table.
+ */
+ReversiAsyncEngine::ReversiAsyncEngine(size_t ttMegabytes) :
+		tt(ttMegabytes), search(tt), stopFlag(false), position(0, 0), pending(
+				false), searching(false), resultValid(false), pondering(false), quit(
+				false), deadlineSet(false)
+{
+	search.searchSetStopFlag(&stopFlag);
+	worker = thread(&ReversiAsyncEngine::engineWorker, this);
+}
+
+/**
+ * @brief Stops the running search and joins the engine thread.
+ */
+ReversiAsyncEngine::~ReversiAsyncEngine()
+{
+	{
+		lock_guard<mutex> guard(lock);
+		quit = true;
+		stopFlag.store(true, memory_order_relaxed);
+	}
+	wake.notify_one();
+	worker.join();
+}
+
+/**
+ * @brief Body of the engine thread: waits for a search, runs it, reports back.
+ *
+ * The position and limits are only changed while no search is pending or
+ * running, so they are read without the lock.
+ */
+void ReversiAsyncEngine::engineWorker()
+{
+	ReversiSearchResult found;
+	unique_lock<mutex> guard(lock);
+
+	while (true)
+	{
+		wake.wait(guard, [this]
+		{	return pending || quit;});
+		if (quit)
+		{
+			return;
+		}
+		pending = false;
+		searching = true;
+		guard.unlock();
+
+		search.searchRun(position, limits, found);
+
+		guard.lock();
+		result.bestMove = found.bestMove;
+		result.score = found.score;
+		result.depth = found.depth;
+		result.nodes = found.nodes;
+		result.seconds = found.seconds;
+		result.pv.swap(found.pv);
+		resultValid = true;
+		searching = false;
+		done.notify_all();
+	}
+}
+
+/**
+ * @brief Stops the running search, waits for it and starts a new one.
+ *
+ * @param guard The held engine lock.
+ * @param position The position to search.
+ * @param limits Its budget.
+ * @param ponder The new search is a ponder search.
+ */
+void ReversiAsyncEngine::engineLaunch(unique_lock<mutex> &guard,
+		const ReversiBoard &position, const ReversiSearchLimits &limits,
+		bool ponder)
+{
+	stopFlag.store(true, memory_order_relaxed);
+	done.wait(guard, [this]
+	{	return !pending && !searching;});
+
+	this->position = position;
+	this->limits = limits;
+	stopFlag.store(false, memory_order_relaxed);
+	resultValid = false;
+	pondering = ponder;
+	deadlineSet = false;
+	pending = true;
+	wake.notify_one();
+}
+
+/**
+ * @brief Sets the pattern evaluation (see ReversiSearch::searchSetEvaluator()).
+ *
+ * @param pPatternEval The trained evaluation, or 0; must outlive the engine.
+ */
+void ReversiAsyncEngine::engineSetEvaluator(
+		const ReversiPatternEval *pPatternEval)
+{
+	search.searchSetEvaluator(pPatternEval);
+}
+
+/**
+ * @brief Starts a search in the background and returns at once.
+ *
+ * @param position The position; the side to move is taken from boardSideToMove().
+ * @param limits Depth, node and time budget.
+ * @return RC_OK if the search was started, RC_ERROR_BAD_PARAM for a board
+ *         without cells.
+ */
+RC_t ReversiAsyncEngine::engineStart(const ReversiBoard &position,
+		const ReversiSearchLimits &limits)
+{
+	if (position.boardCells().maskBits() == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	unique_lock<mutex> guard(lock);
+	engineLaunch(guard, position, limits, false);
+	return RC_OK;
+}
+
+/**
+ * @brief Starts pondering after the engine has moved and returns at once.
+ *
+ * The expected reply is taken from the principal variation of the last search.
+ * It is checked for legality, as the move actually played may have differed from
+ * the variation (e.g. a book move).
+ *
+ * @param position The position after the engine's move.
+ * @return RC_OK if pondering was started, RC_ERROR_BAD_PARAM for a board
+ *         without cells.
+ */
+RC_t ReversiAsyncEngine::enginePonder(const ReversiBoard &position)
+{
+	unsigned int cells = position.boardCells().maskBits();
+
+	if (cells == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	unique_lock<mutex> guard(lock);
+	unsigned int reply = ReversiSearch::NO_MOVE;
+
+	if (resultValid && !searching && result.pv.size() >= 2)
+	{
+		reply = result.pv[1];
+	}
+
+	ReversiBoard target(position);
+	char side = target.boardSideToMove();
+
+	if (reply == ReversiUndo::PASS && !target.boardHasMoves(side))
+	{
+		target.makePass(side);
+	}
+	else if (reply < cells && target.generateMoves(side).maskTest(reply))
+	{
+		target.makeMove(reply, side);
+	}
+
+	engineLaunch(guard, target, ReversiSearchLimits(), true);
+	return RC_OK;
+}
+
+/**
+ * @brief Searches the position after the opponent's move, reusing the ponder search.
+ *
+ * A position matches if the discs and the side to move are the same. Without a
+ * time limit the ponder search could not be bounded, so a new search is started.
+ *
+ * @param position The position; the side to move is taken from boardSideToMove().
+ * @param limits Depth, node and time budget.
+ * @param ponderHit Receives true if the ponder search is continued.
+ * @return RC_OK if the search runs, RC_ERROR_BAD_PARAM for a board without cells.
+ */
+RC_t ReversiAsyncEngine::engineGo(const ReversiBoard &position,
+		const ReversiSearchLimits &limits, bool &ponderHit)
+{
+	ponderHit = false;
+	if (position.boardCells().maskBits() == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	unique_lock<mutex> guard(lock);
+
+	if (pondering && limits.maxTime != 0
+			&& this->position.boardSideToMove() == position.boardSideToMove()
+			&& this->position.boardDiscs('x') == position.boardDiscs('x')
+			&& this->position.boardDiscs('o') == position.boardDiscs('o'))
+	{
+		pondering = false;
+		deadline = chrono::steady_clock::now()
+				+ chrono::milliseconds(limits.maxTime);
+		deadlineSet = true;
+		ponderHit = true;
+		return RC_OK;
+	}
+
+	engineLaunch(guard, position, limits, false);
+	return RC_OK;
+}
+
+/**
+ * @brief Asks the running search to stop; does not wait for it.
+ */
+void ReversiAsyncEngine::engineStop()
+{
+	stopFlag.store(true, memory_order_relaxed);
+}
+
+/**
+ * @brief Checks whether a search has been started and has not finished yet.
+ */
+bool ReversiAsyncEngine::engineBusy()
+{
+	lock_guard<mutex> guard(lock);
+	return pending || searching;
+}
+
+/**
+ * @brief Checks whether the running search is a ponder search.
+ */
+bool ReversiAsyncEngine::enginePondering()
+{
+	lock_guard<mutex> guard(lock);
+	return pondering && (pending || searching);
+}
+
+/**
+ * @brief Returns the result of the last search if it has finished, without waiting.
+ *
+ * @param result Receives the result.
+ * @return true if the last search has finished.
+ */
+bool ReversiAsyncEngine::engineQuery(ReversiSearchResult &result)
+{
+	lock_guard<mutex> guard(lock);
+
+	if (pending || searching || !resultValid)
+	{
+		return false;
+	}
+	result = this->result;
+	return true;
+}
+
+/**
+ * @brief Waits for the running search and returns its result.
+ *
+ * @param result Receives the result.
+ * @return true if there is a result, false if no search was started.
+ */
+bool ReversiAsyncEngine::engineWait(ReversiSearchResult &result)
+{
+	unique_lock<mutex> guard(lock);
+
+	while (pending || searching)
+	{
+		if (!deadlineSet)
+		{
+			done.wait(guard);
+		}
+		else if (done.wait_until(guard, deadline) == cv_status::timeout)
+		{
+			stopFlag.store(true, memory_order_relaxed);
+			deadlineSet = false;
+		}
+	}
+	if (!resultValid)
+	{
+		return false;
+	}
+	pondering = false;
+	result = this->result;
+	return true;
+}
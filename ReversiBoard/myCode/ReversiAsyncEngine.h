@@ -0,0 +1,187 @@
+/*
+ * ReversiAsyncEngine.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiAsyncEngine.h
+ * @brief Declares the asynchronous engine that searches and ponders in the background.
+ *
+ * The engine owns a search thread that is started once and waits for work, so
+ * the caller (e.g. the interactive game loop) can keep reading input while a
+ * search runs. After the engine has moved it ponders: it plays the reply it
+ * expects (the second move of its principal variation) and searches the position
+ * after it without a budget until the opponent has moved. If the opponent plays
+ * the expected reply, the running search simply continues with the move time
+ * counted from then on (a ponder hit); otherwise it is stopped and a new search
+ * starts on the actual position. Either way the transposition table still holds
+ * what the ponder search has found, so the time the opponent spends thinking is
+ * not lost.
+ */
+
+#ifndef REVERSIASYNCENGINE_H_
+#define REVERSIASYNCENGINE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stddef.h>
+#include <thread>
+
+#include "global.h"
+#include "ReversiBoard.h"
+#include "ReversiPatternEval.h"
+#include "ReversiSearch.h"
+#include "ReversiTransTable.h"
+
+/**
+ * @class ReversiAsyncEngine
+ * @brief A search running on its own thread, with pondering.
+ *
+ * All methods are called from one controlling thread; only the search itself runs
+ * on the engine thread. At most one search runs at a time: starting a search stops
+ * the previous one and discards its result.
+ */
+class ReversiAsyncEngine
+{
+private:
+	ReversiTransTable tt;            ///< Table kept across searches (and warmed by pondering).
+	ReversiSearch search;            ///< The engine; used by the engine thread only while searching.
+	std::thread worker;              ///< The engine thread.
+	std::mutex lock;
+	std::condition_variable wake;    ///< Signals a new search or shutdown to the engine thread.
+	std::condition_variable done;    ///< Signals that a search has finished.
+	std::atomic<bool> stopFlag;      ///< Stops the running search; cleared when the next one is started.
+	ReversiBoard position;           ///< Position of the running or last search.
+	ReversiSearchLimits limits;      ///< Budget of the running or last search.
+	ReversiSearchResult result;      ///< Result of the last finished search.
+	bool pending;                    ///< A search was started but not yet picked up.
+	bool searching;                  ///< The engine thread is searching.
+	bool resultValid;                ///< result belongs to the last started search.
+	bool pondering;                  ///< The running search is a ponder search.
+	bool quit;                       ///< The engine thread shall exit.
+	bool deadlineSet;                ///< deadline applies to the running search.
+	std::chrono::steady_clock::time_point deadline; ///< Time at which engineWait() stops the search.
+
+	/**
+	 * @brief Body of the engine thread: waits for a search, runs it, reports back.
+	 */
+	void engineWorker();
+
+	/**
+	 * @brief Stops the running search, waits for it and starts a new one.
+	 *
+	 * @param lock The held engine lock.
+	 */
+	void engineLaunch(std::unique_lock<std::mutex> &lock,
+			const ReversiBoard &position, const ReversiSearchLimits &limits,
+			bool ponder);
+
+	ReversiAsyncEngine(const ReversiAsyncEngine&);
+	ReversiAsyncEngine& operator=(const ReversiAsyncEngine&);
+
+public:
+	/**
+	 * @brief Starts the engine thread.
+	 *
+	 * @param ttMegabytes Size of the transposition table.
+	 */
+	explicit ReversiAsyncEngine(size_t ttMegabytes);
+
+	/**
+	 * @brief Stops the running search and joins the engine thread.
+	 */
+	~ReversiAsyncEngine();
+
+	/**
+	 * @brief Sets the pattern evaluation (see ReversiSearch::searchSetEvaluator()).
+	 *
+	 * Must not be called while a search runs.
+	 *
+	 * @param pPatternEval The trained evaluation, or 0; must outlive the engine.
+	 */
+	void engineSetEvaluator(const ReversiPatternEval *pPatternEval);
+
+	/**
+	 * @brief Starts a search in the background and returns at once.
+	 *
+	 * @param position The position; the side to move is taken from boardSideToMove().
+	 * @param limits Depth, node and time budget.
+	 * @return RC_OK if the search was started, RC_ERROR_BAD_PARAM for a board
+	 *         without cells.
+	 */
+	RC_t engineStart(const ReversiBoard &position,
+			const ReversiSearchLimits &limits);
+
+	/**
+	 * @brief Starts pondering after the engine has moved and returns at once.
+	 *
+	 * The reply expected by the last search (the second move of its principal
+	 * variation) is played if it is legal, and the position after it is searched
+	 * without a budget. Without an expected reply the position itself is searched,
+	 * which fills the table for all replies.
+	 *
+	 * @param position The position after the engine's move; the side to move is
+	 *        taken from boardSideToMove().
+	 * @return RC_OK if pondering was started, RC_ERROR_BAD_PARAM for a board
+	 *         without cells.
+	 */
+	RC_t enginePonder(const ReversiBoard &position);
+
+	/**
+	 * @brief Searches the position after the opponent's move, reusing the ponder search.
+	 *
+	 * If the engine is pondering on this very position, the ponder search goes on
+	 * and only the time limit applies, counted from now. Otherwise a new search is
+	 * started; it still finds the entries the ponder search has left in the table.
+	 * The result is collected with engineWait().
+	 *
+	 * @param position The position; the side to move is taken from boardSideToMove().
+	 * @param limits Depth, node and time budget.
+	 * @param ponderHit Receives true if the ponder search is continued.
+	 * @return RC_OK if the search runs, RC_ERROR_BAD_PARAM for a board without cells.
+	 */
+	RC_t engineGo(const ReversiBoard &position,
+			const ReversiSearchLimits &limits, bool &ponderHit);
+
+	/**
+	 * @brief Asks the running search to stop; does not wait for it.
+	 *
+	 * Like all budgets, the request applies once the first iteration has completed.
+	 */
+	void engineStop();
+
+	/**
+	 * @brief Checks whether a search has been started and has not finished yet.
+	 */
+	bool engineBusy();
+
+	/**
+	 * @brief Checks whether the running search is a ponder search.
+	 */
+	bool enginePondering();
+
+	/**
+	 * @brief Returns the result of the last search if it has finished, without waiting.
+	 *
+	 * @param result Receives the result.
+	 * @return true if the last search has finished.
+	 */
+	bool engineQuery(ReversiSearchResult &result);
+
+	/**
+	 * @brief Waits for the running search and returns its result.
+	 *
+	 * A search continued by engineGo() is stopped when its move time is used up.
+	 * A ponder search has no budget and has to be stopped with engineStop() first.
+	 *
+	 * @param result Receives the result.
+	 * @return true if there is a result, false if no search was started.
+	 */
+	bool engineWait(ReversiSearchResult &result);
+};
+
+#endif /* REVERSIASYNCENGINE_H_ */
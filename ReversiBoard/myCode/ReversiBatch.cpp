@@ -0,0 +1,166 @@
+/*
+ * ReversiBatch.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBatch.cpp
+ * @brief Implements the batch interface of the rules core.
+ */
+
+#include "ReversiBatch.h"
+
+using namespace std;
+
+/**
+ * @brief Checks the parts of a move that do not depend on the position.
+ *
+ * @return BATCH_OK if the board number, the coin and the cell are in range.
+ */
+static ReversiBatchResult_t batchCheck(const ReversiBoard *const *ppBoards,
+		size_t boards, const ReversiBatchMove_t &move)
+{
+	if (move.board >= boards || ppBoards[move.board] == 0)
+	{
+		return BATCH_BAD_BOARD;
+	}
+	if (move.coin != 'x' && move.coin != 'o')
+	{
+		return BATCH_BAD_COIN;
+	}
+	const ReversiBoard &board = *ppBoards[move.board];
+	if (move.cell != ReversiBatch::PASS
+			&& move.cell >= (uint64_t) board.boardRows() * board.boardColumns())
+	{
+		return BATCH_OUT_OF_RANGE;
+	}
+	return BATCH_OK;
+}
+
+/**
+ * @brief Legal moves of one board and player, kept while the batch stays on it.
+ */
+struct ReversiBatchCache
+{
+	const ReversiBoard *pBoard; ///< Board of the cached moves, 0 if none.
+	char coin;                  ///< Player of the cached moves.
+	ReversiMask moves;          ///< The legal moves.
+
+	ReversiBatchCache() :
+			pBoard(0), coin('.')
+	{
+	}
+
+	/**
+	 * @brief Returns the result of a move whose board, coin and cell are in range.
+	 */
+	ReversiBatchResult_t cacheLookup(const ReversiBoard &board,
+			const ReversiBatchMove_t &move)
+	{
+		if (pBoard != &board || coin != move.coin)
+		{
+			board.generateMoves(move.coin, moves);
+			pBoard = &board;
+			coin = move.coin;
+		}
+		if (move.cell == ReversiBatch::PASS)
+		{
+			return moves.maskAny() ? BATCH_ILLEGAL : BATCH_OK;
+		}
+		return moves.maskTest(move.cell) ? BATCH_OK : BATCH_ILLEGAL;
+	}
+};
+
+/**
+ * @brief Checks a batch of moves without changing the boards.
+ *
+ * @param ppBoards The boards.
+ * @param boards Number of boards.
+ * @param pMoves The moves.
+ * @param moves Number of moves.
+ * @param pResults Receives one result per move.
+ * @param legal Receives the number of legal moves.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for a null
+ *         array with a non-zero count.
+ */
+RC_t ReversiBatch::batchValidate(const ReversiBoard *const *ppBoards,
+		size_t boards, const ReversiBatchMove_t *pMoves, size_t moves,
+		ReversiBatchResult_t *pResults, size_t &legal)
+{
+	legal = 0;
+	if ((boards != 0 && ppBoards == 0)
+			|| (moves != 0 && (pMoves == 0 || pResults == 0)))
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiBatchCache cache;
+	for (size_t i = 0; i < moves; i++)
+	{
+		const ReversiBatchMove_t &move = pMoves[i];
+		ReversiBatchResult_t result = batchCheck(ppBoards, boards, move);
+		if (result == BATCH_OK)
+		{
+			result = cache.cacheLookup(*ppBoards[move.board], move);
+		}
+		pResults[i] = result;
+		legal += (result == BATCH_OK);
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Plays a batch of moves in array order.
+ *
+ * @param ppBoards The boards.
+ * @param boards Number of boards.
+ * @param pMoves The moves.
+ * @param moves Number of moves.
+ * @param pResults Receives one result per move.
+ * @param played Receives the number of moves played.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for a null
+ *         array with a non-zero count.
+ */
+RC_t ReversiBatch::batchApply(ReversiBoard *const *ppBoards, size_t boards,
+		const ReversiBatchMove_t *pMoves, size_t moves,
+		ReversiBatchResult_t *pResults, size_t &played)
+{
+	played = 0;
+	if ((boards != 0 && ppBoards == 0)
+			|| (moves != 0 && (pMoves == 0 || pResults == 0)))
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	for (size_t i = 0; i < moves; i++)
+	{
+		const ReversiBatchMove_t &move = pMoves[i];
+		ReversiBatchResult_t result = batchCheck(ppBoards, boards, move);
+		if (result == BATCH_OK)
+		{
+			ReversiBoard &board = *ppBoards[move.board];
+			if (move.cell == PASS)
+			{
+				// A pass is only legal without any move
+				if (board.boardHasMoves(move.coin))
+				{
+					result = BATCH_ILLEGAL;
+				}
+				else
+				{
+					board.makePass(move.coin);
+				}
+			}
+			else if (board.makeMove(move.cell, move.coin) == 0)
+			{
+				// makeMove() validates while computing the flips
+				result = BATCH_ILLEGAL;
+			}
+		}
+		pResults[i] = result;
+		played += (result == BATCH_OK);
+	}
+	return RC_OK;
+}
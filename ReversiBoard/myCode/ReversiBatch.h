@@ -0,0 +1,108 @@
+/*
+ * ReversiBatch.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBatch.h
+ * @brief Declares the batch interface of the rules core.
+ *
+ * One call validates or plays a whole array of moves on an array of boards and
+ * writes one result per move into an array of the caller. Nothing is printed and
+ * nothing is locked, so services can check many requests per call without
+ * touching the console streams.
+ */
+
+#ifndef REVERSIBATCH_H_
+#define REVERSIBATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "global.h"
+#include "ReversiBoard.h"
+
+/**
+ * @enum ReversiBatchResult_t
+ * @brief Outcome of one move of a batch.
+ */
+typedef enum
+{
+	BATCH_OK,            ///< The move is legal (and has been played by batchApply()).
+	BATCH_ILLEGAL,       ///< The cell is taken or would flip nothing, or a pass with legal moves.
+	BATCH_OUT_OF_RANGE,  ///< The cell is outside the board.
+	BATCH_BAD_COIN,      ///< The coin is neither 'x' nor 'o'.
+	BATCH_BAD_BOARD      ///< The board number is not below the number of boards.
+} ReversiBatchResult_t;
+
+/**
+ * @struct ReversiBatchMove_t
+ * @brief One move of a batch.
+ */
+typedef struct
+{
+	uint32_t board; ///< Position of the board in the board array.
+	uint32_t cell;  ///< Cell index (row * columns + column), or ReversiBatch::PASS.
+	char coin;      ///< The moving player ('x' or 'o').
+} ReversiBatchMove_t;
+
+/**
+ * @class ReversiBatch
+ * @brief Validates or plays many moves on many boards in one call.
+ *
+ * Moves may refer to the boards in any order. The legal moves of a board are
+ * computed once and reused for all following moves of the same board and player,
+ * so batches sorted by board are cheapest.
+ */
+class ReversiBatch
+{
+public:
+	/**
+	 * @brief Cell value of a pass.
+	 */
+	static const uint32_t PASS = 0xFFFFFFFFu;
+
+	/**
+	 * @brief Checks a batch of moves without changing the boards.
+	 *
+	 * Every move is checked against the position of its board as given; moves do
+	 * not see each other.
+	 *
+	 * @param ppBoards The boards.
+	 * @param boards Number of boards.
+	 * @param pMoves The moves.
+	 * @param moves Number of moves.
+	 * @param pResults Receives one result per move.
+	 * @param legal Receives the number of legal moves.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for a null
+	 *         array with a non-zero count.
+	 */
+	static RC_t batchValidate(const ReversiBoard *const *ppBoards, size_t boards,
+			const ReversiBatchMove_t *pMoves, size_t moves,
+			ReversiBatchResult_t *pResults, size_t &legal);
+
+	/**
+	 * @brief Plays a batch of moves in array order.
+	 *
+	 * Each move is checked against the position left by the moves before it. Legal
+	 * moves are played with ReversiBoard::makeMove() or ReversiBoard::makePass(), so
+	 * they can be taken back with ReversiBoard::unmakeMove(); illegal moves leave
+	 * their board unchanged and the batch continues.
+	 *
+	 * @param ppBoards The boards.
+	 * @param boards Number of boards.
+	 * @param pMoves The moves.
+	 * @param moves Number of moves.
+	 * @param pResults Receives one result per move.
+	 * @param played Receives the number of moves played.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for a null
+	 *         array with a non-zero count.
+	 */
+	static RC_t batchApply(ReversiBoard *const *ppBoards, size_t boards,
+			const ReversiBatchMove_t *pMoves, size_t moves,
+			ReversiBatchResult_t *pResults, size_t &played);
+};
+
+#endif /* REVERSIBATCH_H_ */
@@ -11,47 +11,104 @@
  *
  * This file contains the methods to manage the board, handle the initial setup,
  * check for valid moves, and flip the discs during gameplay.
- * It uses dynamic memory allocation to store the board state and provides methods
- * to manipulate the board during the game.
+ * The board state is stored as two bit masks (one per player), so that moves and
+ * flips become shift/and/or operations on whole words instead of byte walks.
+ * Boards with up to 64 cells fit into a single word and take a dedicated fast path.
  */
 
-#include <iostream>
-
 #include "ReversiBoard.h"
-#include "ReversiConsoleView.h"
+#include "ReversiMetrics.h"
+#include "ReversiZobrist.h"
 
 using namespace std;
 
+// Offsets for the eight directions in clockwise order.
+static const int xOffsets[] =
+{ -1, -1, 0, 1, 1, 1, 0, -1 };
+static const int yOffsets[] =
+{ 0, -1, -1, -1, 0, 1, 1, 1 };
+static const unsigned int numDirections = sizeof(xOffsets)
+		/ sizeof(xOffsets[0]);
+
+/**
+ * @brief Shifts a single-word mask by a signed amount.
+ *
+ * Positive amounts move bits towards higher indices. Amounts of 64 or more clear
+ * the mask instead of invoking undefined behaviour.
+ *
+ * @param mask The mask to shift.
+ * @param amount Signed number of bit positions.
+ * @return The shifted mask.
+ */
+static inline uint64_t shiftWord(uint64_t mask, int amount)
+{
+	if (amount >= 0)
+	{
+		return (amount < 64) ? (mask << amount) : 0;
+	}
+	return (amount > -64) ? (mask >> -amount) : 0;
+}
+
 /**
  * @brief Constructor that initializes the game board.
  *
  * This constructor creates a board of the specified rows and columns and
- * initializes it with empty cells ('.').
+ * initializes it with empty cells ('.'). The members rows and columns are
+ * initialized first; sizes boardSupports() rejects are replaced by 0x0 there,
+ * so the cell count used for the masks cannot wrap around.
  *
  * @param rows Number of rows in the board.
  * @param columns Number of columns in the board.
  */
 ReversiBoard::ReversiBoard(unsigned int rows, unsigned int columns) :
-		rows(rows), columns(columns)
+		rows(boardSupports(rows, columns) ? rows : 0), columns(
+				boardSupports(rows, columns) ? columns : 0), discsX(
+				boardCellCount()), discsO(boardCellCount()), maskAll(
+				boardCellCount()), maskNotFirstColumn(boardCellCount()), maskNotLastColumn(
+				boardCellCount()), flipKernel(this->rows, this->columns), undoStack(
+				boardCellCount(), 2 * boardCellCount() + 2), hash(0), sideToMove(
+				'x'), countX(0), countO(0), frontier(boardCellCount()), movesX(
+				boardCellCount()), movesO(boardCellCount()), dirty(
+				boardCellCount()), affected(boardCellCount()), dirtyCount(0), mobilityX(
+				0), mobilityO(0), trackFresh(false), trackFull(true)
 {
-	pBoard = new char[rows * columns]; // Allocate memory for the board
+	// Precompute the edge masks used to stop shifts from wrapping around rows
+	maskAll.maskFill();
+	maskNotFirstColumn.maskFill();
+	maskNotLastColumn.maskFill();
+	for (unsigned int r = 0; this->columns > 0 && r < this->rows; r++)
+	{
+		maskNotFirstColumn.maskReset(boardCalcIndex(r, 0));
+		maskNotLastColumn.maskReset(boardCalcIndex(r, this->columns - 1));
+	}
+
 	boardClear();
 }
 
+/**
+ * @brief Constructs a board holding the position of a snapshot, with an empty history.
+ *
+ * @param snapshot The position.
+ */
+ReversiBoard::ReversiBoard(const ReversiBoardSnapshot &snapshot) :
+		ReversiBoard(snapshot.rows, snapshot.columns)
+{
+	boardRestore(snapshot);
+}
+
 /**
  * @brief Destructor that cleans up the dynamically allocated memory.
  */
 ReversiBoard::~ReversiBoard()
 {
-	// TODO Auto-generated destructor stub
-	delete[] pBoard;
 }
 
 /**
  * @brief Calculates the index of the board cell from row and column.
  *
- * This method is used internally to convert the 2D board position to a 1D index
- * for accessing the board array.
+ * This method is used internally to convert the 2D board position to a 1D index,
+ * which is the bit position of the cell within the board masks. The cell must be
+ * on the board; the index is then smaller than MAX_CELLS and cannot wrap around.
  *
  * @param row Row index of the board.
  * @param column Column index of the board.
@@ -63,19 +120,571 @@ unsigned int ReversiBoard::boardCalcIndex(unsigned int row,
 	return row * columns + column;
 }
 
+/**
+ * @brief Returns the signed bit distance between a cell and its neighbour.
+ *
+ * @param direction Index of the direction (0..7, clockwise starting "up").
+ * @return The amount by which a mask has to be shifted to move one step.
+ */
+int ReversiBoard::boardCalcShift(unsigned int direction) const
+{
+	return xOffsets[direction] * (int) columns + yOffsets[direction];
+}
+
+/**
+ * @brief Returns the cells a mask may land on after one step.
+ *
+ * @param direction Index of the direction (0..7).
+ * @return The landing mask for the direction.
+ */
+const ReversiMask& ReversiBoard::boardLandingMask(unsigned int direction) const
+{
+	if (yOffsets[direction] > 0)
+	{
+		return maskNotFirstColumn;
+	}
+	else if (yOffsets[direction] < 0)
+	{
+		return maskNotLastColumn;
+	}
+	return maskAll;
+}
+
+/**
+ * @brief Computes all legal moves on a board with up to 64 cells.
+ *
+ * For each direction, 'gen' starts with the player's discs and 'pro' with the
+ * opponent discs that may be entered by a step in that direction. Each round
+ * doubles the covered distance, so a ray of n cells needs only log2(n) rounds.
+ * The opponent part of 'gen' then is exactly the runs touching the player's
+ * discs, and one more step onto an empty cell yields the legal moves.
+ *
+ * @param own Discs of the moving player.
+ * @param opp Discs of the opponent.
+ * @return The mask of legal moves.
+ */
+uint64_t ReversiBoard::boardMovesWord(uint64_t own, uint64_t opp) const
+{
+	uint64_t empty = maskAll.maskWord(0) & ~(own | opp);
+	unsigned int longest = (rows > columns) ? rows : columns;
+	uint64_t moves = 0;
+
+	for (unsigned int i = 0; i < numDirections; i++)
+	{
+		int shift = boardCalcShift(i);
+		uint64_t landing = boardLandingMask(i).maskWord(0);
+		uint64_t gen = own;
+		uint64_t pro = opp & landing;
+
+		for (unsigned int step = 1; step + 1 < longest; step <<= 1)
+		{
+			gen |= pro & shiftWord(gen, shift * (int) step);
+			pro &= shiftWord(pro, shift * (int) step);
+		}
+
+		moves |= shiftWord(gen & opp, shift) & landing & empty;
+	}
+
+	return moves;
+}
+
+/**
+ * @brief Multi-word counterpart of boardMovesWord() for boards above 64 cells.
+ *
+ * @param own Discs of the moving player.
+ * @param opp Discs of the opponent.
+ * @param moves Receives the mask of legal moves (must have the board length).
+ */
+void ReversiBoard::boardMovesMask(const ReversiMask &own,
+		const ReversiMask &opp, ReversiMask &moves) const
+{
+	unsigned int longest = (rows > columns) ? rows : columns;
+	ReversiMask empty(maskAll);
+	ReversiMask gen(maskAll.maskBits());
+	ReversiMask pro(maskAll.maskBits());
+	ReversiMask tmp(maskAll.maskBits());
+
+	empty.maskAndNot(own);
+	empty.maskAndNot(opp);
+	moves.maskClear();
+
+	for (unsigned int i = 0; i < numDirections; i++)
+	{
+		int shift = boardCalcShift(i);
+		const ReversiMask &landing = boardLandingMask(i);
+
+		gen = own;
+		pro = opp;
+		pro &= landing;
+
+		for (unsigned int step = 1; step + 1 < longest; step <<= 1)
+		{
+			tmp = gen;
+			tmp.maskShift(shift * (int) step);
+			tmp &= pro;
+			gen |= tmp;
+
+			tmp = pro;
+			tmp.maskShift(shift * (int) step);
+			pro &= tmp;
+		}
+
+		gen &= opp;
+		gen.maskShift(shift);
+		gen &= landing;
+		gen &= empty;
+		moves |= gen;
+	}
+}
+
+/**
+ * @brief Counts the opponent discs bracketed in one direction.
+ *
+ * @param row The row index of the move.
+ * @param column The column index of the move.
+ * @param direction Index of the direction (0..7).
+ * @param own Discs of the moving player.
+ * @param opp Discs of the opponent.
+ * @return Number of discs flipped in this direction (0 if not bracketed).
+ */
+unsigned int ReversiBoard::boardRayLength(unsigned int row,
+		unsigned int column, unsigned int direction, const ReversiMask &own,
+		const ReversiMask &opp) const
+{
+	int x = row + xOffsets[direction];
+	int y = column + yOffsets[direction];
+	unsigned int count = 0;
+
+	// Traverse in the current direction.
+	while (x >= 0 && y >= 0 && x < (int) rows && y < (int) columns)
+	{
+		unsigned int index = boardCalcIndex(x, y);
+
+		if (opp.maskTest(index))
+		{
+			count++;
+		}
+		else if (own.maskTest(index))
+		{
+			return count;
+		}
+		else
+		{
+			break;
+		}
+		x += xOffsets[direction];
+		y += yOffsets[direction];
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Checks whether placing a coin of the owner of 'own' is a legal move.
+ *
+ * @param row The row index of the move.
+ * @param column The column index of the move.
+ * @param own Discs of the moving player.
+ * @param opp Discs of the opponent.
+ * @return true if the cell is empty and at least one disc would be flipped.
+ */
+bool ReversiBoard::boardValidPosition(unsigned int row, unsigned int column,
+		const ReversiMask &own, const ReversiMask &opp) const
+{
+	if (row >= rows || column >= columns)
+	{
+		return false;
+	}
+
+	unsigned int index = boardCalcIndex(row, column);
+	if (own.maskTest(index) || opp.maskTest(index))
+	{
+		return false;
+	}
+
+	if (maskAll.maskWords() == 1)
+	{
+		return flipKernel.flipKernelFlips(index, own.maskWord(0),
+				opp.maskWord(0)) != 0;
+	}
+
+	for (unsigned int i = 0; i < numDirections; i++)
+	{
+		if (boardRayLength(row, column, i, own, opp) > 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Updates the hash for a set of flipped discs.
+ *
+ * @param flips The discs that changed color.
+ */
+void ReversiBoard::boardHashFlips(const ReversiMask &flips)
+{
+	if (maskAll.maskWords() == 1)
+	{
+		for (uint64_t w = flips.maskWord(0); w; w &= w - 1)
+		{
+			hash ^= ReversiZobrist::zobristFlip(__builtin_ctzll(w));
+		}
+		return;
+	}
+
+	for (unsigned int bit = 0; flips.maskNext(bit); bit++)
+	{
+		hash ^= ReversiZobrist::zobristFlip(bit);
+	}
+}
+
+/**
+ * @brief Computes all opponent discs bracketed by a coin placed at row/column.
+ *
+ * Boards with up to 64 cells use the flip kernel, larger boards walk the rays.
+ *
+ * @param row The row index of the move.
+ * @param column The column index of the move.
+ * @param own Discs of the moving player.
+ * @param opp Discs of the opponent.
+ * @param flips Receives the discs to flip (must have the board length).
+ * @return The number of discs to flip.
+ */
+unsigned int ReversiBoard::boardFlips(unsigned int row, unsigned int column,
+		const ReversiMask &own, const ReversiMask &opp,
+		ReversiMask &flips) const
+{
+	unsigned int total = 0;
+
+	flips.maskClear();
+	if (row >= rows || column >= columns)
+	{
+		return 0;
+	}
+
+	if (maskAll.maskWords() == 1)
+	{
+		flips.maskSetWord(0,
+				flipKernel.flipKernelFlips(boardCalcIndex(row, column),
+						own.maskWord(0), opp.maskWord(0)));
+		return __builtin_popcountll(flips.maskWord(0));
+	}
+
+	for (unsigned int i = 0; i < numDirections; i++)
+	{
+		unsigned int count = boardRayLength(row, column, i, own, opp);
+		int x = row;
+		int y = column;
+
+		for (unsigned int n = 0; n < count; n++)
+		{
+			x += xOffsets[i];
+			y += yOffsets[i];
+			flips.maskSet(boardCalcIndex(x, y));
+		}
+		total += count;
+	}
+	return total;
+}
+
+/**
+ * @brief Flips all opponent discs bracketed by a coin placed at row/column.
+ *
+ * @param row The row index of the move.
+ * @param column The column index of the move.
+ * @param own Discs of the moving player (updated).
+ * @param opp Discs of the opponent (updated).
+ * @param flipped Receives the flipped discs, or 0 if not needed.
+ */
+void ReversiBoard::boardFlip(unsigned int row, unsigned int column,
+		ReversiMask &own, ReversiMask &opp, ReversiMask *flipped)
+{
+	if (maskAll.maskWords() == 1 && row < rows && column < columns)
+	{
+		// Single-word fast path without a temporary mask
+		uint64_t flips = flipKernel.flipKernelFlips(
+				boardCalcIndex(row, column), own.maskWord(0), opp.maskWord(0));
+		own.maskSetWord(0, own.maskWord(0) | flips);
+		opp.maskSetWord(0, opp.maskWord(0) & ~flips);
+		for (uint64_t w = flips; w; w &= w - 1)
+		{
+			hash ^= ReversiZobrist::zobristFlip(__builtin_ctzll(w));
+		}
+		trackFresh = false;
+		if (flipped)
+		{
+			flipped->maskSetWord(0, flips);
+		}
+		REVERSI_METRIC_ADD(METRIC_FLIP_CALLS, 1);
+		REVERSI_METRIC_ADD(METRIC_DISCS_FLIPPED, __builtin_popcountll(flips));
+		return;
+	}
+
+	ReversiMask flips(maskAll.maskBits());
+	unsigned int count = boardFlips(row, column, own, opp, flips);
+	own |= flips;
+	opp.maskAndNot(flips);
+	boardHashFlips(flips);
+	countX = (&own == &discsX) ? countX + count : countX - count;
+	countO = (&own == &discsO) ? countO + count : countO - count;
+	if (count > 0)
+	{
+		boardTrackChange(boardCalcIndex(row, column), &flips, count);
+	}
+	if (flipped)
+	{
+		*flipped = flips;
+	}
+	REVERSI_METRIC_ADD(METRIC_FLIP_CALLS, 1);
+	REVERSI_METRIC_ADD(METRIC_DISCS_FLIPPED, count);
+}
+
+/**
+ * @brief Records changed cells for the next refresh of frontier and move sets.
+ *
+ * Boards with up to 64 cells are always recomputed as a whole, so only the
+ * larger boards keep the changed cells.
+ *
+ * @param index A cell that has been set or cleared.
+ * @param flips Discs that changed color, or 0 if none.
+ * @param count Number of discs in flips.
+ */
+void ReversiBoard::boardTrackChange(unsigned int index,
+		const ReversiMask *flips, unsigned int count)
+{
+	trackFresh = false;
+	if (maskAll.maskWords() == 1 || trackFull)
+	{
+		return;
+	}
+
+	dirty.maskSet(index);
+	dirtyCount += 1 + count;
+	if (count > 0)
+	{
+		dirty |= *flips;
+	}
+}
+
+/**
+ * @brief Brings frontier, move sets and mobility up to date with the discs.
+ *
+ * A move changes the placed cell and the flipped discs. Whether an empty cell is
+ * a legal move depends on the discs along its rays up to the first empty cell,
+ * so the only empty cells that can gain or lose a move are the changed cells
+ * themselves and, for each changed cell and direction, the first empty cell
+ * behind the run of discs next to it. A cell's frontier state only depends on
+ * the cell and its eight neighbours.
+ */
+void ReversiBoard::boardTrackRefresh() const
+{
+	if (maskAll.maskWords() == 1)
+	{
+		uint64_t x = discsX.maskWord(0);
+		uint64_t o = discsO.maskWord(0);
+		uint64_t near = 0;
+
+		for (unsigned int i = 0; i < numDirections; i++)
+		{
+			near |= shiftWord(x | o, boardCalcShift(i))
+					& boardLandingMask(i).maskWord(0);
+		}
+		frontier.maskSetWord(0, near & ~(x | o));
+		movesX.maskSetWord(0, boardMovesWord(x, o));
+		movesO.maskSetWord(0, boardMovesWord(o, x));
+		mobilityX = __builtin_popcountll(movesX.maskWord(0));
+		mobilityO = __builtin_popcountll(movesO.maskWord(0));
+		trackFresh = true;
+		return;
+	}
+
+	// Each changed cell costs about as much as shifting one word through all
+	// directions, so boards of a few words are cheaper to recompute as a whole.
+	if (trackFull || dirtyCount >= maskAll.maskWords())
+	{
+		ReversiMask occupied(discsX);
+		ReversiMask step(maskAll.maskBits());
+
+		occupied |= discsO;
+		frontier.maskClear();
+		for (unsigned int i = 0; i < numDirections; i++)
+		{
+			step = occupied;
+			step.maskShift(boardCalcShift(i));
+			step &= boardLandingMask(i);
+			frontier |= step;
+		}
+		frontier.maskAndNot(occupied);
+
+		boardMovesMask(discsX, discsO, movesX);
+		boardMovesMask(discsO, discsX, movesO);
+		mobilityX = movesX.maskCount();
+		mobilityO = movesO.maskCount();
+	}
+	else
+	{
+		// Collect the cells to recheck first; neighbouring changes share most of them
+		affected.maskClear();
+		for (unsigned int bit = 0; dirty.maskNext(bit); bit++)
+		{
+			unsigned int row = bit / columns;
+			unsigned int column = bit % columns;
+
+			affected.maskSet(bit);
+			for (unsigned int i = 0; i < numDirections; i++)
+			{
+				int x = row + xOffsets[i];
+				int y = column + yOffsets[i];
+
+				if (x < 0 || y < 0 || x >= (int) rows || y >= (int) columns)
+				{
+					continue;
+				}
+				affected.maskSet(boardCalcIndex(x, y));
+
+				// Skip the run of discs next to the change
+				while (boardGet(x, y) != '.')
+				{
+					x += xOffsets[i];
+					y += yOffsets[i];
+				}
+				if (x >= 0 && y >= 0 && x < (int) rows && y < (int) columns)
+				{
+					affected.maskSet(boardCalcIndex(x, y));
+				}
+			}
+		}
+
+		for (unsigned int bit = 0; affected.maskNext(bit); bit++)
+		{
+			boardTrackMoves(bit / columns, bit % columns);
+			boardTrackFrontier(bit / columns, bit % columns);
+		}
+	}
+
+	dirty.maskClear();
+	dirtyCount = 0;
+	trackFull = false;
+	trackFresh = true;
+}
+
+/**
+ * @brief Rechecks the legal moves of both players on one cell.
+ *
+ * @param row The row index of the cell.
+ * @param column The column index of the cell.
+ */
+void ReversiBoard::boardTrackMoves(unsigned int row, unsigned int column) const
+{
+	unsigned int index = boardCalcIndex(row, column);
+	bool legalX = false;
+	bool legalO = false;
+
+	if (boardGet(row, column) == '.')
+	{
+		// One walk per ray serves both players: a run of one colour that ends
+		// on a disc of the other colour is a move for the other colour
+		for (unsigned int i = 0; i < numDirections && !(legalX && legalO); i++)
+		{
+			int x = row + xOffsets[i];
+			int y = column + yOffsets[i];
+			char run = boardGet(x, y);
+			char end = run;
+
+			while (end == run && end != '.')
+			{
+				x += xOffsets[i];
+				y += yOffsets[i];
+				end = boardGet(x, y);
+			}
+			if (end != run && end != '.')
+			{
+				legalX = legalX || end == 'x';
+				legalO = legalO || end == 'o';
+			}
+		}
+	}
+
+	if (legalX != movesX.maskTest(index))
+	{
+		if (legalX)
+		{
+			movesX.maskSet(index);
+			mobilityX++;
+		}
+		else
+		{
+			movesX.maskReset(index);
+			mobilityX--;
+		}
+	}
+	if (legalO != movesO.maskTest(index))
+	{
+		if (legalO)
+		{
+			movesO.maskSet(index);
+			mobilityO++;
+		}
+		else
+		{
+			movesO.maskReset(index);
+			mobilityO--;
+		}
+	}
+}
+
+/**
+ * @brief Rechecks whether one cell belongs to the frontier.
+ *
+ * @param row The row index of the cell.
+ * @param column The column index of the cell.
+ */
+void ReversiBoard::boardTrackFrontier(unsigned int row,
+		unsigned int column) const
+{
+	unsigned int index = boardCalcIndex(row, column);
+	bool member = false;
+
+	if (boardGet(row, column) == '.')
+	{
+		for (unsigned int i = 0; i < numDirections && !member; i++)
+		{
+			// boardGet() returns '.' outside the board
+			member = boardGet(row + xOffsets[i], column + yOffsets[i]) != '.';
+		}
+	}
+
+	if (member)
+	{
+		frontier.maskSet(index);
+	}
+	else
+	{
+		frontier.maskReset(index);
+	}
+}
+
 /**
  * @brief Clears the board by setting all cells to '.'.
  *
  * This method is used to initialize the board by setting all positions to empty cells.
+ * The undo stack is emptied as well and 'x' is to move.
  *
  * @return RC_OK if the operation was successful.
  */
 RC_t ReversiBoard::boardClear()
 {
-	for (unsigned int i = 0; i < rows * columns; i++)
-	{
-		pBoard[i] = '.';
-	}
+	discsX.maskClear();
+	discsO.maskClear();
+	undoStack.undoClear();
+	hash = 0;
+	sideToMove = 'x';
+	countX = 0;
+	countO = 0;
+	trackFresh = false;
+	trackFull = true;
 	return RC_OK;
 }
 
@@ -83,17 +692,146 @@ RC_t ReversiBoard::boardClear()
  * @brief Sets a piece ('x' or 'o') on the board at a specified position.
  *
  * This method places the specified coin at the given row and column on the board.
+ * Passing '.' removes the coin from the cell.
  *
  * @param row Row index to place the coin.
  * @param column Column index to place the coin.
- * @param coin Character representing the coin ('x' or 'o').
- * @return RC_OK if the operation was successful.
+ * @param coin Character representing the coin ('x', 'o' or '.').
+ * @return RC_OK if the operation was successful, RC_ERROR_PARAM_OUTOFRANGE for a
+ *         position outside the board, RC_ERROR_BAD_PARAM for an unknown coin.
  */
 RC_t ReversiBoard::boardSet(unsigned int row, unsigned int column, char coin)
 {
+	if (row >= rows || column >= columns)
+	{
+		return RC_ERROR_PARAM_OUTOFRANGE;
+	}
+
+	REVERSI_METRIC_ADD(METRIC_BOARD_SET, 1);
+
 	unsigned int index = boardCalcIndex(row, column);
-	pBoard[index] = coin;
+	char previous = boardGet(row, column);
+
+	switch (coin)
+	{
+	case 'x':
+		discsX.maskSet(index);
+		discsO.maskReset(index);
+		break;
+	case 'o':
+		discsO.maskSet(index);
+		discsX.maskReset(index);
+		break;
+	case '.':
+		discsX.maskReset(index);
+		discsO.maskReset(index);
+		break;
+	default:
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	hash ^= ReversiZobrist::zobristCell(index, previous)
+			^ ReversiZobrist::zobristCell(index, coin);
+	countX += (coin == 'x') - (previous == 'x');
+	countO += (coin == 'o') - (previous == 'o');
+	boardTrackChange(index, 0, 0);
+	return RC_OK;
+}
+
+/**
+ * @brief Returns the coin at a specific position on the board.
+ *
+ * @param row Row index of the cell.
+ * @param column Column index of the cell.
+ * @return 'x' or 'o' for an occupied cell, '.' for an empty (or invalid) cell.
+ */
+char ReversiBoard::boardGet(unsigned int row, unsigned int column) const
+{
+	if (row >= rows || column >= columns)
+	{
+		return '.';
+	}
+
+	unsigned int index = boardCalcIndex(row, column);
+	if (discsX.maskTest(index))
+	{
+		return 'x';
+	}
+	else if (discsO.maskTest(index))
+	{
+		return 'o';
+	}
+	return '.';
+}
+
+/**
+ * @brief Computes the Zobrist hash from scratch (for verification).
+ *
+ * @return The hash of all discs and the side to move.
+ */
+uint64_t ReversiBoard::boardCalcHash() const
+{
+	uint64_t value = (sideToMove == 'o') ? ReversiZobrist::zobristSide() : 0;
+
+	for (unsigned int bit = 0; discsX.maskNext(bit); bit++)
+	{
+		value ^= ReversiZobrist::zobristCell(bit, 'x');
+	}
+	for (unsigned int bit = 0; discsO.maskNext(bit); bit++)
+	{
+		value ^= ReversiZobrist::zobristCell(bit, 'o');
+	}
+	return value;
+}
 
+/**
+ * @brief Sets the player to move.
+ *
+ * @param coin The player to move ('x' or 'o').
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for an unknown coin.
+ */
+RC_t ReversiBoard::boardSetSideToMove(char coin)
+{
+	if (coin != 'x' && coin != 'o')
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+	if (coin != sideToMove)
+	{
+		hash ^= ReversiZobrist::zobristSide();
+		sideToMove = coin;
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Loads the position of a snapshot and discards the history.
+ *
+ * The move sets and the frontier are recomputed on the next query.
+ *
+ * @param snapshot The position, taken from a board of the same size.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM if the
+ *         snapshot has a different size.
+ */
+RC_t ReversiBoard::boardRestore(const ReversiBoardSnapshot &snapshot)
+{
+	if (snapshot.rows != rows || snapshot.columns != columns)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	discsX = snapshot.discsX;
+	discsO = snapshot.discsO;
+	hash = snapshot.hash;
+	sideToMove = snapshot.sideToMove;
+	undoStack.undoClear();
+	if (maskAll.maskWords() > 1)
+	{
+		countX = discsX.maskCount();
+		countO = discsO.maskCount();
+	}
+	trackFresh = false;
+	trackFull = true;
 	return RC_OK;
 }
 
@@ -142,52 +880,13 @@ RC_t ReversiBoard::boardInitialState(unsigned int rows, unsigned int columns)
 bool ReversiBoard::boardValidPositionX(unsigned int row, unsigned int column,
 		char coin)
 {
-	// Define offsets for eight directions in clockwise order.
-	int xOffsets[] =
-	{ -1, -1, 0, 1, 1, 1, 0, -1 };
-	int yOffsets[] =
-	{ 0, -1, -1, -1, 0, 1, 1, 1 };
-	unsigned int numElements = sizeof(xOffsets) / sizeof(xOffsets[0]);
-
-	// Check if any direction leads to a valid move
-	for (unsigned int i = 0; i < numElements; i++)
+	REVERSI_METRIC_ADD(METRIC_VALID_PROBES, 1);
+	if (boardValidPosition(row, column, discsX, discsO))
 	{
-		int x = row + xOffsets[i];
-		int y = column + yOffsets[i];
-
-		// Check if there's an 'o' in the current direction immediately adjacent.
-		if (x >= 0 && x < rows && y >= 0 && y < columns
-				&& pBoard[boardCalcIndex(x, y)] == 'o'
-				&& pBoard[boardCalcIndex(row, column)] == '.')
-		{
-			int currentX = x;
-			int currentY = y;
-
-			// Traverse in the current direction.
-			while (currentY >= 0 && currentX >= 0 && currentY < columns
-					&& currentX < rows)
-			{
-				char currentCoin = pBoard[boardCalcIndex(currentX, currentY)];
-
-				if (currentCoin == '.')
-				{
-					break;
-				}
-				else if (currentCoin == 'x')
-				{
-					return true;  // Valid move found
-				}
-				else if (currentCoin == 'o')
-				{
-					// Move one step further in the current direction
-					currentX += xOffsets[i];
-					currentY += yOffsets[i];
-				}
-			}
-		}
+		return true;  // Valid move found
 	}
 
-	cout << "Invalid move. Try again." << endl;
+	REVERSI_METRIC_ADD(METRIC_VALID_REJECTED, 1);
 	return false;  // No valid move found
 }
 
@@ -205,52 +904,13 @@ bool ReversiBoard::boardValidPositionX(unsigned int row, unsigned int column,
 bool ReversiBoard::boardValidPositionO(unsigned int row, unsigned int column,
 		char coin)
 {
-	// Define offsets for eight directions in clockwise order.
-	int xOffsets[] =
-	{ -1, -1, 0, 1, 1, 1, 0, -1 };
-	int yOffsets[] =
-	{ 0, -1, -1, -1, 0, 1, 1, 1 };
-	unsigned int numElements = sizeof(xOffsets) / sizeof(xOffsets[0]);
-
-	// Check if any direction leads to a valid move
-	for (unsigned int i = 0; i < numElements; i++)
+	REVERSI_METRIC_ADD(METRIC_VALID_PROBES, 1);
+	if (boardValidPosition(row, column, discsO, discsX))
 	{
-		int x = row + xOffsets[i];
-		int y = column + yOffsets[i];
-
-		// Check if there's an 'o' in the current direction immediately adjacent.
-		if (x >= 0 && x < rows && y >= 0 && y < columns
-				&& pBoard[boardCalcIndex(x, y)] == 'x'
-				&& pBoard[boardCalcIndex(row, column)] == '.')
-		{
-			int currentX = x;
-			int currentY = y;
-
-			// Traverse in the current direction.
-			while (currentY >= 0 && currentX >= 0 && currentY < columns
-					&& currentX < rows)
-			{
-				char currentCoin = pBoard[boardCalcIndex(currentX, currentY)];
-
-				if (currentCoin == '.')
-				{
-					break;
-				}
-				else if (currentCoin == 'o')
-				{
-					return true;  // Valid move found
-				}
-				else if (currentCoin == 'x')
-				{
-					// Move one step further in the current direction
-					currentX += xOffsets[i];
-					currentY += yOffsets[i];
-				}
-			}
-		}
+		return true;  // Valid move found
 	}
 
-	cout << "Invalid move. Try again." << endl;
+	REVERSI_METRIC_ADD(METRIC_VALID_REJECTED, 1);
 	return false;  // No valid move found
 }
 
@@ -267,127 +927,324 @@ bool ReversiBoard::boardValidPositionO(unsigned int row, unsigned int column,
  */
 RC_t ReversiBoard::flipOtoX(unsigned int row, unsigned int column, char coin)
 {
-	// Define offsets for eight directions in clockwise order.
-	int xOffsets[] =
-	{ -1, -1, 0, 1, 1, 1, 0, -1 };
-	int yOffsets[] =
-	{ 0, -1, -1, -1, 0, 1, 1, 1 };
-	unsigned int numElements = sizeof(xOffsets) / sizeof(xOffsets[0]);
+	boardFlip(row, column, discsX, discsO, 0);
+	return RC_OK;
+}
 
-	// Check if any direction leads to a valid move
-	for (unsigned int i = 0; i < numElements; i++)
+/**
+ * @brief Flips the opponent's pieces ('o' to 'x') and returns the flipped set.
+ *
+ * @param row Row index of the move.
+ * @param column Column index of the move.
+ * @param coin The coin being placed ('x').
+ * @param flipped Receives the mask of flipped pieces.
+ * @return RC_OK if the operation was successful.
+ */
+RC_t ReversiBoard::flipOtoX(unsigned int row, unsigned int column, char coin,
+		ReversiMask &flipped)
+{
+	if (flipped.maskBits() != maskAll.maskBits())
 	{
-		int x = row + xOffsets[i];
-		int y = column + yOffsets[i];
+		flipped.maskResize(maskAll.maskBits());
+	}
+	boardFlip(row, column, discsX, discsO, &flipped);
+	return RC_OK;
+}
 
-		// Temporary storage for 'o' positions in the current direction
-		int storeXcoordinates[8];
-		int storeYcoordinates[8];
-		unsigned int count = 0; // Track how many 'o' positions we store
+/**
+ * @brief Flips the opponent's pieces ('x' to 'o') after a valid move by player 'o'.
+ *
+ * This method flips all the opponent's pieces ('x') in the 8 directions after placing
+ * an 'o' piece.
+ *
+ * @param row Row index of the move.
+ * @param column Column index of the move.
+ * @param coin The coin being placed ('o').
+ * @return RC_OK if the operation was successful.
+ */
+RC_t ReversiBoard::flipXtoO(unsigned int row, unsigned int column, char coin)
+{
+	boardFlip(row, column, discsO, discsX, 0);
+	return RC_OK;
+}
 
-		// Traverse in the current direction.
-		while (x >= 0 && y >= 0 && y < columns && x < rows)
-		{
-			char currentCoin = pBoard[boardCalcIndex(x, y)];
+/**
+ * @brief Flips the opponent's pieces ('x' to 'o') and returns the flipped set.
+ *
+ * @param row Row index of the move.
+ * @param column Column index of the move.
+ * @param coin The coin being placed ('o').
+ * @param flipped Receives the mask of flipped pieces.
+ * @return RC_OK if the operation was successful.
+ */
+RC_t ReversiBoard::flipXtoO(unsigned int row, unsigned int column, char coin,
+		ReversiMask &flipped)
+{
+	if (flipped.maskBits() != maskAll.maskBits())
+	{
+		flipped.maskResize(maskAll.maskBits());
+	}
+	boardFlip(row, column, discsO, discsX, &flipped);
+	return RC_OK;
+}
 
-			if (currentCoin == '.')
-			{
-				break;
-			}
-			else if (currentCoin == 'x')
-			{
-				for (unsigned int i = 0; i < count; i++)
-				{
-					int flipX = storeXcoordinates[i];
-					int flipY = storeYcoordinates[i];
-					pBoard[boardCalcIndex(flipX, flipY)] = 'x';
-				}
+/**
+ * @brief Computes the pieces a move would flip, without changing the board.
+ *
+ * @param row Row index of the move.
+ * @param column Column index of the move.
+ * @param coin The coin that would be placed ('x' or 'o').
+ * @param flips Receives the mask of pieces that would be flipped; resized if needed.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for an unknown coin.
+ */
+RC_t ReversiBoard::boardCalcFlips(unsigned int row, unsigned int column,
+		char coin, ReversiMask &flips) const
+{
+	if (coin != 'x' && coin != 'o')
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
 
-				break;
-			}
-			else if (currentCoin == 'o')
-			{
-				storeXcoordinates[count] = x;
-				storeYcoordinates[count] = y;
-				count++;
+	if (flips.maskBits() != maskAll.maskBits())
+	{
+		flips.maskResize(maskAll.maskBits());
+	}
+	boardFlips(row, column, (coin == 'x') ? discsX : discsO,
+			(coin == 'x') ? discsO : discsX, flips);
+	return RC_OK;
+}
 
-				if (count >= 8)
-					break;
-			}
-			x += xOffsets[i];
-			y += yOffsets[i];
-		}
+/**
+ * @brief Computes the set of all legal moves of a player in one call.
+ *
+ * This method evaluates the whole board at once and never writes to the console,
+ * which makes it suitable for bots and analysis tools that enumerate moves often.
+ *
+ * @param coin The player to move ('x' or 'o').
+ * @param moves Receives the mask of legal moves; resized to the board if needed.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for an unknown coin.
+ */
+RC_t ReversiBoard::generateMoves(char coin, ReversiMask &moves) const
+{
+	if (coin != 'x' && coin != 'o')
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	REVERSI_METRIC_TIMER(METRIC_GENERATE_MOVES_NS);
+	REVERSI_METRIC_ADD(METRIC_GENERATE_MOVES, 1);
 
+	const ReversiMask &own = (coin == 'x') ? discsX : discsO;
+	const ReversiMask &opp = (coin == 'x') ? discsO : discsX;
+
+	if (moves.maskBits() != maskAll.maskBits())
+	{
+		moves.maskResize(maskAll.maskBits());
+	}
+
+	if (maskAll.maskWords() == 1)
+	{
+		moves.maskSetWord(0, boardMovesWord(own.maskWord(0), opp.maskWord(0)));
+	}
+	else
+	{
+		boardMovesMask(own, opp, moves);
 	}
 
 	return RC_OK;
 }
 
 /**
- * @brief Flips the opponent's pieces ('x' to 'o') after a valid move by player 'o'.
+ * @brief Convenience overload of generateMoves() returning the mask by value.
  *
- * This method flips all the opponent's pieces ('x') in the 8 directions after placing
- * an 'o' piece.
+ * @param coin The player to move ('x' or 'o').
+ * @return The mask of legal moves (empty for an unknown coin).
+ */
+ReversiMask ReversiBoard::generateMoves(char coin) const
+{
+	ReversiMask moves(maskAll.maskBits());
+	generateMoves(coin, moves);
+	return moves;
+}
+
+/**
+ * @brief Plays a move and records it on the undo stack.
  *
  * @param row Row index of the move.
  * @param column Column index of the move.
- * @param coin The coin being placed ('o').
- * @return RC_OK if the operation was successful.
+ * @param coin The coin to place ('x' or 'o').
+ * @return The undo record (placed cell and flipped discs), or 0 if the move is illegal.
  */
-RC_t ReversiBoard::flipXtoO(unsigned int row, unsigned int column, char coin)
+const ReversiUndo* ReversiBoard::makeMove(unsigned int row,
+		unsigned int column, char coin)
+{
+	if (row >= rows || column >= columns)
+	{
+		return 0;
+	}
+	return makeMove(boardCalcIndex(row, column), coin);
+}
+
+/**
+ * @brief Plays a move given by its cell index (bit index of generateMoves()).
+ *
+ * The flips are computed straight into the record on top of the undo stack; an
+ * illegal move (occupied cell or nothing to flip) leaves board and stack unchanged.
+ *
+ * @param index The cell index (row * columns + column).
+ * @param coin The coin to place ('x' or 'o').
+ * @return The undo record, or 0 if the move is illegal.
+ */
+const ReversiUndo* ReversiBoard::makeMove(unsigned int index, char coin)
 {
-	// Define offsets for eight directions in clockwise order.
-	int xOffsets[] =
-	{ -1, -1, 0, 1, 1, 1, 0, -1 };
-	int yOffsets[] =
-	{ 0, -1, -1, -1, 0, 1, 1, 1 };
-	unsigned int numElements = sizeof(xOffsets) / sizeof(xOffsets[0]);
+	REVERSI_METRIC_TIMER(METRIC_MAKE_MOVE_NS);
+
+	if (index >= maskAll.maskBits() || (coin != 'x' && coin != 'o'))
+	{
+		REVERSI_METRIC_ADD(METRIC_MOVES_ILLEGAL, 1);
+		return 0;
+	}
 
-	// Check if any direction leads to a valid move
-	for (unsigned int i = 0; i < numElements; i++)
+	ReversiMask &own = (coin == 'x') ? discsX : discsO;
+	ReversiMask &opp = (coin == 'x') ? discsO : discsX;
+
+	if (own.maskTest(index) || opp.maskTest(index))
 	{
-		int x = row + xOffsets[i];
-		int y = column + yOffsets[i];
+		REVERSI_METRIC_ADD(METRIC_MOVES_ILLEGAL, 1);
+		return 0;
+	}
 
-		// Temporary storage for 'o' positions in the current direction
-		int storeXcoordinates[8];
-		int storeYcoordinates[8];
-		unsigned int count = 0; // Track how many 'o' positions we store
+	ReversiUndo &undo = undoStack.undoPush();
+	undo.side = sideToMove;
+	undo.hash = hash;
 
-		// Traverse in the current direction.
-		while (x >= 0 && y >= 0 && y < columns && x < rows)
+	if (maskAll.maskWords() == 1)
+	{
+		uint64_t flips = flipKernel.flipKernelFlips(index, own.maskWord(0),
+				opp.maskWord(0));
+		if (flips == 0)
+		{
+			undoStack.undoPop();
+			REVERSI_METRIC_ADD(METRIC_MOVES_ILLEGAL, 1);
+			return 0;
+		}
+		undo.flips.maskSetWord(0, flips);
+		own.maskSetWord(0, own.maskWord(0) | flips | ((uint64_t) 1 << index));
+		opp.maskSetWord(0, opp.maskWord(0) & ~flips);
+		for (uint64_t w = flips; w; w &= w - 1)
 		{
-			char currentCoin = pBoard[boardCalcIndex(x, y)];
+			hash ^= ReversiZobrist::zobristFlip(__builtin_ctzll(w));
+		}
+		trackFresh = false;
+		REVERSI_METRIC_RECORD(METRIC_MOVE_FLIPS, __builtin_popcountll(flips));
+		REVERSI_METRIC_ADD(METRIC_DISCS_FLIPPED, __builtin_popcountll(flips));
+	}
+	else
+	{
+		undo.count = boardFlips(index / columns, index % columns, own, opp,
+				undo.flips);
+		if (undo.count == 0)
+		{
+			undoStack.undoPop();
+			REVERSI_METRIC_ADD(METRIC_MOVES_ILLEGAL, 1);
+			return 0;
+		}
+		own |= undo.flips;
+		own.maskSet(index);
+		opp.maskAndNot(undo.flips);
+		boardHashFlips(undo.flips);
+		((coin == 'x') ? countX : countO) += undo.count + 1;
+		((coin == 'x') ? countO : countX) -= undo.count;
+		boardTrackChange(index, &undo.flips, undo.count);
+		REVERSI_METRIC_RECORD(METRIC_MOVE_FLIPS, undo.count);
+		REVERSI_METRIC_ADD(METRIC_DISCS_FLIPPED, undo.count);
+	}
 
-			if (currentCoin == '.')
-			{
-				break;
-			}
-			else if (currentCoin == 'o')
-			{
-				for (unsigned int i = 0; i < count; i++)
-				{
-					int flipX = storeXcoordinates[i];
-					int flipY = storeYcoordinates[i];
-					pBoard[boardCalcIndex(flipX, flipY)] = 'o';
-				}
+	hash ^= ReversiZobrist::zobristCell(index, coin);
+	if (sideToMove == coin)
+	{
+		hash ^= ReversiZobrist::zobristSide();
+		sideToMove = (coin == 'x') ? 'o' : 'x';
+	}
 
-				break;
-			}
-			else if (currentCoin == 'x')
-			{
-				storeXcoordinates[count] = x;
-				storeYcoordinates[count] = y;
-				count++;
+	undo.index = index;
+	undo.coin = coin;
+	REVERSI_METRIC_ADD(METRIC_MOVES, 1);
+	return &undo;
+}
 
-				if (count >= 8)
-					break;
-			}
-			x += xOffsets[i];
-			y += yOffsets[i];
-		}
+/**
+ * @brief Records a pass of a player on the undo stack.
+ *
+ * @param coin The passing player ('x' or 'o').
+ * @return The undo record (with index ReversiUndo::PASS), or 0 for an unknown coin.
+ */
+const ReversiUndo* ReversiBoard::makePass(char coin)
+{
+	if (coin != 'x' && coin != 'o')
+	{
+		return 0;
+	}
+
+	ReversiUndo &undo = undoStack.undoPush();
+	undo.index = ReversiUndo::PASS;
+	undo.coin = coin;
+	undo.side = sideToMove;
+	undo.hash = hash;
+	undo.flips.maskClear();
+
+	if (sideToMove == coin)
+	{
+		hash ^= ReversiZobrist::zobristSide();
+		sideToMove = (coin == 'x') ? 'o' : 'x';
+	}
+	return &undo;
+}
 
+/**
+ * @brief Takes back the last move or pass recorded on the undo stack.
+ *
+ * The placed coin is removed and the flipped discs are returned to the opponent,
+ * which costs a few word operations independent of the length of the game.
+ *
+ * @return RC_OK if the operation was successful, RC_ERROR if there is no move to undo.
+ */
+RC_t ReversiBoard::unmakeMove()
+{
+	if (undoStack.undoSize() == 0)
+	{
+		return RC_ERROR;
+	}
+
+	REVERSI_METRIC_ADD(METRIC_UNDOS, 1);
+	ReversiUndo &undo = undoStack.undoTop();
+
+	if (undo.index != ReversiUndo::PASS)
+	{
+		ReversiMask &own = (undo.coin == 'x') ? discsX : discsO;
+		ReversiMask &opp = (undo.coin == 'x') ? discsO : discsX;
+
+		if (maskAll.maskWords() == 1)
+		{
+			uint64_t flips = undo.flips.maskWord(0);
+			own.maskSetWord(0,
+					own.maskWord(0) & ~(flips | ((uint64_t) 1 << undo.index)));
+			opp.maskSetWord(0, opp.maskWord(0) | flips);
+			trackFresh = false;
+		}
+		else
+		{
+			own.maskAndNot(undo.flips);
+			own.maskReset(undo.index);
+			opp |= undo.flips;
+			((undo.coin == 'x') ? countX : countO) -= undo.count + 1;
+			((undo.coin == 'x') ? countO : countX) += undo.count;
+			boardTrackChange(undo.index, &undo.flips, undo.count);
+		}
 	}
 
+	hash = undo.hash;
+	sideToMove = undo.side;
+	undoStack.undoPop();
 	return RC_OK;
 }
@@ -19,6 +19,94 @@
 #define REVERSIBOARD_H_
 
 #include "global.h"
+#include "ReversiFlipKernel.h"
+#include "ReversiMask.h"
+#include "ReversiUndo.h"
+
+/**
+ * @class ReversiBoardSnapshot
+ * @brief An immutable copy of a position: size, discs, side to move and hash.
+ *
+ * Taken with ReversiBoard::boardSnapshot(). It carries neither the undo history
+ * nor the cached move sets, so taking or copying one copies two masks, which live
+ * inline up to 256 cells (no heap allocation). Snapshots can be handed to other
+ * threads by value and loaded into a board with ReversiBoard::boardRestore().
+ */
+class ReversiBoardSnapshot
+{
+	friend class ReversiBoard;
+private:
+	unsigned int rows;
+	unsigned int columns;
+	ReversiMask discsX; ///< Cells occupied by an 'x' coin.
+	ReversiMask discsO; ///< Cells occupied by an 'o' coin.
+	uint64_t hash;      ///< Zobrist hash of the position.
+	char sideToMove;    ///< The player to move ('x' or 'o').
+
+	ReversiBoardSnapshot(unsigned int rows, unsigned int columns,
+			const ReversiMask &discsX, const ReversiMask &discsO, uint64_t hash,
+			char sideToMove) :
+			rows(rows), columns(columns), discsX(discsX), discsO(discsO), hash(
+					hash), sideToMove(sideToMove)
+	{
+	}
+
+public:
+	/**
+	 * @brief Returns the number of rows of the board.
+	 */
+	unsigned int snapshotRows() const
+	{
+		return rows;
+	}
+
+	/**
+	 * @brief Returns the number of columns of the board.
+	 */
+	unsigned int snapshotColumns() const
+	{
+		return columns;
+	}
+
+	/**
+	 * @brief Returns the coin at a position ('x', 'o', or '.' for empty and invalid cells).
+	 */
+	char snapshotGet(unsigned int row, unsigned int column) const
+	{
+		if (row >= rows || column >= columns)
+		{
+			return '.';
+		}
+		unsigned int index = row * columns + column;
+		return discsX.maskTest(index) ? 'x' : (discsO.maskTest(index) ? 'o' : '.');
+	}
+
+	/**
+	 * @brief Returns the mask of all discs of a player.
+	 *
+	 * @param coin The player ('x' or 'o'; any other value returns the 'o' discs).
+	 */
+	const ReversiMask& snapshotDiscs(char coin) const
+	{
+		return (coin == 'x') ? discsX : discsO;
+	}
+
+	/**
+	 * @brief Returns the Zobrist hash of the position (same as ReversiBoard::boardHash()).
+	 */
+	uint64_t snapshotHash() const
+	{
+		return hash;
+	}
+
+	/**
+	 * @brief Returns the player to move ('x' or 'o').
+	 */
+	char snapshotSideToMove() const
+	{
+		return sideToMove;
+	}
+};
 
 /**
  * @class ReversiBoard
@@ -31,10 +119,31 @@
 class ReversiBoard
 {
 	friend class ReversiConsoleView;
+	friend class ReversiEndgame;
 private:
-	unsigned short rows;
-	unsigned short columns;
-	char *pBoard;
+	unsigned int rows;
+	unsigned int columns;
+	ReversiMask discsX;             ///< Cells occupied by an 'x' coin.
+	ReversiMask discsO;             ///< Cells occupied by an 'o' coin.
+	ReversiMask maskAll;            ///< All cells of the board.
+	ReversiMask maskNotFirstColumn; ///< All cells except column 0.
+	ReversiMask maskNotLastColumn;  ///< All cells except the last column.
+	ReversiFlipKernel flipKernel;   ///< Flip kernel for boards with up to 64 cells.
+	ReversiUndoStack undoStack;     ///< Moves made with makeMove() / makePass().
+	uint64_t hash;                  ///< Zobrist hash of discs and side to move.
+	char sideToMove;                ///< The player to move ('x' or 'o').
+	unsigned int countX;            ///< Number of 'x' discs (above 64 cells).
+	unsigned int countO;            ///< Number of 'o' discs (above 64 cells).
+	mutable ReversiMask frontier;   ///< Empty cells next to a disc.
+	mutable ReversiMask movesX;     ///< Legal moves of 'x'.
+	mutable ReversiMask movesO;     ///< Legal moves of 'o'.
+	mutable ReversiMask dirty;      ///< Cells changed since the last refresh (above 64 cells).
+	mutable ReversiMask affected;   ///< Cells rechecked by a refresh (above 64 cells).
+	mutable unsigned int dirtyCount;///< Upper bound of the cells in dirty.
+	mutable unsigned int mobilityX; ///< Number of legal moves of 'x'.
+	mutable unsigned int mobilityO; ///< Number of legal moves of 'o'.
+	mutable bool trackFresh;        ///< frontier and move sets match the discs.
+	mutable bool trackFull;         ///< The next refresh has to rebuild everything.
 
 	/**
 	 * @brief Calculates the index in the board array for a given row and column.
@@ -42,35 +151,229 @@ private:
 	 * This private method computes the linear index in the board array for the given
 	 * row and column, which is necessary for accessing the board's state efficiently.
 	 *
+	 * The cell must be on the board, so the index stays below MAX_CELLS.
+	 *
 	 * @param row The row index (starting from 0).
 	 * @param column The column index (starting from 0).
 	 * @return The calculated index in the board array.
 	 */
 	unsigned int boardCalcIndex(unsigned int row, unsigned column) const;
 
+	/**
+	 * @brief Returns the number of cells; rows and columns have already been checked.
+	 */
+	unsigned int boardCellCount() const
+	{
+		return rows * columns;
+	}
+
+	/**
+	 * @brief Returns the signed bit distance between a cell and its neighbour.
+	 *
+	 * @param direction Index of the direction (0..7, clockwise starting "up").
+	 * @return The amount by which a mask has to be shifted to move one step.
+	 */
+	int boardCalcShift(unsigned int direction) const;
+
+	/**
+	 * @brief Returns the cells a mask may land on after one step.
+	 *
+	 * Shifting a mask by one column wraps the last column into the first column of
+	 * the next row (and vice versa); this mask removes such wrapped bits.
+	 *
+	 * @param direction Index of the direction (0..7).
+	 * @return The landing mask for the direction.
+	 */
+	const ReversiMask& boardLandingMask(unsigned int direction) const;
+
+	/**
+	 * @brief Computes all legal moves on a board with up to 64 cells.
+	 *
+	 * Uses a Kogge-Stone parallel prefix fill per direction: the opponent runs
+	 * adjacent to the player's discs are grown in log2(n) shift steps, and the
+	 * empty cells just beyond those runs are the legal moves.
+	 *
+	 * @param own Discs of the moving player.
+	 * @param opp Discs of the opponent.
+	 * @return The mask of legal moves.
+	 */
+	uint64_t boardMovesWord(uint64_t own, uint64_t opp) const;
+
+	/**
+	 * @brief Multi-word counterpart of boardMovesWord() for boards above 64 cells.
+	 *
+	 * @param own Discs of the moving player.
+	 * @param opp Discs of the opponent.
+	 * @param moves Receives the mask of legal moves (must have the board length).
+	 */
+	void boardMovesMask(const ReversiMask &own, const ReversiMask &opp,
+			ReversiMask &moves) const;
+
+	/**
+	 * @brief Counts the opponent discs bracketed in one direction.
+	 *
+	 * This is the multi-word counterpart of the flip kernel, used for boards with
+	 * more than 64 cells. It walks the ray bit by bit.
+	 *
+	 * @param row The row index of the move.
+	 * @param column The column index of the move.
+	 * @param direction Index of the direction (0..7).
+	 * @param own Discs of the moving player.
+	 * @param opp Discs of the opponent.
+	 * @return Number of discs flipped in this direction (0 if not bracketed).
+	 */
+	unsigned int boardRayLength(unsigned int row, unsigned int column,
+			unsigned int direction, const ReversiMask &own,
+			const ReversiMask &opp) const;
+
+	/**
+	 * @brief Checks whether placing a coin of the owner of 'own' is a legal move.
+	 *
+	 * @param row The row index of the move.
+	 * @param column The column index of the move.
+	 * @param own Discs of the moving player.
+	 * @param opp Discs of the opponent.
+	 * @return true if the cell is empty and at least one disc would be flipped.
+	 */
+	bool boardValidPosition(unsigned int row, unsigned int column,
+			const ReversiMask &own, const ReversiMask &opp) const;
+
+	/**
+	 * @brief Updates the hash for a set of flipped discs.
+	 *
+	 * @param flips The discs that changed color.
+	 */
+	void boardHashFlips(const ReversiMask &flips);
+
+	/**
+	 * @brief Computes all opponent discs bracketed by a coin placed at row/column.
+	 *
+	 * @param row The row index of the move.
+	 * @param column The column index of the move.
+	 * @param own Discs of the moving player.
+	 * @param opp Discs of the opponent.
+	 * @param flips Receives the discs to flip (must have the board length).
+	 * @return The number of discs to flip.
+	 */
+	unsigned int boardFlips(unsigned int row, unsigned int column,
+			const ReversiMask &own, const ReversiMask &opp,
+			ReversiMask &flips) const;
+
+	/**
+	 * @brief Flips all opponent discs bracketed by a coin placed at row/column.
+	 *
+	 * @param row The row index of the move.
+	 * @param column The column index of the move.
+	 * @param own Discs of the moving player (updated).
+	 * @param opp Discs of the opponent (updated).
+	 * @param flipped Receives the flipped discs, or 0 if not needed.
+	 */
+	void boardFlip(unsigned int row, unsigned int column, ReversiMask &own,
+			ReversiMask &opp, ReversiMask *flipped);
+
+	/**
+	 * @brief Records changed cells for the next refresh of frontier and move sets.
+	 *
+	 * @param index A cell that has been set or cleared.
+	 * @param flips Discs that changed color, or 0 if none.
+	 * @param count Number of discs in flips.
+	 */
+	void boardTrackChange(unsigned int index, const ReversiMask *flips,
+			unsigned int count);
+
+	/**
+	 * @brief Brings frontier, move sets and mobility up to date with the discs.
+	 *
+	 * Boards with up to 64 cells recompute the sets with a few word operations.
+	 * Larger boards only recheck the cells whose state can have changed: the
+	 * changed cells, their neighbours, and the first empty cell behind each run of
+	 * discs starting next to a changed cell. When there are more changed cells
+	 * than words in a mask, a full recomputation is cheaper and used instead.
+	 */
+	void boardTrackRefresh() const;
+
+	/**
+	 * @brief Rechecks the legal moves of both players on one cell.
+	 */
+	void boardTrackMoves(unsigned int row, unsigned int column) const;
+
+	/**
+	 * @brief Rechecks whether one cell belongs to the frontier.
+	 */
+	void boardTrackFrontier(unsigned int row, unsigned int column) const;
+
 public:
 	/**
 	 * @brief Constructs a ReversiBoard object with specified dimensions.
 	 *
 	 * This constructor initializes the Reversi board with the specified number of rows
-	 * and columns. It also allocates memory for the board's state.
+	 * and columns. It also allocates the bit masks holding the board's state.
+	 * A size that boardSupports() rejects gives an empty board of 0x0 cells.
 	 *
 	 * @param rows The number of rows on the board.
 	 * @param columns The number of columns on the board.
 	 */
 	ReversiBoard(unsigned int rows, unsigned int columns);
 
+	/**
+	 * @brief Largest number of cells of a board.
+	 *
+	 * Cell indices and the undo stack of 2 * cells + 2 moves must fit into an
+	 * unsigned int.
+	 */
+	static const unsigned int MAX_CELLS = 0x7FFFFFFEu;
+
+	/**
+	 * @brief Checks whether a board of the given size can be built.
+	 *
+	 * @param rows The number of rows on the board.
+	 * @param columns The number of columns on the board.
+	 * @return true if rows * columns does not exceed MAX_CELLS.
+	 */
+	static bool boardSupports(unsigned int rows, unsigned int columns)
+	{
+		return (uint64_t) rows * columns <= MAX_CELLS;
+	}
+
+	/**
+	 * @brief Constructs a board holding the position of a snapshot, with an empty history.
+	 *
+	 * @param snapshot The position.
+	 */
+	explicit ReversiBoard(const ReversiBoardSnapshot &snapshot);
+
+	/**
+	 * @brief Copy constructor, copies the position and the live part of the history.
+	 */
+	ReversiBoard(const ReversiBoard &other) = default;
+
+	/**
+	 * @brief Move constructor, takes over the masks and the undo stack without allocating.
+	 */
+	ReversiBoard(ReversiBoard &&other) = default;
+
+	/**
+	 * @brief Copy assignment, reuses the storage of this board where the sizes match.
+	 */
+	ReversiBoard& operator=(const ReversiBoard &other) = default;
+
+	/**
+	 * @brief Move assignment, takes over the masks and the undo stack of the other board.
+	 */
+	ReversiBoard& operator=(ReversiBoard &&other) = default;
+
 	/**
 	 * @brief Destroys the ReversiBoard object and deallocates memory.
 	 *
-	 * The destructor frees any dynamically allocated memory associated with the board.
+	 * The bit masks release their storage themselves.
 	 */
 	~ReversiBoard();
 
 	/**
 	 * @brief Clears the board and resets all positions.
 	 *
-	 * This method resets the board to its empty state, with no pieces placed on it.
+	 * This method resets the board to its empty state, with no pieces placed on it,
+	 * discards the moves recorded for unmakeMove() and gives the turn to 'x'.
 	 *
 	 * @return RC_OK if the operation is successful, or an error code otherwise.
 	 */
@@ -80,14 +383,115 @@ public:
 	 * @brief Sets a piece at a specific position on the board.
 	 *
 	 * This method places a player's piece (either 'X' or 'O') on the specified row and column.
+	 * Passing '.' removes the piece from the cell.
 	 *
 	 * @param row The row index (starting from 0).
 	 * @param column The column index (starting from 0).
-	 * @param coin The coin to place on the board ('X' or 'O').
-	 * @return RC_OK if the operation is successful, or an error code otherwise.
+	 * @param coin The coin to place on the board ('x', 'o' or '.').
+	 * @return RC_OK if the operation is successful, RC_ERROR_PARAM_OUTOFRANGE for a
+	 *         position outside the board, RC_ERROR_BAD_PARAM for an unknown coin.
 	 */
 	RC_t boardSet(unsigned int row, unsigned int column, char coin);
 
+	/**
+	 * @brief Returns the coin at a specific position on the board.
+	 *
+	 * @param row The row index (starting from 0).
+	 * @param column The column index (starting from 0).
+	 * @return 'x' or 'o' for an occupied cell, '.' for an empty (or invalid) cell.
+	 */
+	char boardGet(unsigned int row, unsigned int column) const;
+
+	/**
+	 * @brief Returns the number of rows of the board.
+	 */
+	unsigned int boardRows() const
+	{
+		return rows;
+	}
+
+	/**
+	 * @brief Returns the number of columns of the board.
+	 */
+	unsigned int boardColumns() const
+	{
+		return columns;
+	}
+
+	/**
+	 * @brief Returns the mask of all discs of a player.
+	 *
+	 * @param coin The player ('x' or 'o'; any other value returns the 'o' discs).
+	 */
+	const ReversiMask& boardDiscs(char coin) const
+	{
+		return (coin == 'x') ? discsX : discsO;
+	}
+
+	/**
+	 * @brief Returns the mask of all cells of the board.
+	 */
+	const ReversiMask& boardCells() const
+	{
+		return maskAll;
+	}
+
+	/**
+	 * @brief Returns the 64-bit Zobrist hash of the position.
+	 *
+	 * The hash covers all discs and the side to move. It is kept up to date by
+	 * boardSet(), the flip methods, makeMove(), makePass() and unmakeMove().
+	 */
+	uint64_t boardHash() const
+	{
+		return hash;
+	}
+
+	/**
+	 * @brief Computes the Zobrist hash from scratch (for verification).
+	 */
+	uint64_t boardCalcHash() const;
+
+	/**
+	 * @brief Returns the player to move ('x' or 'o').
+	 *
+	 * makeMove() and makePass() hand the turn to the opponent, unmakeMove() gives it
+	 * back. The legacy boardSet() / flipOtoX() / flipXtoO() calls do not change it.
+	 */
+	char boardSideToMove() const
+	{
+		return sideToMove;
+	}
+
+	/**
+	 * @brief Sets the player to move.
+	 *
+	 * @param coin The player to move ('x' or 'o').
+	 * @return RC_OK if the operation is successful, RC_ERROR_BAD_PARAM for an unknown coin.
+	 */
+	RC_t boardSetSideToMove(char coin);
+
+	/**
+	 * @brief Returns an immutable copy of the current position.
+	 *
+	 * Copies the discs, the side to move and the hash, but not the history, so
+	 * the cost does not grow with the number of moves played.
+	 */
+	ReversiBoardSnapshot boardSnapshot() const
+	{
+		return ReversiBoardSnapshot(rows, columns, discsX, discsO, hash,
+				sideToMove);
+	}
+
+	/**
+	 * @brief Loads the position of a snapshot and discards the history.
+	 *
+	 * @param snapshot The position, taken from a board of the same size.
+	 * @return RC_OK if the operation is successful, RC_ERROR_BAD_PARAM if the
+	 *         snapshot has a different size.
+	 */
+	RC_t boardRestore(const ReversiBoardSnapshot &snapshot);
+
 	/**
 	 * @brief Initializes the board to the standard initial state for Reversi.
 	 *
@@ -126,6 +530,27 @@ public:
 	 */
 	bool boardValidPositionO(unsigned int row, unsigned int column, char coin);
 
+	/**
+	 * @brief Computes the set of all legal moves of a player in one call.
+	 *
+	 * Bit `row * columns + column` of the result is set if the player may place a
+	 * coin on that cell. Unlike boardValidPositionX() / boardValidPositionO(), this
+	 * method evaluates the whole board at once.
+	 *
+	 * @param coin The player to move ('x' or 'o').
+	 * @param moves Receives the mask of legal moves; resized to the board if needed.
+	 * @return RC_OK if the operation is successful, RC_ERROR_BAD_PARAM for an unknown coin.
+	 */
+	RC_t generateMoves(char coin, ReversiMask &moves) const;
+
+	/**
+	 * @brief Convenience overload of generateMoves() returning the mask by value.
+	 *
+	 * @param coin The player to move ('x' or 'o').
+	 * @return The mask of legal moves (empty for an unknown coin).
+	 */
+	ReversiMask generateMoves(char coin) const;
+
 	/**
 	 * @brief Flips opponent's 'O' pieces to 'X' for a valid move.
 	 *
@@ -139,6 +564,18 @@ public:
 	 */
 	RC_t flipOtoX(unsigned int row, unsigned int column, char coin);
 
+	/**
+	 * @brief Flips opponent's 'O' pieces to 'X' and returns the flipped set.
+	 *
+	 * @param row The row index (starting from 0).
+	 * @param column The column index (starting from 0).
+	 * @param coin The coin to flip ('X').
+	 * @param flipped Receives the mask of flipped pieces.
+	 * @return RC_OK if the operation is successful, or an error code otherwise.
+	 */
+	RC_t flipOtoX(unsigned int row, unsigned int column, char coin,
+			ReversiMask &flipped);
+
 	/**
 	 * @brief Flips opponent's 'X' pieces to 'O' for a valid move.
 	 *
@@ -151,6 +588,171 @@ public:
 	 * @return RC_OK if the operation is successful, or an error code otherwise.
 	 */
 	RC_t flipXtoO(unsigned int row, unsigned int column, char coin);
+
+	/**
+	 * @brief Flips opponent's 'X' pieces to 'O' and returns the flipped set.
+	 *
+	 * @param row The row index (starting from 0).
+	 * @param column The column index (starting from 0).
+	 * @param coin The coin to flip ('O').
+	 * @param flipped Receives the mask of flipped pieces.
+	 * @return RC_OK if the operation is successful, or an error code otherwise.
+	 */
+	RC_t flipXtoO(unsigned int row, unsigned int column, char coin,
+			ReversiMask &flipped);
+
+	/**
+	 * @brief Computes the pieces a move would flip, without changing the board.
+	 *
+	 * @param row The row index (starting from 0).
+	 * @param column The column index (starting from 0).
+	 * @param coin The coin that would be placed ('x' or 'o').
+	 * @param flips Receives the mask of pieces that would be flipped; resized if needed.
+	 * @return RC_OK if the operation is successful, RC_ERROR_BAD_PARAM for an unknown coin.
+	 */
+	RC_t boardCalcFlips(unsigned int row, unsigned int column, char coin,
+			ReversiMask &flips) const;
+
+	/**
+	 * @brief Plays a move and records it on the undo stack.
+	 *
+	 * The move is validated as part of computing the flips, so no separate call to
+	 * boardValidPositionX() / boardValidPositionO() is needed. The returned record
+	 * stays valid until the move is taken back with unmakeMove().
+	 *
+	 * @param row The row index (starting from 0).
+	 * @param column The column index (starting from 0).
+	 * @param coin The coin to place ('x' or 'o').
+	 * @return The undo record (placed cell and flipped discs), or 0 if the move is illegal.
+	 */
+	const ReversiUndo* makeMove(unsigned int row, unsigned int column, char coin);
+
+	/**
+	 * @brief Plays a move given by its cell index (bit index of generateMoves()).
+	 *
+	 * @param index The cell index (row * columns + column).
+	 * @param coin The coin to place ('x' or 'o').
+	 * @return The undo record, or 0 if the move is illegal.
+	 */
+	const ReversiUndo* makeMove(unsigned int index, char coin);
+
+	/**
+	 * @brief Records a pass of a player on the undo stack.
+	 *
+	 * @param coin The passing player ('x' or 'o').
+	 * @return The undo record (with index ReversiUndo::PASS), or 0 for an unknown coin.
+	 */
+	const ReversiUndo* makePass(char coin);
+
+	/**
+	 * @brief Takes back the last move or pass recorded on the undo stack.
+	 *
+	 * @return RC_OK if the operation is successful, RC_ERROR if there is no move to undo.
+	 */
+	RC_t unmakeMove();
+
+	/**
+	 * @brief Returns the number of discs of a player.
+	 *
+	 * Boards with up to 64 cells count their single word, larger boards keep the
+	 * counts up to date with every change.
+	 *
+	 * @param coin The player ('x' or 'o'; any other value returns the 'o' count).
+	 */
+	unsigned int boardCount(char coin) const
+	{
+		if (maskAll.maskWords() == 1)
+		{
+			return __builtin_popcountll(boardDiscs(coin).maskWord(0));
+		}
+		return (coin == 'x') ? countX : countO;
+	}
+
+	/**
+	 * @brief Returns the legal moves of a player, kept up to date across moves.
+	 *
+	 * Same set as generateMoves(), but after a move only the neighbourhood of the
+	 * placed and flipped discs is reexamined (see boardTrackRefresh()). The sets,
+	 * the mobility and the frontier are refreshed on the first query after a
+	 * change, so a const board must not be queried by several threads at once.
+	 *
+	 * @param coin The player ('x' or 'o'; any other value returns the 'o' moves).
+	 * @return The mask of legal moves, valid until the board is changed.
+	 */
+	const ReversiMask& boardMoves(char coin) const
+	{
+		if (!trackFresh)
+		{
+			boardTrackRefresh();
+		}
+		return (coin == 'x') ? movesX : movesO;
+	}
+
+	/**
+	 * @brief Returns the number of legal moves of a player.
+	 *
+	 * @param coin The player ('x' or 'o'; any other value returns the 'o' mobility).
+	 */
+	unsigned int boardMobility(char coin) const
+	{
+		if (!trackFresh)
+		{
+			boardTrackRefresh();
+		}
+		return (coin == 'x') ? mobilityX : mobilityO;
+	}
+
+	/**
+	 * @brief Checks whether a player has a legal move (otherwise it has to pass).
+	 *
+	 * @param coin The player ('x' or 'o').
+	 */
+	bool boardHasMoves(char coin) const
+	{
+		return boardMobility(coin) != 0;
+	}
+
+	/**
+	 * @brief Checks whether the game is over because neither player can move.
+	 */
+	bool boardGameOver() const
+	{
+		if (!trackFresh)
+		{
+			boardTrackRefresh();
+		}
+		return mobilityX == 0 && mobilityO == 0;
+	}
+
+	/**
+	 * @brief Returns the frontier: all empty cells next to at least one disc.
+	 */
+	const ReversiMask& boardFrontier() const
+	{
+		if (!trackFresh)
+		{
+			boardTrackRefresh();
+		}
+		return frontier;
+	}
+
+	/**
+	 * @brief Returns the number of moves and passes on the undo stack.
+	 */
+	unsigned int boardHistorySize() const
+	{
+		return undoStack.undoSize();
+	}
+
+	/**
+	 * @brief Returns a recorded move (0 is the first move on the undo stack).
+	 *
+	 * @param position Index of the move, smaller than boardHistorySize().
+	 */
+	const ReversiUndo& boardHistory(unsigned int position) const
+	{
+		return undoStack.undoAt(position);
+	}
 };
 
 #endif /* REVERSIBOARD_H_ */
@@ -0,0 +1,718 @@
+/*
+ * ReversiBoardBatch.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBoardBatch.cpp
+ * @brief Implements the batch of boards and its scalar, AVX2 and AVX-512 kernels.
+ *
+ * All implementations run the same Kogge-Stone fills as boardMovesWord() and the
+ * flip kernel, with the boards in the lanes instead of the directions, and must
+ * return identical results. The vector code is compiled with function-level
+ * target attributes, so the project itself does not need -mavx2 or -mavx512f.
+ * Boards left over after the last full vector are handled by the scalar code.
+ */
+
+// 64-bit x86 only: the kernels move 64-bit lanes to and from general registers
+#if defined(__x86_64__)
+#define REVERSI_BATCH_X86
+#include <immintrin.h>
+#endif
+
+#include "ReversiBoardBatch.h"
+
+using namespace std;
+
+/**
+ * @brief Shifts a mask by a direction's distance (0 for distances of 64 or more).
+ */
+static inline uint64_t batchShift(uint64_t mask, uint64_t amount, bool up)
+{
+	if (amount >= 64)
+	{
+		return 0;
+	}
+	return up ? (mask << amount) : (mask >> amount);
+}
+
+/**
+ * @brief Scalar legal move generation, one board at a time.
+ */
+static void movesScalar(const ReversiFlipKernel &kernel, uint64_t all,
+		const uint64_t *pPlayer, const uint64_t *pOpponent, uint64_t *pMoves,
+		size_t count)
+{
+	unsigned int rounds = kernel.flipKernelRounds();
+
+	for (size_t b = 0; b < count; b++)
+	{
+		uint64_t own = pPlayer[b];
+		uint64_t opp = pOpponent[b];
+		uint64_t empty = all & ~(own | opp);
+		uint64_t moves = 0;
+
+		for (unsigned int d = 0; d < 8; d++)
+		{
+			bool up = (d < 4);
+			uint64_t amount = kernel.flipKernelAmount(d);
+			uint64_t landing = kernel.flipKernelLanding(d);
+			uint64_t gen = own;
+			uint64_t pro = opp & landing;
+			uint64_t step = amount;
+
+			for (unsigned int r = 0; r < rounds; r++)
+			{
+				gen |= pro & batchShift(gen, step, up);
+				pro &= batchShift(pro, step, up);
+				step += step;
+			}
+			moves |= batchShift(gen & opp, amount, up) & landing & empty;
+		}
+		pMoves[b] = moves;
+	}
+}
+
+/**
+ * @brief Scalar flip computation, one board at a time.
+ *
+ * Starting from the placed coin, each direction fills through the opponent
+ * discs; a run counts if the cell beyond it holds an own disc. Occupied cells,
+ * cells beyond the board and PASS start from an empty mask and flip nothing.
+ */
+static void flipsScalar(const ReversiFlipKernel &kernel, uint64_t all,
+		const uint64_t *pPlayer, const uint64_t *pOpponent,
+		const uint32_t *pCells, uint64_t *pFlips, size_t count)
+{
+	unsigned int rounds = kernel.flipKernelRounds();
+
+	for (size_t b = 0; b < count; b++)
+	{
+		uint64_t own = pPlayer[b];
+		uint64_t opp = pOpponent[b];
+		uint64_t move = (pCells[b] < 64) ? ((uint64_t) 1 << pCells[b]) : 0;
+		uint64_t flips = 0;
+
+		move &= all & ~(own | opp);
+		for (unsigned int d = 0; d < 8; d++)
+		{
+			bool up = (d < 4);
+			uint64_t amount = kernel.flipKernelAmount(d);
+			uint64_t landing = kernel.flipKernelLanding(d);
+			uint64_t gen = move;
+			uint64_t pro = opp & landing;
+			uint64_t step = amount;
+
+			for (unsigned int r = 0; r < rounds; r++)
+			{
+				gen |= pro & batchShift(gen, step, up);
+				pro &= batchShift(pro, step, up);
+				step += step;
+			}
+
+			uint64_t run = gen & opp;
+			if (batchShift(run, amount, up) & own & landing)
+			{
+				flips |= run;
+			}
+		}
+		pFlips[b] = flips;
+	}
+}
+
+/**
+ * @brief Scalar disc count, one board at a time.
+ */
+static void countsScalar(const uint64_t *pDiscs, uint32_t *pCounts,
+		size_t count)
+{
+	for (size_t b = 0; b < count; b++)
+	{
+		pCounts[b] = __builtin_popcountll(pDiscs[b]);
+	}
+}
+
+#ifdef REVERSI_BATCH_X86
+
+/**
+ * @brief Shifts 4 masks by the same distance (0 for distances of 64 or more).
+ */
+__attribute__((target("avx2")))
+static inline __m256i shiftAvx2(__m256i v, __m128i amount, bool up)
+{
+	return up ? _mm256_sll_epi64(v, amount) : _mm256_srl_epi64(v, amount);
+}
+
+/**
+ * @brief AVX2 legal move generation, 4 boards per vector.
+ */
+__attribute__((target("avx2")))
+static void movesAvx2(const ReversiFlipKernel &kernel, uint64_t all,
+		const uint64_t *pPlayer, const uint64_t *pOpponent, uint64_t *pMoves,
+		size_t count)
+{
+	unsigned int rounds = kernel.flipKernelRounds();
+	const __m256i vAll = _mm256_set1_epi64x((long long) all);
+	size_t b = 0;
+
+	for (; b + 4 <= count; b += 4)
+	{
+		__m256i own = _mm256_loadu_si256((const __m256i*) (pPlayer + b));
+		__m256i opp = _mm256_loadu_si256((const __m256i*) (pOpponent + b));
+		__m256i empty = _mm256_andnot_si256(_mm256_or_si256(own, opp), vAll);
+		__m256i moves = _mm256_setzero_si256();
+
+		for (unsigned int d = 0; d < 8; d++)
+		{
+			bool up = (d < 4);
+			__m128i amount = _mm_cvtsi64_si128(
+					(long long) kernel.flipKernelAmount(d));
+			__m256i landing = _mm256_set1_epi64x(
+					(long long) kernel.flipKernelLanding(d));
+			__m256i gen = own;
+			__m256i pro = _mm256_and_si256(opp, landing);
+			__m128i step = amount;
+
+			for (unsigned int r = 0; r < rounds; r++)
+			{
+				gen = _mm256_or_si256(gen,
+						_mm256_and_si256(pro, shiftAvx2(gen, step, up)));
+				pro = _mm256_and_si256(pro, shiftAvx2(pro, step, up));
+				step = _mm_add_epi64(step, step);
+			}
+			moves = _mm256_or_si256(moves,
+					_mm256_and_si256(
+							shiftAvx2(_mm256_and_si256(gen, opp), amount, up),
+							_mm256_and_si256(landing, empty)));
+		}
+		_mm256_storeu_si256((__m256i*) (pMoves + b), moves);
+	}
+	movesScalar(kernel, all, pPlayer + b, pOpponent + b, pMoves + b, count - b);
+}
+
+/**
+ * @brief AVX2 flip computation, 4 boards per vector.
+ */
+__attribute__((target("avx2")))
+static void flipsAvx2(const ReversiFlipKernel &kernel, uint64_t all,
+		const uint64_t *pPlayer, const uint64_t *pOpponent,
+		const uint32_t *pCells, uint64_t *pFlips, size_t count)
+{
+	unsigned int rounds = kernel.flipKernelRounds();
+	const __m256i vAll = _mm256_set1_epi64x((long long) all);
+	const __m256i one = _mm256_set1_epi64x(1);
+	const __m256i zero = _mm256_setzero_si256();
+	size_t b = 0;
+
+	for (; b + 4 <= count; b += 4)
+	{
+		__m256i own = _mm256_loadu_si256((const __m256i*) (pPlayer + b));
+		__m256i opp = _mm256_loadu_si256((const __m256i*) (pOpponent + b));
+		// Shifts by 64 or more (PASS) give an empty mask
+		__m256i move = _mm256_sllv_epi64(one,
+				_mm256_cvtepu32_epi64(
+						_mm_loadu_si128((const __m128i*) (pCells + b))));
+		__m256i flips = zero;
+
+		move = _mm256_andnot_si256(_mm256_or_si256(own, opp),
+				_mm256_and_si256(move, vAll));
+		for (unsigned int d = 0; d < 8; d++)
+		{
+			bool up = (d < 4);
+			__m128i amount = _mm_cvtsi64_si128(
+					(long long) kernel.flipKernelAmount(d));
+			__m256i landing = _mm256_set1_epi64x(
+					(long long) kernel.flipKernelLanding(d));
+			__m256i gen = move;
+			__m256i pro = _mm256_and_si256(opp, landing);
+			__m128i step = amount;
+
+			for (unsigned int r = 0; r < rounds; r++)
+			{
+				gen = _mm256_or_si256(gen,
+						_mm256_and_si256(pro, shiftAvx2(gen, step, up)));
+				pro = _mm256_and_si256(pro, shiftAvx2(pro, step, up));
+				step = _mm_add_epi64(step, step);
+			}
+
+			__m256i run = _mm256_and_si256(gen, opp);
+			__m256i end = _mm256_and_si256(shiftAvx2(run, amount, up),
+					_mm256_and_si256(own, landing));
+			flips = _mm256_or_si256(flips,
+					_mm256_andnot_si256(_mm256_cmpeq_epi64(end, zero), run));
+		}
+		_mm256_storeu_si256((__m256i*) (pFlips + b), flips);
+	}
+	flipsScalar(kernel, all, pPlayer + b, pOpponent + b, pCells + b, pFlips + b,
+			count - b);
+}
+
+/**
+ * @brief AVX2 disc count, 4 boards per vector.
+ *
+ * Every nibble is counted with a table lookup; the byte counts of each board are
+ * then summed with one sum of absolute differences.
+ */
+__attribute__((target("avx2")))
+static void countsAvx2(const uint64_t *pDiscs, uint32_t *pCounts,
+		size_t count)
+{
+	const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3,
+			2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+	const __m256i even = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+	size_t b = 0;
+
+	for (; b + 4 <= count; b += 4)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*) (pDiscs + b));
+		__m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+		__m256i high = _mm256_shuffle_epi8(table,
+				_mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+		__m256i sums = _mm256_sad_epu8(_mm256_add_epi8(low, high),
+				_mm256_setzero_si256());
+
+		_mm_storeu_si128((__m128i*) (pCounts + b),
+				_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(sums, even)));
+	}
+	countsScalar(pDiscs + b, pCounts + b, count - b);
+}
+
+// GCC 12 warns about the deliberately undefined pass-through vectors inside
+// its own AVX-512 intrinsics (fixed in later releases)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+/**
+ * @brief Shifts 8 masks by the same distance (0 for distances of 64 or more).
+ */
+__attribute__((target("avx512f")))
+static inline __m512i shiftAvx512(__m512i v, __m128i amount, bool up)
+{
+	return up ? _mm512_sll_epi64(v, amount) : _mm512_srl_epi64(v, amount);
+}
+
+/**
+ * @brief AVX-512 legal move generation, 8 boards per vector.
+ */
+__attribute__((target("avx512f")))
+static void movesAvx512(const ReversiFlipKernel &kernel, uint64_t all,
+		const uint64_t *pPlayer, const uint64_t *pOpponent, uint64_t *pMoves,
+		size_t count)
+{
+	unsigned int rounds = kernel.flipKernelRounds();
+	const __m512i vAll = _mm512_set1_epi64((long long) all);
+	size_t b = 0;
+
+	for (; b + 8 <= count; b += 8)
+	{
+		__m512i own = _mm512_loadu_si512(pPlayer + b);
+		__m512i opp = _mm512_loadu_si512(pOpponent + b);
+		__m512i empty = _mm512_andnot_si512(_mm512_or_si512(own, opp), vAll);
+		__m512i moves = _mm512_setzero_si512();
+
+		for (unsigned int d = 0; d < 8; d++)
+		{
+			bool up = (d < 4);
+			__m128i amount = _mm_cvtsi64_si128(
+					(long long) kernel.flipKernelAmount(d));
+			__m512i landing = _mm512_set1_epi64(
+					(long long) kernel.flipKernelLanding(d));
+			__m512i gen = own;
+			__m512i pro = _mm512_and_si512(opp, landing);
+			__m128i step = amount;
+
+			for (unsigned int r = 0; r < rounds; r++)
+			{
+				gen = _mm512_or_si512(gen,
+						_mm512_and_si512(pro, shiftAvx512(gen, step, up)));
+				pro = _mm512_and_si512(pro, shiftAvx512(pro, step, up));
+				step = _mm_add_epi64(step, step);
+			}
+			moves = _mm512_or_si512(moves,
+					_mm512_and_si512(
+							shiftAvx512(_mm512_and_si512(gen, opp), amount, up),
+							_mm512_and_si512(landing, empty)));
+		}
+		_mm512_storeu_si512(pMoves + b, moves);
+	}
+	movesScalar(kernel, all, pPlayer + b, pOpponent + b, pMoves + b, count - b);
+}
+
+/**
+ * @brief AVX-512 flip computation, 8 boards per vector.
+ */
+__attribute__((target("avx512f")))
+static void flipsAvx512(const ReversiFlipKernel &kernel, uint64_t all,
+		const uint64_t *pPlayer, const uint64_t *pOpponent,
+		const uint32_t *pCells, uint64_t *pFlips, size_t count)
+{
+	unsigned int rounds = kernel.flipKernelRounds();
+	const __m512i vAll = _mm512_set1_epi64((long long) all);
+	const __m512i one = _mm512_set1_epi64(1);
+	size_t b = 0;
+
+	for (; b + 8 <= count; b += 8)
+	{
+		__m512i own = _mm512_loadu_si512(pPlayer + b);
+		__m512i opp = _mm512_loadu_si512(pOpponent + b);
+		// Shifts by 64 or more (PASS) give an empty mask
+		__m512i move = _mm512_sllv_epi64(one,
+				_mm512_cvtepu32_epi64(
+						_mm256_loadu_si256((const __m256i*) (pCells + b))));
+		__m512i flips = _mm512_setzero_si512();
+
+		move = _mm512_andnot_si512(_mm512_or_si512(own, opp),
+				_mm512_and_si512(move, vAll));
+		for (unsigned int d = 0; d < 8; d++)
+		{
+			bool up = (d < 4);
+			__m128i amount = _mm_cvtsi64_si128(
+					(long long) kernel.flipKernelAmount(d));
+			__m512i landing = _mm512_set1_epi64(
+					(long long) kernel.flipKernelLanding(d));
+			__m512i gen = move;
+			__m512i pro = _mm512_and_si512(opp, landing);
+			__m128i step = amount;
+
+			for (unsigned int r = 0; r < rounds; r++)
+			{
+				gen = _mm512_or_si512(gen,
+						_mm512_and_si512(pro, shiftAvx512(gen, step, up)));
+				pro = _mm512_and_si512(pro, shiftAvx512(pro, step, up));
+				step = _mm_add_epi64(step, step);
+			}
+
+			__m512i run = _mm512_and_si512(gen, opp);
+			__mmask8 bracketed = _mm512_test_epi64_mask(
+					shiftAvx512(run, amount, up), _mm512_and_si512(own, landing));
+			flips = _mm512_mask_or_epi64(flips, bracketed, flips, run);
+		}
+		_mm512_storeu_si512(pFlips + b, flips);
+	}
+	flipsScalar(kernel, all, pPlayer + b, pOpponent + b, pCells + b, pFlips + b,
+			count - b);
+}
+
+/**
+ * @brief AVX-512 disc count, 8 boards per vector.
+ */
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static void countsAvx512(const uint64_t *pDiscs, uint32_t *pCounts,
+		size_t count)
+{
+	size_t b = 0;
+
+	for (; b + 8 <= count; b += 8)
+	{
+		__m512i v = _mm512_popcnt_epi64(_mm512_loadu_si512(pDiscs + b));
+		_mm256_storeu_si256((__m256i*) (pCounts + b), _mm512_cvtepi64_epi32(v));
+	}
+	countsScalar(pDiscs + b, pCounts + b, count - b);
+}
+
+#pragma GCC diagnostic pop
+
+const ReversiBoardBatch::Kernels ReversiBoardBatch::avx2Kernels =
+{ &movesAvx2, &flipsAvx2, &countsAvx2 };
+
+const ReversiBoardBatch::Kernels ReversiBoardBatch::avx512Kernels =
+{ &movesAvx512, &flipsAvx512, &countsAvx512 };
+
+#else
+
+// Builds other than x86-64 have no vector implementation; use the scalar code
+const ReversiBoardBatch::Kernels ReversiBoardBatch::avx2Kernels =
+{ &movesScalar, &flipsScalar, &countsScalar };
+
+const ReversiBoardBatch::Kernels ReversiBoardBatch::avx512Kernels =
+{ &movesScalar, &flipsScalar, &countsScalar };
+
+#endif
+
+const ReversiBoardBatch::Kernels ReversiBoardBatch::scalarKernels =
+{ &movesScalar, &flipsScalar, &countsScalar };
+
+atomic<const ReversiBoardBatch::Kernels*> ReversiBoardBatch::pKernels(0);
+
+/**
+ * @brief Constructs an empty batch for boards of one size.
+ *
+ * @param rows Board rows (2 or more).
+ * @param columns Board columns (2 or more; rows * columns must not exceed 64).
+ */
+ReversiBoardBatch::ReversiBoardBatch(unsigned int rows, unsigned int columns) :
+		rows(rows), columns(columns), kernel(
+				batchSupports(rows, columns) ? rows : 2,
+				batchSupports(rows, columns) ? columns : 2), all(0), initialX(
+				0), initialO(0)
+{
+	if (batchSupports(rows, columns))
+	{
+		ReversiBoard initial(rows, columns);
+
+		initial.boardInitialState(rows, columns);
+		all = initial.boardCells().maskWord(0);
+		initialX = initial.boardDiscs('x').maskWord(0);
+		initialO = initial.boardDiscs('o').maskWord(0);
+	}
+}
+
+/**
+ * @brief Sets the number of boards; all boards start from the initial position.
+ *
+ * @param boards The number of boards.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM if the
+ *         board size is not supported.
+ */
+RC_t ReversiBoardBatch::batchReset(size_t boards)
+{
+	if (!batchSupports(rows, columns))
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	player.assign(boards, initialX);
+	opponent.assign(boards, initialO);
+	sides.assign(boards, 'x');
+	return RC_OK;
+}
+
+/**
+ * @brief Copies a position into the batch.
+ *
+ * @param board Number of the board in the batch.
+ * @param position The position (same size as the batch).
+ * @return RC_OK if the operation was successful, RC_ERROR_PARAM_OUTOFRANGE for
+ *         a board number beyond the batch, RC_ERROR_BAD_PARAM for another size.
+ */
+RC_t ReversiBoardBatch::batchSet(size_t board, const ReversiBoard &position)
+{
+	if (board >= sides.size())
+	{
+		return RC_ERROR_PARAM_OUTOFRANGE;
+	}
+	if (position.boardRows() != rows || position.boardColumns() != columns)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	char side = position.boardSideToMove();
+	player[board] = position.boardDiscs(side).maskWord(0);
+	opponent[board] = position.boardDiscs((side == 'x') ? 'o' : 'x').maskWord(0);
+	sides[board] = side;
+	return RC_OK;
+}
+
+/**
+ * @brief Copies a position out of the batch; the history of the target is cleared.
+ *
+ * @param board Number of the board in the batch.
+ * @param position Receives the position (same size as the batch).
+ * @return RC_OK if the operation was successful, RC_ERROR_PARAM_OUTOFRANGE for
+ *         a board number beyond the batch, RC_ERROR_BAD_PARAM for another size.
+ */
+RC_t ReversiBoardBatch::batchGet(size_t board, ReversiBoard &position) const
+{
+	if (board >= sides.size())
+	{
+		return RC_ERROR_PARAM_OUTOFRANGE;
+	}
+	if (position.boardRows() != rows || position.boardColumns() != columns)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	char side = sides[board];
+	char other = (side == 'x') ? 'o' : 'x';
+
+	position.boardClear();
+	for (uint64_t w = player[board]; w; w &= w - 1)
+	{
+		unsigned int cell = __builtin_ctzll(w);
+		position.boardSet(cell / columns, cell % columns, side);
+	}
+	for (uint64_t w = opponent[board]; w; w &= w - 1)
+	{
+		unsigned int cell = __builtin_ctzll(w);
+		position.boardSet(cell / columns, cell % columns, other);
+	}
+	return position.boardSetSideToMove(side);
+}
+
+/**
+ * @brief Computes the legal moves of the side to move on every board.
+ *
+ * @param pMoves Receives one move mask per board.
+ * @param pReplies Receives the legal moves of the other side per board, or 0.
+ */
+void ReversiBoardBatch::batchMoves(uint64_t *pMoves, uint64_t *pReplies) const
+{
+	const Kernels &kernels = batchKernels();
+
+	kernels.pMoves(kernel, all, player.data(), opponent.data(), pMoves,
+			sides.size());
+	if (pReplies)
+	{
+		kernels.pMoves(kernel, all, opponent.data(), player.data(), pReplies,
+				sides.size());
+	}
+}
+
+/**
+ * @brief Computes the discs one move per board would flip, without playing it.
+ *
+ * @param pCells One cell index per board; PASS or a cell beyond the board flips nothing.
+ * @param pFlips Receives one flip mask per board (empty for an illegal move).
+ */
+void ReversiBoardBatch::batchFlips(const uint32_t *pCells,
+		uint64_t *pFlips) const
+{
+	batchKernels().pFlips(kernel, all, player.data(), opponent.data(), pCells,
+			pFlips, sides.size());
+}
+
+/**
+ * @brief Plays one move (or pass) per board for the side to move.
+ *
+ * The flips of all boards come from one kernel call; applying them is a few
+ * word operations per board. Passes are rare, so their legality is checked
+ * board by board.
+ *
+ * @param pCells One cell index or PASS per board.
+ * @param pResults Receives one result per board, or 0.
+ * @return The number of moves played.
+ */
+size_t ReversiBoardBatch::batchPlay(const uint32_t *pCells,
+		ReversiBatchResult_t *pResults)
+{
+	size_t count = sides.size();
+	unsigned int cells = rows * columns;
+	size_t played = 0;
+
+	// Grows only with the batch, so repeated calls do not allocate
+	scratch.resize(count);
+	batchFlips(pCells, scratch.data());
+
+	for (size_t b = 0; b < count; b++)
+	{
+		uint32_t cell = pCells[b];
+		uint64_t flips = scratch[b];
+		ReversiBatchResult_t result = BATCH_OK;
+
+		if (cell == PASS)
+		{
+			uint64_t moves;
+			movesScalar(kernel, all, &player[b], &opponent[b], &moves, 1);
+			if (moves != 0)
+			{
+				result = BATCH_ILLEGAL;
+			}
+			else
+			{
+				uint64_t own = player[b];
+				player[b] = opponent[b];
+				opponent[b] = own;
+			}
+		}
+		else if (cell >= cells)
+		{
+			result = BATCH_OUT_OF_RANGE;
+		}
+		else if (flips == 0)
+		{
+			result = BATCH_ILLEGAL;
+		}
+		else
+		{
+			uint64_t own = player[b] | flips | ((uint64_t) 1 << cell);
+			player[b] = opponent[b] & ~flips;
+			opponent[b] = own;
+		}
+
+		if (result == BATCH_OK)
+		{
+			sides[b] = (sides[b] == 'x') ? 'o' : 'x';
+			played++;
+		}
+		if (pResults)
+		{
+			pResults[b] = result;
+		}
+	}
+	return played;
+}
+
+/**
+ * @brief Counts the discs on every board.
+ *
+ * @param pPlayer Receives the disc count of the side to move per board.
+ * @param pOpponent Receives the disc count of the other side per board.
+ */
+void ReversiBoardBatch::batchCounts(uint32_t *pPlayer,
+		uint32_t *pOpponent) const
+{
+	const Kernels &kernels = batchKernels();
+
+	kernels.pCounts(player.data(), pPlayer, sides.size());
+	kernels.pCounts(opponent.data(), pOpponent, sides.size());
+}
+
+/**
+ * @brief Returns the selected kernels, selecting the best ones on first use.
+ */
+const ReversiBoardBatch::Kernels& ReversiBoardBatch::batchKernels()
+{
+	const Kernels *pSelected = pKernels.load(memory_order_relaxed);
+
+	if (!pSelected)
+	{
+		batchUseSimd(BATCH_SIMD_AVX512);
+		pSelected = pKernels.load(memory_order_relaxed);
+	}
+	return *pSelected;
+}
+
+/**
+ * @brief Returns the instruction set of the selected kernels.
+ */
+ReversiBatchSimd_t ReversiBoardBatch::batchSimd()
+{
+	const Kernels *pSelected = &batchKernels();
+
+	if (pSelected == &avx512Kernels)
+	{
+		return BATCH_SIMD_AVX512;
+	}
+	return (pSelected == &avx2Kernels) ? BATCH_SIMD_AVX2 : BATCH_SIMD_SCALAR;
+}
+
+/**
+ * @brief Selects the kernels of an instruction set, or the best available below it.
+ *
+ * The AVX-512 kernels also need the 64-bit vector population count.
+ *
+ * @param simd The highest instruction set to use.
+ * @return The instruction set selected.
+ */
+ReversiBatchSimd_t ReversiBoardBatch::batchUseSimd(ReversiBatchSimd_t simd)
+{
+#ifdef REVERSI_BATCH_X86
+	__builtin_cpu_init();
+	if (simd >= BATCH_SIMD_AVX512 && __builtin_cpu_supports("avx512f")
+			&& __builtin_cpu_supports("avx512vpopcntdq"))
+	{
+		pKernels.store(&avx512Kernels, memory_order_relaxed);
+		return BATCH_SIMD_AVX512;
+	}
+	if (simd >= BATCH_SIMD_AVX2 && __builtin_cpu_supports("avx2"))
+	{
+		pKernels.store(&avx2Kernels, memory_order_relaxed);
+		return BATCH_SIMD_AVX2;
+	}
+#endif
+	pKernels.store(&scalarKernels, memory_order_relaxed);
+	return BATCH_SIMD_SCALAR;
+}
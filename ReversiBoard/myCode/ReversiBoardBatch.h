@@ -0,0 +1,232 @@
+/*
+ * ReversiBoardBatch.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBoardBatch.h
+ * @brief Declares a structure-of-arrays batch of boards with vectorized kernels.
+ *
+ * All boards of a batch have the same size (up to 64 cells), so the shift
+ * distances and edge masks of the 8 directions are shared and every board can
+ * take one vector lane: the discs of the side to move, the discs of the opponent
+ * and the side to move are kept in three separate arrays. Legal moves, flips and
+ * disc counts are computed for 8 boards per AVX-512 vector or 4 boards per AVX2
+ * vector; on other CPUs a scalar implementation with identical results is used.
+ * The implementation is chosen once at runtime, like the flip kernel's.
+ */
+
+#ifndef REVERSIBOARDBATCH_H_
+#define REVERSIBOARDBATCH_H_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "global.h"
+#include "ReversiBatch.h"
+#include "ReversiBoard.h"
+#include "ReversiFlipKernel.h"
+
+/**
+ * @enum ReversiBatchSimd_t
+ * @brief Instruction set of the batch kernels.
+ */
+typedef enum
+{
+	BATCH_SIMD_SCALAR, ///< One board at a time.
+	BATCH_SIMD_AVX2,   ///< 4 boards per vector.
+	BATCH_SIMD_AVX512  ///< 8 boards per vector.
+} ReversiBatchSimd_t;
+
+/**
+ * @class ReversiBoardBatch
+ * @brief Many boards of one size, stored lane by lane for vectorized kernels.
+ *
+ * The kernels take and fill arrays with one entry per board, in board order. The
+ * batch holds positions only; there is no undo stack. Use batchSet() and
+ * batchGet() to move positions from and to ReversiBoard.
+ */
+class ReversiBoardBatch
+{
+public:
+	/**
+	 * @brief Cell value of a pass (same as ReversiBatch::PASS).
+	 */
+	static const uint32_t PASS = ReversiBatch::PASS;
+
+private:
+	/**
+	 * @brief The kernels of one instruction set; they handle boards [0, count).
+	 */
+	struct Kernels
+	{
+		void (*pMoves)(const ReversiFlipKernel &kernel, uint64_t all,
+				const uint64_t *pPlayer, const uint64_t *pOpponent,
+				uint64_t *pMoves, size_t count);
+		void (*pFlips)(const ReversiFlipKernel &kernel, uint64_t all,
+				const uint64_t *pPlayer, const uint64_t *pOpponent,
+				const uint32_t *pCells, uint64_t *pFlips, size_t count);
+		void (*pCounts)(const uint64_t *pDiscs, uint32_t *pCounts,
+				size_t count);
+	};
+
+	static const Kernels scalarKernels;
+	static const Kernels avx2Kernels;
+	static const Kernels avx512Kernels;
+	static std::atomic<const Kernels*> pKernels;
+
+	unsigned int rows;
+	unsigned int columns;
+	ReversiFlipKernel kernel;        ///< Shift distances and edge masks of the directions.
+	uint64_t all;                    ///< Mask of all cells.
+	uint64_t initialX;               ///< Discs of 'x' in the initial position.
+	uint64_t initialO;               ///< Discs of 'o' in the initial position.
+	std::vector<uint64_t> player;    ///< Discs of the side to move, per board.
+	std::vector<uint64_t> opponent;  ///< Discs of the other side, per board.
+	std::vector<char> sides;         ///< Side to move ('x' or 'o'), per board.
+	std::vector<uint64_t> scratch;   ///< Flips of batchPlay().
+
+	/**
+	 * @brief Returns the selected kernels, selecting the best ones on first use.
+	 */
+	static const Kernels& batchKernels();
+
+	ReversiBoardBatch(const ReversiBoardBatch&);
+	ReversiBoardBatch& operator=(const ReversiBoardBatch&);
+
+public:
+	/**
+	 * @brief Constructs an empty batch for boards of one size.
+	 *
+	 * @param rows Board rows (2 or more).
+	 * @param columns Board columns (2 or more; rows * columns must not exceed 64).
+	 */
+	ReversiBoardBatch(unsigned int rows, unsigned int columns);
+
+	/**
+	 * @brief Checks whether boards of a size can be batched.
+	 */
+	static bool batchSupports(unsigned int rows, unsigned int columns)
+	{
+		return rows >= 2 && columns >= 2 && rows * columns <= 64;
+	}
+
+	/**
+	 * @brief Sets the number of boards; all boards start from the initial position.
+	 *
+	 * @param boards The number of boards.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM if the
+	 *         board size is not supported.
+	 */
+	RC_t batchReset(size_t boards);
+
+	/**
+	 * @brief Returns the number of boards.
+	 */
+	size_t batchSize() const
+	{
+		return sides.size();
+	}
+
+	/**
+	 * @brief Copies a position into the batch.
+	 *
+	 * @param board Number of the board in the batch.
+	 * @param position The position (same size as the batch).
+	 * @return RC_OK if the operation was successful, RC_ERROR_PARAM_OUTOFRANGE for
+	 *         a board number beyond the batch, RC_ERROR_BAD_PARAM for another size.
+	 */
+	RC_t batchSet(size_t board, const ReversiBoard &position);
+
+	/**
+	 * @brief Copies a position out of the batch; the history of the target is cleared.
+	 *
+	 * @param board Number of the board in the batch.
+	 * @param position Receives the position (same size as the batch).
+	 * @return RC_OK if the operation was successful, RC_ERROR_PARAM_OUTOFRANGE for
+	 *         a board number beyond the batch, RC_ERROR_BAD_PARAM for another size.
+	 */
+	RC_t batchGet(size_t board, ReversiBoard &position) const;
+
+	/**
+	 * @brief Returns the discs of the side to move on a board.
+	 */
+	uint64_t batchPlayer(size_t board) const
+	{
+		return player[board];
+	}
+
+	/**
+	 * @brief Returns the discs of the other side on a board.
+	 */
+	uint64_t batchOpponent(size_t board) const
+	{
+		return opponent[board];
+	}
+
+	/**
+	 * @brief Returns the side to move on a board ('x' or 'o').
+	 */
+	char batchSide(size_t board) const
+	{
+		return sides[board];
+	}
+
+	/**
+	 * @brief Computes the legal moves of the side to move on every board.
+	 *
+	 * @param pMoves Receives one move mask per board.
+	 * @param pReplies Receives the legal moves of the other side per board, or 0.
+	 */
+	void batchMoves(uint64_t *pMoves, uint64_t *pReplies = 0) const;
+
+	/**
+	 * @brief Computes the discs one move per board would flip, without playing it.
+	 *
+	 * @param pCells One cell index per board; PASS or a cell beyond the board flips nothing.
+	 * @param pFlips Receives one flip mask per board (empty for an illegal move).
+	 */
+	void batchFlips(const uint32_t *pCells, uint64_t *pFlips) const;
+
+	/**
+	 * @brief Plays one move (or pass) per board for the side to move.
+	 *
+	 * Illegal moves leave their board unchanged. A pass is legal only without a
+	 * legal move.
+	 *
+	 * @param pCells One cell index or PASS per board.
+	 * @param pResults Receives one result per board (BATCH_OK, BATCH_ILLEGAL or
+	 *        BATCH_OUT_OF_RANGE), or 0.
+	 * @return The number of moves played.
+	 */
+	size_t batchPlay(const uint32_t *pCells, ReversiBatchResult_t *pResults);
+
+	/**
+	 * @brief Counts the discs on every board.
+	 *
+	 * @param pPlayer Receives the disc count of the side to move per board.
+	 * @param pOpponent Receives the disc count of the other side per board.
+	 */
+	void batchCounts(uint32_t *pPlayer, uint32_t *pOpponent) const;
+
+	/**
+	 * @brief Returns the instruction set of the selected kernels.
+	 */
+	static ReversiBatchSimd_t batchSimd();
+
+	/**
+	 * @brief Selects the kernels of an instruction set, or the best available below it.
+	 *
+	 * Used to compare the implementations.
+	 *
+	 * @param simd The highest instruction set to use.
+	 * @return The instruction set selected.
+	 */
+	static ReversiBatchSimd_t batchUseSimd(ReversiBatchSimd_t simd);
+};
+
+#endif /* REVERSIBOARDBATCH_H_ */
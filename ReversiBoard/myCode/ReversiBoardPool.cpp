@@ -0,0 +1,130 @@
+/*
+ * ReversiBoardPool.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBoardPool.cpp
+ * @brief Implements the board pool.
+ */
+
+#include "ReversiBoardPool.h"
+
+using namespace std;
+
+/**
+ * @brief Returns the key of a board size in the table of free boards.
+ */
+static uint64_t poolKey(unsigned int rows, unsigned int columns)
+{
+	return (uint64_t) rows << 32 | columns;
+}
+
+/**
+ * @brief Constructs an empty pool.
+ *
+ * @param limit Number of free boards kept per board size; more are deleted.
+ */
+ReversiBoardPool::ReversiBoardPool(size_t limit) :
+		limit(limit), idleCount(0), created(0), reused(0)
+{
+}
+
+/**
+ * @brief Deletes the free boards. All handles must have been destroyed before.
+ */
+ReversiBoardPool::~ReversiBoardPool()
+{
+	for (unordered_map<uint64_t, vector<ReversiBoard*> >::iterator it =
+			idle.begin(); it != idle.end(); ++it)
+	{
+		for (size_t i = 0; i < it->second.size(); i++)
+		{
+			delete it->second[i];
+		}
+	}
+}
+
+/**
+ * @brief Returns a free board of the given size (with its old contents), or constructs one.
+ */
+ReversiBoard* ReversiBoardPool::poolTake(unsigned int rows,
+		unsigned int columns)
+{
+	vector<ReversiBoard*> &boards = idle[poolKey(rows, columns)];
+
+	if (boards.empty())
+	{
+		created++;
+		return new ReversiBoard(rows, columns);
+	}
+
+	ReversiBoard *pBoard = boards.back();
+	boards.pop_back();
+	idleCount--;
+	reused++;
+	return pBoard;
+}
+
+/**
+ * @brief Returns a board in the initial position.
+ *
+ * A recycled board is cleared first; its masks and undo records are kept, so
+ * playing on it does not allocate up to the depth it reached before.
+ *
+ * @param rows The number of rows (at least 2).
+ * @param columns The number of columns (at least 2).
+ * @return The board, or an empty handle for sizes below 2x2.
+ */
+ReversiBoardPool::Handle ReversiBoardPool::poolAcquire(unsigned int rows,
+		unsigned int columns)
+{
+	Release release =
+	{ this };
+
+	if (rows < 2 || columns < 2)
+	{
+		return Handle(0, release);
+	}
+
+	Handle board(poolTake(rows, columns), release);
+	board->boardClear();
+	board->boardInitialState(rows, columns);
+	return board;
+}
+
+/**
+ * @brief Returns a board holding the position of a snapshot, with an empty history.
+ *
+ * @param snapshot The position.
+ */
+ReversiBoardPool::Handle ReversiBoardPool::poolAcquire(
+		const ReversiBoardSnapshot &snapshot)
+{
+	Release release =
+	{ this };
+	Handle board(poolTake(snapshot.snapshotRows(), snapshot.snapshotColumns()),
+			release);
+
+	board->boardRestore(snapshot);
+	return board;
+}
+
+/**
+ * @brief Takes back a board, or deletes it if enough boards of its size are free.
+ */
+void ReversiBoardPool::poolRelease(ReversiBoard *pBoard)
+{
+	vector<ReversiBoard*> &boards = idle[poolKey(pBoard->boardRows(),
+			pBoard->boardColumns())];
+
+	if (boards.size() >= limit)
+	{
+		delete pBoard;
+		return;
+	}
+	boards.push_back(pBoard);
+	idleCount++;
+}
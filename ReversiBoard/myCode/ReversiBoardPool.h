@@ -0,0 +1,132 @@
+/*
+ * ReversiBoardPool.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBoardPool.h
+ * @brief Declares a pool that recycles boards together with their undo stacks.
+ *
+ * Constructing a ReversiBoard allocates the board object and the storage of its
+ * undo stack (plus every mask on boards above 256 cells). Code that creates
+ * many short-lived boards, such as the game server creating one per game, takes
+ * them from a pool instead: a returned board keeps all its storage, so a board
+ * of a size seen before is handed out again without touching the heap.
+ *
+ * A pool is not thread-safe. Every thread keeps its own pool, which also avoids
+ * contention on the global allocator; positions are passed between threads as
+ * ReversiBoardSnapshot values.
+ */
+
+#ifndef REVERSIBOARDPOOL_H_
+#define REVERSIBOARDPOOL_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+#include "ReversiBoard.h"
+
+/**
+ * @class ReversiBoardPool
+ * @brief Hands out boards by size and takes them back when their handle is destroyed.
+ */
+class ReversiBoardPool
+{
+public:
+	/**
+	 * @brief Deleter of a pooled board, returns the board to its pool.
+	 */
+	struct Release
+	{
+		ReversiBoardPool *pPool;
+
+		void operator()(ReversiBoard *pBoard) const
+		{
+			pPool->poolRelease(pBoard);
+		}
+	};
+
+	/**
+	 * @brief Owning handle of a pooled board; must not outlive the pool.
+	 */
+	typedef std::unique_ptr<ReversiBoard, Release> Handle;
+
+private:
+	std::unordered_map<uint64_t, std::vector<ReversiBoard*> > idle; ///< Free boards by size.
+	size_t limit;      ///< Free boards kept per size.
+	size_t idleCount;  ///< Free boards of all sizes.
+	uint64_t created;  ///< Boards constructed by poolAcquire().
+	uint64_t reused;   ///< Boards handed out again.
+
+	/**
+	 * @brief Takes back a board, or deletes it if enough boards of its size are free.
+	 */
+	void poolRelease(ReversiBoard *pBoard);
+
+	/**
+	 * @brief Returns a free board of the given size (with its old contents), or constructs one.
+	 */
+	ReversiBoard* poolTake(unsigned int rows, unsigned int columns);
+
+	ReversiBoardPool(const ReversiBoardPool&);
+	ReversiBoardPool& operator=(const ReversiBoardPool&);
+
+public:
+	/**
+	 * @brief Constructs an empty pool.
+	 *
+	 * @param limit Number of free boards kept per board size; more are deleted.
+	 */
+	explicit ReversiBoardPool(size_t limit = 1024);
+
+	/**
+	 * @brief Deletes the free boards. All handles must have been destroyed before.
+	 */
+	~ReversiBoardPool();
+
+	/**
+	 * @brief Returns a board in the initial position.
+	 *
+	 * @param rows The number of rows (at least 2).
+	 * @param columns The number of columns (at least 2).
+	 * @return The board, or an empty handle for sizes below 2x2.
+	 */
+	Handle poolAcquire(unsigned int rows, unsigned int columns);
+
+	/**
+	 * @brief Returns a board holding the position of a snapshot, with an empty history.
+	 *
+	 * @param snapshot The position.
+	 */
+	Handle poolAcquire(const ReversiBoardSnapshot &snapshot);
+
+	/**
+	 * @brief Returns the number of free boards of all sizes.
+	 */
+	size_t poolIdle() const
+	{
+		return idleCount;
+	}
+
+	/**
+	 * @brief Returns the number of boards constructed by the pool.
+	 */
+	uint64_t poolCreated() const
+	{
+		return created;
+	}
+
+	/**
+	 * @brief Returns the number of requests served with a recycled board.
+	 */
+	uint64_t poolReused() const
+	{
+		return reused;
+	}
+};
+
+#endif /* REVERSIBOARDPOOL_H_ */
@@ -0,0 +1,407 @@
+/*
+ * ReversiBook.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBook.cpp
+ * @brief Implements the opening book reader and builder.
+ */
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+#include "ReversiBook.h"
+#include "ReversiTransTable.h"
+
+using namespace std;
+
+static const unsigned char bookMagic[4] =
+{ 'R', 'V', 'B', 'K' };
+static const uint16_t BOOK_VERSION = 2; // 2: canonical keys and moves
+static const size_t BOOK_HEADER_SIZE = 16;
+
+// Size of the stdio buffer when writing a book
+static const size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+/**
+ * @brief Orders entries by key, then by decreasing count and score.
+ */
+static bool bookEntryLess(const ReversiBookEntry &a, const ReversiBookEntry &b)
+{
+	if (a.key != b.key)
+	{
+		return a.key < b.key;
+	}
+	if (a.count != b.count)
+	{
+		return a.count > b.count;
+	}
+	return a.score > b.score;
+}
+
+/**
+ * @brief Constructs an empty book.
+ */
+ReversiBook::ReversiBook() :
+		pEntries(0), entries(0)
+{
+}
+
+/**
+ * @brief Returns the book key of a position and its orientation.
+ *
+ * Zobrist keys do not depend on the board size, so the size is mixed in the same
+ * way as for the transposition table keys of ReversiSearch.
+ *
+ * @param board The position; the side to move is part of the key.
+ * @param transform Receives the symmetry that maps the board to the
+ *        orientation of the book moves.
+ * @return The key (the same for all symmetric variants of the position).
+ */
+uint64_t ReversiBook::bookKey(const ReversiBoard &board,
+		ReversiSymmetry_t &transform)
+{
+	return ReversiSymmetry::symmetryKey(board, transform)
+			^ (((uint64_t) board.boardRows() << 32 | board.boardColumns())
+					* 0xC2B2AE3D27D4EB4FULL);
+}
+
+/**
+ * @brief Maps a book file.
+ *
+ * Only the header is checked; the entries are used in place.
+ *
+ * @param path The file name.
+ * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be
+ *         mapped or is not a book.
+ */
+RC_t ReversiBook::bookOpen(const char *path)
+{
+	bookClose();
+
+	if (file.mapOpen(path) != RC_OK || file.mapSize() < BOOK_HEADER_SIZE)
+	{
+		file.mapClose();
+		return RC_ERROR;
+	}
+
+	const unsigned char *pData = file.mapData();
+	uint16_t version, entrySize;
+	uint64_t count;
+
+	memcpy(&version, pData + 4, 2);
+	memcpy(&entrySize, pData + 6, 2);
+	memcpy(&count, pData + 8, 8);
+	if (memcmp(pData, bookMagic, 4) != 0 || version != BOOK_VERSION
+			|| entrySize != sizeof(ReversiBookEntry)
+			|| count != (file.mapSize() - BOOK_HEADER_SIZE) / sizeof(ReversiBookEntry)
+			|| BOOK_HEADER_SIZE + count * sizeof(ReversiBookEntry) != file.mapSize())
+	{
+		file.mapClose();
+		return RC_ERROR;
+	}
+
+	pEntries = (const ReversiBookEntry*) (pData + BOOK_HEADER_SIZE);
+	entries = count;
+	return RC_OK;
+}
+
+/**
+ * @brief Unmaps the book; entries returned before become invalid.
+ */
+void ReversiBook::bookClose()
+{
+	file.mapClose();
+	pEntries = 0;
+	entries = 0;
+}
+
+/**
+ * @brief Finds all entries of a position without copying them.
+ *
+ * @param key The position key.
+ * @param pFirst Receives the first entry (most frequent move first), or 0.
+ * @return The number of entries of the position (0 if it is not in the book).
+ */
+size_t ReversiBook::bookFind(uint64_t key, const ReversiBookEntry *&pFirst) const
+{
+	const ReversiBookEntry *pEnd = pEntries + entries;
+	const ReversiBookEntry *p = lower_bound(pEntries, pEnd, key,
+			[](const ReversiBookEntry &entry, uint64_t value)
+			{
+				return entry.key < value;
+			});
+
+	pFirst = 0;
+	if (p == pEnd || p->key != key)
+	{
+		return 0;
+	}
+
+	pFirst = p;
+	size_t count = 0;
+	while (p != pEnd && p->key == key)
+	{
+		p++;
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Returns the book move of a position.
+ *
+ * The entries of a position are sorted by decreasing count and score, so the
+ * first legal one is taken. Checking legality guards against key collisions.
+ * The stored moves are mapped from the canonical orientation back to the board.
+ *
+ * @param board The position; the side to move is taken from boardSideToMove().
+ * @param move Receives the cell index on board.
+ * @param score Receives the score of the move.
+ * @return RC_OK if the position is in the book, RC_ERROR otherwise.
+ */
+RC_t ReversiBook::bookProbe(const ReversiBoard &board, unsigned int &move,
+		int &score) const
+{
+	const ReversiBookEntry *pFirst;
+	ReversiSymmetry_t transform;
+	size_t count = bookFind(bookKey(board, transform), pFirst);
+
+	if (count == 0)
+	{
+		return RC_ERROR;
+	}
+
+	unsigned int rows = board.boardRows();
+	unsigned int columns = board.boardColumns();
+	ReversiSymmetry_t inverse = ReversiSymmetry::symmetryInverse(transform);
+	ReversiMask moves = board.generateMoves(board.boardSideToMove());
+	for (size_t i = 0; i < count; i++)
+	{
+		unsigned int cell = ReversiSymmetry::symmetryCell(pFirst[i].move, rows,
+				columns, inverse);
+		if (cell < rows * columns && moves.maskTest(cell))
+		{
+			move = cell;
+			score = pFirst[i].score;
+			return RC_OK;
+		}
+	}
+	return RC_ERROR;
+}
+
+/**
+ * @brief Adds the first moves of every game of an archive.
+ *
+ * @param archive The archive.
+ * @param plies Number of plies taken from the start of every game.
+ * @return RC_OK if the operation was successful, RC_ERROR for a damaged game.
+ */
+RC_t ReversiBookBuilder::bookAddArchive(const ReversiArchiveReader &archive,
+		unsigned int plies)
+{
+	ReversiBoard board(0, 0);
+
+	for (size_t i = 0; i < archive.archiveGames(); i++)
+	{
+		ReversiArchiveGame game;
+
+		if (archive.archiveGame(i, game) != RC_OK)
+		{
+			return RC_ERROR;
+		}
+		if (board.boardRows() != game.rows
+				|| board.boardColumns() != game.columns)
+		{
+			board = ReversiBoard(game.rows, game.columns);
+		}
+
+		board.boardClear();
+		board.boardInitialState(game.rows, game.columns);
+		for (unsigned int ply = 0; ply < plies && ply < game.plies; ply++)
+		{
+			unsigned int move = game.gameMove(ply);
+			char coin = board.boardSideToMove();
+
+			if (move == ReversiUndo::PASS)
+			{
+				board.makePass(coin);
+				continue;
+			}
+
+			Sample sample;
+			ReversiSymmetry_t transform;
+			sample.key = ReversiBook::bookKey(board, transform);
+			sample.move = ReversiSymmetry::symmetryCell(move, game.rows,
+					game.columns, transform);
+			sample.score = (coin == 'x') ? game.result : -game.result;
+			samples.push_back(sample);
+
+			if (!board.makeMove(move, coin))
+			{
+				return RC_ERROR;
+			}
+		}
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Searches a position and the positions after all its moves.
+ *
+ * A pass counts as one ply, so the expansion always ends. Of several moves that
+ * lead to symmetric positions only the first is followed.
+ */
+void ReversiBookBuilder::bookExpand(ReversiBoard &board, ReversiSearch &search,
+		const ReversiSearchLimits &limits, unsigned int plies)
+{
+	ReversiSearchResult result;
+
+	search.searchRun(board, limits, result);
+	if (result.bestMove == ReversiSearch::NO_MOVE)
+	{
+		return;
+	}
+	if (result.bestMove != ReversiUndo::PASS)
+	{
+		Sample sample;
+		ReversiSymmetry_t transform;
+		sample.key = ReversiBook::bookKey(board, transform);
+		sample.move = ReversiSymmetry::symmetryCell(result.bestMove,
+				board.boardRows(), board.boardColumns(), transform);
+		sample.score = result.score;
+		samples.push_back(sample);
+	}
+	if (plies == 0)
+	{
+		return;
+	}
+
+	char coin = board.boardSideToMove();
+	ReversiMask moves = board.generateMoves(coin);
+	unsigned int bit = 0;
+
+	if (!moves.maskAny())
+	{
+		board.makePass(coin);
+		bookExpand(board, search, limits, plies - 1);
+		board.unmakeMove();
+		return;
+	}
+	// Moves leading to symmetric positions share their book entries
+	vector<uint64_t> expanded;
+	while (moves.maskNext(bit))
+	{
+		board.makeMove(bit, coin);
+		uint64_t key = ReversiBook::bookKey(board);
+		if (find(expanded.begin(), expanded.end(), key) == expanded.end())
+		{
+			expanded.push_back(key);
+			bookExpand(board, search, limits, plies - 1);
+		}
+		board.unmakeMove();
+		bit++;
+	}
+}
+
+/**
+ * @brief Searches all positions up to a number of plies from a position and
+ *        adds the best move of each.
+ *
+ * @param position The position to start from.
+ * @param plies Number of plies to expand (all moves are followed).
+ * @param limits Budget of every search.
+ * @param ttMegabytes Size of the transposition table of the searches.
+ * @return RC_OK if the operation was successful.
+ */
+RC_t ReversiBookBuilder::bookAddSearch(const ReversiBoard &position,
+		unsigned int plies, const ReversiSearchLimits &limits,
+		size_t ttMegabytes)
+{
+	ReversiTransTable tt(ttMegabytes);
+	ReversiSearch search(tt);
+	ReversiBoard board(position);
+
+	bookExpand(board, search, limits, plies);
+	return RC_OK;
+}
+
+/**
+ * @brief Merges the collected moves and writes them as a sorted book file.
+ *
+ * Moves seen several times in a position become one entry with their count and
+ * average score.
+ *
+ * @param path The file name.
+ * @param minCount Moves seen less often are left out.
+ * @param entries Receives the number of entries written.
+ * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be written.
+ */
+RC_t ReversiBookBuilder::bookWrite(const char *path, unsigned int minCount,
+		size_t &entries)
+{
+	vector<ReversiBookEntry> book;
+
+	sort(samples.begin(), samples.end(), [](const Sample &a, const Sample &b)
+	{
+		return (a.key != b.key) ? a.key < b.key : a.move < b.move;
+	});
+
+	for (size_t i = 0; i < samples.size();)
+	{
+		size_t j = i;
+		int64_t sum = 0;
+
+		while (j < samples.size() && samples[j].key == samples[i].key
+				&& samples[j].move == samples[i].move)
+		{
+			sum += samples[j].score;
+			j++;
+		}
+		if (j - i >= minCount)
+		{
+			ReversiBookEntry entry;
+			int64_t score = sum / (int64_t) (j - i);
+
+			memset(&entry, 0, sizeof(entry));
+			entry.key = samples[i].key;
+			entry.move = samples[i].move;
+			entry.score = (int16_t) max<int64_t>(-32767, min<int64_t>(32767, score));
+			entry.count = (uint32_t) min<size_t>(j - i, 0xFFFFFFFFu);
+			book.push_back(entry);
+		}
+		i = j;
+	}
+	sort(book.begin(), book.end(), bookEntryLess);
+
+	FILE *pFile = fopen(path, "wb");
+	if (!pFile)
+	{
+		return RC_ERROR;
+	}
+	setvbuf(pFile, 0, _IOFBF, WRITE_BUFFER_SIZE);
+
+	unsigned char header[BOOK_HEADER_SIZE];
+	uint16_t entrySize = sizeof(ReversiBookEntry);
+	uint64_t count = book.size();
+
+	memcpy(header, bookMagic, 4);
+	memcpy(header + 4, &BOOK_VERSION, 2);
+	memcpy(header + 6, &entrySize, 2);
+	memcpy(header + 8, &count, 8);
+
+	bool ok = fwrite(header, 1, sizeof(header), pFile) == sizeof(header);
+	if (ok && !book.empty())
+	{
+		ok = fwrite(&book[0], sizeof(ReversiBookEntry), book.size(), pFile)
+				== book.size();
+	}
+	ok = (fclose(pFile) == 0) && ok;
+
+	entries = book.size();
+	return ok ? RC_OK : RC_ERROR;
+}
@@ -0,0 +1,209 @@
+/*
+ * ReversiBook.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiBook.h
+ * @brief Declares the opening book: a builder and a memory-mapped reader.
+ *
+ * A book file is a 16-byte header (magic "RVBK", version u16, entry size u16,
+ * number of entries u64) followed by 16-byte entries (ReversiBookEntry) sorted
+ * by position key and, for the same key, by decreasing count. The reader maps
+ * the file and binary-searches the entries in place, so opening a book costs no
+ * parsing or allocation however large it is. Entries are read in host byte
+ * order; the files are little-endian like all supported targets.
+ *
+ * Positions are keyed by ReversiBook::bookKey(), the Zobrist hash of the
+ * canonical form of the board (ReversiSymmetry, including the side to move)
+ * combined with the board size. All symmetric variants of a position share one
+ * set of entries, whose moves are stored in the canonical orientation.
+ */
+
+#ifndef REVERSIBOOK_H_
+#define REVERSIBOOK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "global.h"
+#include "ReversiArchive.h"
+#include "ReversiBoard.h"
+#include "ReversiMappedFile.h"
+#include "ReversiSearch.h"
+#include "ReversiSymmetry.h"
+
+/**
+ * @brief One book move of a position, as stored in the file.
+ */
+struct ReversiBookEntry
+{
+	uint64_t key;   ///< Position key (ReversiBook::bookKey()).
+	uint16_t move;  ///< Cell index of the move on the canonical board.
+	int16_t score;  ///< Score from the view of the side to move.
+	uint32_t count; ///< Number of games (or searches) the move was seen in.
+};
+
+/**
+ * @class ReversiBook
+ * @brief Read-only opening book mapped from a file.
+ */
+class ReversiBook
+{
+private:
+	ReversiMappedFile file;           ///< The mapped book.
+	const ReversiBookEntry *pEntries; ///< Sorted entries inside the mapping.
+	size_t entries;                   ///< Number of entries.
+
+	ReversiBook(const ReversiBook&);
+	ReversiBook& operator=(const ReversiBook&);
+
+public:
+	/**
+	 * @brief Constructs an empty book.
+	 */
+	ReversiBook();
+
+	/**
+	 * @brief Returns the book key of a position.
+	 *
+	 * @param board The position; the side to move is part of the key.
+	 * @return The key (the same for all symmetric variants of the position).
+	 */
+	static uint64_t bookKey(const ReversiBoard &board)
+	{
+		ReversiSymmetry_t transform;
+		return bookKey(board, transform);
+	}
+
+	/**
+	 * @brief Returns the book key of a position and its orientation.
+	 *
+	 * @param board The position; the side to move is part of the key.
+	 * @param transform Receives the symmetry that maps the board to the
+	 *        orientation of the book moves.
+	 * @return The key (the same for all symmetric variants of the position).
+	 */
+	static uint64_t bookKey(const ReversiBoard &board,
+			ReversiSymmetry_t &transform);
+
+	/**
+	 * @brief Maps a book file.
+	 *
+	 * @param path The file name.
+	 * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be
+	 *         mapped or is not a book.
+	 */
+	RC_t bookOpen(const char *path);
+
+	/**
+	 * @brief Unmaps the book; entries returned before become invalid.
+	 */
+	void bookClose();
+
+	/**
+	 * @brief Returns the number of entries in the book.
+	 */
+	size_t bookEntries() const
+	{
+		return entries;
+	}
+
+	/**
+	 * @brief Finds all entries of a position without copying them.
+	 *
+	 * @param key The position key.
+	 * @param pFirst Receives the first entry (most frequent move first), or 0.
+	 * @return The number of entries of the position (0 if it is not in the book).
+	 */
+	size_t bookFind(uint64_t key, const ReversiBookEntry *&pFirst) const;
+
+	/**
+	 * @brief Returns the book move of a position.
+	 *
+	 * The move seen most often is chosen; among moves seen equally often the one
+	 * with the better score.
+	 *
+	 * @param board The position; the side to move is taken from boardSideToMove().
+	 * @param move Receives the cell index on board.
+	 * @param score Receives the score of the move.
+	 * @return RC_OK if the position is in the book, RC_ERROR otherwise.
+	 */
+	RC_t bookProbe(const ReversiBoard &board, unsigned int &move,
+			int &score) const;
+};
+
+/**
+ * @class ReversiBookBuilder
+ * @brief Collects book moves from game archives and searches and writes a book file.
+ */
+class ReversiBookBuilder
+{
+private:
+	/**
+	 * @brief A move seen in a position, before merging.
+	 */
+	struct Sample
+	{
+		uint64_t key;      ///< Position key.
+		unsigned int move; ///< Cell index on the canonical board.
+		int score;         ///< Score from the view of the side to move.
+	};
+
+	std::vector<Sample> samples; ///< All moves collected so far.
+
+	/**
+	 * @brief Searches a position and the positions after all its moves.
+	 */
+	void bookExpand(ReversiBoard &board, ReversiSearch &search,
+			const ReversiSearchLimits &limits, unsigned int plies);
+
+public:
+	/**
+	 * @brief Adds the first moves of every game of an archive.
+	 *
+	 * The score of a move is the final disc difference of the game from the view
+	 * of the player who made it; the book stores the average.
+	 *
+	 * @param archive The archive.
+	 * @param plies Number of plies taken from the start of every game.
+	 * @return RC_OK if the operation was successful, RC_ERROR for a damaged game.
+	 */
+	RC_t bookAddArchive(const ReversiArchiveReader &archive, unsigned int plies);
+
+	/**
+	 * @brief Searches all positions up to a number of plies from a position and
+	 *        adds the best move of each.
+	 *
+	 * @param position The position to start from.
+	 * @param plies Number of plies to expand (all moves are followed).
+	 * @param limits Budget of every search.
+	 * @param ttMegabytes Size of the transposition table of the searches.
+	 * @return RC_OK if the operation was successful.
+	 */
+	RC_t bookAddSearch(const ReversiBoard &position, unsigned int plies,
+			const ReversiSearchLimits &limits, size_t ttMegabytes);
+
+	/**
+	 * @brief Returns the number of moves collected so far.
+	 */
+	size_t bookSamples() const
+	{
+		return samples.size();
+	}
+
+	/**
+	 * @brief Merges the collected moves and writes them as a sorted book file.
+	 *
+	 * @param path The file name.
+	 * @param minCount Moves seen less often are left out.
+	 * @param entries Receives the number of entries written.
+	 * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be written.
+	 */
+	RC_t bookWrite(const char *path, unsigned int minCount, size_t &entries);
+};
+
+#endif /* REVERSIBOOK_H_ */
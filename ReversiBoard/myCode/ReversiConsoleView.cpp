@@ -11,43 +11,333 @@
  *
  * This file contains the methods that render the Reversi game board to the console.
  * It provides the `boardPrint` method to display the board state.
+ *
+ * The layout of a frame is: a header line with the row numbers, then one line per
+ * column starting with the column number, then an empty line. In the differential
+ * mode the cell of row r and column c is therefore at screen line c + 2 and
+ * screen column (digits of c) + 2 + 2 * r, and the cursor is parked at line
+ * columns + 3 after every frame, where the prompts of the game follow.
  */
 
 #include <iostream>
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <errno.h>
+#include <unistd.h>
+#endif
+
 #include "ReversiBoard.h"
 #include "ReversiConsoleView.h"
 
 using namespace std;
 
+/**
+ * @brief Appends a number in decimal without going through a stream.
+ */
+static void viewAppendNumber(string &text, unsigned int value)
+{
+	char digits[10];
+	unsigned int length = 0;
+	do
+	{
+		digits[length++] = (char) ('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	while (length > 0)
+	{
+		text += digits[--length];
+	}
+}
+
+/**
+ * @brief Appends the ANSI sequence moving the cursor to a screen position.
+ *
+ * @param line The screen line (1-based).
+ * @param column The screen column (1-based).
+ */
+static void viewAppendCursor(string &text, unsigned int line,
+		unsigned int column)
+{
+	text += "\x1b[";
+	viewAppendNumber(text, line);
+	text += ';';
+	viewAppendNumber(text, column);
+	text += 'H';
+}
+
+/**
+ * @brief Returns the number of decimal digits of a number.
+ */
+static unsigned int viewDigits(unsigned int value)
+{
+	unsigned int digits = 1;
+	while (value >= 10)
+	{
+		value /= 10;
+		digits++;
+	}
+	return digits;
+}
+
+/**
+ * @brief Constructs the view in the full mode, without frame rate cap, writing to stdout.
+ *
+ * @param rv A pointer to the ReversiBoard object containing the game state.
+ */
+ReversiConsoleView::ReversiConsoleView(const ReversiBoard *rv) :
+		rv(rv), pOut(stdout), mode(VIEW_FULL), shownRows(0), shownColumns(0),
+		minInterval(0)
+{
+}
+
 /**
  * @brief Prints the current state of the board to the console.
  *
  * This method prints the current state of the game board, showing the row and column indices
  * along with the board contents for visual representation in the console.
+ * Frames within the frame rate cap are dropped.
+ *
+ * @param rv Pointer to the ReversiBoard object containing the board state.
+ * @return RC_OK if the operation was successful, RC_ERROR if the output fails.
+ */
+RC_t ReversiConsoleView::boardPrint(const ReversiBoard *rv)
+{
+	if (minInterval.count() != 0
+			&& chrono::steady_clock::now() - lastFrame < minInterval)
+	{
+		return RC_OK;
+	}
+	return viewDraw(rv);
+}
+
+/**
+ * @brief Prints the board regardless of the frame rate cap.
  *
  * @param rv Pointer to the ReversiBoard object containing the board state.
- * @return RC_OK if the operation was successful.
+ * @return RC_OK if the operation was successful, RC_ERROR if the output fails.
+ */
+RC_t ReversiConsoleView::viewRefresh(const ReversiBoard *rv)
+{
+	return viewDraw(rv);
+}
+
+/**
+ * @brief Selects the full or the differential mode.
+ *
+ * @param mode The new mode.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for an unknown mode.
+ */
+RC_t ReversiConsoleView::viewSetMode(ReversiViewMode_t mode)
+{
+	if (mode != VIEW_FULL && mode != VIEW_DIFF)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+#ifdef _WIN32
+	if (mode == VIEW_DIFF)
+	{
+		// The Windows console interprets ANSI sequences only on request
+		HANDLE console = (HANDLE) _get_osfhandle(_fileno(pOut));
+		DWORD consoleMode;
+		if (GetConsoleMode(console, &consoleMode))
+		{
+			SetConsoleMode(console,
+					consoleMode | 0x0004 /* ENABLE_VIRTUAL_TERMINAL_PROCESSING */);
+		}
+	}
+#endif
+
+	this->mode = mode;
+	shownRows = 0;
+	shownColumns = 0;
+	return RC_OK;
+}
+
+/**
+ * @brief Limits how many frames per second boardPrint() draws.
+ *
+ * @param fps Maximum frames per second, 0 for no limit.
  */
-RC_t ReversiConsoleView::boardPrint(ReversiBoard *rv) const
+void ReversiConsoleView::viewSetFrameRate(unsigned int fps)
 {
-	cout << "  ";
+	if (fps == 0)
+	{
+		minInterval = chrono::steady_clock::duration(0);
+	}
+	else
+	{
+		minInterval = chrono::duration_cast<chrono::steady_clock::duration>(
+				chrono::duration<double>(1.0 / fps));
+	}
+}
+
+/**
+ * @brief Redirects the output.
+ *
+ * @param pFile The output stream.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for a null stream.
+ */
+RC_t ReversiConsoleView::viewSetOutput(FILE *pFile)
+{
+	if (pFile == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+	pOut = pFile;
+	shownRows = 0;
+	shownColumns = 0;
+	return RC_OK;
+}
+
+/**
+ * @brief Appends the whole board in the text format of the full mode.
+ *
+ * @param rv Pointer to the ReversiBoard object containing the board state.
+ */
+void ReversiConsoleView::viewBuildFull(const ReversiBoard *rv)
+{
+	frame += "  ";
 	for (unsigned int r = 0; r < rv->rows; r++)
 	{
-		cout << r << " ";
+		viewAppendNumber(frame, r);
+		frame += ' ';
+	}
+	frame += '\n';
+
+	for (unsigned int c = 0; c < rv->columns; c++)
+	{
+		viewAppendNumber(frame, c);
+		frame += ' ';
+		for (unsigned int r = 0; r < rv->rows; r++)
+		{
+			frame += rv->boardGet(r, c);
+			frame += ' ';
+		}
+		frame += '\n';
 	}
-	cout << endl;
+	frame += '\n';
+}
 
+/**
+ * @brief Appends the cursor movements and coins of all cells that differ from shown.
+ *
+ * @param rv Pointer to the ReversiBoard object containing the board state.
+ */
+void ReversiConsoleView::viewBuildDiff(const ReversiBoard *rv)
+{
 	for (unsigned int c = 0; c < rv->columns; c++)
 	{
-		cout << c << " ";
+		unsigned int column = viewDigits(c) + 2;
 		for (unsigned int r = 0; r < rv->rows; r++)
 		{
-			cout << rv->pBoard[rv->boardCalcIndex(r, c)] << " ";
+			char coin = rv->boardGet(r, c);
+			char &cell = shown[c * rv->rows + r];
+			if (coin != cell)
+			{
+				viewAppendCursor(frame, c + 2, column + 2 * r);
+				frame += coin;
+				cell = coin;
+			}
 		}
-		cout << endl;
 	}
-	cout << endl;
+}
 
+/**
+ * @brief Builds the frame of the current mode and writes it.
+ *
+ * @param rv Pointer to the ReversiBoard object containing the board state.
+ * @return RC_OK if the operation was successful, RC_ERROR if the output fails.
+ */
+RC_t ReversiConsoleView::viewDraw(const ReversiBoard *rv)
+{
+	unsigned int cells = rv->rows * rv->columns;
+
+	// Room for the whole board or for every cell addressed separately
+	size_t capacity = (size_t) (viewDigits(rv->rows) + 2) * (rv->rows + 1)
+			+ (size_t) (viewDigits(rv->columns) + 2 * rv->rows + 2)
+					* rv->columns + 32;
+	if (capacity < (size_t) cells * 24 + 32)
+	{
+		capacity = (size_t) cells * 24 + 32;
+	}
+	frame.clear();
+	frame.reserve(capacity);
+
+	if (mode == VIEW_FULL)
+	{
+		viewBuildFull(rv);
+	}
+	else if (shownRows != rv->rows || shownColumns != rv->columns)
+	{
+		// New screen: clear it, draw everything and remember what is shown
+		frame += "\x1b[H\x1b[2J";
+		viewBuildFull(rv);
+		shown.resize(cells);
+		for (unsigned int c = 0; c < rv->columns; c++)
+		{
+			for (unsigned int r = 0; r < rv->rows; r++)
+			{
+				shown[c * rv->rows + r] = rv->boardGet(r, c);
+			}
+		}
+		shownRows = rv->rows;
+		shownColumns = rv->columns;
+	}
+	else
+	{
+		viewBuildDiff(rv);
+
+		// Park the cursor below the board and remove the old prompts
+		viewAppendCursor(frame, rv->columns + 3, 1);
+		frame += "\x1b[J";
+	}
+
+	lastFrame = chrono::steady_clock::now();
+	return viewEmit();
+}
+
+/**
+ * @brief Writes the frame buffer to the output with one system call.
+ *
+ * Text that the program wrote through cout or stdio before is flushed first, so
+ * that the frame appears in order.
+ *
+ * @return RC_OK if the operation was successful, RC_ERROR if the output fails.
+ */
+RC_t ReversiConsoleView::viewEmit()
+{
+	cout.flush();
+	fflush(pOut);
+
+#ifdef _WIN32
+	int fd = _fileno(pOut);
+#else
+	int fd = fileno(pOut);
+#endif
+	const char *pData = frame.data();
+	size_t remaining = frame.size();
+
+	while (remaining > 0)
+	{
+#ifdef _WIN32
+		int written = _write(fd, pData, (unsigned int) remaining);
+#else
+		ssize_t written = write(fd, pData, remaining);
+		if (written < 0 && errno == EINTR)
+		{
+			continue;
+		}
+#endif
+		if (written <= 0)
+		{
+			return RC_ERROR;
+		}
+		pData += written;
+		remaining -= written;
+	}
 	return RC_OK;
 }
@@ -12,18 +12,66 @@
  * This header file declares the `ReversiConsoleView` class, which is responsible for
  * rendering the game board to the console. It provides the `boardPrint` method for displaying
  * the board state.
+ *
+ * Every frame is built in a buffer that is reused from frame to frame and written
+ * with a single system call. In the differential mode only the cells that changed
+ * since the last frame are redrawn, using ANSI cursor addressing, and an optional
+ * frame rate cap drops frames that follow each other too quickly.
  */
 
 #ifndef REVERSICONSOLEVIEW_H_
 #define REVERSICONSOLEVIEW_H_
 
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
 #include "global.h"
 #include "ReversiBoard.h"
 
+/**
+ * @enum ReversiViewMode_t
+ * @brief How boardPrint() draws a frame.
+ */
+typedef enum
+{
+	VIEW_FULL, ///< Print the whole board below the previous output.
+	VIEW_DIFF  ///< Draw the board at the top of the screen and then update changed cells only.
+} ReversiViewMode_t;
+
 class ReversiConsoleView
 {
 private:
-	ReversiBoard *rv;
+	const ReversiBoard *rv;
+	FILE *pOut;                    ///< The output stream.
+	ReversiViewMode_t mode;
+	std::string frame;             ///< Text of the current frame; keeps its capacity.
+	std::vector<char> shown;       ///< Cells on the screen in the differential mode.
+	unsigned int shownRows;        ///< Size of shown; 0 if the screen must be redrawn.
+	unsigned int shownColumns;
+	std::chrono::steady_clock::duration minInterval; ///< Minimum time between frames, 0 for none.
+	std::chrono::steady_clock::time_point lastFrame;  ///< Time of the last frame drawn.
+
+	/**
+	 * @brief Appends the whole board in the text format of the full mode.
+	 */
+	void viewBuildFull(const ReversiBoard *rv);
+
+	/**
+	 * @brief Appends the cursor movements and coins of all cells that differ from shown.
+	 */
+	void viewBuildDiff(const ReversiBoard *rv);
+
+	/**
+	 * @brief Builds the frame of the current mode and writes it.
+	 */
+	RC_t viewDraw(const ReversiBoard *rv);
+
+	/**
+	 * @brief Writes the frame buffer to the output with one system call.
+	 */
+	RC_t viewEmit();
 
 public:
 	/**
@@ -31,24 +79,58 @@ public:
 	 *
 	 * This constructor initializes the `ReversiConsoleView` object with the provided
 	 * pointer to the `ReversiBoard` object, which will be used for rendering the board.
+	 * The view starts in the full mode, without frame rate cap, writing to stdout.
 	 *
 	 * @param rv A pointer to the ReversiBoard object containing the game state.
 	 */
-	ReversiConsoleView(ReversiBoard *rv) :
-			rv(rv)
-	{
-	}
+	ReversiConsoleView(const ReversiBoard *rv);
 
 	/**
 	 * @brief Prints the current state of the board to the console.
 	 *
 	 * This method prints the current game board, including row and column numbers,
 	 * and the state of each cell (either an empty space or a player's piece).
+	 * Within the frame rate cap the frame is dropped; the differential mode catches
+	 * up with all changes at the next frame that is drawn.
 	 *
 	 * @param rv Pointer to the ReversiBoard object to be printed.
-	 * @return RC_OK if the operation was successful.
+	 * @return RC_OK if the operation was successful, RC_ERROR if the output fails.
+	 */
+	RC_t boardPrint(const ReversiBoard *rv);
+
+	/**
+	 * @brief Prints the board like boardPrint(), but regardless of the frame rate cap.
+	 *
+	 * @param rv Pointer to the ReversiBoard object to be printed.
+	 * @return RC_OK if the operation was successful, RC_ERROR if the output fails.
+	 */
+	RC_t viewRefresh(const ReversiBoard *rv);
+
+	/**
+	 * @brief Selects the full or the differential mode.
+	 *
+	 * The first frame after switching to the differential mode clears the screen
+	 * and draws the whole board. On Windows the console's ANSI processing is enabled.
+	 *
+	 * @param mode The new mode.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for an unknown mode.
+	 */
+	RC_t viewSetMode(ReversiViewMode_t mode);
+
+	/**
+	 * @brief Limits how many frames per second boardPrint() draws.
+	 *
+	 * @param fps Maximum frames per second, 0 for no limit.
+	 */
+	void viewSetFrameRate(unsigned int fps);
+
+	/**
+	 * @brief Redirects the output, e.g. to a file or the null device.
+	 *
+	 * @param pFile The output stream (stdout by default).
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for a null stream.
 	 */
-	RC_t boardPrint(ReversiBoard *rv) const;
+	RC_t viewSetOutput(FILE *pFile);
 };
 
 #endif /* REVERSICONSOLEVIEW_H_ */
@@ -0,0 +1,541 @@
+/*
+ * ReversiEndgame.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiEndgame.cpp
+ * @brief Implements the exact endgame solver.
+ *
+ * Scores are final disc differences (own discs minus opponent discs, empty cells
+ * are not counted), so every score lies within -64..64.
+ */
+
+#include <chrono>
+
+#include "ReversiEndgame.h"
+
+using namespace std;
+
+const unsigned int ReversiEndgame::NO_MOVE;
+const unsigned int ReversiEndgame::TT_EMPTIES;
+const unsigned int ReversiEndgame::FASTEST_FIRST_EMPTIES;
+
+// Lower than any disc difference
+static const int SCORE_NONE = -1000;
+
+/**
+ * @brief Shifts a word by a signed amount (positive: towards higher bits).
+ */
+static inline uint64_t shiftWord(uint64_t mask, int amount)
+{
+	if (amount >= 0)
+	{
+		return (amount < 64) ? (mask << amount) : 0;
+	}
+	return (amount > -64) ? (mask >> -amount) : 0;
+}
+
+/**
+ * @brief Transposition table key of a position given by its two disc words.
+ */
+static inline uint64_t endgameKey(uint64_t own, uint64_t opp, unsigned int cells)
+{
+	uint64_t h = own * 0x9E3779B97F4A7C15ULL
+			^ (opp + cells) * 0xC2B2AE3D27D4EB4FULL;
+	h = (h ^ (h >> 29)) * 0xBF58476D1CE4E5B9ULL;
+	return h ^ (h >> 32);
+}
+
+/**
+ * @brief Constructs a solver.
+ *
+ * @param pTT Optional transposition table (0 for none); must outlive the solver.
+ */
+ReversiEndgame::ReversiEndgame(ReversiTransTable *pTT) :
+		pTT(pTT), board(0, 0), all(0), nodes(0), cells(0)
+{
+}
+
+/**
+ * @brief Precomputes the direction, region and line tables for the board.
+ *
+ * The regions are the four quadrants of the board. A line along an axis starts
+ * at every cell whose neighbour against the axis direction is off the board.
+ */
+void ReversiEndgame::endgamePrepare()
+{
+	unsigned int rows = board.boardRows();
+	unsigned int columns = board.boardColumns();
+
+	cells = rows * columns;
+	all = board.boardCells().maskWord(0);
+
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		shift[i] = board.boardCalcShift(i);
+		landing[i] = board.boardLandingMask(i).maskWord(0);
+	}
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		unsigned int back = (i + 4) & 7;
+		neighbour[i] = shiftWord(all, shift[back]) & landing[back];
+	}
+
+	for (unsigned int r = 0; r < rows; r++)
+	{
+		for (unsigned int c = 0; c < columns; c++)
+		{
+			quadrant[r * columns + c] = ((r >= rows / 2) ? 2 : 0)
+					+ ((c >= columns / 2) ? 1 : 0);
+		}
+	}
+
+	for (unsigned int a = 0; a < 4; a++)
+	{
+		uint64_t starts = all & ~neighbour[a + 4];
+
+		lines[a].clear();
+		for (uint64_t s = starts; s; s &= s - 1)
+		{
+			uint64_t line = 0;
+			for (uint64_t x = s & -s; x; x = shiftWord(x, shift[a]) & landing[a])
+			{
+				line |= x;
+			}
+			lines[a].push_back(line);
+		}
+	}
+}
+
+/**
+ * @brief Computes a subset of the discs that can never be flipped again.
+ *
+ * A disc cannot be flipped along an axis if the line through it is full, if it
+ * touches the edge of the board in that axis, or if it touches a stable disc of
+ * its own colour in that axis. A disc meeting one of these conditions in all
+ * four axes is stable; the set is grown until it does not change any more.
+ *
+ * @param discs The discs of one player.
+ * @param filled All occupied cells.
+ * @return The stable discs found.
+ */
+uint64_t ReversiEndgame::endgameStable(uint64_t discs, uint64_t filled) const
+{
+	uint64_t safe[4];
+	uint64_t stable = 0;
+
+	for (unsigned int a = 0; a < 4; a++)
+	{
+		safe[a] = ~neighbour[a] | ~neighbour[a + 4];
+		for (unsigned int i = 0; i < lines[a].size(); i++)
+		{
+			if ((lines[a][i] & ~filled) == 0)
+			{
+				safe[a] |= lines[a][i];
+			}
+		}
+	}
+
+	for (;;)
+	{
+		uint64_t candidates = discs;
+		for (unsigned int a = 0; a < 4; a++)
+		{
+			candidates &= safe[a]
+					| (shiftWord(stable, shift[a]) & landing[a])
+					| (shiftWord(stable, shift[a + 4]) & landing[a + 4]);
+		}
+		if (candidates == stable)
+		{
+			return stable;
+		}
+		stable = candidates;
+	}
+}
+
+/**
+ * @brief Scores the last empty cell without generating moves.
+ *
+ * If the side to move cannot play the cell, the opponent may; otherwise the game
+ * ends with the cell empty.
+ */
+int ReversiEndgame::endgameLast1(uint64_t own, uint64_t opp, unsigned int cell)
+{
+	int difference = __builtin_popcountll(own) - __builtin_popcountll(opp);
+	uint64_t flips;
+
+	nodes++;
+	flips = board.flipKernel.flipKernelFlips(cell, own, opp);
+	if (flips)
+	{
+		return difference + 2 * __builtin_popcountll(flips) + 1;
+	}
+	flips = board.flipKernel.flipKernelFlips(cell, opp, own);
+	if (flips)
+	{
+		return difference - 2 * __builtin_popcountll(flips) - 1;
+	}
+	return difference;
+}
+
+/**
+ * @brief Solves 2 to 4 empty cells by trying each cell directly.
+ *
+ * @param empties The empty cells, in the order they are tried.
+ * @param count Number of empty cells (2..4).
+ */
+int ReversiEndgame::endgameShallow(uint64_t own, uint64_t opp, int alpha,
+		int beta, const unsigned int *empties, unsigned int count, bool passed)
+{
+	int best = SCORE_NONE;
+	unsigned int rest[3];
+
+	nodes++;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		unsigned int cell = empties[i];
+		uint64_t flips = board.flipKernel.flipKernelFlips(cell, own, opp);
+		int score;
+
+		if (flips == 0)
+		{
+			continue;
+		}
+
+		uint64_t newOwn = own | flips | ((uint64_t) 1 << cell);
+		uint64_t newOpp = opp & ~flips;
+
+		if (count == 2)
+		{
+			score = -endgameLast1(newOpp, newOwn, empties[1 - i]);
+		}
+		else
+		{
+			for (unsigned int j = 0, k = 0; j < count; j++)
+			{
+				if (j != i)
+				{
+					rest[k++] = empties[j];
+				}
+			}
+			score = -endgameShallow(newOpp, newOwn, -beta, -alpha, rest,
+					count - 1, false);
+		}
+
+		if (score > best)
+		{
+			best = score;
+			if (best > alpha)
+			{
+				alpha = best;
+				if (alpha >= beta)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	if (best == SCORE_NONE)
+	{
+		if (passed)
+		{
+			return __builtin_popcountll(own) - __builtin_popcountll(opp);
+		}
+		return -endgameShallow(opp, own, -beta, -alpha, empties, count, true);
+	}
+	return best;
+}
+
+/**
+ * @brief Solves a position with more than 4 empty cells.
+ *
+ * The moves are ordered by the transposition table move, then fastest-first
+ * (fewest replies for the opponent) with parity as tie-break; close to the end
+ * only by parity. The first move is searched with the full window, the others
+ * with a null window.
+ *
+ * @param own Discs of the side to move.
+ * @param opp Discs of the opponent.
+ * @param alpha Lower bound of the window.
+ * @param beta Upper bound of the window.
+ * @param count Number of empty cells.
+ * @param parity One bit per region with an odd number of empty cells.
+ * @param passed The previous ply was a pass.
+ * @param pBest Receives the best move, or 0.
+ * @return The final disc difference from the view of the side to move.
+ */
+int ReversiEndgame::endgameSearch(uint64_t own, uint64_t opp, int alpha,
+		int beta, unsigned int count, unsigned int parity, bool passed,
+		unsigned int *pBest)
+{
+	struct Move
+	{
+		unsigned int cell;
+		uint64_t flips;
+		int key;
+	} list[64];
+
+	int oppDiscs = __builtin_popcountll(opp);
+
+	nodes++;
+
+	// The opponent keeps at least its stable discs
+	if (!pBest && alpha >= (int) cells - 2 * oppDiscs)
+	{
+		int bound = (int) cells
+				- 2 * __builtin_popcountll(endgameStable(opp, own | opp));
+		if (bound <= alpha)
+		{
+			return bound;
+		}
+	}
+
+	bool useTT = pTT && count >= TT_EMPTIES;
+	uint64_t key = 0;
+	unsigned int ttMove = NO_MOVE;
+	if (useTT)
+	{
+		ReversiTTEntry entry;
+
+		key = endgameKey(own, opp, cells);
+		if (pTT->ttProbe(key, entry))
+		{
+			ttMove = entry.move;
+			if (!pBest && entry.depth == count
+					&& (entry.bound == TT_BOUND_EXACT
+							|| (entry.bound == TT_BOUND_LOWER && entry.score >= beta)
+							|| (entry.bound == TT_BOUND_UPPER
+									&& entry.score <= alpha)))
+			{
+				return entry.score;
+			}
+		}
+	}
+
+	uint64_t moves = board.boardMovesWord(own, opp);
+	if (moves == 0)
+	{
+		if (passed)
+		{
+			return __builtin_popcountll(own) - oppDiscs;
+		}
+		if (pBest)
+		{
+			*pBest = ReversiUndo::PASS;
+		}
+		return -endgameSearch(opp, own, -beta, -alpha, count, parity, true, 0);
+	}
+
+	unsigned int n = 0;
+	for (uint64_t m = moves; m; m &= m - 1)
+	{
+		unsigned int cell = __builtin_ctzll(m);
+		uint64_t flips = board.flipKernel.flipKernelFlips(cell, own, opp);
+		int odd = (parity >> quadrant[cell]) & 1;
+
+		list[n].cell = cell;
+		list[n].flips = flips;
+		if (cell == ttMove)
+		{
+			list[n].key = -1000;
+		}
+		else if (count >= FASTEST_FIRST_EMPTIES)
+		{
+			uint64_t newOwn = own | flips | ((uint64_t) 1 << cell);
+			list[n].key = 4
+					* __builtin_popcountll(
+							board.boardMovesWord(opp & ~flips, newOwn)) - 2 * odd;
+		}
+		else
+		{
+			list[n].key = 1 - odd;
+		}
+		n++;
+	}
+
+	int alphaStart = alpha;
+	int best = SCORE_NONE;
+	unsigned int bestMove = NO_MOVE;
+
+	for (unsigned int i = 0; i < n; i++)
+	{
+		// Pick the remaining move with the lowest key
+		unsigned int pick = i;
+		for (unsigned int j = i + 1; j < n; j++)
+		{
+			if (list[j].key < list[pick].key)
+			{
+				pick = j;
+			}
+		}
+		Move move = list[pick];
+		list[pick] = list[i];
+
+		uint64_t newOwn = own | move.flips | ((uint64_t) 1 << move.cell);
+		uint64_t newOpp = opp & ~move.flips;
+		unsigned int newParity = parity ^ (1u << quadrant[move.cell]);
+		int score;
+
+		if (count - 1 <= 4)
+		{
+			unsigned int empties[4];
+			unsigned int e = 0;
+			uint64_t empty = all & ~(newOwn | newOpp);
+
+			// Cells of odd regions first
+			for (uint64_t f = empty; f; f &= f - 1)
+			{
+				unsigned int cell = __builtin_ctzll(f);
+				if ((newParity >> quadrant[cell]) & 1)
+				{
+					empties[e++] = cell;
+				}
+			}
+			for (uint64_t f = empty; f; f &= f - 1)
+			{
+				unsigned int cell = __builtin_ctzll(f);
+				if (!((newParity >> quadrant[cell]) & 1))
+				{
+					empties[e++] = cell;
+				}
+			}
+
+			if (e == 0)
+			{
+				score = __builtin_popcountll(newOwn) - __builtin_popcountll(newOpp);
+			}
+			else if (e == 1)
+			{
+				score = -endgameLast1(newOpp, newOwn, empties[0]);
+			}
+			else
+			{
+				score = -endgameShallow(newOpp, newOwn, -beta, -alpha, empties, e,
+						false);
+			}
+		}
+		else if (i == 0)
+		{
+			score = -endgameSearch(newOpp, newOwn, -beta, -alpha, count - 1,
+					newParity, false, 0);
+		}
+		else
+		{
+			score = -endgameSearch(newOpp, newOwn, -alpha - 1, -alpha, count - 1,
+					newParity, false, 0);
+			if (score > alpha && score < beta)
+			{
+				score = -endgameSearch(newOpp, newOwn, -beta, -alpha, count - 1,
+						newParity, false, 0);
+			}
+		}
+
+		if (score > best)
+		{
+			best = score;
+			bestMove = move.cell;
+			if (best > alpha)
+			{
+				alpha = best;
+				if (alpha >= beta)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	if (pBest)
+	{
+		*pBest = bestMove;
+	}
+	if (useTT)
+	{
+		TTBound_t bound = TT_BOUND_EXACT;
+		if (best <= alphaStart)
+		{
+			bound = TT_BOUND_UPPER;
+		}
+		else if (best >= beta)
+		{
+			bound = TT_BOUND_LOWER;
+		}
+		pTT->ttStore(key, bestMove, best, count, bound);
+	}
+	return best;
+}
+
+/**
+ * @brief Solves a position for its side to move.
+ *
+ * In win/loss/draw mode the search runs with the window (-1, 1), which only
+ * proves the sign of the result and is considerably faster.
+ *
+ * @param position The position; the side to move is taken from boardSideToMove().
+ * @param mode Exact score or win/loss/draw only.
+ * @param result Best move and score.
+ * @return RC_OK if the position was solved, RC_ERROR_BAD_PARAM for boards
+ *         with more than 64 cells.
+ */
+RC_t ReversiEndgame::endgameSolve(const ReversiBoard &position,
+		EndgameMode_t mode, ReversiEndgameResult &result)
+{
+	if (position.boardCells().maskWords() != 1)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	if (position.boardRows() != board.boardRows()
+			|| position.boardColumns() != board.boardColumns())
+	{
+		board = position;
+		endgamePrepare();
+	}
+	else
+	{
+		board = position;
+	}
+
+	char side = board.boardSideToMove();
+	uint64_t own = board.boardDiscs(side).maskWord(0);
+	uint64_t opp = board.boardDiscs((side == 'x') ? 'o' : 'x').maskWord(0);
+	uint64_t empty = all & ~(own | opp);
+	unsigned int parity = 0;
+
+	for (uint64_t f = empty; f; f &= f - 1)
+	{
+		parity ^= 1u << quadrant[__builtin_ctzll(f)];
+	}
+
+	nodes = 0;
+	result.bestMove = NO_MOVE;
+	if (mode == ENDGAME_WLD)
+	{
+		int score = endgameSearch(own, opp, -1, 1,
+				__builtin_popcountll(empty), parity, false, &result.bestMove);
+		result.score = (score > 0) - (score < 0);
+	}
+	else
+	{
+		result.score = endgameSearch(own, opp, -65, 65,
+				__builtin_popcountll(empty), parity, false, &result.bestMove);
+	}
+
+	// A finished game has no move at all, not even a pass
+	if (result.bestMove == ReversiUndo::PASS
+			&& board.boardMovesWord(opp, own) == 0)
+	{
+		result.bestMove = NO_MOVE;
+	}
+
+	result.nodes = nodes;
+	result.seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return RC_OK;
+}
@@ -0,0 +1,159 @@
+/*
+ * ReversiEndgame.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiEndgame.h
+ * @brief Declares the exact endgame solver for boards of up to 64 cells.
+ *
+ * The solver searches the game tree to the end and returns the final disc
+ * difference under perfect play, or only win/loss/draw. It works directly on
+ * the two 64-bit disc words of the board instead of calling makeMove(), and uses
+ * several endgame specific techniques:
+ * - parity ordering: the board is split into quadrants and moves into quadrants
+ *   with an odd number of empty cells are tried first; the parity is updated with
+ *   one XOR per move,
+ * - fastest-first ordering: moves leaving the opponent the fewest replies first,
+ * - a solver for the last 4 empty cells that tries the cells directly instead
+ *   of generating a move list,
+ * - a stability cutoff: discs that can never be flipped bound the best result.
+ */
+
+#ifndef REVERSIENDGAME_H_
+#define REVERSIENDGAME_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "global.h"
+#include "ReversiBoard.h"
+#include "ReversiTransTable.h"
+
+/**
+ * @enum EndgameMode_t
+ * @brief What the solver has to prove.
+ */
+typedef enum
+{
+	ENDGAME_EXACT, ///< The exact final disc difference.
+	ENDGAME_WLD,   ///< Only win (+1), draw (0) or loss (-1).
+} EndgameMode_t;
+
+/**
+ * @brief Result of a solved endgame.
+ */
+struct ReversiEndgameResult
+{
+	unsigned int bestMove; ///< Cell index, ReversiUndo::PASS or NO_MOVE if the game is over.
+	int score;             ///< Disc difference (or -1/0/+1) from the view of the side to move.
+	uint64_t nodes;        ///< Number of positions visited.
+	double seconds;        ///< Time used by the solver.
+};
+
+/**
+ * @class ReversiEndgame
+ * @brief Exact alpha-beta solver for the last empty cells of a game.
+ *
+ * A transposition table is optional; when given, positions with at least
+ * TT_EMPTIES empty cells are stored in it.
+ */
+class ReversiEndgame
+{
+public:
+	/**
+	 * @brief Move value used when there is no move (game over).
+	 */
+	static const unsigned int NO_MOVE = ReversiTransTable::NO_MOVE;
+
+	/**
+	 * @brief Fewest empty cells for which the transposition table is used.
+	 */
+	static const unsigned int TT_EMPTIES = 7;
+
+	/**
+	 * @brief Fewest empty cells for which moves are ordered fastest-first.
+	 */
+	static const unsigned int FASTEST_FIRST_EMPTIES = 7;
+
+private:
+	ReversiTransTable *pTT;         ///< Optional transposition table, or 0.
+	ReversiBoard board;             ///< Copy of the position (board size and flip kernel).
+	uint64_t all;                   ///< All cells of the board.
+	uint64_t nodes;                 ///< Positions visited by the running solve.
+	unsigned int cells;             ///< Number of cells of the board.
+	unsigned char quadrant[64];     ///< Parity region (0..3) of every cell.
+	uint64_t neighbour[8];          ///< Cells whose neighbour in a direction is on the board.
+	uint64_t landing[8];            ///< Cells a step in a direction may land on.
+	int shift[8];                   ///< Bit shift of a step in a direction.
+	std::vector<uint64_t> lines[4]; ///< All lines of the board along the 4 axes.
+
+	/**
+	 * @brief Precomputes the direction, region and line tables for the board.
+	 */
+	void endgamePrepare();
+
+	/**
+	 * @brief Computes a subset of the discs that can never be flipped again.
+	 *
+	 * @param discs The discs of one player.
+	 * @param filled All occupied cells.
+	 * @return The stable discs found.
+	 */
+	uint64_t endgameStable(uint64_t discs, uint64_t filled) const;
+
+	/**
+	 * @brief Scores the last empty cell without generating moves.
+	 */
+	int endgameLast1(uint64_t own, uint64_t opp, unsigned int cell);
+
+	/**
+	 * @brief Solves 2 to 4 empty cells by trying each cell directly.
+	 *
+	 * @param empties The empty cells, in the order they are tried.
+	 * @param count Number of empty cells (2..4).
+	 */
+	int endgameShallow(uint64_t own, uint64_t opp, int alpha, int beta,
+			const unsigned int *empties, unsigned int count, bool passed);
+
+	/**
+	 * @brief Solves a position with more than 4 empty cells.
+	 *
+	 * @param own Discs of the side to move.
+	 * @param opp Discs of the opponent.
+	 * @param alpha Lower bound of the window.
+	 * @param beta Upper bound of the window.
+	 * @param count Number of empty cells.
+	 * @param parity One bit per region with an odd number of empty cells.
+	 * @param passed The previous ply was a pass.
+	 * @param pBest Receives the best move, or 0.
+	 * @return The final disc difference from the view of the side to move.
+	 */
+	int endgameSearch(uint64_t own, uint64_t opp, int alpha, int beta,
+			unsigned int count, unsigned int parity, bool passed,
+			unsigned int *pBest);
+
+public:
+	/**
+	 * @brief Constructs a solver.
+	 *
+	 * @param pTT Optional transposition table (0 for none); must outlive the solver.
+	 */
+	explicit ReversiEndgame(ReversiTransTable *pTT = 0);
+
+	/**
+	 * @brief Solves a position for its side to move.
+	 *
+	 * @param position The position; the side to move is taken from boardSideToMove().
+	 * @param mode Exact score or win/loss/draw only.
+	 * @param result Best move and score.
+	 * @return RC_OK if the position was solved, RC_ERROR_BAD_PARAM for boards
+	 *         with more than 64 cells.
+	 */
+	RC_t endgameSolve(const ReversiBoard &position, EndgameMode_t mode,
+			ReversiEndgameResult &result);
+};
+
+#endif /* REVERSIENDGAME_H_ */
@@ -0,0 +1,464 @@
+/*
+ * ReversiFixedBoard.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiFixedBoard.h
+ * @brief Declares and implements the board with a compile-time size.
+ *
+ * All cells of ReversiFixedBoard<Rows, Columns> fit into one machine word
+ * (uint64_t up to 64 cells, unsigned __int128 up to 128 cells). Shift amounts and
+ * edge masks of the 8 directions are compile-time constants, and the direction
+ * loops have a constant trip count, so the compiler can unroll and fold them.
+ * The same bit layout as ReversiBoard is used: bit row * Columns + column.
+ */
+
+#ifndef REVERSIFIXEDBOARD_H_
+#define REVERSIFIXEDBOARD_H_
+
+#include <stdint.h>
+#include <type_traits>
+
+#include "ReversiRules.h"
+#include "ReversiUndo.h"
+#include "ReversiZobrist.h"
+
+/**
+ * @class ReversiFixedBoard
+ * @brief Rules on a Rows x Columns board held in single words.
+ *
+ * @tparam Rows The number of rows (at least 2).
+ * @tparam Columns The number of columns (at least 2).
+ */
+template<unsigned int Rows, unsigned int Columns>
+class ReversiFixedBoard final : public ReversiRules
+{
+public:
+	/**
+	 * @brief Number of cells of the board.
+	 */
+	static constexpr unsigned int CELLS = Rows * Columns;
+
+#ifdef __SIZEOF_INT128__
+	static_assert(Rows >= 2 && Columns >= 2 && CELLS <= 128,
+			"ReversiFixedBoard supports 2x2 up to 128 cells");
+
+	/**
+	 * @brief Word holding one bit per cell.
+	 */
+	typedef typename std::conditional<(CELLS <= 64), uint64_t,
+			unsigned __int128>::type Word;
+#else
+	static_assert(Rows >= 2 && Columns >= 2 && CELLS <= 64,
+			"ReversiFixedBoard supports 2x2 up to 64 cells on this compiler");
+
+	/**
+	 * @brief Word holding one bit per cell.
+	 */
+	typedef uint64_t Word;
+#endif
+
+private:
+	/**
+	 * @brief A move or pass on the undo stack.
+	 */
+	struct Undo
+	{
+		Word flips;         ///< Flipped discs.
+		unsigned int index; ///< Cell of the move, or ReversiUndo::PASS.
+		unsigned int side;  ///< Player who moved (0 'x', 1 'o').
+		uint64_t hash;      ///< Hash before the move.
+	};
+
+	static constexpr unsigned int WORD_BITS = sizeof(Word) * 8;
+
+	// Longest run of opponent discs between a move and a bracketing disc
+	static constexpr unsigned int RUN = ((Rows > Columns) ? Rows : Columns) - 2;
+
+	Word discs[2];             ///< Discs of 'x' (0) and 'o' (1).
+	unsigned int side;         ///< Player to move (0 'x', 1 'o').
+	uint64_t hash;             ///< Zobrist hash of the position.
+	Undo undo[2 * CELLS + 2];  ///< Moves and passes for rulesUnmakeMove().
+	unsigned int undoSize;     ///< Number of records on the undo stack.
+
+	static constexpr Word bit(unsigned int index)
+	{
+		return (Word) 1 << index;
+	}
+
+	/**
+	 * @brief Returns all cells of the board.
+	 */
+	static constexpr Word allCells()
+	{
+		return (CELLS == WORD_BITS) ? ~(Word) 0 : (((Word) 1 << (CELLS % WORD_BITS)) - 1);
+	}
+
+	/**
+	 * @brief Returns all cells of one column.
+	 */
+	static constexpr Word columnCells(unsigned int column)
+	{
+		Word mask = 0;
+		for (unsigned int row = 0; row < Rows; row++)
+		{
+			mask |= bit(row * Columns + column);
+		}
+		return mask;
+	}
+
+	static constexpr Word ALL = allCells();
+	static constexpr Word NOT_FIRST = allCells() & ~columnCells(0);
+	static constexpr Word NOT_LAST = allCells() & ~columnCells(Columns - 1);
+
+	/**
+	 * @brief Moves all bits one step in direction Direction.
+	 *
+	 * Directions 0..3 shift towards higher bit indices (east, south-west, south,
+	 * south-east), 4..7 are their opposites. Bits leaving the board or wrapping
+	 * around a row end are dropped.
+	 */
+	template<unsigned int Direction>
+	static Word shift(Word x)
+	{
+		switch (Direction)
+		{
+		case 0:
+			return (x << 1) & NOT_FIRST;
+		case 1:
+			return (x << (Columns - 1)) & NOT_LAST;
+		case 2:
+			return (x << Columns) & ALL;
+		case 3:
+			return (x << (Columns + 1)) & NOT_FIRST;
+		case 4:
+			return (x >> 1) & NOT_LAST;
+		case 5:
+			return (x >> (Columns - 1)) & NOT_FIRST;
+		case 6:
+			return x >> Columns;
+		default:
+			return (x >> (Columns + 1)) & NOT_LAST;
+		}
+	}
+
+	/**
+	 * @brief Legal moves along one direction.
+	 */
+	template<unsigned int Direction>
+	static Word movesDirection(Word own, Word opp, Word empty)
+	{
+		Word run = shift<Direction>(own) & opp;
+		for (unsigned int i = 1; i < RUN; i++)
+		{
+			run |= shift<Direction>(run) & opp;
+		}
+		return shift<Direction>(run) & empty;
+	}
+
+	/**
+	 * @brief Discs flipped along one direction by a coin on move.
+	 */
+	template<unsigned int Direction>
+	static Word flipsDirection(Word move, Word own, Word opp)
+	{
+		Word flips = 0;
+		Word x = shift<Direction>(move) & opp;
+
+		for (unsigned int i = 0; i < RUN && x; i++)
+		{
+			flips |= x;
+			x = shift<Direction>(x);
+			if (x & own)
+			{
+				return flips;
+			}
+			x &= opp;
+		}
+		return 0;
+	}
+
+	static unsigned int count(Word x)
+	{
+#ifdef __SIZEOF_INT128__
+		if (WORD_BITS > 64)
+		{
+			return __builtin_popcountll((uint64_t) x)
+					+ __builtin_popcountll((uint64_t) (x >> (WORD_BITS / 2)));
+		}
+#endif
+		return __builtin_popcountll((uint64_t) x);
+	}
+
+	static unsigned int lowest(Word x)
+	{
+#ifdef __SIZEOF_INT128__
+		if (WORD_BITS > 64 && (uint64_t) x == 0)
+		{
+			return 64 + __builtin_ctzll((uint64_t) (x >> (WORD_BITS / 2)));
+		}
+#endif
+		return __builtin_ctzll((uint64_t) x);
+	}
+
+	/**
+	 * @brief Recursive part of rulesPerft(), on words passed by value.
+	 */
+	static uint64_t perft(Word own, Word opp, unsigned int depth, bool passed)
+	{
+		if (depth == 0)
+		{
+			return 1;
+		}
+
+		Word moves = boardMoves(own, opp);
+		if (!moves)
+		{
+			// Two passes in a row end the game
+			return passed ? 1 : perft(opp, own, depth - 1, true);
+		}
+
+		uint64_t nodes = 0;
+		do
+		{
+			unsigned int index = lowest(moves);
+			Word flips = boardFlips(index, own, opp);
+			nodes += perft(opp & ~flips, own | flips | bit(index), depth - 1,
+					false);
+			moves &= moves - 1;
+		} while (moves);
+		return nodes;
+	}
+
+public:
+	/**
+	 * @brief Constructs a board in the initial position.
+	 */
+	ReversiFixedBoard()
+	{
+		rulesInitialState();
+	}
+
+	/**
+	 * @brief Computes the legal moves of the player owning own.
+	 *
+	 * @param own Discs of the player to move.
+	 * @param opp Discs of the opponent.
+	 * @return One bit per legal cell.
+	 */
+	static Word boardMoves(Word own, Word opp)
+	{
+		Word empty = ALL & ~(own | opp);
+		return movesDirection<0>(own, opp, empty)
+				| movesDirection<1>(own, opp, empty)
+				| movesDirection<2>(own, opp, empty)
+				| movesDirection<3>(own, opp, empty)
+				| movesDirection<4>(own, opp, empty)
+				| movesDirection<5>(own, opp, empty)
+				| movesDirection<6>(own, opp, empty)
+				| movesDirection<7>(own, opp, empty);
+	}
+
+	/**
+	 * @brief Computes the discs flipped by placing a coin on an empty cell.
+	 *
+	 * @param index The cell index.
+	 * @param own Discs of the moving player.
+	 * @param opp Discs of the opponent.
+	 * @return The flipped discs (empty if the move is illegal).
+	 */
+	static Word boardFlips(unsigned int index, Word own, Word opp)
+	{
+		Word move = bit(index);
+		return flipsDirection<0>(move, own, opp)
+				| flipsDirection<1>(move, own, opp)
+				| flipsDirection<2>(move, own, opp)
+				| flipsDirection<3>(move, own, opp)
+				| flipsDirection<4>(move, own, opp)
+				| flipsDirection<5>(move, own, opp)
+				| flipsDirection<6>(move, own, opp)
+				| flipsDirection<7>(move, own, opp);
+	}
+
+	/**
+	 * @brief Returns the discs of a player ('x' or 'o').
+	 */
+	Word boardDiscs(char coin) const
+	{
+		return discs[(coin == 'x') ? 0 : 1];
+	}
+
+	unsigned int rulesRows() const override
+	{
+		return Rows;
+	}
+
+	unsigned int rulesColumns() const override
+	{
+		return Columns;
+	}
+
+	bool rulesSpecialized() const override
+	{
+		return true;
+	}
+
+	void rulesInitialState() override
+	{
+		unsigned int top = Rows / 2 - 1;
+		unsigned int left = Columns / 2 - 1;
+
+		discs[0] = bit(top * Columns + left) | bit((top + 1) * Columns + left + 1);
+		discs[1] = bit((top + 1) * Columns + left) | bit(top * Columns + left + 1);
+		side = 0;
+		undoSize = 0;
+		hash = 0;
+		for (unsigned int c = 0; c < 2; c++)
+		{
+			for (Word x = discs[c]; x; x &= x - 1)
+			{
+				hash ^= ReversiZobrist::zobristCell(lowest(x), c ? 'o' : 'x');
+			}
+		}
+	}
+
+	char rulesGet(unsigned int row, unsigned int column) const override
+	{
+		if (row >= Rows || column >= Columns)
+		{
+			return '.';
+		}
+		Word cell = bit(row * Columns + column);
+		return (discs[0] & cell) ? 'x' : ((discs[1] & cell) ? 'o' : '.');
+	}
+
+	char rulesSideToMove() const override
+	{
+		return side ? 'o' : 'x';
+	}
+
+	void rulesMoves(char coin, ReversiMask &moves) const override
+	{
+		unsigned int c = (coin == 'x') ? 0 : 1;
+		Word legal = boardMoves(discs[c], discs[c ^ 1]);
+
+		if (moves.maskBits() != CELLS)
+		{
+			moves.maskResize(CELLS);
+		}
+		moves.maskSetWord(0, (uint64_t) legal);
+		if (CELLS > 64)
+		{
+			moves.maskSetWord(1, (uint64_t) (legal >> (WORD_BITS / 2)));
+		}
+	}
+
+	bool rulesMakeMove(unsigned int index, char coin) override
+	{
+		unsigned int c = (coin == 'x') ? 0 : 1;
+
+		if (index >= CELLS || ((discs[0] | discs[1]) & bit(index))
+				|| undoSize == sizeof(undo) / sizeof(undo[0]))
+		{
+			return false;
+		}
+		Word flips = boardFlips(index, discs[c], discs[c ^ 1]);
+		if (!flips)
+		{
+			return false;
+		}
+
+		Undo &record = undo[undoSize++];
+		record.flips = flips;
+		record.index = index;
+		record.side = side;
+		record.hash = hash;
+
+		discs[c] |= flips | bit(index);
+		discs[c ^ 1] &= ~flips;
+		hash ^= ReversiZobrist::zobristCell(index, coin);
+		for (Word x = flips; x; x &= x - 1)
+		{
+			hash ^= ReversiZobrist::zobristFlip(lowest(x));
+		}
+		if ((c ^ 1) != side)
+		{
+			hash ^= ReversiZobrist::zobristSide();
+		}
+		side = c ^ 1;
+		return true;
+	}
+
+	bool rulesMakePass(char coin) override
+	{
+		unsigned int c = (coin == 'x') ? 0 : 1;
+
+		if (undoSize == sizeof(undo) / sizeof(undo[0]))
+		{
+			return false;
+		}
+
+		Undo &record = undo[undoSize++];
+		record.flips = 0;
+		record.index = ReversiUndo::PASS;
+		record.side = side;
+		record.hash = hash;
+
+		if ((c ^ 1) != side)
+		{
+			hash ^= ReversiZobrist::zobristSide();
+		}
+		side = c ^ 1;
+		return true;
+	}
+
+	RC_t rulesUnmakeMove() override
+	{
+		if (undoSize == 0)
+		{
+			return RC_ERROR;
+		}
+
+		const Undo &record = undo[--undoSize];
+		if (record.index != ReversiUndo::PASS)
+		{
+			// The mover's discs are the ones that include the placed coin
+			unsigned int c = (discs[0] & bit(record.index)) ? 0 : 1;
+			discs[c] &= ~(record.flips | bit(record.index));
+			discs[c ^ 1] |= record.flips;
+		}
+		side = record.side;
+		hash = record.hash;
+		return RC_OK;
+	}
+
+	unsigned int rulesCount(char coin) const override
+	{
+		return count(discs[(coin == 'x') ? 0 : 1]);
+	}
+
+	uint64_t rulesHash() const override
+	{
+		return hash;
+	}
+
+	uint64_t rulesPerft(unsigned int depth) override
+	{
+		return perft(discs[side], discs[side ^ 1], depth, false);
+	}
+};
+
+template<unsigned int Rows, unsigned int Columns>
+constexpr typename ReversiFixedBoard<Rows, Columns>::Word ReversiFixedBoard<Rows,
+		Columns>::ALL;
+template<unsigned int Rows, unsigned int Columns>
+constexpr typename ReversiFixedBoard<Rows, Columns>::Word ReversiFixedBoard<Rows,
+		Columns>::NOT_FIRST;
+template<unsigned int Rows, unsigned int Columns>
+constexpr typename ReversiFixedBoard<Rows, Columns>::Word ReversiFixedBoard<Rows,
+		Columns>::NOT_LAST;
+
+#endif /* REVERSIFIXEDBOARD_H_ */
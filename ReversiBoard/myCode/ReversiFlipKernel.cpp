@@ -0,0 +1,240 @@
+/*
+ * ReversiFlipKernel.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiFlipKernel.cpp
+ * @brief Implements the scalar and the AVX2 flip kernel and the runtime dispatch.
+ *
+ * Both implementations use the same tables and must return identical masks. The
+ * AVX2 code is compiled with a function-level target attribute, so the project
+ * itself does not need to be built with -mavx2.
+ */
+
+// 64-bit x86 only: the kernel moves 64-bit lanes to general registers
+#if defined(__x86_64__)
+#define REVERSI_FLIP_X86
+#include <immintrin.h>
+#endif
+
+#include "ReversiFlipKernel.h"
+
+using namespace std;
+
+// Direction (row, column) offsets in lane order: 4 towards higher, 4 towards lower bit indices.
+static const int laneRowOffsets[8] =
+{ 1, 1, 1, 0, -1, -1, -1, 0 };
+static const int laneColumnOffsets[8] =
+{ -1, 0, 1, 1, 1, 0, -1, -1 };
+
+atomic<ReversiFlipKernel::FlipFunction> ReversiFlipKernel::pFlip(
+		&ReversiFlipKernel::flipResolve);
+
+/**
+ * @brief Precomputes the direction tables for a board with up to 64 cells.
+ *
+ * @param rows The number of rows on the board.
+ * @param columns The number of columns on the board.
+ */
+ReversiFlipKernel::ReversiFlipKernel(unsigned int rows, unsigned int columns)
+{
+	uint64_t cells = (uint64_t) rows * columns;
+	uint64_t all = (cells >= 64) ? ~(uint64_t) 0 : ((uint64_t) 1 << cells) - 1;
+	uint64_t firstColumn = 0;
+	uint64_t lastColumn = 0;
+
+	for (unsigned int r = 0; columns > 0 && r < rows && r * columns < 64; r++)
+	{
+		firstColumn |= (uint64_t) 1 << (r * columns);
+		lastColumn |= (uint64_t) 1 << (r * columns + columns - 1);
+	}
+
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		int shift = laneRowOffsets[i] * (int) columns + laneColumnOffsets[i];
+		amount[i] = (shift < 0) ? -shift : shift;
+
+		// A step to the right must not land in column 0, a step to the left not in the last column
+		if (laneColumnOffsets[i] > 0)
+		{
+			landing[i] = all & ~firstColumn;
+		}
+		else if (laneColumnOffsets[i] < 0)
+		{
+			landing[i] = all & ~lastColumn;
+		}
+		else
+		{
+			landing[i] = all;
+		}
+	}
+
+	unsigned int longest = (rows > columns) ? rows : columns;
+	rounds = 0;
+	for (unsigned int step = 1; step + 1 < longest; step <<= 1)
+	{
+		rounds++;
+	}
+}
+
+/**
+ * @brief Selects the implementation on first use and forwards the call.
+ */
+uint64_t ReversiFlipKernel::flipResolve(const ReversiFlipKernel &kernel,
+		unsigned int index, uint64_t own, uint64_t opp)
+{
+	flipKernelUseSimd(true);
+	return pFlip.load(memory_order_relaxed)(kernel, index, own, opp);
+}
+
+/**
+ * @brief Scalar implementation walking each direction with single-bit shifts.
+ *
+ * This is the reference the vectorized implementation is validated against.
+ */
+uint64_t ReversiFlipKernel::flipScalar(const ReversiFlipKernel &kernel,
+		unsigned int index, uint64_t own, uint64_t opp)
+{
+	uint64_t move = (uint64_t) 1 << index;
+	uint64_t flips = 0;
+
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		uint64_t landing = kernel.landing[i];
+		uint64_t shift = kernel.amount[i];
+		uint64_t ray = 0;
+		uint64_t current;
+
+		if (shift >= 64)
+		{
+			continue;
+		}
+
+		current = ((i < 4) ? (move << shift) : (move >> shift)) & landing;
+		while (current & opp)
+		{
+			ray |= current;
+			current = ((i < 4) ? (current << shift) : (current >> shift))
+					& landing;
+		}
+
+		if (current & own)
+		{
+			flips |= ray;
+		}
+	}
+
+	return flips;
+}
+
+#ifdef REVERSI_FLIP_X86
+
+/**
+ * @brief AVX2 implementation processing 4 directions per vector.
+ *
+ * Each lane runs a Kogge-Stone fill from the move through the opponent discs,
+ * doubling the shift distance every round. The lanes whose run ends on one of the
+ * player's own discs contribute their run to the result.
+ */
+__attribute__((target("avx2")))
+uint64_t ReversiFlipKernel::flipAvx2(const ReversiFlipKernel &kernel,
+		unsigned int index, uint64_t own, uint64_t opp)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i move = _mm256_set1_epi64x((long long) ((uint64_t) 1 << index));
+	const __m256i vOwn = _mm256_set1_epi64x((long long) own);
+	const __m256i vOpp = _mm256_set1_epi64x(
+			(long long) (opp & ~((uint64_t) 1 << index)));
+
+	const __m256i shiftUp = _mm256_loadu_si256(
+			(const __m256i*) &kernel.amount[0]);
+	const __m256i shiftDown = _mm256_loadu_si256(
+			(const __m256i*) &kernel.amount[4]);
+	const __m256i landingUp = _mm256_loadu_si256(
+			(const __m256i*) &kernel.landing[0]);
+	const __m256i landingDown = _mm256_loadu_si256(
+			(const __m256i*) &kernel.landing[4]);
+
+	__m256i genUp = move;
+	__m256i genDown = move;
+	__m256i proUp = _mm256_and_si256(vOpp, landingUp);
+	__m256i proDown = _mm256_and_si256(vOpp, landingDown);
+	__m256i stepUp = shiftUp;
+	__m256i stepDown = shiftDown;
+
+	for (unsigned int r = 0; r < kernel.rounds; r++)
+	{
+		genUp = _mm256_or_si256(genUp,
+				_mm256_and_si256(proUp, _mm256_sllv_epi64(genUp, stepUp)));
+		genDown = _mm256_or_si256(genDown,
+				_mm256_and_si256(proDown, _mm256_srlv_epi64(genDown, stepDown)));
+		proUp = _mm256_and_si256(proUp, _mm256_sllv_epi64(proUp, stepUp));
+		proDown = _mm256_and_si256(proDown,
+				_mm256_srlv_epi64(proDown, stepDown));
+		stepUp = _mm256_add_epi64(stepUp, stepUp);
+		stepDown = _mm256_add_epi64(stepDown, stepDown);
+	}
+
+	// The run of opponent discs next to the move, and the cell just beyond it
+	__m256i runUp = _mm256_and_si256(genUp, vOpp);
+	__m256i runDown = _mm256_and_si256(genDown, vOpp);
+	__m256i endUp = _mm256_and_si256(_mm256_sllv_epi64(runUp, shiftUp),
+			_mm256_and_si256(vOwn, landingUp));
+	__m256i endDown = _mm256_and_si256(_mm256_srlv_epi64(runDown, shiftDown),
+			_mm256_and_si256(vOwn, landingDown));
+
+	// Keep only the runs that are bracketed by an own disc
+	__m256i flips = _mm256_or_si256(
+			_mm256_andnot_si256(_mm256_cmpeq_epi64(endUp, zero), runUp),
+			_mm256_andnot_si256(_mm256_cmpeq_epi64(endDown, zero), runDown));
+
+	__m128i half = _mm_or_si128(_mm256_castsi256_si128(flips),
+			_mm256_extracti128_si256(flips, 1));
+	half = _mm_or_si128(half, _mm_unpackhi_epi64(half, half));
+
+	return (uint64_t) _mm_cvtsi128_si64(half);
+}
+
+#else
+
+/**
+ * @brief Builds other than x86-64 have no vector implementation; use the scalar code.
+ */
+uint64_t ReversiFlipKernel::flipAvx2(const ReversiFlipKernel &kernel,
+		unsigned int index, uint64_t own, uint64_t opp)
+{
+	return flipScalar(kernel, index, own, opp);
+}
+
+#endif
+
+/**
+ * @brief Checks whether the CPU supports the AVX2 implementation.
+ */
+bool ReversiFlipKernel::flipKernelHasAvx2()
+{
+#ifdef REVERSI_FLIP_X86
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief Enables or disables the vectorized implementation.
+ *
+ * @param enable true to use AVX2 when available, false to force the scalar code.
+ * @return true if the vectorized implementation is active afterwards.
+ */
+bool ReversiFlipKernel::flipKernelUseSimd(bool enable)
+{
+	bool simd = enable && flipKernelHasAvx2();
+
+	pFlip.store(simd ? &ReversiFlipKernel::flipAvx2 :
+						&ReversiFlipKernel::flipScalar, memory_order_relaxed);
+	return simd;
+}
@@ -0,0 +1,145 @@
+/*
+ * ReversiFlipKernel.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiFlipKernel.h
+ * @brief Declares the flip kernel used to apply moves on boards of up to 64 cells.
+ *
+ * The kernel computes the discs flipped by a move in all 8 directions at once.
+ * On CPUs with AVX2 the 8 directions are processed as two vectors of 4 lanes; on
+ * all other CPUs a scalar implementation with identical results is used. The
+ * implementation is chosen once at runtime.
+ */
+
+#ifndef REVERSIFLIPKERNEL_H_
+#define REVERSIFLIPKERNEL_H_
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @class ReversiFlipKernel
+ * @brief Precomputed direction tables and the dispatched flip implementation.
+ *
+ * Directions are stored in lane order: lanes 0..3 shift towards higher bit
+ * indices, lanes 4..7 towards lower bit indices.
+ */
+class ReversiFlipKernel
+{
+public:
+	/**
+	 * @brief Signature shared by the scalar and the vectorized implementation.
+	 */
+	typedef uint64_t (*FlipFunction)(const ReversiFlipKernel &kernel,
+			unsigned int index, uint64_t own, uint64_t opp);
+
+private:
+	uint64_t amount[8];  ///< Absolute shift per lane.
+	uint64_t landing[8]; ///< Cells a step in the lane's direction may land on.
+	unsigned int rounds; ///< Number of doubling rounds covering the longest ray.
+
+	static std::atomic<FlipFunction> pFlip;
+
+	/**
+	 * @brief Selects the implementation on first use and forwards the call.
+	 */
+	static uint64_t flipResolve(const ReversiFlipKernel &kernel,
+			unsigned int index, uint64_t own, uint64_t opp);
+
+	/**
+	 * @brief Scalar implementation walking each direction with single-bit shifts.
+	 */
+	static uint64_t flipScalar(const ReversiFlipKernel &kernel,
+			unsigned int index, uint64_t own, uint64_t opp);
+
+	/**
+	 * @brief AVX2 implementation processing 4 directions per vector.
+	 */
+	static uint64_t flipAvx2(const ReversiFlipKernel &kernel,
+			unsigned int index, uint64_t own, uint64_t opp);
+
+public:
+	/**
+	 * @brief Precomputes the direction tables for a board with up to 64 cells.
+	 *
+	 * @param rows The number of rows on the board.
+	 * @param columns The number of columns on the board.
+	 */
+	ReversiFlipKernel(unsigned int rows, unsigned int columns);
+
+	/**
+	 * @brief Computes the opponent discs flipped by placing a coin.
+	 *
+	 * The cell itself is not checked; the caller makes sure it is empty. A move
+	 * without any bracketed disc returns an empty mask.
+	 *
+	 * @param index Bit index of the cell the coin is placed on.
+	 * @param own Discs of the moving player.
+	 * @param opp Discs of the opponent.
+	 * @return The mask of flipped discs.
+	 */
+	uint64_t flipKernelFlips(unsigned int index, uint64_t own,
+			uint64_t opp) const
+	{
+		return pFlip.load(std::memory_order_relaxed)(*this, index, own, opp);
+	}
+
+	/**
+	 * @brief Computes the flips with the scalar implementation, regardless of dispatch.
+	 *
+	 * @param index Bit index of the cell the coin is placed on.
+	 * @param own Discs of the moving player.
+	 * @param opp Discs of the opponent.
+	 * @return The mask of flipped discs.
+	 */
+	uint64_t flipKernelFlipsScalar(unsigned int index, uint64_t own,
+			uint64_t opp) const
+	{
+		return flipScalar(*this, index, own, opp);
+	}
+
+	/**
+	 * @brief Returns the shift distance of a direction (lanes 0..3 shift up, 4..7 down).
+	 */
+	uint64_t flipKernelAmount(unsigned int lane) const
+	{
+		return amount[lane];
+	}
+
+	/**
+	 * @brief Returns the cells a step in a direction may land on.
+	 */
+	uint64_t flipKernelLanding(unsigned int lane) const
+	{
+		return landing[lane];
+	}
+
+	/**
+	 * @brief Returns the number of doubling rounds covering the longest ray.
+	 */
+	unsigned int flipKernelRounds() const
+	{
+		return rounds;
+	}
+
+	/**
+	 * @brief Checks whether the CPU supports the AVX2 implementation.
+	 */
+	static bool flipKernelHasAvx2();
+
+	/**
+	 * @brief Enables or disables the vectorized implementation.
+	 *
+	 * Used to compare both implementations; enabling has no effect on CPUs without AVX2.
+	 *
+	 * @param enable true to use AVX2 when available, false to force the scalar code.
+	 * @return true if the vectorized implementation is active afterwards.
+	 */
+	static bool flipKernelUseSimd(bool enable);
+};
+
+#endif /* REVERSIFLIPKERNEL_H_ */
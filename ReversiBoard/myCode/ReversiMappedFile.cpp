@@ -0,0 +1,122 @@
+/*
+ * ReversiMappedFile.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiMappedFile.cpp
+ * @brief Implements the read-only file mapping for POSIX systems and Windows.
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ReversiMappedFile.h"
+
+using namespace std;
+
+/**
+ * @brief Constructs an object without a mapping.
+ */
+ReversiMappedFile::ReversiMappedFile() :
+		pData(0), size(0), pHandle(0)
+{
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+ReversiMappedFile::~ReversiMappedFile()
+{
+	mapClose();
+}
+
+/**
+ * @brief Maps a file.
+ *
+ * @param path The file name.
+ * @return RC_OK if the operation was successful, RC_ERROR if the file cannot
+ *         be opened or mapped (empty files cannot be mapped).
+ */
+RC_t ReversiMappedFile::mapOpen(const char *path)
+{
+	mapClose();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return RC_ERROR;
+	}
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(file, &length) || length.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return RC_ERROR;
+	}
+	HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+	CloseHandle(file);
+	if (!mapping)
+	{
+		return RC_ERROR;
+	}
+	pData = (const unsigned char*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!pData)
+	{
+		CloseHandle(mapping);
+		return RC_ERROR;
+	}
+	pHandle = mapping;
+	size = (size_t) length.QuadPart;
+#else
+	int file = open(path, O_RDONLY);
+	if (file < 0)
+	{
+		return RC_ERROR;
+	}
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0)
+	{
+		close(file);
+		return RC_ERROR;
+	}
+	void *p = mmap(0, info.st_size, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (p == MAP_FAILED)
+	{
+		return RC_ERROR;
+	}
+	pData = (const unsigned char*) p;
+	size = info.st_size;
+#endif
+
+	return RC_OK;
+}
+
+/**
+ * @brief Unmaps the file; pointers into the mapping become invalid.
+ */
+void ReversiMappedFile::mapClose()
+{
+	if (pData)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(pData);
+		CloseHandle((HANDLE) pHandle);
+#else
+		munmap((void*) pData, size);
+#endif
+	}
+	pData = 0;
+	pHandle = 0;
+	size = 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * ReversiMappedFile.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiMappedFile.h
+ * @brief Declares a read-only memory mapping of a whole file.
+ *
+ * Used by the game archive and the opening book, which read their data in place
+ * instead of loading and parsing it. The mapping uses mmap() on POSIX systems
+ * and a file mapping object on Windows.
+ */
+
+#ifndef REVERSIMAPPEDFILE_H_
+#define REVERSIMAPPEDFILE_H_
+
+#include <stddef.h>
+
+#include "global.h"
+
+/**
+ * @class ReversiMappedFile
+ * @brief Maps a file read-only into memory until it is closed.
+ */
+class ReversiMappedFile
+{
+private:
+	const unsigned char *pData; ///< Start of the mapping, or 0.
+	size_t size;                ///< Length of the file.
+	void *pHandle;              ///< Platform specific mapping handle.
+
+	ReversiMappedFile(const ReversiMappedFile&);
+	ReversiMappedFile& operator=(const ReversiMappedFile&);
+
+public:
+	/**
+	 * @brief Constructs an object without a mapping.
+	 */
+	ReversiMappedFile();
+
+	/**
+	 * @brief Unmaps the file.
+	 */
+	~ReversiMappedFile();
+
+	/**
+	 * @brief Maps a file.
+	 *
+	 * @param path The file name.
+	 * @return RC_OK if the operation was successful, RC_ERROR if the file cannot
+	 *         be opened or mapped (empty files cannot be mapped).
+	 */
+	RC_t mapOpen(const char *path);
+
+	/**
+	 * @brief Unmaps the file; pointers into the mapping become invalid.
+	 */
+	void mapClose();
+
+	/**
+	 * @brief Returns the start of the mapping, or 0 if no file is mapped.
+	 */
+	const unsigned char* mapData() const
+	{
+		return pData;
+	}
+
+	/**
+	 * @brief Returns the length of the mapped file.
+	 */
+	size_t mapSize() const
+	{
+		return size;
+	}
+};
+
+#endif /* REVERSIMAPPEDFILE_H_ */
@@ -0,0 +1,367 @@
+/*
+ * ReversiMask.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiMask.cpp
+ * @brief Implements the multi-word bit mask used by the board.
+ */
+
+#include "ReversiMask.h"
+
+/**
+ * @brief Points pWords to the inline storage or to a new heap block.
+ *
+ * @param bits The new length of the mask in bits.
+ */
+void ReversiMask::maskAllocate(unsigned int bits)
+{
+	this->bits = bits;
+	words = (bits + 63) / 64;
+
+	if (words <= INLINE_WORDS)
+	{
+		pWords = inlineWords;
+	}
+	else
+	{
+		pWords = new uint64_t[words];
+	}
+}
+
+/**
+ * @brief Releases the heap block, if any.
+ */
+void ReversiMask::maskRelease()
+{
+	if (pWords != inlineWords)
+	{
+		delete[] pWords;
+	}
+	pWords = inlineWords;
+}
+
+/**
+ * @brief Clears the unused high bits of the last word.
+ */
+void ReversiMask::maskTrim()
+{
+	if (bits & 63)
+	{
+		pWords[words - 1] &= ((uint64_t) 1 << (bits & 63)) - 1;
+	}
+}
+
+/**
+ * @brief Constructs an empty mask of zero length.
+ */
+ReversiMask::ReversiMask() :
+		bits(0), words(0), pWords(inlineWords)
+{
+}
+
+/**
+ * @brief Constructs a mask of the given length with all bits cleared.
+ *
+ * @param bits The length of the mask in bits.
+ */
+ReversiMask::ReversiMask(unsigned int bits)
+{
+	maskAllocate(bits);
+	maskClear();
+}
+
+/**
+ * @brief Copy constructor, copies length and contents.
+ */
+ReversiMask::ReversiMask(const ReversiMask &other)
+{
+	maskAllocate(other.bits);
+	for (unsigned int i = 0; i < words; i++)
+	{
+		pWords[i] = other.pWords[i];
+	}
+}
+
+/**
+ * @brief Move constructor, takes over the heap block of the other mask.
+ */
+ReversiMask::ReversiMask(ReversiMask &&other) noexcept :
+		bits(other.bits), words(other.words), pWords(inlineWords)
+{
+	if (other.pWords != other.inlineWords)
+	{
+		pWords = other.pWords;
+		other.pWords = other.inlineWords;
+	}
+	else
+	{
+		for (unsigned int i = 0; i < words; i++)
+		{
+			inlineWords[i] = other.inlineWords[i];
+		}
+	}
+	other.bits = 0;
+	other.words = 0;
+}
+
+/**
+ * @brief Copy assignment; reuses the existing storage if the length matches.
+ */
+ReversiMask& ReversiMask::operator=(const ReversiMask &other)
+{
+	if (this != &other)
+	{
+		if (words != other.words)
+		{
+			maskRelease();
+			maskAllocate(other.bits);
+		}
+		bits = other.bits;
+		for (unsigned int i = 0; i < words; i++)
+		{
+			pWords[i] = other.pWords[i];
+		}
+	}
+	return *this;
+}
+
+/**
+ * @brief Move assignment, takes over the heap block of the other mask.
+ */
+ReversiMask& ReversiMask::operator=(ReversiMask &&other)
+{
+	if (this != &other)
+	{
+		if (other.pWords != other.inlineWords)
+		{
+			maskRelease();
+			bits = other.bits;
+			words = other.words;
+			pWords = other.pWords;
+			other.pWords = other.inlineWords;
+			other.bits = 0;
+			other.words = 0;
+		}
+		else
+		{
+			*this = static_cast<const ReversiMask&>(other);
+		}
+	}
+	return *this;
+}
+
+/**
+ * @brief Frees the heap block of masks longer than INLINE_WORDS words.
+ */
+ReversiMask::~ReversiMask()
+{
+	maskRelease();
+}
+
+/**
+ * @brief Changes the length of the mask and clears all bits.
+ *
+ * @param bits The new length in bits.
+ */
+void ReversiMask::maskResize(unsigned int bits)
+{
+	if ((bits + 63) / 64 != words)
+	{
+		maskRelease();
+		maskAllocate(bits);
+	}
+	this->bits = bits;
+	maskClear();
+}
+
+/**
+ * @brief Clears all bits.
+ */
+void ReversiMask::maskClear()
+{
+	for (unsigned int i = 0; i < words; i++)
+	{
+		pWords[i] = 0;
+	}
+}
+
+/**
+ * @brief Sets all bits within the mask length.
+ */
+void ReversiMask::maskFill()
+{
+	for (unsigned int i = 0; i < words; i++)
+	{
+		pWords[i] = ~(uint64_t) 0;
+	}
+	maskTrim();
+}
+
+/**
+ * @brief Checks whether at least one bit is set.
+ */
+bool ReversiMask::maskAny() const
+{
+	for (unsigned int i = 0; i < words; i++)
+	{
+		if (pWords[i])
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Returns the number of set bits.
+ */
+unsigned int ReversiMask::maskCount() const
+{
+	unsigned int count = 0;
+	for (unsigned int i = 0; i < words; i++)
+	{
+		count += __builtin_popcountll(pWords[i]);
+	}
+	return count;
+}
+
+/**
+ * @brief Finds the lowest set bit at or above a start position.
+ *
+ * @param bit In: first bit to look at. Out: index of the set bit found.
+ * @return true if a set bit was found, false otherwise.
+ */
+bool ReversiMask::maskNext(unsigned int &bit) const
+{
+	if (bit >= bits)
+	{
+		return false;
+	}
+
+	unsigned int i = bit >> 6;
+	uint64_t w = pWords[i] & (~(uint64_t) 0 << (bit & 63));
+
+	while (w == 0)
+	{
+		if (++i >= words)
+		{
+			return false;
+		}
+		w = pWords[i];
+	}
+
+	bit = (i << 6) + __builtin_ctzll(w);
+	return true;
+}
+
+/**
+ * @brief Shifts all bits towards higher (positive amount) or lower (negative
+ * amount) indices. Bits shifted beyond either end are lost.
+ *
+ * @param amount Signed number of bit positions.
+ */
+void ReversiMask::maskShift(int amount)
+{
+	if (amount > 0)
+	{
+		unsigned int q = amount / 64;
+		unsigned int r = amount % 64;
+
+		// Walk downwards so that every source word is read before it is overwritten
+		for (unsigned int i = words; i-- > 0;)
+		{
+			uint64_t w = 0;
+			if (i >= q)
+			{
+				w = pWords[i - q] << r;
+				if (r && i >= q + 1)
+				{
+					w |= pWords[i - q - 1] >> (64 - r);
+				}
+			}
+			pWords[i] = w;
+		}
+		maskTrim();
+	}
+	else if (amount < 0)
+	{
+		unsigned int q = (-amount) / 64;
+		unsigned int r = (-amount) % 64;
+
+		for (unsigned int i = 0; i < words; i++)
+		{
+			uint64_t w = 0;
+			if (i + q < words)
+			{
+				w = pWords[i + q] >> r;
+				if (r && i + q + 1 < words)
+				{
+					w |= pWords[i + q + 1] << (64 - r);
+				}
+			}
+			pWords[i] = w;
+		}
+	}
+}
+
+/**
+ * @brief Clears all bits that are set in the other mask (this &= ~other).
+ */
+ReversiMask& ReversiMask::maskAndNot(const ReversiMask &other)
+{
+	for (unsigned int i = 0; i < words; i++)
+	{
+		pWords[i] &= ~other.pWords[i];
+	}
+	return *this;
+}
+
+ReversiMask& ReversiMask::operator&=(const ReversiMask &other)
+{
+	for (unsigned int i = 0; i < words; i++)
+	{
+		pWords[i] &= other.pWords[i];
+	}
+	return *this;
+}
+
+ReversiMask& ReversiMask::operator|=(const ReversiMask &other)
+{
+	for (unsigned int i = 0; i < words; i++)
+	{
+		pWords[i] |= other.pWords[i];
+	}
+	return *this;
+}
+
+ReversiMask& ReversiMask::operator^=(const ReversiMask &other)
+{
+	for (unsigned int i = 0; i < words; i++)
+	{
+		pWords[i] ^= other.pWords[i];
+	}
+	return *this;
+}
+
+/**
+ * @brief Compares length and contents of two masks.
+ */
+bool ReversiMask::operator==(const ReversiMask &other) const
+{
+	if (bits != other.bits)
+	{
+		return false;
+	}
+	for (unsigned int i = 0; i < words; i++)
+	{
+		if (pWords[i] != other.pWords[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
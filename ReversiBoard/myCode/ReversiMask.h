@@ -0,0 +1,234 @@
+/*
+ * ReversiMask.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiMask.h
+ * @brief Declares the multi-word bit mask used as the board representation.
+ *
+ * A `ReversiMask` holds one bit per board cell, using the same row-major cell
+ * numbering as `ReversiBoard::boardCalcIndex`. Boards with up to 64 cells fit into
+ * a single 64-bit word; larger boards use several words. Masks of up to
+ * `INLINE_WORDS` words are stored inside the object, so the common board sizes
+ * never touch the heap.
+ */
+
+#ifndef REVERSIMASK_H_
+#define REVERSIMASK_H_
+
+#include <stdint.h>
+
+/**
+ * @class ReversiMask
+ * @brief A fixed-length set of bits with word-wise logical and shift operations.
+ *
+ * All binary operations expect both operands to have the same length. Bits beyond
+ * the mask length are always kept at zero.
+ */
+class ReversiMask
+{
+public:
+	/**
+	 * @brief Number of 64-bit words stored inside the object (256 cells, e.g. 16x16).
+	 */
+	static const unsigned int INLINE_WORDS = 4;
+
+private:
+	unsigned int bits;
+	unsigned int words;
+	uint64_t *pWords;
+	uint64_t inlineWords[INLINE_WORDS];
+
+	/**
+	 * @brief Points pWords to the inline storage or to a new heap block.
+	 *
+	 * @param bits The new length of the mask in bits.
+	 */
+	void maskAllocate(unsigned int bits);
+
+	/**
+	 * @brief Releases the heap block, if any.
+	 */
+	void maskRelease();
+
+	/**
+	 * @brief Clears the unused high bits of the last word.
+	 */
+	void maskTrim();
+
+public:
+	/**
+	 * @brief Constructs an empty mask of zero length.
+	 */
+	ReversiMask();
+
+	/**
+	 * @brief Constructs a mask of the given length with all bits cleared.
+	 *
+	 * @param bits The length of the mask in bits.
+	 */
+	explicit ReversiMask(unsigned int bits);
+
+	/**
+	 * @brief Copy constructor, copies length and contents.
+	 */
+	ReversiMask(const ReversiMask &other);
+
+	/**
+	 * @brief Move constructor, takes over the heap block of the other mask.
+	 */
+	ReversiMask(ReversiMask &&other) noexcept;
+
+	/**
+	 * @brief Copy assignment; reuses the existing storage if the length matches.
+	 */
+	ReversiMask& operator=(const ReversiMask &other);
+
+	/**
+	 * @brief Move assignment, takes over the heap block of the other mask.
+	 */
+	ReversiMask& operator=(ReversiMask &&other);
+
+	/**
+	 * @brief Frees the heap block of masks longer than INLINE_WORDS words.
+	 */
+	~ReversiMask();
+
+	/**
+	 * @brief Returns the length of the mask in bits.
+	 */
+	unsigned int maskBits() const
+	{
+		return bits;
+	}
+
+	/**
+	 * @brief Returns the number of 64-bit words used by the mask.
+	 */
+	unsigned int maskWords() const
+	{
+		return words;
+	}
+
+	/**
+	 * @brief Returns the word at the given position (bit 0 is the LSB of word 0).
+	 *
+	 * @param word Index of the word.
+	 */
+	uint64_t maskWord(unsigned int word) const
+	{
+		return pWords[word];
+	}
+
+	/**
+	 * @brief Overwrites the word at the given position.
+	 *
+	 * The caller is responsible for keeping bits beyond the mask length at zero.
+	 *
+	 * @param word Index of the word.
+	 * @param value The new value.
+	 */
+	void maskSetWord(unsigned int word, uint64_t value)
+	{
+		pWords[word] = value;
+	}
+
+	/**
+	 * @brief Checks whether a single bit is set.
+	 *
+	 * @param bit Index of the bit (must be smaller than maskBits()).
+	 */
+	bool maskTest(unsigned int bit) const
+	{
+		return (pWords[bit >> 6] >> (bit & 63)) & 1;
+	}
+
+	/**
+	 * @brief Sets a single bit.
+	 *
+	 * @param bit Index of the bit (must be smaller than maskBits()).
+	 */
+	void maskSet(unsigned int bit)
+	{
+		pWords[bit >> 6] |= (uint64_t) 1 << (bit & 63);
+	}
+
+	/**
+	 * @brief Clears a single bit.
+	 *
+	 * @param bit Index of the bit (must be smaller than maskBits()).
+	 */
+	void maskReset(unsigned int bit)
+	{
+		pWords[bit >> 6] &= ~((uint64_t) 1 << (bit & 63));
+	}
+
+	/**
+	 * @brief Changes the length of the mask and clears all bits.
+	 *
+	 * @param bits The new length in bits.
+	 */
+	void maskResize(unsigned int bits);
+
+	/**
+	 * @brief Clears all bits.
+	 */
+	void maskClear();
+
+	/**
+	 * @brief Sets all bits within the mask length.
+	 */
+	void maskFill();
+
+	/**
+	 * @brief Checks whether at least one bit is set.
+	 */
+	bool maskAny() const;
+
+	/**
+	 * @brief Returns the number of set bits.
+	 */
+	unsigned int maskCount() const;
+
+	/**
+	 * @brief Finds the lowest set bit at or above a start position.
+	 *
+	 * Iterating over all set bits: `for (b = 0; m.maskNext(b); b++)`.
+	 *
+	 * @param bit In: first bit to look at. Out: index of the set bit found.
+	 * @return true if a set bit was found, false otherwise.
+	 */
+	bool maskNext(unsigned int &bit) const;
+
+	/**
+	 * @brief Shifts all bits towards higher (positive amount) or lower (negative
+	 * amount) indices. Bits shifted beyond either end are lost.
+	 *
+	 * @param amount Signed number of bit positions.
+	 */
+	void maskShift(int amount);
+
+	/**
+	 * @brief Clears all bits that are set in the other mask (this &= ~other).
+	 */
+	ReversiMask& maskAndNot(const ReversiMask &other);
+
+	ReversiMask& operator&=(const ReversiMask &other);
+	ReversiMask& operator|=(const ReversiMask &other);
+	ReversiMask& operator^=(const ReversiMask &other);
+
+	/**
+	 * @brief Compares length and contents of two masks.
+	 */
+	bool operator==(const ReversiMask &other) const;
+
+	bool operator!=(const ReversiMask &other) const
+	{
+		return !(*this == other);
+	}
+};
+
+#endif /* REVERSIMASK_H_ */
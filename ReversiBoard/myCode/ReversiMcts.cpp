@@ -0,0 +1,539 @@
+/*
+ * ReversiMcts.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiMcts.cpp
+ * @brief Implements the parallel Monte Carlo tree search (MCTS) engine.
+ */
+
+#include <cmath>
+#include <thread>
+
+#include "ReversiMcts.h"
+
+using namespace std;
+
+// Playouts claimed from the budget at a time; the time is checked once per batch
+static const uint64_t PLAYOUT_BATCH = 16;
+
+/// Node states: no children yet, children being added, children complete.
+enum
+{
+	NODE_EMPTY, NODE_EXPANDING, NODE_EXPANDED
+};
+
+/**
+ * @brief A node of the search tree, reached by one move.
+ *
+ * Scores are kept in half points (win 2, draw 1, loss 0) from the view of the
+ * player who made the move. The children of a node are consecutive in the arena.
+ */
+struct ReversiMcts::Node
+{
+	atomic<uint32_t> visits;     ///< Playouts through the node plus virtual losses in flight.
+	atomic<uint32_t> score;      ///< Half points of the finished playouts.
+	atomic<uint32_t> state;      ///< NODE_EMPTY, NODE_EXPANDING or NODE_EXPANDED.
+	uint32_t firstChild;         ///< Arena index of the first child, valid once EXPANDED.
+	uint32_t children;           ///< Number of children (0 when the game is over).
+	unsigned int move;           ///< Cell index of the move or ReversiUndo::PASS.
+	float prior;                 ///< PUCT prior of the move.
+
+	/**
+	 * @brief Prepares a node handed out by the arena.
+	 */
+	void nodeInit(unsigned int move, float prior)
+	{
+		visits.store(0, memory_order_relaxed);
+		score.store(0, memory_order_relaxed);
+		state.store(NODE_EMPTY, memory_order_relaxed);
+		firstChild = 0;
+		children = 0;
+		this->move = move;
+		this->prior = prior;
+	}
+};
+
+/**
+ * @brief Returns the next number of a splitmix64 generator.
+ */
+static inline uint64_t mctsNext(uint64_t &state)
+{
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/**
+ * @brief Constructs an engine and allocates its node arena.
+ *
+ * @param config The settings of the engine.
+ */
+ReversiMcts::ReversiMcts(const ReversiMctsConfig &config) :
+		config(config), used(0), full(false), stopRequest(false), tickets(0), runSeed(
+				0), pRoot(0)
+{
+	if (this->config.maxNodes < 2)
+	{
+		this->config.maxNodes = 2;
+	}
+	if (this->config.virtualLoss == 0)
+	{
+		this->config.virtualLoss = 1;
+	}
+	arena.reset(new Node[this->config.maxNodes]);
+}
+
+ReversiMcts::~ReversiMcts()
+{
+}
+
+/**
+ * @brief Picks one of the moves of a mask, uniformly at random.
+ *
+ * The high half of the random number is scaled to the count, and the chosen
+ * move is found by counting the bits of whole words, without looking at the
+ * single cells.
+ *
+ * @param moves The legal moves.
+ * @param count Number of moves in the mask (not 0).
+ * @param random A random number.
+ * @return The cell index of the chosen move.
+ */
+unsigned int ReversiMcts::mctsRandomMove(const ReversiMask &moves,
+		unsigned int count, uint64_t random)
+{
+	unsigned int pick = (unsigned int) (((random >> 32) * count) >> 32);
+
+	for (unsigned int word = 0; word < moves.maskWords(); word++)
+	{
+		uint64_t bits = moves.maskWord(word);
+		unsigned int inWord = __builtin_popcountll(bits);
+
+		if (pick < inWord)
+		{
+			while (pick--)
+			{
+				bits &= bits - 1;
+			}
+			return word * 64 + __builtin_ctzll(bits);
+		}
+		pick -= inWord;
+	}
+	return 0;
+}
+
+/**
+ * @brief Returns the static prior of a move for PUCT.
+ *
+ * Corners cannot be flipped and edges are hard to flip, while the cells next to
+ * a corner often give it away; the weights hold for any board size.
+ */
+float ReversiMcts::mctsPrior(unsigned int row, unsigned int column,
+		unsigned int rows, unsigned int columns)
+{
+	bool rowEdge = (row == 0 || row == rows - 1);
+	bool columnEdge = (column == 0 || column == columns - 1);
+	bool rowNear = (row <= 1 || row + 2 >= rows);
+	bool columnNear = (column <= 1 || column + 2 >= columns);
+
+	if (rowEdge && columnEdge)
+	{
+		return 4.0f;
+	}
+	if (rowNear && columnNear)
+	{
+		return 0.25f;
+	}
+	if (rowEdge || columnEdge)
+	{
+		return 2.0f;
+	}
+	return 1.0f;
+}
+
+/**
+ * @brief Adds the children of a node for the position on the board.
+ *
+ * A player without a legal move gets a single pass child; a finished game gets
+ * no children. The children are published by the release store of the state.
+ *
+ * @param node The node, set to EXPANDING by the caller.
+ * @param board The position of the node.
+ * @return True if the node was expanded, false if the arena is full.
+ */
+bool ReversiMcts::mctsExpand(Node &node, ReversiBoard &board)
+{
+	char side = board.boardSideToMove();
+	unsigned int count = board.boardMobility(side);
+
+	if (count == 0 && board.boardGameOver())
+	{
+		node.children = 0;
+		node.state.store(NODE_EXPANDED, memory_order_release);
+		return true;
+	}
+
+	unsigned int needed = (count == 0) ? 1 : count;
+	uint32_t first = used.fetch_add(needed, memory_order_relaxed);
+	if (first + (uint64_t) needed > config.maxNodes)
+	{
+		full.store(true, memory_order_relaxed);
+		node.state.store(NODE_EMPTY, memory_order_release);
+		return false;
+	}
+
+	if (count == 0)
+	{
+		arena[first].nodeInit(ReversiUndo::PASS, 1.0f);
+	}
+	else
+	{
+		const ReversiMask &moves = board.boardMoves(side);
+		unsigned int columns = board.boardColumns();
+		float total = 0;
+		uint32_t child = first;
+
+		for (unsigned int index = 0; moves.maskNext(index); index++)
+		{
+			float prior = mctsPrior(index / columns, index % columns,
+					board.boardRows(), columns);
+			arena[child++].nodeInit(index, prior);
+			total += prior;
+		}
+		for (child = first; child < first + count; child++)
+		{
+			arena[child].prior /= total;
+		}
+	}
+
+	node.firstChild = first;
+	node.children = needed;
+	node.state.store(NODE_EXPANDED, memory_order_release);
+	return true;
+}
+
+/**
+ * @brief Returns the child of an expanded node with the best UCT / PUCT value.
+ *
+ * Virtual losses count as visits without score, which lowers the value of the
+ * paths other threads are working on. Unvisited children come first under UCT;
+ * under PUCT they are valued like their parent.
+ */
+uint32_t ReversiMcts::mctsSelect(const Node &node) const
+{
+	uint32_t parentVisits = node.visits.load(memory_order_relaxed);
+	uint32_t parentScore = node.score.load(memory_order_relaxed);
+	double logVisits = log((double) parentVisits + 1);
+	double sqrtVisits = sqrt((double) parentVisits);
+	// The parent's score is from the other player's view
+	double parentValue =
+			(parentVisits > 0) ? 1 - parentScore / (2.0 * parentVisits) : 0.5;
+	uint32_t best = node.firstChild;
+	double bestValue = -1;
+
+	for (uint32_t i = node.firstChild; i < node.firstChild + node.children; i++)
+	{
+		const Node &child = arena[i];
+		uint32_t visits = child.visits.load(memory_order_relaxed);
+		double value;
+
+		if (config.puct)
+		{
+			double q = (visits > 0) ?
+					child.score.load(memory_order_relaxed) / (2.0 * visits) :
+					parentValue;
+			value = q + config.exploration * child.prior * sqrtVisits / (1 + visits);
+		}
+		else if (visits == 0)
+		{
+			return i;
+		}
+		else
+		{
+			value = child.score.load(memory_order_relaxed) / (2.0 * visits)
+					+ config.exploration * sqrt(logVisits / visits);
+		}
+
+		if (value > bestValue)
+		{
+			bestValue = value;
+			best = i;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Plays random moves until the game is over.
+ *
+ * Only the moves of the side to move are generated (the opponent's only when
+ * it has to pass), which is half the work of keeping both move sets of the
+ * board up to date. The moves are played with makeMove() on the undo stack.
+ *
+ * @param board The position; the moves are left on its undo stack.
+ * @param moves Scratch mask of the size of the board.
+ * @param random State of the random number generator.
+ * @param plies Incremented for every move and pass played.
+ */
+void ReversiMcts::mctsPlayout(ReversiBoard &board, ReversiMask &moves,
+		uint64_t &random, unsigned int &plies)
+{
+	for (;;)
+	{
+		char side = board.boardSideToMove();
+
+		board.generateMoves(side, moves);
+		unsigned int count = moves.maskCount();
+		if (count == 0)
+		{
+			board.generateMoves((side == 'x') ? 'o' : 'x', moves);
+			if (moves.maskCount() == 0)
+			{
+				return;
+			}
+			board.makePass(side);
+		}
+		else
+		{
+			board.makeMove(mctsRandomMove(moves, count, mctsNext(random)), side);
+		}
+		plies++;
+	}
+}
+
+/**
+ * @brief Body of a search thread: runs iterations until the budget is used up.
+ *
+ * One iteration descends from the root to a leaf, expands the leaf if it has
+ * been reached before, plays one random game from there and adds the result to
+ * all nodes on the path. Board copy, move mask and path buffers are set up once, so the
+ * iterations do not allocate memory.
+ *
+ * @param thread Number of the thread (0 is the calling thread).
+ * @param playouts Receives the playouts of this thread.
+ */
+void ReversiMcts::mctsWorker(unsigned int thread, uint64_t &playouts)
+{
+	ReversiBoard board(*pRoot);
+	ReversiMask moves(board.boardCells().maskBits());
+	vector<uint32_t> path;
+	vector<char> movers;
+	uint64_t random = runSeed + 0x9E3779B97F4A7C15ULL * (thread + 1);
+	uint64_t count = 0;
+	uint64_t allowed = 0;
+	uint32_t virtualLoss = config.virtualLoss;
+
+	path.reserve(2 * board.boardCells().maskBits() + 4);
+	movers.reserve(path.capacity());
+
+	for (;;)
+	{
+		if (allowed == 0)
+		{
+			if (stopRequest.load(memory_order_relaxed))
+			{
+				break;
+			}
+			if (limits.maxTime != 0
+					&& chrono::steady_clock::now() - start
+							>= chrono::milliseconds(limits.maxTime))
+			{
+				stopRequest.store(true, memory_order_relaxed);
+				break;
+			}
+
+			uint64_t ticket = tickets.fetch_add(PLAYOUT_BATCH,
+					memory_order_relaxed);
+			allowed = PLAYOUT_BATCH;
+			if (limits.maxPlayouts != 0)
+			{
+				if (ticket >= limits.maxPlayouts)
+				{
+					stopRequest.store(true, memory_order_relaxed);
+					break;
+				}
+				if (limits.maxPlayouts - ticket < allowed)
+				{
+					allowed = limits.maxPlayouts - ticket;
+				}
+			}
+		}
+		allowed--;
+
+		// Selection and expansion
+		unsigned int plies = 0;
+		uint32_t index = 0;
+
+		path.clear();
+		movers.clear();
+		movers.push_back((board.boardSideToMove() == 'x') ? 'o' : 'x');
+		for (;;)
+		{
+			Node &node = arena[index];
+			uint32_t before = node.visits.fetch_add(virtualLoss,
+					memory_order_relaxed);
+			uint32_t state = node.state.load(memory_order_acquire);
+
+			path.push_back(index);
+			if (state == NODE_EMPTY && before > 0
+					&& !full.load(memory_order_relaxed))
+			{
+				uint32_t expected = NODE_EMPTY;
+				if (node.state.compare_exchange_strong(expected, NODE_EXPANDING,
+						memory_order_acquire) && mctsExpand(node, board))
+				{
+					state = NODE_EXPANDED;
+				}
+			}
+			if (state != NODE_EXPANDED || node.children == 0)
+			{
+				break;
+			}
+
+			index = mctsSelect(node);
+			char side = board.boardSideToMove();
+			movers.push_back(side);
+			if (arena[index].move == ReversiUndo::PASS)
+			{
+				board.makePass(side);
+			}
+			else
+			{
+				board.makeMove(arena[index].move, side);
+			}
+			plies++;
+		}
+
+		// Simulation
+		mctsPlayout(board, moves, random, plies);
+		unsigned int discsX = board.boardCount('x');
+		unsigned int discsO = board.boardCount('o');
+		char winner = (discsX > discsO) ? 'x' : ((discsO > discsX) ? 'o' : '.');
+		while (plies--)
+		{
+			board.unmakeMove();
+		}
+
+		// Backpropagation: replace the virtual loss by the result
+		for (unsigned int i = 0; i < path.size(); i++)
+		{
+			Node &node = arena[path[i]];
+			node.visits.fetch_sub(virtualLoss - 1, memory_order_relaxed);
+			node.score.fetch_add(
+					(winner == '.') ? 1 : ((winner == movers[i]) ? 2 : 0),
+					memory_order_relaxed);
+		}
+		count++;
+	}
+
+	playouts = count;
+}
+
+/**
+ * @brief Searches a position with all threads.
+ *
+ * The root is expanded on the calling thread before the helpers start, so every
+ * thread finds its children in place.
+ *
+ * @param position The position; the side to move is taken from boardSideToMove().
+ * @param limits Playout and time budget.
+ * @param result Best move, its win rate and the playout statistics.
+ * @return RC_OK if the search ran, RC_ERROR_BAD_PARAM for a board without cells,
+ *         without a budget or with more moves than the arena holds.
+ */
+RC_t ReversiMcts::mctsRun(const ReversiBoard &position,
+		const ReversiMctsLimits &limits, ReversiMctsResult &result)
+{
+	if (position.boardCells().maskBits() == 0
+			|| (limits.maxPlayouts == 0 && limits.maxTime == 0))
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiBoard board(position);
+	Node &root = arena[0];
+
+	this->limits = limits;
+	pRoot = &position;
+	runSeed = config.seed;
+	start = chrono::steady_clock::now();
+	used.store(1, memory_order_relaxed);
+	full.store(false, memory_order_relaxed);
+	stopRequest.store(false, memory_order_relaxed);
+	tickets.store(0, memory_order_relaxed);
+	root.nodeInit(ReversiUndo::PASS, 1.0f);
+	root.state.store(NODE_EXPANDING, memory_order_relaxed);
+	if (!mctsExpand(root, board))
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	unsigned int threads = config.threads;
+	if (threads == 0)
+	{
+		threads = thread::hardware_concurrency();
+	}
+	if (threads == 0)
+	{
+		threads = 1;
+	}
+
+	vector<uint64_t> playouts(threads, 0);
+	vector<thread> workers;
+	if (root.children > 0)
+	{
+		for (unsigned int i = 1; i < threads; i++)
+		{
+			workers.push_back(
+					thread(&ReversiMcts::mctsWorker, this, i, ref(playouts[i])));
+		}
+		mctsWorker(0, playouts[0]);
+		for (unsigned int i = 0; i < workers.size(); i++)
+		{
+			workers[i].join();
+		}
+	}
+
+	result.bestMove = NO_MOVE;
+	result.winRate = 0;
+	result.visits = 0;
+	result.playouts = 0;
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		result.playouts += playouts[i];
+	}
+	for (uint32_t i = root.firstChild; i < root.firstChild + root.children; i++)
+	{
+		uint32_t visits = arena[i].visits.load(memory_order_relaxed);
+		if (result.bestMove == NO_MOVE || visits > result.visits)
+		{
+			result.bestMove = arena[i].move;
+			result.visits = visits;
+			result.winRate =
+					(visits > 0) ?
+							arena[i].score.load(memory_order_relaxed)
+									/ (2.0 * visits) :
+							0;
+		}
+	}
+	result.nodes = min(used.load(memory_order_relaxed), config.maxNodes);
+	result.seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	result.playoutsPerSecond =
+			(result.seconds > 0) ? result.playouts / result.seconds : 0;
+	pRoot = 0;
+	return RC_OK;
+}
+
+/**
+ * @brief Asks a running search to stop as soon as possible. Thread safe.
+ */
+void ReversiMcts::mctsStop()
+{
+	stopRequest.store(true, memory_order_relaxed);
+}
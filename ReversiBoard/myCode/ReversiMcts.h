@@ -0,0 +1,204 @@
+/*
+ * ReversiMcts.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiMcts.h
+ * @brief Declares the parallel Monte Carlo tree search (MCTS) engine.
+ *
+ * The engine is an alternative to the alpha-beta search that needs no evaluation
+ * function: it plays random games (playouts) from the leaves of a search tree and
+ * grows the tree towards the moves that win most often. Children are selected by
+ * UCT, or by PUCT with static priors that favour corners and edges.
+ *
+ * All threads work on the same tree (tree parallelism). The nodes live in one
+ * arena allocated with the engine; visit and score counters are atomic, and a
+ * thread descending through a node adds a virtual loss to it, so the other
+ * threads prefer different paths until the playout result is in. Every thread
+ * plays on its own board copy and takes its moves back with unmakeMove(), so the
+ * playout loop does not allocate memory.
+ */
+
+#ifndef REVERSIMCTS_H_
+#define REVERSIMCTS_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include "global.h"
+#include "ReversiBoard.h"
+#include "ReversiTransTable.h"
+
+/**
+ * @brief Settings of an MCTS engine.
+ */
+struct ReversiMctsConfig
+{
+	unsigned int threads;     ///< Number of threads including the calling one (0: one per core).
+	uint32_t maxNodes;        ///< Capacity of the node arena; the tree stops growing when it is full.
+	double exploration;       ///< Weight of the exploration term of UCT / PUCT.
+	bool puct;                ///< Select by PUCT with static priors instead of UCT.
+	unsigned int virtualLoss; ///< Losses added to a node while a thread is below it.
+	uint64_t seed;            ///< Seed of the random number generators of the threads.
+
+	ReversiMctsConfig() :
+			threads(1), maxNodes(1 << 20), exploration(1.0), puct(false), virtualLoss(
+					3), seed(1)
+	{
+	}
+};
+
+/**
+ * @brief Budget of an MCTS run. A value of 0 means "no limit"; one is required.
+ */
+struct ReversiMctsLimits
+{
+	uint64_t maxPlayouts; ///< Number of playouts after which the search stops.
+	unsigned int maxTime; ///< Time in milliseconds after which the search stops.
+
+	ReversiMctsLimits() :
+			maxPlayouts(0), maxTime(0)
+	{
+	}
+};
+
+/**
+ * @brief Result of an MCTS run.
+ */
+struct ReversiMctsResult
+{
+	unsigned int bestMove;    ///< Most visited move: cell index, ReversiUndo::PASS or NO_MOVE.
+	double winRate;           ///< Share of the playouts through bestMove won by the side to move (draws count half).
+	uint64_t visits;          ///< Playouts through bestMove.
+	uint64_t playouts;        ///< Playouts of the whole run.
+	uint64_t nodes;           ///< Nodes in the tree.
+	double seconds;           ///< Time used by the run.
+	double playoutsPerSecond; ///< Playouts of all threads per second.
+};
+
+/**
+ * @class ReversiMcts
+ * @brief Monte Carlo tree search with UCT/PUCT selection, shared by several threads.
+ *
+ * One run uses the whole arena; the tree is rebuilt for every run. Threads are
+ * started per run, the calling thread being one of them.
+ */
+class ReversiMcts
+{
+public:
+	/**
+	 * @brief Move value used when there is no move (game over).
+	 */
+	static const unsigned int NO_MOVE = ReversiTransTable::NO_MOVE;
+
+private:
+	struct Node;
+
+	ReversiMctsConfig config;
+	std::unique_ptr<Node[]> arena;    ///< All nodes; node 0 is the root.
+	std::atomic<uint32_t> used;       ///< Nodes handed out (may run past maxNodes when full).
+	std::atomic<bool> full;           ///< The arena had no room for an expansion.
+	std::atomic<bool> stopRequest;    ///< Set by mctsStop() or when the budget is used up.
+	std::atomic<uint64_t> tickets;    ///< Playouts claimed by the threads.
+	uint64_t runSeed;                 ///< Seed of the running search.
+	const ReversiBoard *pRoot;        ///< Position of the running search.
+	ReversiMctsLimits limits;         ///< Budget of the running search.
+	std::chrono::steady_clock::time_point start; ///< Start time of the running search.
+
+	/**
+	 * @brief Body of a search thread: runs iterations until the budget is used up.
+	 *
+	 * @param thread Number of the thread (0 is the calling thread).
+	 * @param playouts Receives the playouts of this thread.
+	 */
+	void mctsWorker(unsigned int thread, uint64_t &playouts);
+
+	/**
+	 * @brief Adds the children of a node for the position on the board.
+	 *
+	 * The caller has set the node to EXPANDING; the node is left EXPANDED, or
+	 * EMPTY if the arena is full.
+	 *
+	 * @return True if the node was expanded.
+	 */
+	bool mctsExpand(Node &node, ReversiBoard &board);
+
+	/**
+	 * @brief Returns the child of an expanded node with the best UCT / PUCT value.
+	 */
+	uint32_t mctsSelect(const Node &node) const;
+
+	/**
+	 * @brief Plays random moves until the game is over.
+	 *
+	 * @param board The position; the moves are left on its undo stack.
+	 * @param moves Scratch mask of the size of the board.
+	 * @param random State of the random number generator.
+	 * @param plies Incremented for every move and pass played.
+	 */
+	static void mctsPlayout(ReversiBoard &board, ReversiMask &moves,
+			uint64_t &random, unsigned int &plies);
+
+	/**
+	 * @brief Returns the static prior of a move for PUCT.
+	 */
+	static float mctsPrior(unsigned int row, unsigned int column,
+			unsigned int rows, unsigned int columns);
+
+	ReversiMcts(const ReversiMcts&);
+	ReversiMcts& operator=(const ReversiMcts&);
+
+public:
+	/**
+	 * @brief Constructs an engine and allocates its node arena.
+	 *
+	 * @param config The settings of the engine.
+	 */
+	explicit ReversiMcts(const ReversiMctsConfig &config = ReversiMctsConfig());
+
+	~ReversiMcts();
+
+	/**
+	 * @brief Sets the seed of the next runs (see ReversiMctsConfig::seed).
+	 */
+	void mctsSeed(uint64_t seed)
+	{
+		config.seed = seed;
+	}
+
+	/**
+	 * @brief Searches a position with all threads.
+	 *
+	 * @param position The position; the side to move is taken from boardSideToMove().
+	 * @param limits Playout and time budget.
+	 * @param result Best move, its win rate and the playout statistics.
+	 * @return RC_OK if the search ran, RC_ERROR_BAD_PARAM for a board without cells,
+	 *         without a budget or with more moves than the arena holds.
+	 */
+	RC_t mctsRun(const ReversiBoard &position, const ReversiMctsLimits &limits,
+			ReversiMctsResult &result);
+
+	/**
+	 * @brief Asks a running search to stop as soon as possible. Thread safe.
+	 */
+	void mctsStop();
+
+	/**
+	 * @brief Picks one of the moves of a mask, uniformly at random.
+	 *
+	 * @param moves The legal moves.
+	 * @param count Number of moves in the mask (not 0).
+	 * @param random A random number.
+	 * @return The cell index of the chosen move.
+	 */
+	static unsigned int mctsRandomMove(const ReversiMask &moves,
+			unsigned int count, uint64_t random);
+};
+
+#endif /* REVERSIMCTS_H_ */
@@ -0,0 +1,306 @@
+/*
+ * ReversiMetrics.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiMetrics.cpp
+ * @brief Implements the per-thread metric shards, their aggregation and export.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+#include "ReversiMetrics.h"
+
+using namespace std;
+
+/**
+ * @brief Name, help text and scale of one exported metric.
+ */
+struct ReversiMetricInfo
+{
+	const char *pName;  ///< Name without the "reversi_" prefix.
+	const char *pHelp;  ///< Help text of the Prometheus export.
+	double scale;       ///< Factor from the recorded unit to the exported one.
+};
+
+static const ReversiMetricInfo counterInfo[METRIC_COUNTERS] =
+{
+{ "board_set_total", "Calls of boardSet().", 1 },
+{ "valid_probes_total", "Calls of boardValidPositionX/O().", 1 },
+{ "valid_rejected_total", "Validity probes that found the move illegal.", 1 },
+{ "flip_calls_total", "Calls of flipOtoX/flipXtoO().", 1 },
+{ "discs_flipped_total", "Discs flipped by flip calls and moves.", 1 },
+{ "moves_total", "Moves played with makeMove().", 1 },
+{ "moves_illegal_total", "makeMove() calls rejected as illegal.", 1 },
+{ "undos_total", "Moves and passes taken back with unmakeMove().", 1 },
+{ "generate_moves_total", "Calls of generateMoves().", 1 } };
+
+static const ReversiMetricInfo histogramInfo[METRIC_HISTOGRAMS] =
+{
+{ "make_move_seconds", "Duration of makeMove() (sampled).", 1e-9 },
+{ "generate_moves_seconds", "Duration of generateMoves() (sampled).", 1e-9 },
+{ "move_flips", "Discs flipped per move played with makeMove().", 1 } };
+
+/// Head of the list of all shards; shards are never freed.
+static atomic<ReversiMetrics::Shard*> pShards(0);
+
+/// Serializes handing out shards.
+static mutex shardMutex;
+
+thread_local ReversiMetrics::Shard *ReversiMetrics::pShard = 0;
+
+/**
+ * @brief Releases the shard of a thread when the thread ends.
+ */
+struct ReversiMetrics::Detach
+{
+	~Detach()
+	{
+		if (pShard)
+		{
+			lock_guard<mutex> lock(shardMutex);
+			pShard->inUse = false;
+			pShard = 0;
+		}
+	}
+};
+
+/**
+ * @brief Constructs a shard with all counters at zero.
+ */
+ReversiMetrics::Shard::Shard() :
+		pNext(0), inUse(true)
+{
+	for (unsigned int c = 0; c < METRIC_COUNTERS; c++)
+	{
+		counters[c].store(0, memory_order_relaxed);
+	}
+	for (unsigned int h = 0; h < METRIC_HISTOGRAMS; h++)
+	{
+		for (unsigned int b = 0; b < BUCKETS; b++)
+		{
+			buckets[h][b].store(0, memory_order_relaxed);
+		}
+		sums[h].store(0, memory_order_relaxed);
+		ticks[h] = 0;
+	}
+}
+
+/**
+ * @brief Assigns a shard to the calling thread.
+ *
+ * A shard left by a finished thread is reused (its counts stay part of the
+ * totals); otherwise a new shard is added to the list.
+ */
+ReversiMetrics::Shard& ReversiMetrics::metricsAttach()
+{
+	static thread_local Detach detach;
+	(void) detach;
+
+	lock_guard<mutex> lock(shardMutex);
+	for (Shard *p = pShards.load(memory_order_acquire); p; p = p->pNext)
+	{
+		if (!p->inUse)
+		{
+			p->inUse = true;
+			pShard = p;
+			return *p;
+		}
+	}
+
+	Shard *p = new Shard();
+	p->pNext = pShards.load(memory_order_relaxed);
+	pShards.store(p, memory_order_release);
+	pShard = p;
+	return *p;
+}
+
+/**
+ * @brief Returns true if the hooks of the rules core are compiled in.
+ */
+bool ReversiMetrics::metricsEnabled()
+{
+#ifdef REVERSI_METRICS
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief Returns a monotonic time stamp in nanoseconds.
+ */
+uint64_t ReversiMetrics::metricsNow()
+{
+	return chrono::duration_cast<chrono::nanoseconds>(
+			chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Returns the upper bound of the bucket holding a percentile.
+ *
+ * @param pBuckets Number of samples per bucket (BUCKETS entries).
+ * @param fraction The percentile (0.5 for the median).
+ * @return The value, 0 without samples.
+ */
+uint64_t ReversiMetrics::metricsPercentile(const uint64_t *pBuckets,
+		double fraction)
+{
+	uint64_t total = 0;
+	for (unsigned int b = 0; b < BUCKETS; b++)
+	{
+		total += pBuckets[b];
+	}
+	if (total == 0)
+	{
+		return 0;
+	}
+
+	uint64_t rank = (uint64_t) (fraction * total + 0.999999);
+	uint64_t seen = 0;
+	for (unsigned int b = 0; b < BUCKETS; b++)
+	{
+		seen += pBuckets[b];
+		if (seen >= rank)
+		{
+			return metricsBucketLower(b + 1);
+		}
+	}
+	return metricsBucketLower(BUCKETS);
+}
+
+/**
+ * @brief Sums the shards of all threads.
+ *
+ * @param snapshot Receives the totals.
+ */
+void ReversiMetrics::metricsCollect(ReversiMetricsSnapshot &snapshot)
+{
+	memset(&snapshot, 0, sizeof(snapshot));
+	for (Shard *p = pShards.load(memory_order_acquire); p; p = p->pNext)
+	{
+		for (unsigned int c = 0; c < METRIC_COUNTERS; c++)
+		{
+			snapshot.counters[c] += p->counters[c].load(memory_order_relaxed);
+		}
+		for (unsigned int h = 0; h < METRIC_HISTOGRAMS; h++)
+		{
+			for (unsigned int b = 0; b < BUCKETS; b++)
+			{
+				uint64_t count = p->buckets[h][b].load(memory_order_relaxed);
+				snapshot.buckets[h][b] += count;
+				snapshot.counts[h] += count;
+			}
+			snapshot.sums[h] += p->sums[h].load(memory_order_relaxed);
+		}
+	}
+}
+
+/**
+ * @brief Sets all counters and histograms to zero.
+ */
+void ReversiMetrics::metricsReset()
+{
+	for (Shard *p = pShards.load(memory_order_acquire); p; p = p->pNext)
+	{
+		for (unsigned int c = 0; c < METRIC_COUNTERS; c++)
+		{
+			p->counters[c].store(0, memory_order_relaxed);
+		}
+		for (unsigned int h = 0; h < METRIC_HISTOGRAMS; h++)
+		{
+			for (unsigned int b = 0; b < BUCKETS; b++)
+			{
+				p->buckets[h][b].store(0, memory_order_relaxed);
+			}
+			p->sums[h].store(0, memory_order_relaxed);
+		}
+	}
+}
+
+/**
+ * @brief Writes the totals in the Prometheus text exposition format.
+ *
+ * Histograms are exported with one cumulative bucket per power of two, so the
+ * set of buckets is the same in every export.
+ *
+ * @param out The stream to write to.
+ */
+void ReversiMetrics::metricsWritePrometheus(ostream &out)
+{
+	ReversiMetricsSnapshot snapshot;
+	metricsCollect(snapshot);
+
+	for (unsigned int c = 0; c < METRIC_COUNTERS; c++)
+	{
+		const ReversiMetricInfo &info = counterInfo[c];
+		out << "# HELP reversi_" << info.pName << " " << info.pHelp << "\n"
+				<< "# TYPE reversi_" << info.pName << " counter\n" << "reversi_"
+				<< info.pName << " " << snapshot.counters[c] << "\n";
+	}
+
+	for (unsigned int h = 0; h < METRIC_HISTOGRAMS; h++)
+	{
+		const ReversiMetricInfo &info = histogramInfo[h];
+		uint64_t cumulative = 0;
+
+		out << "# HELP reversi_" << info.pName << " " << info.pHelp << "\n"
+				<< "# TYPE reversi_" << info.pName << " histogram\n";
+		for (unsigned int b = 0; b < BUCKETS; b++)
+		{
+			cumulative += snapshot.buckets[h][b];
+			// Bucket b ends just below bucket b + 1; export the ends of whole octaves
+			if ((b + 1) % 8 == 0 || b == 0)
+			{
+				out << "reversi_" << info.pName << "_bucket{le=\""
+						<< (metricsBucketLower(b + 1) - 1) * info.scale << "\"} "
+						<< cumulative << "\n";
+			}
+		}
+		out << "reversi_" << info.pName << "_bucket{le=\"+Inf\"} "
+				<< snapshot.counts[h] << "\n" << "reversi_" << info.pName
+				<< "_sum " << snapshot.sums[h] * info.scale << "\n" << "reversi_"
+				<< info.pName << "_count " << snapshot.counts[h] << "\n";
+	}
+}
+
+/**
+ * @brief Writes the totals as one line of JSON (without a line break).
+ *
+ * @param out The stream to write to.
+ */
+void ReversiMetrics::metricsWriteJson(ostream &out)
+{
+	ReversiMetricsSnapshot snapshot;
+	metricsCollect(snapshot);
+
+	out << "{\"enabled\":" << (metricsEnabled() ? "true" : "false")
+			<< ",\"counters\":{";
+	for (unsigned int c = 0; c < METRIC_COUNTERS; c++)
+	{
+		out << (c ? "," : "") << "\"" << counterInfo[c].pName << "\":"
+				<< snapshot.counters[c];
+	}
+	out << "},\"histograms\":{";
+	for (unsigned int h = 0; h < METRIC_HISTOGRAMS; h++)
+	{
+		const ReversiMetricInfo &info = histogramInfo[h];
+		const uint64_t *pBuckets = snapshot.buckets[h];
+		uint64_t count = snapshot.counts[h];
+
+		out << (h ? "," : "") << "\"" << info.pName << "\":{\"count\":" << count
+				<< ",\"mean\":"
+				<< (count ? (double) snapshot.sums[h] / count * info.scale : 0)
+				<< ",\"p50\":" << metricsPercentile(pBuckets, 0.50) * info.scale
+				<< ",\"p90\":" << metricsPercentile(pBuckets, 0.90) * info.scale
+				<< ",\"p99\":" << metricsPercentile(pBuckets, 0.99) * info.scale
+				<< ",\"max\":" << metricsPercentile(pBuckets, 1.0) * info.scale
+				<< "}";
+	}
+	out << "}}";
+}
@@ -0,0 +1,288 @@
+/*
+ * ReversiMetrics.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiMetrics.h
+ * @brief Declares the counters and histograms of the rules core and their export.
+ *
+ * The hooks in ReversiBoard are compiled in only when REVERSI_METRICS is defined
+ * (add -DREVERSI_METRICS to the compiler flags); otherwise the macros below
+ * expand to nothing and the rules core runs exactly as without them.
+ *
+ * Every thread writes to its own shard of counters, padded so that no two
+ * shards share a cache line, and without atomic read-modify-write operations.
+ * metricsCollect() sums all shards on demand; the totals can be written in the
+ * Prometheus text format or as one line of JSON. Shards of finished threads
+ * are handed to new threads, so their counts are kept.
+ *
+ * The histograms use log-linear buckets (8 per power of two, so every value is
+ * placed within 12.5 %). Durations are measured on one call in SAMPLE_RATE per
+ * thread to keep the clock reads off most calls.
+ */
+
+#ifndef REVERSIMETRICS_H_
+#define REVERSIMETRICS_H_
+
+#include <atomic>
+#include <ostream>
+#include <stdint.h>
+
+/**
+ * @brief The counters of the rules core.
+ */
+enum ReversiMetricCounter_t
+{
+	METRIC_BOARD_SET,       ///< Calls of boardSet().
+	METRIC_VALID_PROBES,    ///< Calls of boardValidPositionX() / boardValidPositionO().
+	METRIC_VALID_REJECTED,  ///< Probes that found the move illegal.
+	METRIC_FLIP_CALLS,      ///< Calls of flipOtoX() / flipXtoO().
+	METRIC_DISCS_FLIPPED,   ///< Discs flipped by the flip calls and makeMove().
+	METRIC_MOVES,           ///< Moves played with makeMove().
+	METRIC_MOVES_ILLEGAL,   ///< makeMove() calls rejected as illegal.
+	METRIC_UNDOS,           ///< Moves and passes taken back with unmakeMove().
+	METRIC_GENERATE_MOVES,  ///< Calls of generateMoves().
+	METRIC_COUNTERS         ///< Number of counters.
+};
+
+/**
+ * @brief The histograms of the rules core.
+ */
+enum ReversiMetricHistogram_t
+{
+	METRIC_MAKE_MOVE_NS,      ///< Duration of makeMove() in nanoseconds (sampled).
+	METRIC_GENERATE_MOVES_NS, ///< Duration of generateMoves() in nanoseconds (sampled).
+	METRIC_MOVE_FLIPS,        ///< Discs flipped per move played with makeMove().
+	METRIC_HISTOGRAMS         ///< Number of histograms.
+};
+
+struct ReversiMetricsSnapshot;
+
+/**
+ * @class ReversiMetrics
+ * @brief Per-thread counters and histograms with on-demand aggregation and export.
+ */
+class ReversiMetrics
+{
+public:
+	/**
+	 * @brief Number of histogram buckets: 8 per power of two, up to 2^40.
+	 */
+	static const unsigned int BUCKETS = 8 * 40;
+
+	/**
+	 * @brief One duration in this many is measured per thread and histogram.
+	 */
+	static const unsigned int SAMPLE_RATE = 64;
+
+	/**
+	 * @brief Counters of one thread, written by that thread only.
+	 */
+	struct Shard
+	{
+		char padBefore[64]; ///< Keeps the counters off the cache line of the neighbour.
+		std::atomic<uint64_t> counters[METRIC_COUNTERS];
+		std::atomic<uint64_t> buckets[METRIC_HISTOGRAMS][BUCKETS];
+		std::atomic<uint64_t> sums[METRIC_HISTOGRAMS];
+		unsigned int ticks[METRIC_HISTOGRAMS]; ///< Calls since the last measured one.
+		Shard *pNext;       ///< Next shard in the list of all shards.
+		bool inUse;         ///< Owned by a running thread.
+		char padAfter[64];
+
+		Shard();
+	};
+
+private:
+	struct Detach;
+
+	static thread_local Shard *pShard; ///< Shard of the calling thread, 0 before its first use.
+
+	/**
+	 * @brief Assigns a shard to the calling thread.
+	 */
+	static Shard& metricsAttach();
+
+	/**
+	 * @brief Adds to a counter of the calling thread's shard.
+	 */
+	static void metricsBump(std::atomic<uint64_t> &counter, uint64_t amount)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + amount,
+				std::memory_order_relaxed);
+	}
+
+public:
+	/**
+	 * @brief Returns true if the hooks of the rules core are compiled in.
+	 */
+	static bool metricsEnabled();
+
+	/**
+	 * @brief Returns the shard of the calling thread.
+	 */
+	static Shard& metricsShard()
+	{
+		return pShard ? *pShard : metricsAttach();
+	}
+
+	/**
+	 * @brief Adds to a counter.
+	 */
+	static void metricsAdd(ReversiMetricCounter_t counter, uint64_t amount)
+	{
+		metricsBump(metricsShard().counters[counter], amount);
+	}
+
+	/**
+	 * @brief Adds one value to a histogram.
+	 */
+	static void metricsRecord(ReversiMetricHistogram_t histogram,
+			uint64_t value)
+	{
+		Shard &shard = metricsShard();
+		metricsBump(shard.buckets[histogram][metricsBucket(value)], 1);
+		metricsBump(shard.sums[histogram], value);
+	}
+
+	/**
+	 * @brief Returns true if the current call of a sampled histogram is to be measured.
+	 */
+	static bool metricsSample(ReversiMetricHistogram_t histogram)
+	{
+		return metricsShard().ticks[histogram]++ % SAMPLE_RATE == 0;
+	}
+
+	/**
+	 * @brief Returns a monotonic time stamp in nanoseconds.
+	 */
+	static uint64_t metricsNow();
+
+	/**
+	 * @brief Returns the histogram bucket of a value.
+	 */
+	static unsigned int metricsBucket(uint64_t value)
+	{
+		if (value < 8)
+		{
+			return (unsigned int) value;
+		}
+
+		unsigned int magnitude = 63 - __builtin_clzll(value);
+		unsigned int bucket = (magnitude - 2) * 8
+				+ (unsigned int) ((value >> (magnitude - 3)) & 7);
+		return (bucket < BUCKETS) ? bucket : BUCKETS - 1;
+	}
+
+	/**
+	 * @brief Returns the smallest value that falls into a bucket.
+	 *
+	 * @param bucket The bucket (BUCKETS returns the end of the last bucket).
+	 */
+	static uint64_t metricsBucketLower(unsigned int bucket)
+	{
+		if (bucket < 8)
+		{
+			return bucket;
+		}
+		return (uint64_t) (8 + bucket % 8) << (bucket / 8 - 1);
+	}
+
+	/**
+	 * @brief Returns the upper bound of the bucket holding a percentile.
+	 *
+	 * @param pBuckets Number of samples per bucket (BUCKETS entries).
+	 * @param fraction The percentile (0.5 for the median).
+	 * @return The value, 0 without samples.
+	 */
+	static uint64_t metricsPercentile(const uint64_t *pBuckets,
+			double fraction);
+
+	/**
+	 * @brief Sums the shards of all threads.
+	 *
+	 * Counters written while collecting may or may not be included.
+	 *
+	 * @param snapshot Receives the totals.
+	 */
+	static void metricsCollect(ReversiMetricsSnapshot &snapshot);
+
+	/**
+	 * @brief Sets all counters and histograms to zero.
+	 *
+	 * Increments made by other threads at the same time may be lost.
+	 */
+	static void metricsReset();
+
+	/**
+	 * @brief Writes the totals in the Prometheus text exposition format.
+	 *
+	 * All names start with "reversi_"; durations are exported in seconds.
+	 *
+	 * @param out The stream to write to.
+	 */
+	static void metricsWritePrometheus(std::ostream &out);
+
+	/**
+	 * @brief Writes the totals as one line of JSON (without a line break).
+	 *
+	 * Histograms are summarized by count, mean and the 50th, 90th, 99th percentiles
+	 * and maximum.
+	 *
+	 * @param out The stream to write to.
+	 */
+	static void metricsWriteJson(std::ostream &out);
+};
+
+/**
+ * @brief Totals of all counters and histograms, summed over all threads.
+ */
+struct ReversiMetricsSnapshot
+{
+	uint64_t counters[METRIC_COUNTERS];
+	uint64_t buckets[METRIC_HISTOGRAMS][ReversiMetrics::BUCKETS]; ///< Samples per bucket.
+	uint64_t counts[METRIC_HISTOGRAMS];          ///< Samples per histogram.
+	uint64_t sums[METRIC_HISTOGRAMS];            ///< Sum of the sampled values.
+};
+
+/**
+ * @class ReversiMetricsTimer
+ * @brief Measures the duration of a scope into a histogram, on sampled calls only.
+ */
+class ReversiMetricsTimer
+{
+private:
+	ReversiMetricHistogram_t histogram;
+	uint64_t start; ///< Start time, or 0 if this call is not measured.
+
+public:
+	explicit ReversiMetricsTimer(ReversiMetricHistogram_t histogram) :
+			histogram(histogram), start(
+					ReversiMetrics::metricsSample(histogram) ?
+							ReversiMetrics::metricsNow() : 0)
+	{
+	}
+
+	~ReversiMetricsTimer()
+	{
+		if (start != 0)
+		{
+			ReversiMetrics::metricsRecord(histogram,
+					ReversiMetrics::metricsNow() - start);
+		}
+	}
+};
+
+#ifdef REVERSI_METRICS
+#define REVERSI_METRIC_ADD(counter, amount) ReversiMetrics::metricsAdd(counter, amount)
+#define REVERSI_METRIC_RECORD(histogram, value) ReversiMetrics::metricsRecord(histogram, value)
+#define REVERSI_METRIC_TIMER(histogram) ReversiMetricsTimer metricTimer(histogram)
+#else
+#define REVERSI_METRIC_ADD(counter, amount) ((void) 0)
+#define REVERSI_METRIC_RECORD(histogram, value) ((void) 0)
+#define REVERSI_METRIC_TIMER(histogram) ((void) 0)
+#endif
+
+#endif /* REVERSIMETRICS_H_ */
@@ -0,0 +1,189 @@
+/*
+ * ReversiParallelSearch.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiParallelSearch.cpp
+ * @brief Implements the multi-threaded (Lazy SMP) search.
+ */
+
+#include "ReversiParallelSearch.h"
+
+using namespace std;
+
+/**
+ * @brief Starts the helper threads.
+ *
+ * @param tt The shared transposition table; must outlive the object.
+ * @param threads Total number of threads including the calling thread (at least 1).
+ */
+ReversiParallelSearch::ReversiParallelSearch(ReversiTransTable &tt,
+		unsigned int threads) :
+		tt(tt), generation(0), running(0), quit(false), stopHelpers(false), pPosition(
+				0)
+{
+	if (threads == 0)
+	{
+		threads = 1;
+	}
+
+	results.resize(threads);
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		engines.push_back(unique_ptr<ReversiSearch>(new ReversiSearch(tt)));
+		engines[i]->searchSetThread(i, (i == 0) ? 0 : &stopHelpers);
+	}
+	for (unsigned int i = 1; i < threads; i++)
+	{
+		workers.push_back(thread(&ReversiParallelSearch::parallelWorker, this, i));
+	}
+}
+
+/**
+ * @brief Stops and joins the helper threads.
+ */
+ReversiParallelSearch::~ReversiParallelSearch()
+{
+	{
+		lock_guard<mutex> guard(lock);
+		quit = true;
+	}
+	stopHelpers.store(true, memory_order_relaxed);
+	wake.notify_all();
+	for (unsigned int i = 0; i < workers.size(); i++)
+	{
+		workers[i].join();
+	}
+}
+
+/**
+ * @brief Body of a helper thread: waits for a search, runs it, reports back.
+ *
+ * @param thread Number of the thread (1..n-1).
+ */
+void ReversiParallelSearch::parallelWorker(unsigned int thread)
+{
+	unsigned int seen = 0;
+
+	for (;;)
+	{
+		unique_lock<mutex> guard(lock);
+		wake.wait(guard, [&]()
+		{
+			return quit || generation != seen;
+		});
+		if (quit)
+		{
+			return;
+		}
+		seen = generation;
+		guard.unlock();
+
+		engines[thread]->searchRun(*pPosition, helperLimits, results[thread]);
+
+		guard.lock();
+		if (--running == 0)
+		{
+			done.notify_one();
+		}
+	}
+}
+
+/**
+ * @brief Searches a position with all threads.
+ *
+ * The helpers get the depth limit only; they run until the main thread has
+ * finished and are then stopped through the shared flag.
+ *
+ * @param position The position; the side to move is taken from boardSideToMove().
+ * @param limits Depth, node and time budget.
+ * @param result Best move, score, principal variation and total nodes.
+ * @return RC_OK if the search ran, RC_ERROR_BAD_PARAM for a board without cells.
+ */
+RC_t ReversiParallelSearch::parallelRun(const ReversiBoard &position,
+		const ReversiSearchLimits &limits, ReversiSearchResult &result)
+{
+	if (position.boardCells().maskBits() == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	{
+		lock_guard<mutex> guard(lock);
+		pPosition = &position;
+		helperLimits = ReversiSearchLimits();
+		helperLimits.maxDepth = limits.maxDepth;
+		stopHelpers.store(false, memory_order_relaxed);
+		running = workers.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	RC_t rc = engines[0]->searchRun(position, limits, results[0]);
+
+	stopHelpers.store(true, memory_order_relaxed);
+	{
+		unique_lock<mutex> guard(lock);
+		done.wait(guard, [&]()
+		{
+			return running == 0;
+		});
+		pPosition = 0;
+	}
+
+	unsigned int best = 0;
+	uint64_t nodes = 0;
+	for (unsigned int i = 0; i < results.size(); i++)
+	{
+		nodes += results[i].nodes;
+		if (results[i].depth > results[best].depth)
+		{
+			best = i;
+		}
+	}
+
+	result = results[best];
+	result.nodes = nodes;
+	result.seconds = results[0].seconds;
+	return rc;
+}
+
+/**
+ * @brief Asks a running search to stop as soon as possible. Thread safe.
+ */
+void ReversiParallelSearch::parallelStop()
+{
+	engines[0]->searchStop();
+}
+
+/**
+ * @brief Sets the pattern evaluation of all threads.
+ *
+ * Must not be called while a search is running.
+ *
+ * @param pPatternEval The trained evaluation, or 0; must outlive the search.
+ */
+void ReversiParallelSearch::parallelSetEvaluator(
+		const ReversiPatternEval *pPatternEval)
+{
+	for (unsigned int i = 0; i < engines.size(); i++)
+	{
+		engines[i]->searchSetEvaluator(pPatternEval);
+	}
+}
+
+/**
+ * @brief Clears killer and history tables of all threads.
+ *
+ * Must not be called while a search is running.
+ */
+void ReversiParallelSearch::parallelClear()
+{
+	for (unsigned int i = 0; i < engines.size(); i++)
+	{
+		engines[i]->searchClear();
+	}
+}
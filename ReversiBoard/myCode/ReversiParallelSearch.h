@@ -0,0 +1,123 @@
+/*
+ * ReversiParallelSearch.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiParallelSearch.h
+ * @brief Declares the multi-threaded (Lazy SMP) search.
+ *
+ * All threads search the same position with their own `ReversiSearch` engine, that
+ * is with their own board copy, undo stack and ordering tables. The only shared
+ * state is the lock-free transposition table, through which the threads profit
+ * from each other's results. The threads are started once and wait for work
+ * between searches, so a search does not pay for creating threads.
+ */
+
+#ifndef REVERSIPARALLELSEARCH_H_
+#define REVERSIPARALLELSEARCH_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "global.h"
+#include "ReversiBoard.h"
+#include "ReversiSearch.h"
+#include "ReversiTransTable.h"
+
+/**
+ * @class ReversiParallelSearch
+ * @brief A pool of search threads sharing one transposition table.
+ *
+ * The calling thread acts as the main thread: it runs the search with the given
+ * limits, and the helper threads are stopped as soon as it returns.
+ */
+class ReversiParallelSearch
+{
+private:
+	ReversiTransTable &tt;                                 ///< Table shared by all threads.
+	std::vector<std::unique_ptr<ReversiSearch> > engines; ///< One engine per thread, 0 is the main thread.
+	std::vector<ReversiSearchResult> results;              ///< Result per thread of the last search.
+	std::vector<std::thread> workers;                      ///< Helper threads 1..n-1.
+	std::mutex lock;
+	std::condition_variable wake;  ///< Signals a new search or shutdown to the helpers.
+	std::condition_variable done;  ///< Signals that a helper has finished its search.
+	unsigned int generation;       ///< Incremented for every search.
+	unsigned int running;          ///< Number of helpers still searching.
+	bool quit;                     ///< The helpers shall exit.
+	std::atomic<bool> stopHelpers; ///< Set when the main thread has finished.
+	const ReversiBoard *pPosition; ///< Position of the running search.
+	ReversiSearchLimits helperLimits; ///< Depth limit of the running search, no other budget.
+
+	/**
+	 * @brief Body of a helper thread: waits for a search, runs it, reports back.
+	 *
+	 * @param thread Number of the thread (1..n-1).
+	 */
+	void parallelWorker(unsigned int thread);
+
+	ReversiParallelSearch(const ReversiParallelSearch&);
+	ReversiParallelSearch& operator=(const ReversiParallelSearch&);
+
+public:
+	/**
+	 * @brief Starts the helper threads.
+	 *
+	 * @param tt The shared transposition table; must outlive the object.
+	 * @param threads Total number of threads including the calling thread (at least 1).
+	 */
+	ReversiParallelSearch(ReversiTransTable &tt, unsigned int threads);
+
+	/**
+	 * @brief Stops and joins the helper threads.
+	 */
+	~ReversiParallelSearch();
+
+	/**
+	 * @brief Returns the total number of threads including the calling thread.
+	 */
+	unsigned int parallelThreads() const
+	{
+		return engines.size();
+	}
+
+	/**
+	 * @brief Searches a position with all threads.
+	 *
+	 * The limits apply to the main thread; the node budget counts the nodes of the
+	 * main thread only. The result is the one of the thread that completed the
+	 * deepest iteration (the main thread on a tie), with the nodes of all threads.
+	 *
+	 * @param position The position; the side to move is taken from boardSideToMove().
+	 * @param limits Depth, node and time budget.
+	 * @param result Best move, score, principal variation and total nodes.
+	 * @return RC_OK if the search ran, RC_ERROR_BAD_PARAM for a board without cells.
+	 */
+	RC_t parallelRun(const ReversiBoard &position,
+			const ReversiSearchLimits &limits, ReversiSearchResult &result);
+
+	/**
+	 * @brief Asks a running search to stop as soon as possible. Thread safe.
+	 */
+	void parallelStop();
+
+	/**
+	 * @brief Sets the pattern evaluation of all threads (see ReversiSearch::searchSetEvaluator()).
+	 *
+	 * @param pPatternEval The trained evaluation, or 0; must outlive the search.
+	 */
+	void parallelSetEvaluator(const ReversiPatternEval *pPatternEval);
+
+	/**
+	 * @brief Clears killer and history tables of all threads.
+	 */
+	void parallelClear();
+};
+
+#endif /* REVERSIPARALLELSEARCH_H_ */
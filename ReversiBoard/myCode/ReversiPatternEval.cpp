@@ -0,0 +1,488 @@
+/*
+ * ReversiPatternEval.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiPatternEval.cpp
+ * @brief Implements the pattern evaluation, its trainer and the runtime dispatch.
+ *
+ * Both implementations use the same tables and must return identical scores. The
+ * AVX2 code is compiled with a function-level target attribute, so the project
+ * itself does not need to be built with -mavx2 -mbmi2.
+ */
+
+// pext of 64-bit words needs x86-64
+#if defined(__x86_64__)
+#define REVERSI_EVAL_X86
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <map>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ReversiPatternEval.h"
+
+using namespace std;
+
+/**
+ * @brief A pattern in its canonical orientation (at the top left corner).
+ */
+struct PatternShape
+{
+	unsigned int size;            ///< Number of cells.
+	unsigned char rows[10];       ///< Row of every cell.
+	unsigned char columns[10];    ///< Column of every cell.
+	unsigned int transforms;      ///< Bit t set: the instance rotated t % 4 times, transposed if t >= 4.
+};
+
+// Edge with X-cells, 3x3 corner, 2x5 corner, lines 2..4 and diagonals of length 8..4
+static const PatternShape shapes[] =
+{
+{ 10,
+{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 1 },
+{ 0, 1, 2, 3, 4, 5, 6, 7, 1, 6 }, 0x0F },
+{ 9,
+{ 0, 0, 0, 1, 1, 1, 2, 2, 2 },
+{ 0, 1, 2, 0, 1, 2, 0, 1, 2 }, 0x0F },
+{ 10,
+{ 0, 0, 0, 0, 0, 1, 1, 1, 1, 1 },
+{ 0, 1, 2, 3, 4, 0, 1, 2, 3, 4 }, 0xFF },
+{ 8,
+{ 1, 1, 1, 1, 1, 1, 1, 1 },
+{ 0, 1, 2, 3, 4, 5, 6, 7 }, 0x0F },
+{ 8,
+{ 2, 2, 2, 2, 2, 2, 2, 2 },
+{ 0, 1, 2, 3, 4, 5, 6, 7 }, 0x0F },
+{ 8,
+{ 3, 3, 3, 3, 3, 3, 3, 3 },
+{ 0, 1, 2, 3, 4, 5, 6, 7 }, 0x0F },
+{ 8,
+{ 0, 1, 2, 3, 4, 5, 6, 7 },
+{ 0, 1, 2, 3, 4, 5, 6, 7 }, 0x03 },
+{ 7,
+{ 0, 1, 2, 3, 4, 5, 6 },
+{ 1, 2, 3, 4, 5, 6, 7 }, 0x0F },
+{ 6,
+{ 0, 1, 2, 3, 4, 5 },
+{ 2, 3, 4, 5, 6, 7 }, 0x0F },
+{ 5,
+{ 0, 1, 2, 3, 4 },
+{ 3, 4, 5, 6, 7 }, 0x0F },
+{ 4,
+{ 0, 1, 2, 3 },
+{ 4, 5, 6, 7 }, 0x0F }, };
+
+static const unsigned char weightMagic[4] =
+{ 'R', 'V', 'P', 'W' };
+static const uint16_t WEIGHT_VERSION = 1;
+
+atomic<ReversiPatternEval::EvalFunction> ReversiPatternEval::pEval(
+		&ReversiPatternEval::evalResolve);
+
+/**
+ * @brief Builds the pattern instances and zero weights.
+ *
+ * For every instance the cells are listed in the digit order of its pattern, so
+ * rotated and reflected instances read the same table. The base-3 tables are
+ * shared between instances whose cells appear in the same digit order when
+ * sorted by bit index.
+ */
+ReversiPatternEval::ReversiPatternEval() :
+		stageSize(0)
+{
+	unsigned int pow3[11];
+	map<vector<unsigned int>, unsigned int> tables;
+	unsigned int count = 0;
+
+	pow3[0] = 1;
+	for (unsigned int i = 1; i < 11; i++)
+	{
+		pow3[i] = 3 * pow3[i - 1];
+	}
+
+	for (unsigned int s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+	{
+		const PatternShape &shape = shapes[s];
+
+		for (unsigned int t = 0; t < 8; t++)
+		{
+			if (!(shape.transforms & (1u << t)))
+			{
+				continue;
+			}
+
+			Instance &instance = instances[count++];
+			instance.size = shape.size;
+			instance.mask = 0;
+			instance.offset = stageSize;
+			for (unsigned int i = 0; i < shape.size; i++)
+			{
+				unsigned int row = shape.rows[i];
+				unsigned int column = shape.columns[i];
+				if (t >= 4)
+				{
+					swap(row, column);
+				}
+				for (unsigned int r = 0; r < t % 4; r++)
+				{
+					unsigned int rotated = column;
+					column = 7 - row;
+					row = rotated;
+				}
+				instance.cells[i] = row * 8 + column;
+				instance.mask |= (uint64_t) 1 << instance.cells[i];
+			}
+
+			// Digit weight of every extracted bit, in bit order
+			vector<unsigned int> digits;
+			for (uint64_t m = instance.mask; m; m &= m - 1)
+			{
+				unsigned int cell = __builtin_ctzll(m);
+				unsigned int position = find(instance.cells,
+						instance.cells + shape.size, cell) - instance.cells;
+				digits.push_back(pow3[shape.size - 1 - position]);
+			}
+
+			map<vector<unsigned int>, unsigned int>::iterator it = tables.find(
+					digits);
+			if (it == tables.end())
+			{
+				unsigned int offset = ternary.size();
+				ternary.resize(offset + (1u << shape.size));
+				for (unsigned int bits = 0; bits < (1u << shape.size); bits++)
+				{
+					unsigned int value = 0;
+					for (unsigned int j = 0; j < shape.size; j++)
+					{
+						if (bits & (1u << j))
+						{
+							value += digits[j];
+						}
+					}
+					ternary[offset + bits] = value;
+				}
+				it = tables.insert(make_pair(digits, offset)).first;
+			}
+			instance.ternary = it->second;
+		}
+		stageSize += pow3[shape.size];
+	}
+
+	// Two zero weights after the last stage are the target of the padding lanes
+	weights.assign((size_t) STAGES * stageSize + 2, 0);
+}
+
+/**
+ * @brief Computes the weight index of every instance within a stage.
+ */
+void ReversiPatternEval::evalIndices(uint64_t own, uint64_t opp,
+		unsigned int *pIndices) const
+{
+	for (unsigned int i = 0; i < INSTANCES; i++)
+	{
+		const Instance &instance = instances[i];
+		unsigned int index = 0;
+
+		for (unsigned int j = 0; j < instance.size; j++)
+		{
+			unsigned int cell = instance.cells[j];
+			index = 3 * index + ((own >> cell) & 1) + 2 * ((opp >> cell) & 1);
+		}
+		pIndices[i] = instance.offset + index;
+	}
+}
+
+/**
+ * @brief Selects the implementation on first use and forwards the call.
+ */
+int ReversiPatternEval::evalResolve(const ReversiPatternEval &eval,
+		uint64_t own, uint64_t opp)
+{
+	evalUseSimd(true);
+	return pEval.load(memory_order_relaxed)(eval, own, opp);
+}
+
+/**
+ * @brief Scalar implementation building the indices cell by cell.
+ */
+int ReversiPatternEval::evalScalar(const ReversiPatternEval &eval,
+		uint64_t own, uint64_t opp)
+{
+	unsigned int indices[INSTANCES];
+	const int16_t *pWeights = &eval.weights[evalStage(own, opp) * eval.stageSize];
+	int score = 0;
+
+	eval.evalIndices(own, opp, indices);
+	for (unsigned int i = 0; i < INSTANCES; i++)
+	{
+		score += pWeights[indices[i]];
+	}
+	return score;
+}
+
+#ifdef REVERSI_EVAL_X86
+
+/**
+ * @brief AVX2 implementation with pext indices and gathered weights.
+ *
+ * The indices of the 46 instances (and two padding lanes pointing at a zero
+ * weight) are gathered 8 at a time. A 32-bit gather at the address of an int16
+ * weight loads the weight into the low half of the lane, which is then sign
+ * extended.
+ */
+__attribute__((target("avx2,bmi2")))
+int ReversiPatternEval::evalAvx2(const ReversiPatternEval &eval, uint64_t own,
+		uint64_t opp)
+{
+	alignas(32) int indices[48];
+	const uint16_t *pTernary = &eval.ternary[0];
+	unsigned int base = evalStage(own, opp) * eval.stageSize;
+
+	for (unsigned int i = 0; i < INSTANCES; i++)
+	{
+		const Instance &instance = eval.instances[i];
+		const uint16_t *pTable = pTernary + instance.ternary;
+
+		indices[i] = base + instance.offset
+				+ pTable[_pext_u64(own, instance.mask)]
+				+ 2 * pTable[_pext_u64(opp, instance.mask)];
+	}
+	indices[46] = indices[47] = STAGES * eval.stageSize;
+
+	const int *pWeights = (const int*) &eval.weights[0];
+	__m256i sum = _mm256_setzero_si256();
+	for (unsigned int i = 0; i < 48; i += 8)
+	{
+		__m256i index = _mm256_load_si256((const __m256i*) &indices[i]);
+		__m256i value = _mm256_i32gather_epi32(pWeights, index, 2);
+		sum = _mm256_add_epi32(sum,
+				_mm256_srai_epi32(_mm256_slli_epi32(value, 16), 16));
+	}
+
+	__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum),
+			_mm256_extracti128_si256(sum, 1));
+	half = _mm_add_epi32(half, _mm_unpackhi_epi64(half, half));
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 1));
+	return _mm_cvtsi128_si32(half);
+}
+
+#else
+
+/**
+ * @brief Non-x86 builds have no vector implementation; use the scalar code.
+ */
+int ReversiPatternEval::evalAvx2(const ReversiPatternEval &eval, uint64_t own,
+		uint64_t opp)
+{
+	return evalScalar(eval, own, opp);
+}
+
+#endif
+
+/**
+ * @brief Reads the weights from a file written by evalSave().
+ *
+ * File layout: magic "RVPW", version (u16), number of stages (u16), weights per
+ * stage (u32), then all weights as int16 in host byte order.
+ *
+ * @param path The file name.
+ * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be
+ *         read or does not match the patterns.
+ */
+RC_t ReversiPatternEval::evalLoad(const char *path)
+{
+	FILE *pFile = fopen(path, "rb");
+	if (!pFile)
+	{
+		return RC_ERROR;
+	}
+
+	unsigned char header[12];
+	uint16_t version, stages;
+	uint32_t size;
+	bool ok = fread(header, 1, sizeof(header), pFile) == sizeof(header);
+
+	memcpy(&version, header + 4, 2);
+	memcpy(&stages, header + 6, 2);
+	memcpy(&size, header + 8, 4);
+	ok = ok && memcmp(header, weightMagic, 4) == 0 && version == WEIGHT_VERSION
+			&& stages == STAGES && size == stageSize;
+
+	vector<int16_t> loaded(evalWeights());
+	ok = ok && fread(&loaded[0], sizeof(int16_t), loaded.size(), pFile)
+			== loaded.size();
+	fclose(pFile);
+
+	if (!ok)
+	{
+		return RC_ERROR;
+	}
+	copy(loaded.begin(), loaded.end(), weights.begin());
+	return RC_OK;
+}
+
+/**
+ * @brief Writes the weights to a file.
+ *
+ * @param path The file name.
+ * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be written.
+ */
+RC_t ReversiPatternEval::evalSave(const char *path) const
+{
+	FILE *pFile = fopen(path, "wb");
+	if (!pFile)
+	{
+		return RC_ERROR;
+	}
+
+	unsigned char header[12];
+	uint16_t stages = STAGES;
+	uint32_t size = stageSize;
+
+	memcpy(header, weightMagic, 4);
+	memcpy(header + 4, &WEIGHT_VERSION, 2);
+	memcpy(header + 6, &stages, 2);
+	memcpy(header + 8, &size, 4);
+
+	bool ok = fwrite(header, 1, sizeof(header), pFile) == sizeof(header);
+	ok = ok && fwrite(&weights[0], sizeof(int16_t), evalWeights(), pFile)
+			== evalWeights();
+	ok = (fclose(pFile) == 0) && ok;
+	return ok ? RC_OK : RC_ERROR;
+}
+
+/**
+ * @brief Fits the weights to the results of the 8x8 games of an archive.
+ *
+ * The weights are trained as floating point numbers in discs, starting from the
+ * current weights, and rounded to int16 at the end. The correction of a sample is
+ * spread evenly over its instances.
+ *
+ * @param archive The archive; games on other board sizes are skipped.
+ * @param epochs Number of passes over all games.
+ * @param rate Learning rate.
+ * @param error Receives the root mean square error (in discs) of the last pass.
+ * @return RC_OK if the operation was successful, RC_ERROR for a damaged game,
+ *         RC_ERROR_BAD_PARAM if the archive has no 8x8 game.
+ */
+RC_t ReversiPatternEval::evalTrain(const ReversiArchiveReader &archive,
+		unsigned int epochs, double rate, double &error)
+{
+	vector<float> trained(evalWeights());
+	unsigned int indices[INSTANCES];
+	ReversiBoard board(8, 8);
+	float step = (float) (rate / INSTANCES);
+
+	for (size_t i = 0; i < trained.size(); i++)
+	{
+		trained[i] = (float) weights[i] / WEIGHT_SCALE;
+	}
+
+	error = 0;
+	for (unsigned int epoch = 0; epoch < epochs; epoch++)
+	{
+		double squares = 0;
+		uint64_t samples = 0;
+
+		for (size_t g = 0; g < archive.archiveGames(); g++)
+		{
+			ReversiArchiveGame game;
+
+			if (archive.archiveGame(g, game) != RC_OK)
+			{
+				return RC_ERROR;
+			}
+			if (game.rows != 8 || game.columns != 8)
+			{
+				continue;
+			}
+
+			board.boardClear();
+			board.boardInitialState(8, 8);
+			for (unsigned int ply = 0; ply <= game.plies; ply++)
+			{
+				char side = board.boardSideToMove();
+				uint64_t own = board.boardDiscs(side).maskWord(0);
+				uint64_t opp = board.boardDiscs((side == 'x') ? 'o' : 'x').maskWord(0);
+				float *pWeights = &trained[evalStage(own, opp) * stageSize];
+				float target = (float) ((side == 'x') ? game.result : -game.result);
+				float predicted = 0;
+
+				evalIndices(own, opp, indices);
+				for (unsigned int i = 0; i < INSTANCES; i++)
+				{
+					predicted += pWeights[indices[i]];
+				}
+
+				float difference = target - predicted;
+				squares += (double) difference * difference;
+				samples++;
+				for (unsigned int i = 0; i < INSTANCES; i++)
+				{
+					pWeights[indices[i]] += step * difference;
+				}
+
+				if (ply == game.plies)
+				{
+					break;
+				}
+				unsigned int move = game.gameMove(ply);
+				if (move == ReversiUndo::PASS)
+				{
+					board.makePass(side);
+				}
+				else if (!board.makeMove(move, side))
+				{
+					return RC_ERROR;
+				}
+			}
+		}
+
+		if (samples == 0)
+		{
+			return RC_ERROR_BAD_PARAM;
+		}
+		error = sqrt(squares / samples);
+	}
+
+	for (size_t i = 0; i < trained.size(); i++)
+	{
+		float value = trained[i] * WEIGHT_SCALE;
+		weights[i] = (int16_t) max(-32767.0f, min(32767.0f, value + ((value < 0) ? -0.5f : 0.5f)));
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Checks whether the CPU supports the AVX2 implementation (AVX2 and BMI2).
+ */
+bool ReversiPatternEval::evalHasAvx2()
+{
+#ifdef REVERSI_EVAL_X86
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2");
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief Enables or disables the vectorized implementation.
+ *
+ * @param enable true to use AVX2 when available, false to force the scalar code.
+ * @return true if the vectorized implementation is active afterwards.
+ */
+bool ReversiPatternEval::evalUseSimd(bool enable)
+{
+	bool simd = enable && evalHasAvx2();
+
+	pEval.store(simd ? &ReversiPatternEval::evalAvx2 :
+						&ReversiPatternEval::evalScalar, memory_order_relaxed);
+	return simd;
+}
@@ -0,0 +1,203 @@
+/*
+ * ReversiPatternEval.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiPatternEval.h
+ * @brief Declares the pattern-table evaluation of 8x8 positions.
+ *
+ * The evaluation sums one weight per pattern instance. A pattern is a fixed set
+ * of cells (an edge with its two X-cells, a 3x3 corner, a 2x5 corner block, the
+ * inner lines and the diagonals); its contents are encoded as a base-3 number
+ * (0 empty, 1 own disc, 2 opponent disc) that indexes an int16 weight table.
+ * All rotations and reflections of a pattern share one table. Every game stage
+ * (by number of discs) has its own set of tables.
+ *
+ * The index is computed from the two disc words: the cells of an instance are
+ * extracted with pext and a small table turns the extracted bits into their
+ * base-3 value. The AVX2 implementation (BMI2 pext, gathers of 8 weights at a
+ * time) is selected at runtime; a scalar implementation covers other CPUs.
+ */
+
+#ifndef REVERSIPATTERNEVAL_H_
+#define REVERSIPATTERNEVAL_H_
+
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+#include "global.h"
+#include "ReversiArchive.h"
+
+/**
+ * @class ReversiPatternEval
+ * @brief Pattern weights of all stages with scalar and AVX2 evaluation.
+ *
+ * A new object has all weights zero; they are filled by evalLoad() or evalTrain().
+ */
+class ReversiPatternEval
+{
+public:
+	/**
+	 * @brief Number of game stages with their own weights.
+	 */
+	static const unsigned int STAGES = 12;
+
+	/**
+	 * @brief Number of pattern instances on the board.
+	 */
+	static const unsigned int INSTANCES = 46;
+
+	/**
+	 * @brief Weight units per disc of the predicted final disc difference.
+	 */
+	static const int WEIGHT_SCALE = 16;
+
+	/**
+	 * @brief Signature shared by the scalar and the vectorized implementation.
+	 */
+	typedef int (*EvalFunction)(const ReversiPatternEval &eval, uint64_t own,
+			uint64_t opp);
+
+private:
+	/**
+	 * @brief One pattern instance: its cells and where its weights are.
+	 */
+	struct Instance
+	{
+		unsigned char cells[10]; ///< Cells in base-3 digit order (most significant first).
+		unsigned int size;       ///< Number of cells.
+		uint64_t mask;           ///< The cells as a bit mask.
+		unsigned int ternary;    ///< Offset of the bits to base-3 table in ternary.
+		unsigned int offset;     ///< Offset of the pattern's table within a stage.
+	};
+
+	Instance instances[INSTANCES];
+	std::vector<uint16_t> ternary; ///< Base-3 value of the pext bits of an instance.
+	std::vector<int16_t> weights;  ///< STAGES tables of stageSize weights, then padding.
+	unsigned int stageSize;        ///< Number of weights of one stage.
+
+	static std::atomic<EvalFunction> pEval;
+
+	/**
+	 * @brief Selects the implementation on first use and forwards the call.
+	 */
+	static int evalResolve(const ReversiPatternEval &eval, uint64_t own,
+			uint64_t opp);
+
+	/**
+	 * @brief Scalar implementation building the indices cell by cell.
+	 */
+	static int evalScalar(const ReversiPatternEval &eval, uint64_t own,
+			uint64_t opp);
+
+	/**
+	 * @brief AVX2 implementation with pext indices and gathered weights.
+	 */
+	static int evalAvx2(const ReversiPatternEval &eval, uint64_t own,
+			uint64_t opp);
+
+	/**
+	 * @brief Returns the index of the weight table of a stage.
+	 */
+	static unsigned int evalStage(uint64_t own, uint64_t opp)
+	{
+		unsigned int stage = (__builtin_popcountll(own | opp) - 4) / 5;
+		return (stage < STAGES) ? stage : STAGES - 1;
+	}
+
+	/**
+	 * @brief Computes the weight index of every instance within a stage.
+	 */
+	void evalIndices(uint64_t own, uint64_t opp, unsigned int *pIndices) const;
+
+	ReversiPatternEval(const ReversiPatternEval&);
+	ReversiPatternEval& operator=(const ReversiPatternEval&);
+
+public:
+	/**
+	 * @brief Builds the pattern instances and zero weights.
+	 */
+	ReversiPatternEval();
+
+	/**
+	 * @brief Evaluates a position.
+	 *
+	 * @param own Discs of the side to move.
+	 * @param opp Discs of the opponent.
+	 * @return The predicted final disc difference for the side to move, in
+	 *         units of 1/WEIGHT_SCALE disc.
+	 */
+	int evalScore(uint64_t own, uint64_t opp) const
+	{
+		return pEval.load(std::memory_order_relaxed)(*this, own, opp);
+	}
+
+	/**
+	 * @brief Evaluates a position with the scalar implementation, regardless of dispatch.
+	 */
+	int evalScoreScalar(uint64_t own, uint64_t opp) const
+	{
+		return evalScalar(*this, own, opp);
+	}
+
+	/**
+	 * @brief Reads the weights from a file written by evalSave().
+	 *
+	 * @param path The file name.
+	 * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be
+	 *         read or does not match the patterns.
+	 */
+	RC_t evalLoad(const char *path);
+
+	/**
+	 * @brief Writes the weights to a file.
+	 *
+	 * @param path The file name.
+	 * @return RC_OK if the operation was successful, RC_ERROR if the file cannot be written.
+	 */
+	RC_t evalSave(const char *path) const;
+
+	/**
+	 * @brief Fits the weights to the results of the 8x8 games of an archive.
+	 *
+	 * Every position of every game is a training sample whose target is the final
+	 * disc difference from the view of the side to move. The weights are fitted by
+	 * stochastic gradient descent on the squared error.
+	 *
+	 * @param archive The archive; games on other board sizes are skipped.
+	 * @param epochs Number of passes over all games.
+	 * @param rate Learning rate.
+	 * @param error Receives the root mean square error (in discs) of the last pass.
+	 * @return RC_OK if the operation was successful, RC_ERROR for a damaged game,
+	 *         RC_ERROR_BAD_PARAM if the archive has no 8x8 game.
+	 */
+	RC_t evalTrain(const ReversiArchiveReader &archive, unsigned int epochs,
+			double rate, double &error);
+
+	/**
+	 * @brief Returns the number of weights of all stages.
+	 */
+	size_t evalWeights() const
+	{
+		return (size_t) STAGES * stageSize;
+	}
+
+	/**
+	 * @brief Checks whether the CPU supports the AVX2 implementation (AVX2 and BMI2).
+	 */
+	static bool evalHasAvx2();
+
+	/**
+	 * @brief Enables or disables the vectorized implementation.
+	 *
+	 * @param enable true to use AVX2 when available, false to force the scalar code.
+	 * @return true if the vectorized implementation is active afterwards.
+	 */
+	static bool evalUseSimd(bool enable);
+};
+
+#endif /* REVERSIPATTERNEVAL_H_ */
@@ -0,0 +1,165 @@
+/*
+ * ReversiRules.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiRules.cpp
+ * @brief Implements the generic rules and the board factory.
+ */
+
+#include "ReversiRules.h"
+#include "ReversiFixedBoard.h"
+
+using namespace std;
+
+/**
+ * @brief Creates the fastest available board of the given size.
+ *
+ * @param rows The number of rows (at least 2).
+ * @param columns The number of columns (at least 2).
+ * @return The board, or an empty pointer for sizes below 2x2.
+ */
+unique_ptr<ReversiRules> ReversiRules::rulesCreate(unsigned int rows,
+		unsigned int columns)
+{
+	if (rows < 2 || columns < 2)
+	{
+		return unique_ptr<ReversiRules>();
+	}
+
+	if (rows == 8 && columns == 8)
+	{
+		return unique_ptr<ReversiRules>(new ReversiFixedBoard<8, 8>());
+	}
+	if (rows == 6 && columns == 6)
+	{
+		return unique_ptr<ReversiRules>(new ReversiFixedBoard<6, 6>());
+	}
+	if (rows == 4 && columns == 4)
+	{
+		return unique_ptr<ReversiRules>(new ReversiFixedBoard<4, 4>());
+	}
+#ifdef __SIZEOF_INT128__
+	if (rows == 10 && columns == 10)
+	{
+		return unique_ptr<ReversiRules>(new ReversiFixedBoard<10, 10>());
+	}
+#endif
+	return unique_ptr<ReversiRules>(new ReversiGenericRules(rows, columns));
+}
+
+/**
+ * @brief Constructs a board in the initial position.
+ */
+ReversiGenericRules::ReversiGenericRules(unsigned int rows,
+		unsigned int columns) :
+		board(rows, columns)
+{
+	board.boardInitialState(rows, columns);
+}
+
+unsigned int ReversiGenericRules::rulesRows() const
+{
+	return board.boardRows();
+}
+
+unsigned int ReversiGenericRules::rulesColumns() const
+{
+	return board.boardColumns();
+}
+
+bool ReversiGenericRules::rulesSpecialized() const
+{
+	return false;
+}
+
+void ReversiGenericRules::rulesInitialState()
+{
+	board.boardClear();
+	board.boardInitialState(board.boardRows(), board.boardColumns());
+}
+
+char ReversiGenericRules::rulesGet(unsigned int row, unsigned int column) const
+{
+	return board.boardGet(row, column);
+}
+
+char ReversiGenericRules::rulesSideToMove() const
+{
+	return board.boardSideToMove();
+}
+
+void ReversiGenericRules::rulesMoves(char coin, ReversiMask &moves) const
+{
+	board.generateMoves(coin, moves);
+}
+
+bool ReversiGenericRules::rulesMakeMove(unsigned int index, char coin)
+{
+	return board.makeMove(index, coin) != 0;
+}
+
+bool ReversiGenericRules::rulesMakePass(char coin)
+{
+	return board.makePass(coin) != 0;
+}
+
+RC_t ReversiGenericRules::rulesUnmakeMove()
+{
+	return board.unmakeMove();
+}
+
+unsigned int ReversiGenericRules::rulesCount(char coin) const
+{
+	return board.boardDiscs(coin).maskCount();
+}
+
+uint64_t ReversiGenericRules::rulesHash() const
+{
+	return board.boardHash();
+}
+
+uint64_t ReversiGenericRules::rulesPerft(unsigned int depth)
+{
+	return rulesPerftCount(board.boardSideToMove(), depth, false);
+}
+
+/**
+ * @brief Recursive part of rulesPerft().
+ */
+uint64_t ReversiGenericRules::rulesPerftCount(char coin, unsigned int depth,
+		bool passed)
+{
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	char other = (coin == 'x') ? 'o' : 'x';
+	ReversiMask moves = board.generateMoves(coin);
+
+	if (!moves.maskAny())
+	{
+		// Two passes in a row end the game
+		if (passed)
+		{
+			return 1;
+		}
+		board.makePass(coin);
+		uint64_t nodes = rulesPerftCount(other, depth - 1, true);
+		board.unmakeMove();
+		return nodes;
+	}
+
+	uint64_t nodes = 0;
+	for (unsigned int bit = 0; moves.maskNext(bit); bit++)
+	{
+		board.makeMove(bit, coin);
+		nodes += rulesPerftCount(other, depth - 1, false);
+		board.unmakeMove();
+	}
+	return nodes;
+}
@@ -0,0 +1,181 @@
+/*
+ * ReversiRules.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiRules.h
+ * @brief Declares the common interface of the generic and the size-specialized boards.
+ *
+ * ReversiBoard takes its size at runtime, so all its index, bounds and direction
+ * calculations are generic. ReversiFixedBoard<Rows, Columns> fixes the size at
+ * compile time. rulesCreate() picks the specialized board for common sizes and
+ * wraps a ReversiBoard for all others, so callers can use either through the
+ * same interface. Hot loops that should not pay for a virtual call per move are
+ * run inside the board (see rulesPerft()).
+ */
+
+#ifndef REVERSIRULES_H_
+#define REVERSIRULES_H_
+
+#include <memory>
+#include <stdint.h>
+
+#include "global.h"
+#include "ReversiBoard.h"
+#include "ReversiMask.h"
+
+/**
+ * @class ReversiRules
+ * @brief The game rules on a board of some size: moves, flips and take-backs.
+ */
+class ReversiRules
+{
+public:
+	virtual ~ReversiRules()
+	{
+	}
+
+	/**
+	 * @brief Creates the fastest available board of the given size.
+	 *
+	 * 4x4, 6x6, 8x8 and 10x10 get a ReversiFixedBoard, all other sizes the generic
+	 * ReversiBoard. The board is set to the initial position.
+	 *
+	 * @param rows The number of rows (at least 2).
+	 * @param columns The number of columns (at least 2).
+	 * @return The board, or an empty pointer for sizes below 2x2.
+	 */
+	static std::unique_ptr<ReversiRules> rulesCreate(unsigned int rows,
+			unsigned int columns);
+
+	/**
+	 * @brief Returns the number of rows of the board.
+	 */
+	virtual unsigned int rulesRows() const = 0;
+
+	/**
+	 * @brief Returns the number of columns of the board.
+	 */
+	virtual unsigned int rulesColumns() const = 0;
+
+	/**
+	 * @brief Returns true for a board with a compile-time size.
+	 */
+	virtual bool rulesSpecialized() const = 0;
+
+	/**
+	 * @brief Clears the board, places the four initial discs and gives the turn to 'x'.
+	 */
+	virtual void rulesInitialState() = 0;
+
+	/**
+	 * @brief Returns the coin at a position ('x', 'o' or '.').
+	 */
+	virtual char rulesGet(unsigned int row, unsigned int column) const = 0;
+
+	/**
+	 * @brief Returns the player to move ('x' or 'o').
+	 */
+	virtual char rulesSideToMove() const = 0;
+
+	/**
+	 * @brief Computes all legal moves of a player.
+	 *
+	 * @param coin The player ('x' or 'o').
+	 * @param moves Receives one bit per legal cell (resized to the board if needed).
+	 */
+	virtual void rulesMoves(char coin, ReversiMask &moves) const = 0;
+
+	/**
+	 * @brief Plays a move given by its cell index.
+	 *
+	 * @param index The cell index (row * columns + column).
+	 * @param coin The coin to place ('x' or 'o').
+	 * @return true if the move was legal and has been played.
+	 */
+	virtual bool rulesMakeMove(unsigned int index, char coin) = 0;
+
+	/**
+	 * @brief Records a pass of a player.
+	 *
+	 * @param coin The passing player ('x' or 'o').
+	 * @return true if the pass has been recorded, false if the undo stack is full.
+	 */
+	virtual bool rulesMakePass(char coin) = 0;
+
+	/**
+	 * @brief Takes back the last move or pass.
+	 *
+	 * @return RC_OK if the operation was successful, RC_ERROR if there is nothing to take back.
+	 */
+	virtual RC_t rulesUnmakeMove() = 0;
+
+	/**
+	 * @brief Returns the number of discs of a player.
+	 */
+	virtual unsigned int rulesCount(char coin) const = 0;
+
+	/**
+	 * @brief Returns the Zobrist hash of the position (same keys as ReversiBoard::boardHash()).
+	 */
+	virtual uint64_t rulesHash() const = 0;
+
+	/**
+	 * @brief Counts the leaf nodes of the game tree up to a fixed depth.
+	 *
+	 * Same counting as ReversiBenchmark::benchPerftCount(): a pass is one ply and
+	 * finished games are leaves. The position is unchanged on return.
+	 *
+	 * @param depth Depth in plies.
+	 * @return The number of leaf nodes.
+	 */
+	virtual uint64_t rulesPerft(unsigned int depth) = 0;
+};
+
+/**
+ * @class ReversiGenericRules
+ * @brief The rules interface on top of the generic ReversiBoard (any size).
+ */
+class ReversiGenericRules: public ReversiRules
+{
+private:
+	ReversiBoard board;
+
+	/**
+	 * @brief Recursive part of rulesPerft().
+	 */
+	uint64_t rulesPerftCount(char coin, unsigned int depth, bool passed);
+
+public:
+	/**
+	 * @brief Constructs a board in the initial position.
+	 */
+	ReversiGenericRules(unsigned int rows, unsigned int columns);
+
+	/**
+	 * @brief Returns the underlying board.
+	 */
+	const ReversiBoard& rulesBoard() const
+	{
+		return board;
+	}
+
+	unsigned int rulesRows() const override;
+	unsigned int rulesColumns() const override;
+	bool rulesSpecialized() const override;
+	void rulesInitialState() override;
+	char rulesGet(unsigned int row, unsigned int column) const override;
+	char rulesSideToMove() const override;
+	void rulesMoves(char coin, ReversiMask &moves) const override;
+	bool rulesMakeMove(unsigned int index, char coin) override;
+	bool rulesMakePass(char coin) override;
+	RC_t rulesUnmakeMove() override;
+	unsigned int rulesCount(char coin) const override;
+	uint64_t rulesHash() const override;
+	uint64_t rulesPerft(unsigned int depth) override;
+};
+
+#endif /* REVERSIRULES_H_ */
@@ -0,0 +1,594 @@
+/*
+ * ReversiSearch.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiSearch.cpp
+ * @brief Implements the alpha-beta search engine.
+ *
+ * Passes do not use up depth, so an iteration of depth n always looks n moves
+ * ahead; two passes in a row end the game and are scored by the final disc count.
+ */
+
+#include "ReversiSearch.h"
+
+using namespace std;
+
+const unsigned int ReversiSearch::NO_MOVE;
+const int ReversiSearch::SCORE_INFINITE;
+const int ReversiSearch::SCORE_WIN;
+const unsigned int ReversiSearch::MAX_DEPTH;
+
+// Half width of the first aspiration window around the previous score
+static const int ASPIRATION_WINDOW = 50;
+
+// Ordering scores of the transposition table move and the two killers
+static const unsigned int ORDER_TT_MOVE = 0xFFFFFFFFu;
+static const unsigned int ORDER_KILLER_1 = 0xFFFFFFFEu;
+static const unsigned int ORDER_KILLER_2 = 0xFFFFFFFDu;
+
+// History scores are halved when one of them grows beyond this value
+static const unsigned int HISTORY_LIMIT = 1u << 24;
+
+/**
+ * @brief Constructs an engine using the given transposition table.
+ *
+ * @param tt The transposition table; must outlive the engine.
+ */
+ReversiSearch::ReversiSearch(ReversiTransTable &tt) :
+		tt(tt), board(0, 0), nodes(0), stopped(false), stopRequest(false), budget(
+				false), plies(0), sizeKey(0), thread(0), pSharedStop(0), pStopFlag(
+				0), pPatternEval(0)
+{
+}
+
+/**
+ * @brief Resizes the per-ply buffers for the current board and depth.
+ *
+ * Between two moves there is at most one pass, so 2 * depth + 2 plies are enough.
+ * Killer and history tables survive the resize when the board size stays the same.
+ * The Zobrist keys do not depend on the board size, so the size is mixed into the
+ * transposition table key to keep boards of different sizes apart.
+ *
+ * @param depth The deepest iteration that will be searched.
+ */
+void ReversiSearch::searchPrepare(unsigned int depth)
+{
+	unsigned int cells = board.boardCells().maskBits();
+
+	plies = 2 * depth + 2;
+	sizeKey = ((uint64_t) board.boardRows() << 32 | board.boardColumns())
+			* 0xC2B2AE3D27D4EB4FULL;
+	if (history.size() != 2 * cells)
+	{
+		history.assign(2 * cells, 0);
+		killers.clear();
+	}
+	killers.resize(2 * plies, NO_MOVE);
+	moveList.resize(plies * cells);
+	moveScore.resize(plies * cells);
+	pvTable.resize(plies * plies);
+	pvLength.resize(plies);
+	if (moves.maskBits() != cells)
+	{
+		moves.maskResize(cells);
+	}
+}
+
+/**
+ * @brief Checks the node and time budget; sets stopped when it is used up.
+ *
+ * The budget only applies once the first iteration has completed, so every
+ * search returns a legal move. The shared stop flag of a helper thread applies
+ * at once, as its result is only used if it searched deeper than the main thread.
+ */
+void ReversiSearch::searchCheckLimits()
+{
+	if (pSharedStop && pSharedStop->load(memory_order_relaxed))
+	{
+		stopped = true;
+	}
+	if (!budget)
+	{
+		return;
+	}
+	if (stopRequest.load(memory_order_relaxed)
+			|| (pStopFlag && pStopFlag->load(memory_order_relaxed))
+			|| (limits.maxNodes && nodes >= limits.maxNodes))
+	{
+		stopped = true;
+	}
+	else if (limits.maxTime
+			&& chrono::steady_clock::now() - start
+					>= chrono::milliseconds(limits.maxTime))
+	{
+		stopped = true;
+	}
+}
+
+/**
+ * @brief Evaluates a position from the view of the side to move.
+ *
+ * With a pattern evaluation on an 8x8 board its score is used. Otherwise corners
+ * are worth 100, every legal move 10 and every disc 1 point. A position in which
+ * neither player can move is scored as a finished game.
+ */
+int ReversiSearch::searchEvaluate()
+{
+	char side = board.boardSideToMove();
+	char other = (side == 'x') ? 'o' : 'x';
+	const ReversiMask &own = board.boardDiscs(side);
+	const ReversiMask &opp = board.boardDiscs(other);
+	unsigned int rows = board.boardRows();
+	unsigned int columns = board.boardColumns();
+
+	unsigned int mobility = board.boardMobility(side);
+	unsigned int otherMobility = board.boardMobility(other);
+
+	// Neither player can move: the game is over
+	if (mobility == 0 && otherMobility == 0)
+	{
+		return searchFinalScore();
+	}
+
+	int score = 0;
+	if (pPatternEval && rows == 8 && columns == 8)
+	{
+		score = pPatternEval->evalScore(own.maskWord(0), opp.maskWord(0));
+	}
+	else
+	{
+		const unsigned int corners[4] =
+		{ 0, columns - 1, (rows - 1) * columns, rows * columns - 1 };
+
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			score += 100
+					* ((int) own.maskTest(corners[i]) - (int) opp.maskTest(corners[i]));
+		}
+		score += 10 * ((int) mobility - (int) otherMobility);
+		score += (int) board.boardCount(side) - (int) board.boardCount(other);
+	}
+
+	if (score >= SCORE_WIN)
+	{
+		return SCORE_WIN - 1;
+	}
+	if (score <= -SCORE_WIN)
+	{
+		return -SCORE_WIN + 1;
+	}
+	return score;
+}
+
+/**
+ * @brief Returns the score of a finished game from the view of the side to move.
+ *
+ * A won game scores SCORE_WIN plus the disc difference, so that the engine prefers
+ * any win to the best heuristic score and a big win to a narrow one.
+ */
+int ReversiSearch::searchFinalScore() const
+{
+	char side = board.boardSideToMove();
+	int difference = (int) board.boardCount(side)
+			- (int) board.boardCount((side == 'x') ? 'o' : 'x');
+
+	if (difference > SCORE_INFINITE - SCORE_WIN - 1)
+	{
+		difference = SCORE_INFINITE - SCORE_WIN - 1;
+	}
+	else if (difference < -(SCORE_INFINITE - SCORE_WIN - 1))
+	{
+		difference = -(SCORE_INFINITE - SCORE_WIN - 1);
+	}
+
+	if (difference > 0)
+	{
+		return SCORE_WIN + difference;
+	}
+	if (difference < 0)
+	{
+		return -SCORE_WIN + difference;
+	}
+	return 0;
+}
+
+/**
+ * @brief Collects and orders the legal moves of the side to move at a ply.
+ *
+ * Only the ordering scores are computed here; the search picks the best remaining
+ * move one at a time, so a cutoff does not pay for sorting the whole list.
+ *
+ * @param ply Distance from the root.
+ * @param ttMove Move from the transposition table, searched first.
+ * @return The number of moves in the move list of the ply.
+ */
+unsigned int ReversiSearch::searchOrderMoves(unsigned int ply,
+		unsigned int ttMove)
+{
+	char side = board.boardSideToMove();
+	unsigned int cells = moves.maskBits();
+	unsigned int *list = &moveList[ply * cells];
+	unsigned int *score = &moveScore[ply * cells];
+	const unsigned int *sideHistory = &history[(side == 'x') ? 0 : cells];
+	unsigned int count = 0;
+
+	board.generateMoves(side, moves);
+	for (unsigned int b = 0; moves.maskNext(b); b++)
+	{
+		list[count] = b;
+		if (b == ttMove)
+		{
+			score[count] = ORDER_TT_MOVE;
+		}
+		else if (b == killers[2 * ply])
+		{
+			score[count] = ORDER_KILLER_1;
+		}
+		else if (b == killers[2 * ply + 1])
+		{
+			score[count] = ORDER_KILLER_2;
+		}
+		else
+		{
+			score[count] = sideHistory[b];
+		}
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Searches a position with a negamax alpha-beta search.
+ *
+ * The first move is searched with the full window, all others with a null window
+ * that is only widened when a move turns out to be better (principal variation
+ * search). Cutoffs are remembered in the killer and history tables.
+ *
+ * @param alpha Lower bound of the window.
+ * @param beta Upper bound of the window.
+ * @param depth Remaining depth in plies.
+ * @param ply Distance from the root.
+ * @param passed The previous ply was a pass.
+ * @return The score from the view of the side to move.
+ */
+int ReversiSearch::searchNegamax(int alpha, int beta, unsigned int depth,
+		unsigned int ply, bool passed)
+{
+	pvLength[ply] = ply;
+
+	if ((++nodes & 1023) == 0)
+	{
+		searchCheckLimits();
+	}
+	if (stopped)
+	{
+		return 0;
+	}
+	if (depth == 0 || ply + 1 >= plies)
+	{
+		return searchEvaluate();
+	}
+
+	bool pvNode = beta - alpha > 1;
+	uint64_t hash = board.boardHash() ^ sizeKey;
+	unsigned int ttMove = NO_MOVE;
+	ReversiTTEntry entry;
+
+	if (tt.ttProbe(hash, entry))
+	{
+		ttMove = entry.move;
+		if (!pvNode && entry.depth >= depth)
+		{
+			if (entry.bound == TT_BOUND_EXACT
+					|| (entry.bound == TT_BOUND_LOWER && entry.score >= beta)
+					|| (entry.bound == TT_BOUND_UPPER && entry.score <= alpha))
+			{
+				return entry.score;
+			}
+		}
+	}
+
+	char side = board.boardSideToMove();
+	unsigned int count = searchOrderMoves(ply, ttMove);
+	int score;
+
+	if (count == 0)
+	{
+		if (passed)
+		{
+			return searchFinalScore();
+		}
+
+		board.makePass(side);
+		score = -searchNegamax(-beta, -alpha, depth, ply + 1, true);
+		board.unmakeMove();
+
+		pvTable[ply * plies + ply] = ReversiUndo::PASS;
+		for (unsigned int i = ply + 1; i < pvLength[ply + 1]; i++)
+		{
+			pvTable[ply * plies + i] = pvTable[(ply + 1) * plies + i];
+		}
+		pvLength[ply] = (pvLength[ply + 1] > ply + 1) ? pvLength[ply + 1] : ply + 1;
+		return score;
+	}
+
+	unsigned int cells = moves.maskBits();
+	unsigned int *list = &moveList[ply * cells];
+	unsigned int *order = &moveScore[ply * cells];
+	int alphaStart = alpha;
+	int bestScore = -SCORE_INFINITE;
+	unsigned int bestMove = NO_MOVE;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		// Pick the best remaining move
+		unsigned int best = i;
+		for (unsigned int j = i + 1; j < count; j++)
+		{
+			if (order[j] > order[best])
+			{
+				best = j;
+			}
+		}
+		unsigned int move = list[best];
+		list[best] = list[i];
+		order[best] = order[i];
+		list[i] = move;
+
+		board.makeMove(move, side);
+		if (i == 0)
+		{
+			score = -searchNegamax(-beta, -alpha, depth - 1, ply + 1, false);
+		}
+		else
+		{
+			score = -searchNegamax(-alpha - 1, -alpha, depth - 1, ply + 1, false);
+			if (score > alpha && score < beta)
+			{
+				score = -searchNegamax(-beta, -alpha, depth - 1, ply + 1, false);
+			}
+		}
+		board.unmakeMove();
+
+		if (stopped)
+		{
+			return 0;
+		}
+		if (score <= bestScore)
+		{
+			continue;
+		}
+
+		bestScore = score;
+		bestMove = move;
+		if (score <= alpha)
+		{
+			continue;
+		}
+
+		alpha = score;
+		pvTable[ply * plies + ply] = move;
+		for (unsigned int j = ply + 1; j < pvLength[ply + 1]; j++)
+		{
+			pvTable[ply * plies + j] = pvTable[(ply + 1) * plies + j];
+		}
+		pvLength[ply] = (pvLength[ply + 1] > ply + 1) ? pvLength[ply + 1] : ply + 1;
+
+		if (alpha >= beta)
+		{
+			if (move != ttMove && move != killers[2 * ply])
+			{
+				killers[2 * ply + 1] = killers[2 * ply];
+				killers[2 * ply] = move;
+			}
+
+			unsigned int *sideHistory = &history[(side == 'x') ? 0 : cells];
+			sideHistory[move] += depth * depth;
+			if (sideHistory[move] > HISTORY_LIMIT)
+			{
+				for (unsigned int j = 0; j < history.size(); j++)
+				{
+					history[j] >>= 1;
+				}
+			}
+			break;
+		}
+	}
+
+	TTBound_t bound = TT_BOUND_EXACT;
+	if (bestScore <= alphaStart)
+	{
+		bound = TT_BOUND_UPPER;
+	}
+	else if (bestScore >= beta)
+	{
+		bound = TT_BOUND_LOWER;
+	}
+	tt.ttStore(hash, bestMove, bestScore, depth, bound);
+
+	return bestScore;
+}
+
+/**
+ * @brief Searches a position and returns the best move of its side to move.
+ *
+ * Each iteration starts with a narrow window around the score of the previous
+ * one and widens it on failure. The search ends after the deepest iteration, when
+ * the budget is used up, or when an iteration covered all empty cells.
+ *
+ * @param position The position; the side to move is taken from boardSideToMove().
+ * @param limits Depth, node and time budget.
+ * @param result Best move, score and principal variation of the last completed iteration.
+ * @return RC_OK if the search ran, RC_ERROR_BAD_PARAM for a board without cells.
+ */
+RC_t ReversiSearch::searchRun(const ReversiBoard &position,
+		const ReversiSearchLimits &limits, ReversiSearchResult &result)
+{
+	unsigned int cells = position.boardCells().maskBits();
+
+	if (cells == 0)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	start = chrono::steady_clock::now();
+	board = position;
+	this->limits = limits;
+	nodes = 0;
+	stopped = false;
+	stopRequest.store(false, memory_order_relaxed);
+	budget = false;
+
+	unsigned int empties = cells - board.boardCount('x') - board.boardCount('o');
+	unsigned int maxDepth = limits.maxDepth ? limits.maxDepth : MAX_DEPTH;
+	if (maxDepth > empties)
+	{
+		maxDepth = empties;
+	}
+	if (maxDepth > 255)
+	{
+		maxDepth = 255;
+	}
+	if (maxDepth == 0)
+	{
+		maxDepth = 1;
+	}
+
+	searchPrepare(maxDepth);
+	if (thread == 0)
+	{
+		tt.ttNewSearch();
+	}
+
+	result.bestMove = NO_MOVE;
+	result.score = 0;
+	result.depth = 0;
+	result.pv.clear();
+
+	// A finished game has no move, not even a pass
+	if (board.boardGameOver())
+	{
+		result.score = searchFinalScore();
+		result.nodes = 0;
+		result.seconds = 0;
+		return RC_OK;
+	}
+
+	int previous = 0;
+	// Odd helper threads run one ply ahead, so that the threads do not all search the same tree
+	for (unsigned int depth = 1 + (thread & 1); depth <= maxDepth; depth++)
+	{
+		int delta = ASPIRATION_WINDOW;
+		int alpha = -SCORE_INFINITE;
+		int beta = SCORE_INFINITE;
+		int score;
+
+		if (depth >= 3)
+		{
+			alpha = (previous - delta > -SCORE_INFINITE) ? previous - delta : -SCORE_INFINITE;
+			beta = (previous + delta < SCORE_INFINITE) ? previous + delta : SCORE_INFINITE;
+		}
+
+		for (;;)
+		{
+			score = searchNegamax(alpha, beta, depth, 0, false);
+			if (stopped)
+			{
+				break;
+			}
+
+			delta *= 4;
+			if (score <= alpha && alpha > -SCORE_INFINITE)
+			{
+				alpha = (score - delta > -SCORE_INFINITE) ? score - delta : -SCORE_INFINITE;
+			}
+			else if (score >= beta && beta < SCORE_INFINITE)
+			{
+				beta = (score + delta < SCORE_INFINITE) ? score + delta : SCORE_INFINITE;
+			}
+			else
+			{
+				break;
+			}
+		}
+		if (stopped)
+		{
+			break;
+		}
+
+		previous = score;
+		result.score = score;
+		result.depth = depth;
+		result.pv.assign(pvTable.begin(), pvTable.begin() + pvLength[0]);
+		result.bestMove = result.pv.empty() ? NO_MOVE : result.pv[0];
+
+		// From now on the budget applies; the result above is always available
+		budget = true;
+		searchCheckLimits();
+		if (stopped)
+		{
+			break;
+		}
+	}
+
+	result.nodes = nodes;
+	result.seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return RC_OK;
+}
+
+/**
+ * @brief Asks a running search to stop as soon as possible. Thread safe.
+ *
+ * The search still completes its first iteration, so it always returns a move.
+ */
+void ReversiSearch::searchStop()
+{
+	stopRequest.store(true, memory_order_relaxed);
+}
+
+/**
+ * @brief Makes the engine a helper thread of a parallel search.
+ *
+ * @param thread Number of the thread; 0 is the main thread.
+ * @param pSharedStop Stop flag set when the main thread has finished, or 0.
+ */
+void ReversiSearch::searchSetThread(unsigned int thread,
+		const atomic<bool> *pSharedStop)
+{
+	this->thread = thread;
+	this->pSharedStop = pSharedStop;
+}
+
+/**
+ * @brief Sets a stop flag owned by the caller.
+ *
+ * @param pStopFlag The flag, or 0; must outlive the engine.
+ */
+void ReversiSearch::searchSetStopFlag(const atomic<bool> *pStopFlag)
+{
+	this->pStopFlag = pStopFlag;
+}
+
+/**
+ * @brief Sets the pattern evaluation used on 8x8 boards.
+ *
+ * @param pPatternEval The trained evaluation, or 0; must outlive the engine.
+ */
+void ReversiSearch::searchSetEvaluator(const ReversiPatternEval *pPatternEval)
+{
+	this->pPatternEval = pPatternEval;
+}
+
+/**
+ * @brief Clears killer and history tables (e.g. before a new game).
+ */
+void ReversiSearch::searchClear()
+{
+	history.assign(history.size(), 0);
+	killers.assign(killers.size(), NO_MOVE);
+}
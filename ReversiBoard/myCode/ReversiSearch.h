@@ -0,0 +1,224 @@
+/*
+ * ReversiSearch.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiSearch.h
+ * @brief Declares the alpha-beta search engine used by the computer player.
+ *
+ * The engine runs a negamax alpha-beta search with iterative deepening, aspiration
+ * windows and principal variation search on a private copy of the position. Moves
+ * are ordered by the transposition table move, two killer moves per ply and a
+ * history table. The search stops when a node or time budget is used up and returns
+ * the result of the last completed iteration.
+ */
+
+#ifndef REVERSISEARCH_H_
+#define REVERSISEARCH_H_
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <vector>
+
+#include "global.h"
+#include "ReversiBoard.h"
+#include "ReversiPatternEval.h"
+#include "ReversiTransTable.h"
+
+/**
+ * @brief Budget of a search. A value of 0 means "no limit".
+ */
+struct ReversiSearchLimits
+{
+	unsigned int maxDepth; ///< Deepest iteration to search (in plies).
+	uint64_t maxNodes;     ///< Number of nodes after which the search stops.
+	unsigned int maxTime;  ///< Time in milliseconds after which the search stops.
+
+	ReversiSearchLimits() :
+			maxDepth(0), maxNodes(0), maxTime(0)
+	{
+	}
+};
+
+/**
+ * @brief Result of a search.
+ */
+struct ReversiSearchResult
+{
+	unsigned int bestMove;        ///< Cell index, ReversiUndo::PASS or NO_MOVE if the game is over.
+	int score;                    ///< Score from the view of the side to move.
+	unsigned int depth;           ///< Depth of the last completed iteration.
+	uint64_t nodes;               ///< Nodes visited by the whole search.
+	double seconds;               ///< Time used by the whole search.
+	std::vector<unsigned int> pv; ///< Principal variation, starting with bestMove.
+};
+
+/**
+ * @class ReversiSearch
+ * @brief Negamax alpha-beta search sharing a transposition table.
+ *
+ * One object is used by one thread at a time; several objects may share the same
+ * transposition table. All per-ply buffers are allocated once per search, so the
+ * search itself does not allocate memory.
+ */
+class ReversiSearch
+{
+public:
+	/**
+	 * @brief Move value used when there is no move (game over).
+	 */
+	static const unsigned int NO_MOVE = ReversiTransTable::NO_MOVE;
+
+	/**
+	 * @brief Largest absolute score; used as the initial search window.
+	 */
+	static const int SCORE_INFINITE = 32000;
+
+	/**
+	 * @brief Base score of a won game. The final disc difference is added on top.
+	 */
+	static const int SCORE_WIN = 16000;
+
+	/**
+	 * @brief Deepest iteration searched when the limits do not say otherwise.
+	 */
+	static const unsigned int MAX_DEPTH = 64;
+
+private:
+	ReversiTransTable &tt;            ///< Transposition table, possibly shared.
+	ReversiBoard board;               ///< Private copy of the position being searched.
+	ReversiSearchLimits limits;       ///< Budget of the running search.
+	std::chrono::steady_clock::time_point start; ///< Start time of the running search.
+	uint64_t nodes;                   ///< Nodes visited by the running search.
+	bool stopped;                     ///< The running search ran out of budget.
+	std::atomic<bool> stopRequest;    ///< Set by searchStop() from any thread.
+	bool budget;                      ///< The budget applies (first iteration completed).
+	unsigned int plies;               ///< Number of plies the per-ply buffers hold.
+	uint64_t sizeKey;                 ///< Board size key mixed into the table key.
+	unsigned int thread;              ///< Thread number in a parallel search (0 = main).
+	const std::atomic<bool> *pSharedStop; ///< Stop flag of a parallel search, or 0.
+	const std::atomic<bool> *pStopFlag;   ///< Stop flag of the owner (searchSetStopFlag()), or 0.
+	const ReversiPatternEval *pPatternEval; ///< Pattern evaluation for 8x8 boards, or 0.
+	std::vector<unsigned int> killers;   ///< Two killer moves per ply.
+	std::vector<unsigned int> history;   ///< History score per player and cell.
+	std::vector<unsigned int> moveList;  ///< Move list per ply, cells entries each.
+	std::vector<unsigned int> moveScore; ///< Ordering score per move list entry.
+	std::vector<unsigned int> pvTable;   ///< Triangular principal variation table.
+	std::vector<unsigned int> pvLength;  ///< Length of the variation per ply.
+	ReversiMask moves;                ///< Scratch mask for move generation.
+
+	/**
+	 * @brief Resizes the per-ply buffers for the current board and depth.
+	 *
+	 * @param depth The deepest iteration that will be searched.
+	 */
+	void searchPrepare(unsigned int depth);
+
+	/**
+	 * @brief Checks the node and time budget; sets stopped when it is used up.
+	 */
+	void searchCheckLimits();
+
+	/**
+	 * @brief Evaluates a position from the view of the side to move.
+	 *
+	 * The evaluation counts corners, mobility and discs; only finished games reach
+	 * SCORE_WIN.
+	 */
+	int searchEvaluate();
+
+	/**
+	 * @brief Returns the score of a finished game from the view of the side to move.
+	 */
+	int searchFinalScore() const;
+
+	/**
+	 * @brief Collects and orders the legal moves of the side to move at a ply.
+	 *
+	 * @param ply Distance from the root.
+	 * @param ttMove Move from the transposition table, searched first.
+	 * @return The number of moves in the move list of the ply.
+	 */
+	unsigned int searchOrderMoves(unsigned int ply, unsigned int ttMove);
+
+	/**
+	 * @brief Searches a position with a negamax alpha-beta search.
+	 *
+	 * @param alpha Lower bound of the window.
+	 * @param beta Upper bound of the window.
+	 * @param depth Remaining depth in plies.
+	 * @param ply Distance from the root.
+	 * @param passed The previous ply was a pass.
+	 * @return The score from the view of the side to move.
+	 */
+	int searchNegamax(int alpha, int beta, unsigned int depth, unsigned int ply,
+			bool passed);
+
+public:
+	/**
+	 * @brief Constructs an engine using the given transposition table.
+	 *
+	 * @param tt The transposition table; must outlive the engine.
+	 */
+	explicit ReversiSearch(ReversiTransTable &tt);
+
+	/**
+	 * @brief Searches a position and returns the best move of its side to move.
+	 *
+	 * @param position The position; the side to move is taken from boardSideToMove().
+	 * @param limits Depth, node and time budget.
+	 * @param result Best move, score and principal variation of the last completed iteration.
+	 * @return RC_OK if the search ran, RC_ERROR_BAD_PARAM for a board without cells.
+	 */
+	RC_t searchRun(const ReversiBoard &position, const ReversiSearchLimits &limits,
+			ReversiSearchResult &result);
+
+	/**
+	 * @brief Asks a running search to stop as soon as possible. Thread safe.
+	 */
+	void searchStop();
+
+	/**
+	 * @brief Makes the engine a helper thread of a parallel search.
+	 *
+	 * Only the main thread (0) starts a new table generation; odd helper threads
+	 * search one ply deeper than the main thread. A helper stops as soon as the
+	 * shared flag is set.
+	 *
+	 * @param thread Number of the thread; 0 is the main thread.
+	 * @param pSharedStop Stop flag set when the main thread has finished, or 0.
+	 */
+	void searchSetThread(unsigned int thread,
+			const std::atomic<bool> *pSharedStop);
+
+	/**
+	 * @brief Sets a stop flag owned by the caller.
+	 *
+	 * The flag acts like searchStop() but is not reset when a search starts, so a
+	 * stop requested just before searchRun() is not lost. The owner clears it.
+	 *
+	 * @param pStopFlag The flag, or 0; must outlive the engine.
+	 */
+	void searchSetStopFlag(const std::atomic<bool> *pStopFlag);
+
+	/**
+	 * @brief Sets the pattern evaluation used on 8x8 boards.
+	 *
+	 * Without one (and on other board sizes) positions are evaluated by corners,
+	 * mobility and discs.
+	 *
+	 * @param pPatternEval The trained evaluation, or 0; must outlive the engine.
+	 */
+	void searchSetEvaluator(const ReversiPatternEval *pPatternEval);
+
+	/**
+	 * @brief Clears killer and history tables (e.g. before a new game).
+	 */
+	void searchClear();
+};
+
+#endif /* REVERSISEARCH_H_ */
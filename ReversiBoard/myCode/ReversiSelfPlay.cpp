@@ -0,0 +1,323 @@
+/*
+ * ReversiSelfPlay.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiSelfPlay.cpp
+ * @brief Implements the headless self-play driver.
+ */
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ReversiSelfPlay.h"
+
+using namespace std;
+
+// Size of the transposition table of the engines of one worker
+static const size_t ENGINE_TABLE_MB = 1;
+
+// Nodes of the MCTS arena of the engines of one worker
+static const uint32_t MCTS_NODES = 1 << 18;
+
+/**
+ * @brief Constructs a driver with the given settings.
+ *
+ * @param config The settings of the run.
+ */
+ReversiSelfPlay::ReversiSelfPlay(const ReversiSelfPlayConfig &config) :
+		config(config)
+{
+}
+
+/**
+ * @brief Sets a function to be called after every game, e.g. to store it.
+ *
+ * @param onGame The function, or an empty function for none.
+ */
+void ReversiSelfPlay::selfPlaySetCallback(const GameCallback &onGame)
+{
+	this->onGame = onGame;
+}
+
+/**
+ * @brief Plays one game from the initial position to its end.
+ *
+ * The game ends as soon as neither player can move, so the history of the board
+ * ends with the last move played.
+ *
+ * @param board The board to play on (rows and columns of the game); it is cleared first.
+ * @param rng The random number generator of the game.
+ * @param pEngineX Engine of 'x', or 0 for random moves.
+ * @param pEngineO Engine of 'o', or 0 for random moves.
+ * @param engineNodes Node budget per engine move.
+ * @param pMctsX MCTS engine of 'x' (used if pEngineX is 0), or 0.
+ * @param pMctsO MCTS engine of 'o' (used if pEngineO is 0), or 0.
+ * @param mctsPlayouts Playout budget per MCTS move.
+ * @param randomPlies Number of plies (passes included) played at random
+ *        before the engines take over.
+ * @return RC_OK if the game was played, RC_ERROR_BAD_PARAM for boards too small
+ *         to hold the initial position, RC_ERROR if an engine failed or chose
+ *         an illegal move (the game is then left unfinished).
+ */
+RC_t ReversiSelfPlay::selfPlayGame(ReversiBoard &board, mt19937_64 &rng,
+		ReversiSearch *pEngineX, ReversiSearch *pEngineO, uint64_t engineNodes,
+		ReversiMcts *pMctsX, ReversiMcts *pMctsO, uint64_t mctsPlayouts,
+		unsigned int randomPlies)
+{
+	unsigned int rows = board.boardRows();
+	unsigned int columns = board.boardColumns();
+
+	if (rows < 2 || columns < 2)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiSearchLimits limits;
+	ReversiSearchResult result;
+	ReversiMctsLimits mctsLimits;
+	ReversiMctsResult mctsResult;
+
+	limits.maxNodes = engineNodes;
+	mctsLimits.maxPlayouts = mctsPlayouts;
+	board.boardClear();
+	board.boardInitialState(rows, columns);
+
+	for (;;)
+	{
+		char coin = board.boardSideToMove();
+		ReversiSearch *pEngine = (coin == 'x') ? pEngineX : pEngineO;
+		ReversiMcts *pMcts = (coin == 'x') ? pMctsX : pMctsO;
+
+		// The engines are deterministic; a random opening makes the games differ
+		if (board.boardHistorySize() < randomPlies)
+		{
+			pEngine = 0;
+			pMcts = 0;
+		}
+
+		if (board.boardGameOver())
+		{
+			break;
+		}
+		if (!board.boardHasMoves(coin))
+		{
+			board.makePass(coin);
+			continue;
+		}
+
+		unsigned int move = 0;
+		if (pEngine)
+		{
+			if (pEngine->searchRun(board, limits, result) != RC_OK)
+			{
+				return RC_ERROR;
+			}
+			move = result.bestMove;
+		}
+		else if (pMcts)
+		{
+			// Seeded from the game, so that the game does not depend on the thread
+			pMcts->mctsSeed(rng());
+			if (pMcts->mctsRun(board, mctsLimits, mctsResult) != RC_OK)
+			{
+				return RC_ERROR;
+			}
+			move = mctsResult.bestMove;
+		}
+		else
+		{
+			const ReversiMask &moves = board.boardMoves(coin);
+			unsigned int pick = rng() % board.boardMobility(coin);
+			moves.maskNext(move);
+			while (pick--)
+			{
+				move++;
+				moves.maskNext(move);
+			}
+		}
+		if (board.makeMove(move, coin) == 0)
+		{
+			return RC_ERROR;
+		}
+	}
+
+	return RC_OK;
+}
+
+/**
+ * @brief Body of a worker thread: plays games until none are left.
+ *
+ * Every worker owns its board and its engines. The engines start every game with
+ * a cleared table, so that a game does not depend on the games played before it
+ * by the same worker.
+ *
+ * @param next Number of the next game to play, shared by all workers.
+ * @param failed Set by the worker whose game failed; stops all workers.
+ * @param stats Receives the counters of this worker.
+ */
+void ReversiSelfPlay::selfPlayWorker(atomic<uint64_t> &next,
+		atomic<bool> &failed, ReversiSelfPlayStats &stats)
+{
+	ReversiSelfPlayStats local;
+	ReversiBoard board(config.rows, config.columns);
+	ReversiTransTable tt(ENGINE_TABLE_MB);
+	ReversiSearch engineX(tt);
+	ReversiSearch engineO(tt);
+	bool engines = config.playerX == SELFPLAY_ENGINE
+			|| config.playerO == SELFPLAY_ENGINE;
+	ReversiMctsConfig mctsConfig;
+	unique_ptr<ReversiMcts> pMctsX;
+	unique_ptr<ReversiMcts> pMctsO;
+
+	mctsConfig.maxNodes = MCTS_NODES;
+	if (config.playerX == SELFPLAY_MCTS)
+	{
+		pMctsX.reset(new ReversiMcts(mctsConfig));
+	}
+	if (config.playerO == SELFPLAY_MCTS)
+	{
+		pMctsO.reset(new ReversiMcts(mctsConfig));
+	}
+
+	engineX.searchSetEvaluator(config.pEval);
+	engineO.searchSetEvaluator(config.pEval);
+
+	for (;;)
+	{
+		uint64_t game = next.fetch_add(1, memory_order_relaxed);
+		if (game >= config.games || failed.load(memory_order_relaxed))
+		{
+			break;
+		}
+
+		mt19937_64 rng(config.seed * 0x9E3779B97F4A7C15ULL + game);
+		if (engines)
+		{
+			tt.ttClear();
+			engineX.searchClear();
+			engineO.searchClear();
+		}
+
+		if (selfPlayGame(board, rng,
+				(config.playerX == SELFPLAY_ENGINE) ? &engineX : 0,
+				(config.playerO == SELFPLAY_ENGINE) ? &engineO : 0,
+				config.engineNodes, pMctsX.get(), pMctsO.get(),
+				config.mctsPlayouts, config.randomPlies) != RC_OK)
+		{
+			failed.store(true, memory_order_relaxed);
+			break;
+		}
+
+		for (unsigned int i = 0; i < board.boardHistorySize(); i++)
+		{
+			if (board.boardHistory(i).index == ReversiUndo::PASS)
+			{
+				local.passes++;
+			}
+			else
+			{
+				local.moves++;
+			}
+		}
+
+		unsigned int discsX = board.boardCount('x');
+		unsigned int discsO = board.boardCount('o');
+		if (discsX > discsO)
+		{
+			local.winsX++;
+		}
+		else if (discsO > discsX)
+		{
+			local.winsO++;
+		}
+		else
+		{
+			local.draws++;
+		}
+		local.games++;
+
+		if (onGame)
+		{
+			onGame(game, board);
+		}
+	}
+
+	// Written once at the end, so that the workers do not share cache lines while playing
+	stats = local;
+}
+
+/**
+ * @brief Plays all games of the run and sums up the counters.
+ *
+ * @param stats Receives the counters of the run.
+ * @return RC_OK if the run was successful, RC_ERROR_BAD_PARAM for invalid settings
+ *         (including a zero node or playout budget of an engine player), RC_ERROR
+ *         if a game failed.
+ */
+RC_t ReversiSelfPlay::selfPlayRun(ReversiSelfPlayStats &stats)
+{
+	if (config.rows < 2 || config.columns < 2
+			|| !ReversiBoard::boardSupports(config.rows, config.columns))
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+	if (((config.playerX == SELFPLAY_ENGINE || config.playerO == SELFPLAY_ENGINE)
+			&& config.engineNodes == 0)
+			|| ((config.playerX == SELFPLAY_MCTS || config.playerO == SELFPLAY_MCTS)
+					&& config.mctsPlayouts == 0))
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	unsigned int threads = config.threads;
+	if (threads == 0)
+	{
+		threads = thread::hardware_concurrency();
+	}
+	if (threads == 0)
+	{
+		threads = 1;
+	}
+	if (threads > config.games)
+	{
+		threads = (config.games > 0) ? (unsigned int) config.games : 1;
+	}
+
+	atomic<uint64_t> next(0);
+	atomic<bool> failed(false);
+	vector<ReversiSelfPlayStats> partial(threads);
+	vector<thread> workers;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (unsigned int i = 1; i < threads; i++)
+	{
+		workers.push_back(
+				thread(&ReversiSelfPlay::selfPlayWorker, this, ref(next),
+						ref(failed), ref(partial[i])));
+	}
+	selfPlayWorker(next, failed, partial[0]);
+	for (unsigned int i = 0; i < workers.size(); i++)
+	{
+		workers[i].join();
+	}
+
+	stats = ReversiSelfPlayStats();
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		stats.games += partial[i].games;
+		stats.moves += partial[i].moves;
+		stats.passes += partial[i].passes;
+		stats.winsX += partial[i].winsX;
+		stats.winsO += partial[i].winsO;
+		stats.draws += partial[i].draws;
+	}
+	stats.seconds =
+			chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return failed.load() ? RC_ERROR : RC_OK;
+}
@@ -0,0 +1,167 @@
+/*
+ * ReversiSelfPlay.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiSelfPlay.h
+ * @brief Declares the headless self-play driver.
+ *
+ * The driver plays many complete games without any console input or output,
+ * spread over a pool of threads. Every game has its own random number generator
+ * seeded from the base seed and the game number, so a run gives the same games
+ * regardless of the number of threads. The first plies of every game are random
+ * whatever the players, so that deterministic engines play different games.
+ */
+
+#ifndef REVERSISELFPLAY_H_
+#define REVERSISELFPLAY_H_
+
+#include <atomic>
+#include <functional>
+#include <random>
+#include <stdint.h>
+
+#include "global.h"
+#include "ReversiBoard.h"
+#include "ReversiMcts.h"
+#include "ReversiSearch.h"
+
+/**
+ * @enum SelfPlayPlayer_t
+ * @brief How a player chooses its moves.
+ */
+typedef enum
+{
+	SELFPLAY_RANDOM, ///< A uniformly random legal move.
+	SELFPLAY_ENGINE, ///< The move of a ReversiSearch with a node budget.
+	SELFPLAY_MCTS,   ///< The move of a single-threaded ReversiMcts with a playout budget.
+} SelfPlayPlayer_t;
+
+/**
+ * @brief Settings of a self-play run.
+ */
+struct ReversiSelfPlayConfig
+{
+	unsigned int rows;         ///< Board rows.
+	unsigned int columns;      ///< Board columns.
+	uint64_t games;            ///< Number of games to play.
+	unsigned int threads;      ///< Number of threads (0: one per core).
+	uint64_t seed;             ///< Base seed of the per-game random number generators.
+	SelfPlayPlayer_t playerX;  ///< Player of the 'x' coins (moves first).
+	SelfPlayPlayer_t playerO;  ///< Player of the 'o' coins.
+	uint64_t engineNodes;      ///< Node budget per engine move.
+	uint64_t mctsPlayouts;     ///< Playout budget per MCTS move.
+	unsigned int randomPlies;  ///< Number of random plies at the start of every game.
+	const ReversiPatternEval *pEval; ///< Pattern evaluation of the engines on 8x8, or 0.
+
+	ReversiSelfPlayConfig() :
+			rows(8), columns(8), games(1000), threads(0), seed(1), playerX(
+					SELFPLAY_RANDOM), playerO(SELFPLAY_RANDOM), engineNodes(2000), mctsPlayouts(
+					1000), randomPlies(8), pEval(0)
+	{
+	}
+};
+
+/**
+ * @brief Counters of a self-play run.
+ */
+struct ReversiSelfPlayStats
+{
+	uint64_t games;   ///< Games played.
+	uint64_t moves;   ///< Moves played (without passes).
+	uint64_t passes;  ///< Passes played.
+	uint64_t winsX;   ///< Games won by 'x'.
+	uint64_t winsO;   ///< Games won by 'o'.
+	uint64_t draws;   ///< Drawn games.
+	double seconds;   ///< Wall-clock time of the run.
+
+	ReversiSelfPlayStats() :
+			games(0), moves(0), passes(0), winsX(0), winsO(0), draws(0), seconds(0)
+	{
+	}
+};
+
+/**
+ * @class ReversiSelfPlay
+ * @brief Plays batches of games on a pool of threads and collects statistics.
+ */
+class ReversiSelfPlay
+{
+public:
+	/**
+	 * @brief Called once per finished game, from the thread that played it.
+	 *
+	 * The board holds the final position and the complete move history
+	 * (boardHistory()). Calls from different threads may overlap.
+	 */
+	typedef std::function<void(uint64_t game, const ReversiBoard &board)> GameCallback;
+
+private:
+	ReversiSelfPlayConfig config;
+	GameCallback onGame;
+
+	/**
+	 * @brief Body of a worker thread: plays games until none are left.
+	 *
+	 * @param next Number of the next game to play, shared by all workers.
+	 * @param failed Set by the worker whose game failed; stops all workers.
+	 * @param stats Receives the counters of this worker.
+	 */
+	void selfPlayWorker(std::atomic<uint64_t> &next, std::atomic<bool> &failed,
+			ReversiSelfPlayStats &stats);
+
+public:
+	/**
+	 * @brief Constructs a driver with the given settings.
+	 *
+	 * @param config The settings of the run.
+	 */
+	explicit ReversiSelfPlay(const ReversiSelfPlayConfig &config);
+
+	/**
+	 * @brief Sets a function to be called after every game, e.g. to store it.
+	 *
+	 * @param onGame The function, or an empty function for none.
+	 */
+	void selfPlaySetCallback(const GameCallback &onGame);
+
+	/**
+	 * @brief Plays one game from the initial position to its end.
+	 *
+	 * A player without a legal move passes; the game ends when both players
+	 * have to pass in a row.
+	 *
+	 * @param board The board to play on (rows and columns of the game); it is cleared first.
+	 * @param rng The random number generator of the game.
+	 * @param pEngineX Engine of 'x', or 0 for random moves.
+	 * @param pEngineO Engine of 'o', or 0 for random moves.
+	 * @param engineNodes Node budget per engine move.
+	 * @param pMctsX MCTS engine of 'x' (used if pEngineX is 0), or 0.
+	 * @param pMctsO MCTS engine of 'o' (used if pEngineO is 0), or 0.
+	 * @param mctsPlayouts Playout budget per MCTS move.
+	 * @param randomPlies Number of plies (passes included) played at random
+	 *        before the engines take over.
+	 * @return RC_OK if the game was played, RC_ERROR_BAD_PARAM for boards too small
+	 *         to hold the initial position, RC_ERROR if an engine failed or chose
+	 *         an illegal move (the game is then left unfinished).
+	 */
+	static RC_t selfPlayGame(ReversiBoard &board, std::mt19937_64 &rng,
+			ReversiSearch *pEngineX, ReversiSearch *pEngineO, uint64_t engineNodes,
+			ReversiMcts *pMctsX = 0, ReversiMcts *pMctsO = 0,
+			uint64_t mctsPlayouts = 0, unsigned int randomPlies = 0);
+
+	/**
+	 * @brief Plays all games of the run and sums up the counters.
+	 *
+	 * @param stats Receives the counters of the run.
+	 * @return RC_OK if the run was successful, RC_ERROR_BAD_PARAM for invalid settings
+	 *         (including a zero node or playout budget of an engine player), RC_ERROR
+	 *         if a game failed.
+	 */
+	RC_t selfPlayRun(ReversiSelfPlayStats &stats);
+};
+
+#endif /* REVERSISELFPLAY_H_ */
@@ -0,0 +1,905 @@
+/*
+ * ReversiServer.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiServer.cpp
+ * @brief Implements the epoll based game server (Linux only).
+ */
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include "ReversiBoard.h"
+#include "ReversiBoardPool.h"
+#include "ReversiMetrics.h"
+#include "ReversiServer.h"
+
+using namespace std;
+
+// Events handled per epoll_wait() call
+static const int MAX_EVENTS = 256;
+
+// Connections accepted per wake-up of a loop, so that the others get their share
+static const unsigned int ACCEPT_BATCH = 64;
+
+// Input is not read and output not produced beyond these sizes until the client catches up
+static const size_t INPUT_LIMIT = 1 << 20;
+static const size_t OUTPUT_LIMIT = 1 << 20;
+
+// Longest command line
+static const size_t MAX_LINE = 256;
+
+// Boards of one size kept for reuse per thread
+static const size_t POOL_LIMIT = 1024;
+
+/**
+ * @brief Returns a monotonic time stamp in nanoseconds.
+ */
+static int64_t serverNow()
+{
+	return chrono::duration_cast<chrono::nanoseconds>(
+			chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief State of one client connection, owned by the loop that accepted it.
+ */
+struct ReversiServer::Connection
+{
+	int fd;
+	bool closing;     ///< Close once the output has been sent.
+	bool quit;        ///< QUIT was received; further input is ignored.
+	bool stalled;     ///< Input was left unread or unhandled because of the limits.
+	bool writeArmed;  ///< EPOLLOUT is registered.
+	bool flushQueued; ///< Listed for the flush at the end of the event batch.
+	uint32_t nextGame;
+	string input;     ///< Received bytes not handled yet.
+	string output;    ///< Responses not sent yet.
+	vector<int64_t> moveStarts; ///< Read times of the moves answered in output.
+	unordered_map<uint32_t, ReversiBoardPool::Handle> games; ///< Boards from the loop's pool.
+
+	explicit Connection(int fd) :
+			fd(fd), closing(false), quit(false), stalled(false), writeArmed(false), flushQueued(
+					false), nextGame(0)
+	{
+	}
+};
+
+/**
+ * @brief One event loop thread with its connections, board pool and counters.
+ *
+ * The counters are written by the loop only and read by serverStats().
+ */
+struct ReversiServer::Worker
+{
+	int epoll;
+	int wake;         ///< eventfd that interrupts epoll_wait() for shutdown.
+	int spare;        ///< Reserve descriptor, freed to reject connections at the descriptor limit.
+	thread loop;
+	ReversiBoardPool pool;  ///< Boards of finished games, declared before the connections holding boards.
+	unordered_map<int, unique_ptr<Connection> > connections;
+	vector<int> flushList; ///< Connections with output from the current batch.
+	atomic<uint64_t> accepted;
+	atomic<uint64_t> games;
+	atomic<uint64_t> moves;
+	atomic<uint64_t> latency[ReversiMetrics::BUCKETS]; ///< Move latencies, bucketed like the rules core histograms.
+
+	Worker() :
+			epoll(-1), wake(-1), spare(-1), pool(POOL_LIMIT), accepted(0), games(0), moves(0)
+	{
+		for (unsigned int b = 0; b < ReversiMetrics::BUCKETS; b++)
+		{
+			latency[b].store(0, memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * @brief Adds one sample to the latency histogram.
+	 */
+	void latencyRecord(int64_t ns)
+	{
+		latency[ReversiMetrics::metricsBucket(ns > 0 ? (uint64_t) ns : 0)].fetch_add(1,
+				memory_order_relaxed);
+	}
+};
+
+/**
+ * @brief Constructs a stopped server.
+ *
+ * @param config The settings of the server.
+ */
+ReversiServer::ReversiServer(const ReversiServerConfig &config) :
+		config(config), tcpListener(-1), unixListener(-1), port(0), running(
+				false)
+{
+}
+
+/**
+ * @brief Stops the server if it is running.
+ */
+ReversiServer::~ReversiServer()
+{
+	serverStop();
+}
+
+/**
+ * @brief Collects the counters and latency percentiles of all threads.
+ *
+ * @param stats Receives the counters.
+ */
+void ReversiServer::serverStats(ReversiServerStats &stats) const
+{
+	uint64_t counts[ReversiMetrics::BUCKETS] =
+	{ 0 };
+
+	stats = ReversiServerStats();
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		const Worker &worker = *workers[i];
+
+		stats.connections += worker.accepted.load(memory_order_relaxed);
+		stats.games += worker.games.load(memory_order_relaxed);
+		stats.moves += worker.moves.load(memory_order_relaxed);
+		for (unsigned int b = 0; b < ReversiMetrics::BUCKETS; b++)
+		{
+			counts[b] += worker.latency[b].load(memory_order_relaxed);
+		}
+	}
+
+	stats.p50Micros = ReversiMetrics::metricsPercentile(counts, 0.50) / 1000.0;
+	stats.p99Micros = ReversiMetrics::metricsPercentile(counts, 0.99) / 1000.0;
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Opens the listening sockets and starts the event loop threads.
+ *
+ * @return RC_OK if the server is running, RC_ERROR_BAD_PARAM if no socket is
+ *         configured, RC_ERROR if a socket cannot be opened, the server is
+ *         already running or the system is not supported.
+ */
+RC_t ReversiServer::serverStart()
+{
+	if (running.load())
+	{
+		return RC_ERROR;
+	}
+	if (!config.listenTcp && config.socketPath.empty())
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	workers.clear();
+
+	if (config.listenTcp)
+	{
+		sockaddr_in address;
+		socklen_t length = sizeof(address);
+		int one = 1;
+
+		memset(&address, 0, sizeof(address));
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		address.sin_port = htons(config.port);
+
+		tcpListener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+				0);
+		if (tcpListener < 0
+				|| setsockopt(tcpListener, SOL_SOCKET, SO_REUSEADDR, &one,
+						sizeof(one)) != 0
+				|| bind(tcpListener, (sockaddr*) &address, sizeof(address)) != 0
+				|| listen(tcpListener, SOMAXCONN) != 0
+				|| getsockname(tcpListener, (sockaddr*) &address, &length) != 0)
+		{
+			serverStop();
+			return RC_ERROR;
+		}
+		port = ntohs(address.sin_port);
+	}
+
+	if (!config.socketPath.empty())
+	{
+		sockaddr_un address;
+		struct stat status;
+
+		memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		if (config.socketPath.size() >= sizeof(address.sun_path))
+		{
+			serverStop();
+			return RC_ERROR;
+		}
+		strcpy(address.sun_path, config.socketPath.c_str());
+
+		// A socket left over by an earlier run would make bind() fail
+		if (stat(address.sun_path, &status) == 0 && S_ISSOCK(status.st_mode))
+		{
+			unlink(address.sun_path);
+		}
+
+		unixListener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+				0);
+		if (unixListener < 0
+				|| bind(unixListener, (sockaddr*) &address, sizeof(address)) != 0
+				|| listen(unixListener, SOMAXCONN) != 0)
+		{
+			serverStop();
+			return RC_ERROR;
+		}
+	}
+
+	unsigned int threads = config.threads;
+	if (threads == 0)
+	{
+		threads = thread::hardware_concurrency();
+	}
+	if (threads == 0)
+	{
+		threads = 1;
+	}
+
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		unique_ptr<Worker> worker(new Worker());
+		epoll_event event;
+
+		worker->epoll = epoll_create1(EPOLL_CLOEXEC);
+		worker->wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		worker->spare = open("/dev/null", O_RDONLY | O_CLOEXEC);
+		workers.push_back(move(worker));
+
+		Worker &added = *workers.back();
+		if (added.epoll < 0 || added.wake < 0 || added.spare < 0)
+		{
+			serverStop();
+			return RC_ERROR;
+		}
+
+		event.events = EPOLLIN;
+		event.data.fd = added.wake;
+		if (epoll_ctl(added.epoll, EPOLL_CTL_ADD, added.wake, &event) != 0)
+		{
+			serverStop();
+			return RC_ERROR;
+		}
+
+		// Every loop waits for new connections; EPOLLEXCLUSIVE wakes only one of them
+		const int listeners[2] =
+		{ tcpListener, unixListener };
+		for (unsigned int l = 0; l < 2; l++)
+		{
+			if (listeners[l] < 0)
+			{
+				continue;
+			}
+			event.events = EPOLLIN;
+#ifdef EPOLLEXCLUSIVE
+			event.events |= EPOLLEXCLUSIVE;
+#endif
+			event.data.fd = listeners[l];
+			if (epoll_ctl(added.epoll, EPOLL_CTL_ADD, listeners[l], &event) != 0)
+			{
+				serverStop();
+				return RC_ERROR;
+			}
+		}
+	}
+
+	running.store(true);
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		workers[i]->loop = thread(&ReversiServer::serverLoop, this,
+				ref(*workers[i]));
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Stops the event loops, closes all connections and the listening sockets.
+ *
+ * The counters of the stopped loops stay available to serverStats().
+ */
+void ReversiServer::serverStop()
+{
+	running.store(false);
+
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		uint64_t one = 1;
+		if (workers[i]->wake >= 0 && write(workers[i]->wake, &one, sizeof(one)) < 0)
+		{
+			// The loop also ends with its next event
+		}
+	}
+
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		Worker &worker = *workers[i];
+
+		if (worker.loop.joinable())
+		{
+			worker.loop.join();
+		}
+		if (worker.epoll >= 0)
+		{
+			close(worker.epoll);
+			worker.epoll = -1;
+		}
+		if (worker.wake >= 0)
+		{
+			close(worker.wake);
+			worker.wake = -1;
+		}
+		if (worker.spare >= 0)
+		{
+			close(worker.spare);
+			worker.spare = -1;
+		}
+	}
+
+	if (tcpListener >= 0)
+	{
+		close(tcpListener);
+		tcpListener = -1;
+	}
+	if (unixListener >= 0)
+	{
+		close(unixListener);
+		unlink(config.socketPath.c_str());
+		unixListener = -1;
+	}
+}
+
+/**
+ * @brief Runs the server until the process receives SIGINT or SIGTERM.
+ *
+ * The signals are blocked before the loops start, so the loop threads inherit
+ * the mask and the calling thread receives them with sigwait().
+ *
+ * @param onStarted Called once the sockets are open, or an empty function.
+ * @return RC_OK after a regular shutdown, otherwise the error of serverStart().
+ */
+RC_t ReversiServer::serverRun(const function<void()> &onStarted)
+{
+	sigset_t signals;
+	sigset_t previous;
+	int received;
+
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &signals, &previous);
+
+	RC_t result = serverStart();
+	if (result == RC_OK)
+	{
+		if (onStarted)
+		{
+			onStarted();
+		}
+		sigwait(&signals, &received);
+		serverStop();
+	}
+
+	pthread_sigmask(SIG_SETMASK, &previous, 0);
+	return result;
+}
+
+/**
+ * @brief Body of an event loop thread.
+ *
+ * Every batch of events is handled completely before any response is sent, so
+ * all responses to one connection from that batch leave in one send().
+ */
+void ReversiServer::serverLoop(Worker &worker)
+{
+	epoll_event events[MAX_EVENTS];
+
+	while (running.load(memory_order_relaxed))
+	{
+		int count = epoll_wait(worker.epoll, events, MAX_EVENTS, -1);
+		if (count < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+
+		int64_t now = serverNow();
+		for (int i = 0; i < count; i++)
+		{
+			int fd = events[i].data.fd;
+
+			if (fd == worker.wake)
+			{
+				continue;
+			}
+			if (fd == tcpListener || fd == unixListener)
+			{
+				serverAccept(worker, fd);
+				continue;
+			}
+
+			unordered_map<int, unique_ptr<Connection> >::iterator it =
+					worker.connections.find(fd);
+			if (it == worker.connections.end())
+			{
+				continue;
+			}
+
+			// EPOLLOUT also means that input held back by the limits can go on
+			Connection &connection = *it->second;
+			serverRead(worker, connection, now);
+			if (!connection.flushQueued)
+			{
+				connection.flushQueued = true;
+				worker.flushList.push_back(fd);
+			}
+		}
+
+		for (size_t i = 0; i < worker.flushList.size(); i++)
+		{
+			int fd = worker.flushList[i];
+			Connection &connection = *worker.connections[fd];
+
+			connection.flushQueued = false;
+			serverFlush(worker, connection);
+			while (connection.stalled && connection.output.empty()
+					&& !connection.quit)
+			{
+				connection.stalled = false;
+				serverRead(worker, connection, now);
+				serverFlush(worker, connection);
+			}
+			if (connection.closing && connection.output.empty())
+			{
+				serverClose(worker, fd);
+			}
+		}
+		worker.flushList.clear();
+	}
+
+	while (!worker.connections.empty())
+	{
+		serverClose(worker, worker.connections.begin()->first);
+	}
+}
+
+/**
+ * @brief Accepts the pending connections of a listening socket.
+ */
+void ReversiServer::serverAccept(Worker &worker, int listener)
+{
+	for (unsigned int i = 0; i < ACCEPT_BATCH; i++)
+	{
+		int fd = accept4(listener, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0 && (errno == EMFILE || errno == ENFILE) && worker.spare >= 0)
+		{
+			// Out of descriptors: the listener would stay readable and keep the
+			// loop spinning, so accept the client with the reserve and close it
+			close(worker.spare);
+			fd = accept(listener, 0, 0);
+			if (fd >= 0)
+			{
+				close(fd);
+			}
+			worker.spare = open("/dev/null", O_RDONLY | O_CLOEXEC);
+			return;
+		}
+		if (fd < 0)
+		{
+			return;
+		}
+
+		// Responses are batched already, so Nagle's algorithm would only add delay
+		if (listener == tcpListener)
+		{
+			int one = 1;
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		}
+
+		epoll_event event;
+		event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+		event.data.fd = fd;
+		if (epoll_ctl(worker.epoll, EPOLL_CTL_ADD, fd, &event) != 0)
+		{
+			close(fd);
+			continue;
+		}
+
+		worker.connections[fd].reset(new Connection(fd));
+		worker.accepted.fetch_add(1, memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Reads everything available on a connection and handles complete lines.
+ *
+ * The sockets are edge triggered, so reading goes on until the socket is empty
+ * (or the input limit is reached, which marks the connection as stalled).
+ *
+ * @param now Time at which the data was noticed, in nanoseconds.
+ */
+void ReversiServer::serverRead(Worker &worker, Connection &connection,
+		int64_t now)
+{
+	char buffer[16384];
+
+	while (!connection.closing)
+	{
+		if (connection.input.size() >= INPUT_LIMIT)
+		{
+			connection.stalled = true;
+			break;
+		}
+
+		ssize_t length = recv(connection.fd, buffer, sizeof(buffer), 0);
+		if (length > 0)
+		{
+			connection.input.append(buffer, length);
+		}
+		else if (length == 0)
+		{
+			// The client has closed its side; answer what it has sent
+			connection.closing = true;
+		}
+		else if (errno != EINTR)
+		{
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+			{
+				connection.closing = true;
+			}
+			break;
+		}
+	}
+
+	serverProcess(worker, connection, now);
+}
+
+/**
+ * @brief Handles the complete lines of a connection's input.
+ *
+ * @param now Time at which the lines were read, in nanoseconds.
+ */
+void ReversiServer::serverProcess(Worker &worker, Connection &connection,
+		int64_t now)
+{
+	string &input = connection.input;
+	size_t start = 0;
+	size_t end;
+
+	while ((end = input.find('\n', start)) != string::npos)
+	{
+		if (connection.output.size() >= OUTPUT_LIMIT)
+		{
+			connection.stalled = true;
+			break;
+		}
+
+		input[end] = '\0';
+		if (end > start && input[end - 1] == '\r')
+		{
+			input[end - 1] = '\0';
+		}
+		serverCommand(worker, connection, &input[start], now);
+		start = end + 1;
+
+		if (connection.quit)
+		{
+			break;
+		}
+	}
+	if (connection.quit)
+	{
+		input.clear();
+		return;
+	}
+	input.erase(0, start);
+
+	if (!connection.stalled && input.size() > MAX_LINE)
+	{
+		connection.output += "ERR line too long\n";
+		connection.closing = true;
+		input.clear();
+	}
+}
+
+/**
+ * @brief Appends the side to move and the legal moves of a game to a response.
+ */
+static void serverAppendMoves(string &output, const ReversiBoard &board)
+{
+	char buffer[32];
+	char coin = board.boardSideToMove();
+	const ReversiMask &moves = board.boardMoves(coin);
+	unsigned int columns = board.boardColumns();
+
+	snprintf(buffer, sizeof(buffer), "OK %c %u", coin,
+			board.boardMobility(coin));
+	output += buffer;
+	for (unsigned int index = 0; moves.maskNext(index); index++)
+	{
+		snprintf(buffer, sizeof(buffer), " %u %u", index / columns,
+				index % columns);
+		output += buffer;
+	}
+	output += '\n';
+}
+
+/**
+ * @brief Handles one command line and appends its response.
+ *
+ * @param pLine The line without its line break.
+ * @param now Time at which the line was read, in nanoseconds.
+ */
+void ReversiServer::serverCommand(Worker &worker, Connection &connection,
+		const char *pLine, int64_t now)
+{
+	char command[8];
+	unsigned int a = 0;
+	unsigned int b = 0;
+	unsigned int c = 0;
+	char buffer[96];
+	string &output = connection.output;
+
+	int fields = sscanf(pLine, "%7s %u %u %u", command, &a, &b, &c);
+	if (fields < 1)
+	{
+		output += "ERR empty command\n";
+		return;
+	}
+
+	if (strcmp(command, "NEW") == 0)
+	{
+		if (fields != 3 || a < 2 || b < 2
+				|| (uint64_t) a * b > config.maxCells)
+		{
+			output += "ERR bad size\n";
+			return;
+		}
+		uint32_t game = connection.nextGame++;
+		connection.games[game] = worker.pool.poolAcquire(a, b);
+		worker.games.fetch_add(1, memory_order_relaxed);
+		snprintf(buffer, sizeof(buffer), "OK %u\n", game);
+		output += buffer;
+		return;
+	}
+	if (strcmp(command, "STATS") == 0)
+	{
+		ReversiServerStats stats;
+		serverStats(stats);
+		snprintf(buffer, sizeof(buffer),
+				"OK connections %llu games %llu moves %llu p50 %.1f p99 %.1f\n",
+				(unsigned long long) stats.connections,
+				(unsigned long long) stats.games,
+				(unsigned long long) stats.moves, stats.p50Micros,
+				stats.p99Micros);
+		output += buffer;
+		return;
+	}
+	if (strcmp(command, "METRICS") == 0)
+	{
+		ostringstream json;
+		ReversiMetrics::metricsWriteJson(json);
+		output += "OK " + json.str() + "\n";
+		return;
+	}
+	if (strcmp(command, "QUIT") == 0)
+	{
+		output += "OK\n";
+		connection.quit = true;
+		connection.closing = true;
+		return;
+	}
+
+	bool play = (strcmp(command, "MOVE") == 0);
+	if (!play && strcmp(command, "MOVES") != 0 && strcmp(command, "BOARD") != 0
+			&& strcmp(command, "END") != 0)
+	{
+		output += "ERR unknown command\n";
+		return;
+	}
+	if (fields < 2)
+	{
+		output += "ERR missing game\n";
+		return;
+	}
+
+	unordered_map<uint32_t, ReversiBoardPool::Handle>::iterator it =
+			connection.games.find(a);
+	if (it == connection.games.end())
+	{
+		output += "ERR unknown game\n";
+		return;
+	}
+	ReversiBoard &board = *it->second;
+
+	if (play)
+	{
+		char coin = board.boardSideToMove();
+		if (fields != 4)
+		{
+			output += "ERR missing position\n";
+			return;
+		}
+		if (board.boardGameOver())
+		{
+			output += "ERR game over\n";
+			return;
+		}
+		if (board.makeMove(b, c, coin) == 0)
+		{
+			output += "ERR illegal move\n";
+			return;
+		}
+		worker.moves.fetch_add(1, memory_order_relaxed);
+		connection.moveStarts.push_back(now);
+
+		// Record the opponent's pass, so the response names who moves next
+		char opponent = (coin == 'x') ? 'o' : 'x';
+		if (!board.boardHasMoves(opponent) && board.boardHasMoves(coin))
+		{
+			board.makePass(opponent);
+		}
+
+		if (board.boardGameOver())
+		{
+			snprintf(buffer, sizeof(buffer), "OVER %u %u\n",
+					board.boardCount('x'), board.boardCount('o'));
+		}
+		else
+		{
+			snprintf(buffer, sizeof(buffer), "OK %c\n",
+					board.boardSideToMove());
+		}
+		output += buffer;
+	}
+	else if (command[0] == 'M')
+	{
+		serverAppendMoves(output, board);
+	}
+	else if (command[0] == 'B')
+	{
+		output += "OK ";
+		output += board.boardSideToMove();
+		output += ' ';
+		for (unsigned int row = 0; row < board.boardRows(); row++)
+		{
+			for (unsigned int column = 0; column < board.boardColumns();
+					column++)
+			{
+				output += board.boardGet(row, column);
+			}
+		}
+		output += '\n';
+	}
+	else
+	{
+		// Destroying the handle returns the board to the pool
+		connection.games.erase(it);
+		output += "OK\n";
+	}
+}
+
+/**
+ * @brief Writes the pending output of a connection.
+ *
+ * Records the latency of the moves answered once all output has been sent;
+ * arms EPOLLOUT if the socket cannot take everything.
+ */
+void ReversiServer::serverFlush(Worker &worker, Connection &connection)
+{
+	size_t sent = 0;
+
+	while (sent < connection.output.size())
+	{
+		ssize_t length = send(connection.fd, connection.output.data() + sent,
+				connection.output.size() - sent, MSG_NOSIGNAL);
+		if (length > 0)
+		{
+			sent += length;
+		}
+		else if (length < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		else
+		{
+			if (length == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+			{
+				// The client is gone, nothing more can be delivered
+				connection.closing = true;
+				connection.output.clear();
+				connection.moveStarts.clear();
+				sent = 0;
+			}
+			break;
+		}
+	}
+	connection.output.erase(0, sent);
+
+	bool pending = !connection.output.empty();
+	if (!pending && !connection.moveStarts.empty())
+	{
+		int64_t now = serverNow();
+		for (size_t i = 0; i < connection.moveStarts.size(); i++)
+		{
+			worker.latencyRecord(now - connection.moveStarts[i]);
+		}
+		connection.moveStarts.clear();
+	}
+
+	if (pending != connection.writeArmed && !connection.closing)
+	{
+		epoll_event event;
+		event.events = EPOLLIN | EPOLLRDHUP | EPOLLET
+				| (pending ? (uint32_t) EPOLLOUT : 0u);
+		event.data.fd = connection.fd;
+		if (epoll_ctl(worker.epoll, EPOLL_CTL_MOD, connection.fd, &event) == 0)
+		{
+			connection.writeArmed = pending;
+		}
+	}
+}
+
+/**
+ * @brief Closes a connection and returns the boards of its games to the pool.
+ */
+void ReversiServer::serverClose(Worker &worker, int fd)
+{
+	unordered_map<int, unique_ptr<Connection> >::iterator it =
+			worker.connections.find(fd);
+	if (it == worker.connections.end())
+	{
+		return;
+	}
+
+	epoll_ctl(worker.epoll, EPOLL_CTL_DEL, fd, 0);
+	close(fd);
+	worker.connections.erase(it);
+}
+
+#else
+
+RC_t ReversiServer::serverStart()
+{
+	return RC_ERROR;
+}
+
+void ReversiServer::serverStop()
+{
+}
+
+RC_t ReversiServer::serverRun(const function<void()>&)
+{
+	return RC_ERROR;
+}
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * ReversiServer.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiServer.h
+ * @brief Declares the event-driven game server hosting many games in one process.
+ *
+ * Clients connect over TCP on the loopback interface or over a Unix domain
+ * socket and send one command per line; every command gets exactly one response
+ * line, in order. A connection may run any number of games at the same time:
+ *
+ *   NEW <rows> <columns>         -> OK <game>
+ *   MOVE <game> <row> <column>   -> OK <side to move> | OVER <discs x> <discs o>
+ *   MOVES <game>                 -> OK <side to move> <n> <row> <column> ...
+ *   BOARD <game>                 -> OK <side to move> <cells row by row, x/o/.>
+ *   END <game>                   -> OK
+ *   STATS                        -> OK connections <n> games <n> moves <n> p50 <us> p99 <us>
+ *   METRICS                      -> OK <rules core metrics as one line of JSON>
+ *   QUIT                         -> OK (and the server closes the connection)
+ *
+ * Errors are answered with "ERR <reason>". MOVE plays for the side to move; if
+ * the opponent has no legal move afterwards, its pass is recorded right away,
+ * so the response always names the player who moves next.
+ *
+ * A small pool of threads runs one epoll event loop each. The listening sockets
+ * are shared by all loops, and a connection stays with the loop that accepted
+ * it, so its games are never touched by two threads. All responses produced
+ * while handling one batch of events are written with one send() per
+ * connection. Finished games return their board to a per-thread pool.
+ *
+ * The server is available on Linux only; on other systems serverStart() fails.
+ */
+
+#ifndef REVERSISERVER_H_
+#define REVERSISERVER_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "global.h"
+
+/**
+ * @brief Settings of a game server.
+ */
+struct ReversiServerConfig
+{
+	bool listenTcp;          ///< Listen on 127.0.0.1.
+	unsigned short port;     ///< TCP port (0: any free port, see serverPort()).
+	std::string socketPath;  ///< Path of a Unix domain socket, or empty for none.
+	unsigned int threads;    ///< Number of event loop threads (0: one per core).
+	unsigned int maxCells;   ///< Largest board (rows * columns) a game may use.
+
+	ReversiServerConfig() :
+			listenTcp(true), port(7878), threads(0), maxCells(256)
+	{
+	}
+};
+
+/**
+ * @brief Counters and move latencies of a server.
+ */
+struct ReversiServerStats
+{
+	uint64_t connections; ///< Connections accepted.
+	uint64_t games;       ///< Games started.
+	uint64_t moves;       ///< Moves played.
+	double p50Micros;     ///< Median move latency, from reading the request to sending the response.
+	double p99Micros;     ///< 99th percentile of the move latency.
+
+	ReversiServerStats() :
+			connections(0), games(0), moves(0), p50Micros(0), p99Micros(0)
+	{
+	}
+};
+
+/**
+ * @class ReversiServer
+ * @brief Hosts games for many client connections on a few event loop threads.
+ */
+class ReversiServer
+{
+private:
+	struct Connection;
+	struct Worker;
+
+	ReversiServerConfig config;
+	std::vector<std::unique_ptr<Worker> > workers; ///< One event loop per thread.
+	int tcpListener;        ///< Listening TCP socket, or -1.
+	int unixListener;       ///< Listening Unix domain socket, or -1.
+	unsigned short port;    ///< Bound TCP port.
+	std::atomic<bool> running;
+
+	/**
+	 * @brief Body of an event loop thread.
+	 */
+	void serverLoop(Worker &worker);
+
+	/**
+	 * @brief Accepts the pending connections of a listening socket.
+	 */
+	void serverAccept(Worker &worker, int listener);
+
+	/**
+	 * @brief Reads everything available on a connection and handles complete lines.
+	 *
+	 * @param now Time at which the data was noticed, in nanoseconds.
+	 */
+	void serverRead(Worker &worker, Connection &connection, int64_t now);
+
+	/**
+	 * @brief Handles the complete lines of a connection's input.
+	 *
+	 * Stops early while a large amount of output is waiting, so a client that
+	 * does not read its responses cannot make the server buffer without limit.
+	 *
+	 * @param now Time at which the lines were read, in nanoseconds.
+	 */
+	void serverProcess(Worker &worker, Connection &connection, int64_t now);
+
+	/**
+	 * @brief Handles one command line and appends its response.
+	 *
+	 * @param now Time at which the line was read, in nanoseconds.
+	 */
+	void serverCommand(Worker &worker, Connection &connection,
+			const char *pLine, int64_t now);
+
+	/**
+	 * @brief Writes the pending output of a connection.
+	 *
+	 * Records the latency of the moves answered once all output has been sent;
+	 * arms EPOLLOUT if the socket cannot take everything.
+	 */
+	void serverFlush(Worker &worker, Connection &connection);
+
+	/**
+	 * @brief Closes a connection and returns the boards of its games to the pool.
+	 */
+	void serverClose(Worker &worker, int fd);
+
+	ReversiServer(const ReversiServer&);
+	ReversiServer& operator=(const ReversiServer&);
+
+public:
+	/**
+	 * @brief Constructs a stopped server.
+	 *
+	 * @param config The settings of the server.
+	 */
+	explicit ReversiServer(const ReversiServerConfig &config);
+
+	/**
+	 * @brief Stops the server if it is running.
+	 */
+	~ReversiServer();
+
+	/**
+	 * @brief Opens the listening sockets and starts the event loop threads.
+	 *
+	 * @return RC_OK if the server is running, RC_ERROR_BAD_PARAM if no socket is
+	 *         configured, RC_ERROR if a socket cannot be opened, the server is
+	 *         already running or the system is not supported.
+	 */
+	RC_t serverStart();
+
+	/**
+	 * @brief Stops the event loops, closes all connections and the listening sockets.
+	 */
+	void serverStop();
+
+	/**
+	 * @brief Runs the server until the process receives SIGINT or SIGTERM.
+	 *
+	 * @param onStarted Called once the sockets are open (e.g. to print
+	 *        serverPort()), or an empty function for none.
+	 * @return RC_OK after a regular shutdown, otherwise the error of serverStart().
+	 */
+	RC_t serverRun(
+			const std::function<void()> &onStarted = std::function<void()>());
+
+	/**
+	 * @brief Returns the bound TCP port (useful when configured with port 0).
+	 */
+	unsigned short serverPort() const
+	{
+		return port;
+	}
+
+	/**
+	 * @brief Collects the counters and latency percentiles of all threads.
+	 *
+	 * May be called while the server is running.
+	 *
+	 * @param stats Receives the counters.
+	 */
+	void serverStats(ReversiServerStats &stats) const;
+};
+
+#endif /* REVERSISERVER_H_ */
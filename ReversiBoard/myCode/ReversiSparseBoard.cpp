@@ -0,0 +1,677 @@
+/*
+ * ReversiSparseBoard.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiSparseBoard.cpp
+ * @brief Implements the tiled board for very large sizes.
+ */
+
+#include <algorithm>
+
+#include "ReversiSparseBoard.h"
+
+using namespace std;
+
+// Row and column steps of the eight directions
+static const int rowSteps[] =
+{ -1, -1, 0, 1, 1, 1, 0, -1 };
+static const int columnSteps[] =
+{ 0, -1, -1, -1, 0, 1, 1, 1 };
+static const unsigned int numDirections = sizeof(rowSteps) / sizeof(rowSteps[0]);
+
+// Cells of a tile in its first / last column and row
+static const uint64_t TILE_COLUMN_0 = 0x0101010101010101ULL;
+static const uint64_t TILE_COLUMN_7 = 0x8080808080808080ULL;
+static const uint64_t TILE_ROW_0 = 0x00000000000000FFULL;
+static const uint64_t TILE_ROW_7 = 0xFF00000000000000ULL;
+
+/**
+ * @brief Constructs an empty board.
+ *
+ * @param rows The number of rows on the board.
+ * @param columns The number of columns on the board.
+ */
+ReversiSparseBoard::ReversiSparseBoard(uint32_t rows, uint32_t columns) :
+		rows(rows), columns(columns), countX(0), countO(0), sideToMove('x')
+{
+}
+
+/**
+ * @brief Looks up a tile and its neighbours.
+ *
+ * @param tileRow The row of the center tile.
+ * @param tileColumn The column of the center tile.
+ * @param window Receives the tiles; neighbours off the board are 0.
+ */
+void ReversiSparseBoard::sparseWindow(uint32_t tileRow, uint32_t tileColumn,
+		Window &window) const
+{
+	uint32_t lastTileRow = (rows - 1) >> 3;
+	uint32_t lastTileColumn = (columns - 1) >> 3;
+
+	window.tileRow = tileRow;
+	window.tileColumn = tileColumn;
+	for (int dRow = -1; dRow <= 1; dRow++)
+	{
+		for (int dColumn = -1; dColumn <= 1; dColumn++)
+		{
+			uint32_t row = tileRow + dRow;
+			uint32_t column = tileColumn + dColumn;
+			window.pTiles[dRow + 1][dColumn + 1] =
+					(row > lastTileRow || column > lastTileColumn) ?
+							0 : sparseTile(((uint64_t) row << 32) | column);
+		}
+	}
+}
+
+/**
+ * @brief Returns the cells of a tile that lie on the board.
+ *
+ * @param tileRow The row of the tile (row / 8).
+ * @param tileColumn The column of the tile (column / 8).
+ * @return One bit per cell inside the board.
+ */
+uint64_t ReversiSparseBoard::sparseTileCells(uint32_t tileRow,
+		uint32_t tileColumn) const
+{
+	uint64_t rowsInside = rows - ((uint64_t) tileRow << 3);
+	uint64_t columnsInside = columns - ((uint64_t) tileColumn << 3);
+
+	uint64_t rowMask = (rowsInside >= 8) ? ~0ULL : (1ULL << (rowsInside * 8)) - 1;
+	uint64_t columnMask = (columnsInside >= 8) ?
+			~0ULL : ((1ULL << columnsInside) - 1) * TILE_COLUMN_0;
+	return rowMask & columnMask;
+}
+
+/**
+ * @brief Updates the frontier around a tile whose occupancy became empty or full.
+ *
+ * The occupancy of the 5x5 tiles around the tile is looked up once: a tile of the
+ * inner 3x3 belongs to the frontier if it is occupied and it or one of its
+ * neighbours is not full. Tiles off the board count as full.
+ *
+ * @param tileRow The row of the changed tile.
+ * @param tileColumn The column of the changed tile.
+ */
+void ReversiSparseBoard::sparseUpdateFrontier(uint32_t tileRow,
+		uint32_t tileColumn)
+{
+	static const unsigned char TILE_EMPTY = 0;
+	static const unsigned char TILE_PARTIAL = 1;
+	static const unsigned char TILE_FULL = 2;
+
+	uint32_t lastTileRow = (rows - 1) >> 3;
+	uint32_t lastTileColumn = (columns - 1) >> 3;
+	unsigned char state[5][5];
+
+	for (int dRow = -2; dRow <= 2; dRow++)
+	{
+		for (int dColumn = -2; dColumn <= 2; dColumn++)
+		{
+			// Offsets beyond the first row or column wrap around to large values
+			uint32_t row = tileRow + dRow;
+			uint32_t column = tileColumn + dColumn;
+			unsigned char &cell = state[dRow + 2][dColumn + 2];
+
+			if (row > lastTileRow || column > lastTileColumn)
+			{
+				cell = TILE_FULL;
+				continue;
+			}
+			const Tile *pTile = sparseTile(((uint64_t) row << 32) | column);
+			uint64_t occupied = pTile ? (pTile->discsX | pTile->discsO) : 0;
+			cell = (occupied == 0) ? TILE_EMPTY :
+					(occupied == sparseTileCells(row, column)) ?
+							TILE_FULL : TILE_PARTIAL;
+		}
+	}
+
+	for (int dRow = -1; dRow <= 1; dRow++)
+	{
+		for (int dColumn = -1; dColumn <= 1; dColumn++)
+		{
+			uint32_t row = tileRow + dRow;
+			uint32_t column = tileColumn + dColumn;
+			if (row > lastTileRow || column > lastTileColumn)
+			{
+				continue;
+			}
+
+			uint64_t key = ((uint64_t) row << 32) | column;
+			bool enclosed = true;
+			for (int r = dRow + 1; r <= dRow + 3; r++)
+			{
+				for (int c = dColumn + 1; c <= dColumn + 3; c++)
+				{
+					enclosed = enclosed && state[r][c] == TILE_FULL;
+				}
+			}
+
+			if (state[dRow + 2][dColumn + 2] == TILE_EMPTY || enclosed)
+			{
+				frontier.erase(key);
+			}
+			else
+			{
+				frontier.insert(key);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Measures the run of opponent discs next to a cell in one direction.
+ *
+ * The tile is looked up again only when the walk crosses a tile border, and
+ * not at all while it stays within the window.
+ *
+ * @param row The row of the cell.
+ * @param column The column of the cell.
+ * @param direction The direction (0..7).
+ * @param coin The moving player ('x' or 'o').
+ * @param pWindow Tiles around the cell, or 0 to look up every tile.
+ * @return The number of discs that would be flipped in this direction.
+ */
+uint32_t ReversiSparseBoard::sparseRun(uint32_t row, uint32_t column,
+		unsigned int direction, char coin, const Window *pWindow) const
+{
+	uint64_t key = ~0ULL;
+	const Tile *pTile = 0;
+	uint32_t run = 0;
+
+	while (true)
+	{
+		// Stepping off row or column 0 wraps around to 2^32 - 1, which is never inside
+		row += rowSteps[direction];
+		column += columnSteps[direction];
+		if (row >= rows || column >= columns)
+		{
+			return 0;
+		}
+
+		uint64_t cellKey = sparseKey(row, column);
+		if (cellKey != key)
+		{
+			key = cellKey;
+			pTile = 0;
+			if (pWindow)
+			{
+				// Offsets outside -1..1 wrap around to large values
+				uint32_t dRow = (row >> 3) - pWindow->tileRow + 1;
+				uint32_t dColumn = (column >> 3) - pWindow->tileColumn + 1;
+				if (dRow < 3 && dColumn < 3)
+				{
+					pTile = pWindow->pTiles[dRow][dColumn];
+				}
+				else
+				{
+					pTile = sparseTile(key);
+				}
+			}
+			else
+			{
+				pTile = sparseTile(key);
+			}
+		}
+		if (pTile == 0)
+		{
+			return 0;
+		}
+
+		uint64_t bit = sparseBit(row, column);
+		uint64_t own = (coin == 'x') ? pTile->discsX : pTile->discsO;
+		uint64_t opp = (coin == 'x') ? pTile->discsO : pTile->discsX;
+		if ((opp & bit) == 0)
+		{
+			return (own & bit) ? run : 0;
+		}
+		run++;
+	}
+}
+
+/**
+ * @brief Toggles a disc between the players (the tile must exist).
+ */
+void ReversiSparseBoard::sparseToggle(uint32_t row, uint32_t column)
+{
+	Tile &tile = tiles.find(sparseKey(row, column))->second;
+	uint64_t bit = sparseBit(row, column);
+	tile.discsX ^= bit;
+	tile.discsO ^= bit;
+}
+
+/**
+ * @brief Removes all discs, discards the recorded moves and gives the turn to 'x'.
+ *
+ * @return RC_OK if the operation was successful.
+ */
+RC_t ReversiSparseBoard::sparseClear()
+{
+	tiles.clear();
+	frontier.clear();
+	undoMoves.clear();
+	undoFlips.clear();
+	countX = 0;
+	countO = 0;
+	sideToMove = 'x';
+	return RC_OK;
+}
+
+/**
+ * @brief Clears the board and places the four initial discs at its center.
+ *
+ * Same layout as ReversiBoard::boardInitialState().
+ *
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+ *         smaller than 2x2.
+ */
+RC_t ReversiSparseBoard::sparseInitialState()
+{
+	if (rows < 2 || columns < 2)
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	sparseClear();
+	sparseSet(rows / 2 - 1, columns / 2 - 1, 'x');
+	sparseSet(rows / 2, columns / 2 - 1, 'o');
+	sparseSet(rows / 2 - 1, columns / 2, 'o');
+	sparseSet(rows / 2, columns / 2, 'x');
+	return RC_OK;
+}
+
+/**
+ * @brief Sets or removes a coin without flipping anything.
+ *
+ * @param row The row index (starting from 0).
+ * @param column The column index (starting from 0).
+ * @param coin 'x', 'o' or '.' to remove the coin.
+ * @return RC_OK if the operation was successful, RC_ERROR_PARAM_OUTOFRANGE for a
+ *         cell outside the board, RC_ERROR_BAD_PARAM for an unknown coin.
+ */
+RC_t ReversiSparseBoard::sparseSet(uint32_t row, uint32_t column, char coin)
+{
+	if (row >= rows || column >= columns)
+	{
+		return RC_ERROR_PARAM_OUTOFRANGE;
+	}
+	if (coin != 'x' && coin != 'o' && coin != '.')
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	uint64_t key = sparseKey(row, column);
+	uint64_t bit = sparseBit(row, column);
+	unordered_map<uint64_t, Tile>::iterator it = tiles.find(key);
+
+	if (it == tiles.end())
+	{
+		if (coin == '.')
+		{
+			return RC_OK;
+		}
+		Tile empty =
+		{ 0, 0 };
+		it = tiles.insert(make_pair(key, empty)).first;
+	}
+
+	Tile &tile = it->second;
+	uint64_t before = tile.discsX | tile.discsO;
+	countX -= (tile.discsX & bit) != 0;
+	countO -= (tile.discsO & bit) != 0;
+	tile.discsX &= ~bit;
+	tile.discsO &= ~bit;
+
+	if (coin == 'x')
+	{
+		tile.discsX |= bit;
+		countX++;
+	}
+	else if (coin == 'o')
+	{
+		tile.discsO |= bit;
+		countO++;
+	}
+
+	// The frontier only changes when a tile becomes or stops being empty or full
+	uint64_t after = tile.discsX | tile.discsO;
+	uint32_t tileRow = row >> 3;
+	uint32_t tileColumn = column >> 3;
+	uint64_t cells = sparseTileCells(tileRow, tileColumn);
+	if (after == 0)
+	{
+		tiles.erase(it);
+	}
+	if ((before == 0) != (after == 0) || (before == cells) != (after == cells))
+	{
+		sparseUpdateFrontier(tileRow, tileColumn);
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Returns the coin on a cell.
+ *
+ * @param row The row index (starting from 0).
+ * @param column The column index (starting from 0).
+ * @return 'x', 'o' or '.' (also for cells outside the board).
+ */
+char ReversiSparseBoard::sparseGet(uint32_t row, uint32_t column) const
+{
+	if (row >= rows || column >= columns)
+	{
+		return '.';
+	}
+
+	const Tile *pTile = sparseTile(sparseKey(row, column));
+	if (pTile == 0)
+	{
+		return '.';
+	}
+
+	uint64_t bit = sparseBit(row, column);
+	if (pTile->discsX & bit)
+	{
+		return 'x';
+	}
+	return (pTile->discsO & bit) ? 'o' : '.';
+}
+
+/**
+ * @brief Checks whether a player may place a coin on a cell.
+ *
+ * @param row The row index (starting from 0).
+ * @param column The column index (starting from 0).
+ * @param coin The player ('x' or 'o').
+ * @return true if the cell is empty and at least one disc would be flipped.
+ */
+bool ReversiSparseBoard::sparseValidPosition(uint32_t row, uint32_t column,
+		char coin) const
+{
+	if (row >= rows || column >= columns || (coin != 'x' && coin != 'o')
+			|| sparseGet(row, column) != '.')
+	{
+		return false;
+	}
+
+	for (unsigned int direction = 0; direction < numDirections; direction++)
+	{
+		if (sparseRun(row, column, direction, coin, 0) != 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Computes all legal moves of a player.
+ *
+ * A legal move is next to an opponent disc, so the candidates are the 3x3
+ * neighbourhood of the opponent discs. Opponent discs on tiles enclosed by full
+ * tiles have no empty neighbour and are skipped by walking the frontier only.
+ * The neighbourhood is computed per frontier tile with opponent discs as a
+ * separable dilation: first by one column (spilling into the left and
+ * right tile), then each of the three results by one row (spilling into the tile
+ * above and below). The empty candidates are then checked with sparseRun(), with
+ * the tiles around each candidate tile looked up only once.
+ *
+ * @param coin The player ('x' or 'o').
+ * @param moves Receives the moves, sorted by row and column.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for an unknown coin.
+ */
+RC_t ReversiSparseBoard::sparseMoves(char coin,
+		vector<ReversiSparseCell_t> &moves) const
+{
+	moves.clear();
+	if (coin != 'x' && coin != 'o')
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	uint32_t lastTileRow = (rows - 1) >> 3;
+	uint32_t lastTileColumn = (columns - 1) >> 3;
+
+	// Candidate cells per tile key; a tile may appear several times until merged
+	vector<pair<uint64_t, uint64_t> > candidates;
+	candidates.reserve(frontier.size() * 9);
+
+	for (unordered_set<uint64_t>::const_iterator it = frontier.begin();
+			it != frontier.end(); ++it)
+	{
+		const Tile *pTile = sparseTile(*it);
+		uint64_t opp = (coin == 'x') ? pTile->discsO : pTile->discsX;
+		if (opp == 0)
+		{
+			continue;
+		}
+
+		uint32_t tileRow = (uint32_t) (*it >> 32);
+		uint32_t tileColumn = (uint32_t) *it;
+		uint64_t spread[3] =
+		{ (opp & TILE_COLUMN_0) << 7, opp | ((opp << 1) & ~TILE_COLUMN_0)
+				| ((opp >> 1) & ~TILE_COLUMN_7), (opp & TILE_COLUMN_7) >> 7 };
+
+		for (int dColumn = -1; dColumn <= 1; dColumn++)
+		{
+			uint64_t cells = spread[dColumn + 1];
+			uint64_t column = (uint32_t) (tileColumn + dColumn);
+			if (cells == 0 || column > lastTileColumn)
+			{
+				continue;
+			}
+
+			if (tileRow > 0 && (cells & TILE_ROW_0))
+			{
+				candidates.push_back(
+						make_pair(((uint64_t) (tileRow - 1) << 32) | column,
+								(cells & TILE_ROW_0) << 56));
+			}
+			candidates.push_back(
+					make_pair(((uint64_t) tileRow << 32) | column,
+							cells | (cells << 8) | (cells >> 8)));
+			if (tileRow < lastTileRow && (cells & TILE_ROW_7))
+			{
+				candidates.push_back(
+						make_pair(((uint64_t) (tileRow + 1) << 32) | column,
+								(cells & TILE_ROW_7) >> 56));
+			}
+		}
+	}
+
+	// Sorting brings the contributions to the same tile together
+	sort(candidates.begin(), candidates.end());
+
+	Window window;
+	for (size_t i = 0; i < candidates.size();)
+	{
+		uint64_t key = candidates[i].first;
+		uint64_t cells = 0;
+		for (; i < candidates.size() && candidates[i].first == key; i++)
+		{
+			cells |= candidates[i].second;
+		}
+
+		uint32_t tileRow = (uint32_t) (key >> 32);
+		uint32_t tileColumn = (uint32_t) key;
+		sparseWindow(tileRow, tileColumn, window);
+
+		const Tile *pTile = window.pTiles[1][1];
+		cells &= sparseTileCells(tileRow, tileColumn);
+		if (pTile)
+		{
+			cells &= ~(pTile->discsX | pTile->discsO);
+		}
+
+		while (cells)
+		{
+			unsigned int bit = __builtin_ctzll(cells);
+			cells &= cells - 1;
+
+			uint32_t row = (tileRow << 3) | (bit >> 3);
+			uint32_t column = (tileColumn << 3) | (bit & 7);
+			for (unsigned int direction = 0; direction < numDirections;
+					direction++)
+			{
+				if (sparseRun(row, column, direction, coin, &window) != 0)
+				{
+					ReversiSparseCell_t move =
+					{ row, column };
+					moves.push_back(move);
+					break;
+				}
+			}
+		}
+	}
+
+	// Tiles of one tile row are in column order; restore row-major cell order
+	sort(moves.begin(), moves.end(),
+			[](const ReversiSparseCell_t &a, const ReversiSparseCell_t &b)
+			{
+				return (a.row != b.row) ? a.row < b.row : a.column < b.column;
+			});
+	return RC_OK;
+}
+
+/**
+ * @brief Plays a move, flips the enclosed discs and records it for sparseUnmakeMove().
+ *
+ * @param row The row index (starting from 0).
+ * @param column The column index (starting from 0).
+ * @param coin The player ('x' or 'o').
+ * @return RC_OK if the move was played, RC_ERROR if it is illegal,
+ *         RC_ERROR_PARAM_OUTOFRANGE for a cell outside the board,
+ *         RC_ERROR_BAD_PARAM for an unknown coin.
+ */
+RC_t ReversiSparseBoard::sparseMakeMove(uint32_t row, uint32_t column,
+		char coin)
+{
+	if (row >= rows || column >= columns)
+	{
+		return RC_ERROR_PARAM_OUTOFRANGE;
+	}
+	if (coin != 'x' && coin != 'o')
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+	if (sparseGet(row, column) != '.')
+	{
+		return RC_ERROR;
+	}
+
+	// Collect the flips of all directions before changing anything
+	size_t first = undoFlips.size();
+	for (unsigned int direction = 0; direction < numDirections; direction++)
+	{
+		uint32_t run = sparseRun(row, column, direction, coin, 0);
+		for (uint32_t step = 1; step <= run; step++)
+		{
+			ReversiSparseCell_t cell =
+			{ row + step * rowSteps[direction], column
+					+ step * columnSteps[direction] };
+			undoFlips.push_back(cell);
+		}
+	}
+
+	uint64_t flips = undoFlips.size() - first;
+	if (flips == 0)
+	{
+		return RC_ERROR;
+	}
+
+	for (size_t i = first; i < undoFlips.size(); i++)
+	{
+		sparseToggle(undoFlips[i].row, undoFlips[i].column);
+	}
+	sparseSet(row, column, coin);
+	if (coin == 'x')
+	{
+		countX += flips;
+		countO -= flips;
+	}
+	else
+	{
+		countO += flips;
+		countX -= flips;
+	}
+
+	Undo undo =
+	{
+	{ row, column }, first, coin, sideToMove, false };
+	undoMoves.push_back(undo);
+	if (sideToMove == coin)
+	{
+		sideToMove = (coin == 'x') ? 'o' : 'x';
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Records a pass of a player.
+ *
+ * @param coin The passing player ('x' or 'o').
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for an unknown coin.
+ */
+RC_t ReversiSparseBoard::sparseMakePass(char coin)
+{
+	if (coin != 'x' && coin != 'o')
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	Undo undo =
+	{
+	{ 0, 0 }, undoFlips.size(), coin, sideToMove, true };
+	undoMoves.push_back(undo);
+	if (sideToMove == coin)
+	{
+		sideToMove = (coin == 'x') ? 'o' : 'x';
+	}
+	return RC_OK;
+}
+
+/**
+ * @brief Takes back the last move or pass.
+ *
+ * @return RC_OK if the operation was successful, RC_ERROR if there is no move to undo.
+ */
+RC_t ReversiSparseBoard::sparseUnmakeMove()
+{
+	if (undoMoves.empty())
+	{
+		return RC_ERROR;
+	}
+
+	Undo undo = undoMoves.back();
+	undoMoves.pop_back();
+
+	if (!undo.pass)
+	{
+		uint64_t flips = undoFlips.size() - undo.flips;
+		for (size_t i = undo.flips; i < undoFlips.size(); i++)
+		{
+			sparseToggle(undoFlips[i].row, undoFlips[i].column);
+		}
+		undoFlips.resize(undo.flips);
+
+		// Removing the placed coin releases its tile if it was the only disc
+		sparseSet(undo.cell.row, undo.cell.column, '.');
+		if (undo.coin == 'x')
+		{
+			countX -= flips;
+			countO += flips;
+		}
+		else
+		{
+			countO -= flips;
+			countX += flips;
+		}
+	}
+
+	sideToMove = undo.side;
+	return RC_OK;
+}
@@ -0,0 +1,298 @@
+/*
+ * ReversiSparseBoard.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiSparseBoard.h
+ * @brief Declares a board for very large sizes that stores only occupied regions.
+ *
+ * ReversiBoard keeps two dense bit masks of rows * columns bits and scans whole
+ * masks for every move, so its memory and time grow with the area of the board.
+ * ReversiSparseBoard splits the board into 8x8 tiles of two 64-bit words and
+ * allocates a tile only when a disc is placed on it; the hash map of allocated
+ * tiles is at the same time the index of occupied tiles. A second set holds the
+ * frontier tiles: occupied tiles that are not full or have a neighbour that is
+ * not full. Tiles enclosed by full tiles cannot border an empty cell, so moves
+ * are generated from the frontier tiles with opponent discs and their direct
+ * neighbours only. Memory grows with the occupied area, the time of move
+ * generation with the frontier. Rows and columns may be up to 2^32 - 1.
+ */
+
+#ifndef REVERSISPARSEBOARD_H_
+#define REVERSISPARSEBOARD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "global.h"
+
+/**
+ * @struct ReversiSparseCell_t
+ * @brief A cell of a sparse board.
+ */
+typedef struct
+{
+	uint32_t row;    ///< The row index (starting from 0).
+	uint32_t column; ///< The column index (starting from 0).
+} ReversiSparseCell_t;
+
+/**
+ * @class ReversiSparseBoard
+ * @brief A Reversi board of 8x8 bitboard tiles that are allocated on demand.
+ *
+ * Cell (row, column) is bit (row % 8) * 8 + (column % 8) of tile
+ * (row / 8, column / 8). Tiles that become empty again (by sparseSet() or
+ * sparseUnmakeMove()) are released.
+ */
+class ReversiSparseBoard
+{
+private:
+	/**
+	 * @brief The discs of one 8x8 tile.
+	 */
+	struct Tile
+	{
+		uint64_t discsX; ///< Cells occupied by an 'x' coin.
+		uint64_t discsO; ///< Cells occupied by an 'o' coin.
+	};
+
+	/**
+	 * @brief A tile and its eight neighbours, looked up once for many cells.
+	 */
+	struct Window
+	{
+		uint32_t tileRow;           ///< Row of the center tile.
+		uint32_t tileColumn;        ///< Column of the center tile.
+		const Tile *pTiles[3][3];   ///< The tiles, 0 if not allocated.
+	};
+
+	/**
+	 * @brief Undo record of one move or pass.
+	 */
+	struct Undo
+	{
+		ReversiSparseCell_t cell; ///< The placed coin (unused for a pass).
+		size_t flips;             ///< First flipped cell of this move in undoFlips.
+		char coin;                ///< The player who moved ('x' or 'o').
+		char side;                ///< The player to move before the move.
+		bool pass;                ///< true for a pass.
+	};
+
+	uint32_t rows;
+	uint32_t columns;
+	std::unordered_map<uint64_t, Tile> tiles; ///< Occupied tiles by sparseKey().
+	std::unordered_set<uint64_t> frontier;    ///< Keys of the occupied tiles not enclosed by full tiles.
+	std::vector<Undo> undoMoves;              ///< Moves made with sparseMakeMove() / sparseMakePass().
+	std::vector<ReversiSparseCell_t> undoFlips; ///< Flipped discs of all recorded moves.
+	uint64_t countX;                          ///< Number of 'x' discs.
+	uint64_t countO;                          ///< Number of 'o' discs.
+	char sideToMove;                          ///< The player to move ('x' or 'o').
+
+	/**
+	 * @brief Returns the key of the tile holding a cell.
+	 */
+	static uint64_t sparseKey(uint32_t row, uint32_t column)
+	{
+		return ((uint64_t) (row >> 3) << 32) | (column >> 3);
+	}
+
+	/**
+	 * @brief Returns the bit of a cell within its tile.
+	 */
+	static uint64_t sparseBit(uint32_t row, uint32_t column)
+	{
+		return 1ULL << (((row & 7) << 3) | (column & 7));
+	}
+
+	/**
+	 * @brief Returns the tile with the given key, or 0 if it is not allocated.
+	 */
+	const Tile* sparseTile(uint64_t key) const
+	{
+		std::unordered_map<uint64_t, Tile>::const_iterator it = tiles.find(key);
+		return (it == tiles.end()) ? 0 : &it->second;
+	}
+
+	/**
+	 * @brief Looks up a tile and its neighbours.
+	 */
+	void sparseWindow(uint32_t tileRow, uint32_t tileColumn,
+			Window &window) const;
+
+	/**
+	 * @brief Returns the cells of a tile that lie on the board.
+	 */
+	uint64_t sparseTileCells(uint32_t tileRow, uint32_t tileColumn) const;
+
+	/**
+	 * @brief Updates the frontier around a tile whose occupancy became empty or full.
+	 *
+	 * Only the tile and its eight neighbours can change their state.
+	 */
+	void sparseUpdateFrontier(uint32_t tileRow, uint32_t tileColumn);
+
+	/**
+	 * @brief Measures the run of opponent discs next to a cell in one direction.
+	 *
+	 * @param row The row of the cell.
+	 * @param column The column of the cell.
+	 * @param direction The direction (0..7).
+	 * @param coin The moving player ('x' or 'o').
+	 * @param pWindow Tiles around the cell, or 0 to look up every tile.
+	 * @return The number of opponent discs that a coin on the cell would flip in
+	 *         this direction (0 unless the run ends at a disc of the player).
+	 */
+	uint32_t sparseRun(uint32_t row, uint32_t column, unsigned int direction,
+			char coin, const Window *pWindow) const;
+
+	/**
+	 * @brief Toggles a disc between the players (the tile must exist).
+	 */
+	void sparseToggle(uint32_t row, uint32_t column);
+
+public:
+	/**
+	 * @brief Constructs an empty board.
+	 *
+	 * @param rows The number of rows on the board.
+	 * @param columns The number of columns on the board.
+	 */
+	ReversiSparseBoard(uint32_t rows, uint32_t columns);
+
+	/**
+	 * @brief Returns the number of rows of the board.
+	 */
+	uint32_t sparseRows() const
+	{
+		return rows;
+	}
+
+	/**
+	 * @brief Returns the number of columns of the board.
+	 */
+	uint32_t sparseColumns() const
+	{
+		return columns;
+	}
+
+	/**
+	 * @brief Returns the player to move ('x' or 'o').
+	 */
+	char sparseSideToMove() const
+	{
+		return sideToMove;
+	}
+
+	/**
+	 * @brief Returns the number of allocated (occupied) tiles.
+	 */
+	size_t sparseTiles() const
+	{
+		return tiles.size();
+	}
+
+	/**
+	 * @brief Returns the number of frontier tiles (those examined by sparseMoves()).
+	 */
+	size_t sparseFrontierTiles() const
+	{
+		return frontier.size();
+	}
+
+	/**
+	 * @brief Returns the number of discs of a player.
+	 *
+	 * @param coin The player ('x' or 'o').
+	 */
+	uint64_t sparseCount(char coin) const
+	{
+		return (coin == 'x') ? countX : (coin == 'o') ? countO : 0;
+	}
+
+	/**
+	 * @brief Removes all discs, discards the recorded moves and gives the turn to 'x'.
+	 *
+	 * @return RC_OK if the operation was successful.
+	 */
+	RC_t sparseClear();
+
+	/**
+	 * @brief Clears the board and places the four initial discs at its center.
+	 *
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for boards
+	 *         smaller than 2x2.
+	 */
+	RC_t sparseInitialState();
+
+	/**
+	 * @brief Sets or removes a coin without flipping anything.
+	 *
+	 * @param row The row index (starting from 0).
+	 * @param column The column index (starting from 0).
+	 * @param coin 'x', 'o' or '.' to remove the coin.
+	 * @return RC_OK if the operation was successful, RC_ERROR_PARAM_OUTOFRANGE for a
+	 *         cell outside the board, RC_ERROR_BAD_PARAM for an unknown coin.
+	 */
+	RC_t sparseSet(uint32_t row, uint32_t column, char coin);
+
+	/**
+	 * @brief Returns the coin on a cell ('x', 'o' or '.'; '.' outside the board).
+	 */
+	char sparseGet(uint32_t row, uint32_t column) const;
+
+	/**
+	 * @brief Checks whether a player may place a coin on a cell.
+	 *
+	 * @param row The row index (starting from 0).
+	 * @param column The column index (starting from 0).
+	 * @param coin The player ('x' or 'o').
+	 * @return true if the cell is empty and at least one disc would be flipped.
+	 */
+	bool sparseValidPosition(uint32_t row, uint32_t column, char coin) const;
+
+	/**
+	 * @brief Computes all legal moves of a player.
+	 *
+	 * Only the frontier tiles with opponent discs and their neighbours are examined.
+	 *
+	 * @param coin The player ('x' or 'o').
+	 * @param moves Receives the moves, sorted by row and column.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for an unknown coin.
+	 */
+	RC_t sparseMoves(char coin, std::vector<ReversiSparseCell_t> &moves) const;
+
+	/**
+	 * @brief Plays a move, flips the enclosed discs and records it for sparseUnmakeMove().
+	 *
+	 * @param row The row index (starting from 0).
+	 * @param column The column index (starting from 0).
+	 * @param coin The player ('x' or 'o').
+	 * @return RC_OK if the move was played, RC_ERROR if it is illegal,
+	 *         RC_ERROR_PARAM_OUTOFRANGE for a cell outside the board,
+	 *         RC_ERROR_BAD_PARAM for an unknown coin.
+	 */
+	RC_t sparseMakeMove(uint32_t row, uint32_t column, char coin);
+
+	/**
+	 * @brief Records a pass of a player.
+	 *
+	 * @param coin The passing player ('x' or 'o').
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for an unknown coin.
+	 */
+	RC_t sparseMakePass(char coin);
+
+	/**
+	 * @brief Takes back the last move or pass.
+	 *
+	 * @return RC_OK if the operation was successful, RC_ERROR if there is no move to undo.
+	 */
+	RC_t sparseUnmakeMove();
+};
+
+#endif /* REVERSISPARSEBOARD_H_ */
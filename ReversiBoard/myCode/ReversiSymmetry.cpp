@@ -0,0 +1,503 @@
+/*
+ * ReversiSymmetry.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiSymmetry.cpp
+ * @brief Implements the board symmetries and the canonical form of a position.
+ *
+ * Boards of up to 8x8 are first spread to 8 bits per row. In that layout the
+ * delta swaps of an 8x8 board apply unchanged; a board with fewer rows or
+ * columns ends up in the last rows or columns and is shifted back. Spreading
+ * keeps the order of the masks, so canonical forms are compared without
+ * packing the candidates back.
+ */
+
+#include "ReversiSymmetry.h"
+#include "ReversiZobrist.h"
+
+using namespace std;
+
+/**
+ * @brief Mask of the lowest bits of a word (all bits for 64 or more).
+ */
+static inline uint64_t symmetryLowBits(unsigned int bits)
+{
+	return (bits >= 64) ? ~(uint64_t) 0 : (((uint64_t) 1 << bits) - 1);
+}
+
+/**
+ * @brief Spreads a mask of a board with up to 8 columns to 8 bits per row.
+ */
+static inline uint64_t symmetrySpread(uint64_t discs, unsigned int rows,
+		unsigned int columns)
+{
+	if (columns == 8)
+	{
+		return discs;
+	}
+
+	uint64_t row = symmetryLowBits(columns);
+	uint64_t spread = 0;
+	for (unsigned int r = 0; r < rows; r++)
+	{
+		spread |= ((discs >> (r * columns)) & row) << (8 * r);
+	}
+	return spread;
+}
+
+/**
+ * @brief Packs a mask with 8 bits per row back to the board's columns.
+ */
+static inline uint64_t symmetryPack(uint64_t spread, unsigned int rows,
+		unsigned int columns)
+{
+	if (columns == 8)
+	{
+		return spread;
+	}
+
+	uint64_t row = symmetryLowBits(columns);
+	uint64_t discs = 0;
+	for (unsigned int r = 0; r < rows; r++)
+	{
+		discs |= ((spread >> (8 * r)) & row) << (r * columns);
+	}
+	return discs;
+}
+
+/**
+ * @brief Reverses the order of the rows of an 8x8 mask; the rows of a board
+ *        with fewer rows are shifted back to the top.
+ */
+static inline uint64_t symmetryMirrorRows8(uint64_t spread, unsigned int rows)
+{
+	return __builtin_bswap64(spread) >> (8 * (8 - rows));
+}
+
+/**
+ * @brief Reverses the order of the columns of an 8x8 mask; the columns of a
+ *        board with fewer columns are shifted back to the left.
+ */
+static inline uint64_t symmetryMirrorColumns8(uint64_t spread,
+		unsigned int columns)
+{
+	spread = ((spread >> 1) & 0x5555555555555555ULL)
+			| ((spread & 0x5555555555555555ULL) << 1);
+	spread = ((spread >> 2) & 0x3333333333333333ULL)
+			| ((spread & 0x3333333333333333ULL) << 2);
+	spread = ((spread >> 4) & 0x0F0F0F0F0F0F0F0FULL)
+			| ((spread & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	return spread >> (8 - columns);
+}
+
+/**
+ * @brief Mirrors an 8x8 mask at the main diagonal with three delta swaps.
+ */
+static inline uint64_t symmetryTranspose8(uint64_t spread)
+{
+	uint64_t t;
+
+	t = 0x0F0F0F0F00000000ULL & (spread ^ (spread << 28));
+	spread ^= t ^ (t >> 28);
+	t = 0x3333000033330000ULL & (spread ^ (spread << 14));
+	spread ^= t ^ (t >> 14);
+	t = 0x5500550055005500ULL & (spread ^ (spread << 7));
+	spread ^= t ^ (t >> 7);
+	return spread;
+}
+
+/**
+ * @brief Loads discs and the side to move into a board, resizing it if needed.
+ */
+static void symmetryLoad(ReversiBoard &board, unsigned int rows,
+		unsigned int columns, const ReversiMask &x, const ReversiMask &o,
+		char side)
+{
+	if (board.boardRows() != rows || board.boardColumns() != columns)
+	{
+		board = ReversiBoard(rows, columns);
+	}
+
+	board.boardClear();
+	for (unsigned int bit = 0; x.maskNext(bit); bit++)
+	{
+		board.boardSet(bit / columns, bit % columns, 'x');
+	}
+	for (unsigned int bit = 0; o.maskNext(bit); bit++)
+	{
+		board.boardSet(bit / columns, bit % columns, 'o');
+	}
+	board.boardSetSideToMove(side);
+}
+
+/**
+ * @brief Compares two masks of the same length as numbers.
+ *
+ * @return A negative value, 0 or a positive value if a is smaller than, equal
+ *         to or larger than b.
+ */
+static int symmetryCompare(const ReversiMask &a, const ReversiMask &b)
+{
+	for (unsigned int word = a.maskWords(); word-- > 0;)
+	{
+		if (a.maskWord(word) != b.maskWord(word))
+		{
+			return (a.maskWord(word) < b.maskWord(word)) ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief Transforms a mask of a board of up to 8x8 cells stored with 8 bits per row.
+ */
+uint64_t ReversiSymmetry::symmetryWord8(uint64_t discs, unsigned int rows,
+		unsigned int columns, ReversiSymmetry_t transform)
+{
+	switch (transform)
+	{
+	case SYMMETRY_ROTATE_90:
+		return symmetryMirrorColumns8(symmetryTranspose8(discs), rows);
+	case SYMMETRY_ROTATE_180:
+		return symmetryMirrorColumns8(symmetryMirrorRows8(discs, rows), columns);
+	case SYMMETRY_ROTATE_270:
+		return symmetryMirrorRows8(symmetryTranspose8(discs), columns);
+	case SYMMETRY_MIRROR_ROWS:
+		return symmetryMirrorRows8(discs, rows);
+	case SYMMETRY_MIRROR_COLUMNS:
+		return symmetryMirrorColumns8(discs, columns);
+	case SYMMETRY_TRANSPOSE:
+		return symmetryTranspose8(discs);
+	case SYMMETRY_ANTI_TRANSPOSE:
+		return symmetryMirrorColumns8(
+				symmetryMirrorRows8(symmetryTranspose8(discs), columns), rows);
+	default:
+		return discs;
+	}
+}
+
+/**
+ * @brief Transforms a mask of any board size, disc by disc.
+ */
+void ReversiSymmetry::symmetryMask(const ReversiMask &discs, unsigned int rows,
+		unsigned int columns, ReversiSymmetry_t transform, ReversiMask &result)
+{
+	result.maskResize(discs.maskBits());
+	result.maskClear();
+	for (unsigned int bit = 0; discs.maskNext(bit); bit++)
+	{
+		result.maskSet(symmetryCell(bit, rows, columns, transform));
+	}
+}
+
+/**
+ * @brief Maps a cell index to the cell it is moved to by a symmetry.
+ *
+ * @param index The cell index; values beyond the board (ReversiUndo::PASS)
+ *        are returned unchanged.
+ * @param rows Board rows.
+ * @param columns Board columns.
+ * @param transform A symmetry valid for the board size.
+ * @return The cell index after the transform.
+ */
+unsigned int ReversiSymmetry::symmetryCell(unsigned int index,
+		unsigned int rows, unsigned int columns, ReversiSymmetry_t transform)
+{
+	if (index >= (uint64_t) rows * columns)
+	{
+		return index;
+	}
+
+	unsigned int row = index / columns;
+	unsigned int column = index % columns;
+	unsigned int lastRow = rows - 1;
+	unsigned int lastColumn = columns - 1;
+
+	// The transforms that swap rows and columns only exist for square boards
+	switch (transform)
+	{
+	case SYMMETRY_ROTATE_90:
+		return column * columns + (lastRow - row);
+	case SYMMETRY_ROTATE_180:
+		return (lastRow - row) * columns + (lastColumn - column);
+	case SYMMETRY_ROTATE_270:
+		return (lastColumn - column) * columns + row;
+	case SYMMETRY_MIRROR_ROWS:
+		return (lastRow - row) * columns + column;
+	case SYMMETRY_MIRROR_COLUMNS:
+		return row * columns + (lastColumn - column);
+	case SYMMETRY_TRANSPOSE:
+		return column * columns + row;
+	case SYMMETRY_ANTI_TRANSPOSE:
+		return (lastColumn - column) * columns + (lastRow - row);
+	default:
+		return index;
+	}
+}
+
+/**
+ * @brief Transforms a disc mask of a board with up to 64 cells.
+ *
+ * Boards with more than 8 rows or columns are rectangular, so only the mirrors
+ * and the half turn apply: the half turn reverses all bits of the board, and
+ * mirroring the columns is a half turn of the mirrored rows.
+ *
+ * @param discs The mask (bit row * columns + column).
+ * @param rows Board rows.
+ * @param columns Board columns (rows * columns must not exceed 64).
+ * @param transform A symmetry valid for the board size.
+ * @return The transformed mask.
+ */
+uint64_t ReversiSymmetry::symmetryWord(uint64_t discs, unsigned int rows,
+		unsigned int columns, ReversiSymmetry_t transform)
+{
+	if (transform == SYMMETRY_IDENTITY || rows * columns == 0)
+	{
+		return discs;
+	}
+	if (rows <= 8 && columns <= 8)
+	{
+		return symmetryPack(
+				symmetryWord8(symmetrySpread(discs, rows, columns), rows,
+						columns, transform), rows, columns);
+	}
+
+	if (transform == SYMMETRY_MIRROR_ROWS || transform == SYMMETRY_MIRROR_COLUMNS)
+	{
+		uint64_t row = symmetryLowBits(columns);
+		uint64_t mirrored = 0;
+
+		for (unsigned int r = 0; r < rows; r++)
+		{
+			mirrored |= ((discs >> (r * columns)) & row)
+					<< ((rows - 1 - r) * columns);
+		}
+		if (transform == SYMMETRY_MIRROR_ROWS)
+		{
+			return mirrored;
+		}
+		discs = mirrored;
+	}
+	else if (transform != SYMMETRY_ROTATE_180)
+	{
+		return discs;
+	}
+
+	// Half turn: reverse the bits of every byte, then the bytes
+	return __builtin_bswap64(symmetryMirrorColumns8(discs, 8))
+			>> (64 - rows * columns);
+}
+
+/**
+ * @brief Copies a position with a symmetry applied.
+ *
+ * @param board The position.
+ * @param transform The symmetry.
+ * @param result Receives the transformed position and the side to move; it is
+ *        resized to the size of board if needed, and its history is cleared.
+ * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for a
+ *         symmetry that is not valid for the size.
+ */
+RC_t ReversiSymmetry::symmetryApply(const ReversiBoard &board,
+		ReversiSymmetry_t transform, ReversiBoard &result)
+{
+	unsigned int rows = board.boardRows();
+	unsigned int columns = board.boardColumns();
+
+	if (transform >= SYMMETRY_COUNT || !symmetryValid(transform, rows, columns))
+	{
+		return RC_ERROR_BAD_PARAM;
+	}
+
+	ReversiMask x, o;
+	symmetryMask(board.boardDiscs('x'), rows, columns, transform, x);
+	symmetryMask(board.boardDiscs('o'), rows, columns, transform, o);
+	symmetryLoad(result, rows, columns, x, o, board.boardSideToMove());
+	return RC_OK;
+}
+
+/**
+ * @brief Replaces two disc masks by their canonical form.
+ *
+ * The 'o' discs of a candidate are only transformed when its 'x' discs tie.
+ *
+ * @param x The 'x' discs; replaced by the canonical 'x' discs.
+ * @param o The 'o' discs; replaced by the canonical 'o' discs.
+ * @param rows Board rows.
+ * @param columns Board columns (rows * columns must not exceed 64).
+ * @return The symmetry that maps the given masks to the canonical ones.
+ */
+ReversiSymmetry_t ReversiSymmetry::symmetryCanonicalWords(uint64_t &x,
+		uint64_t &o, unsigned int rows, unsigned int columns)
+{
+	ReversiSymmetry_t best = SYMMETRY_IDENTITY;
+	bool spread = (rows <= 8 && columns <= 8);
+	uint64_t startX = spread ? symmetrySpread(x, rows, columns) : x;
+	uint64_t startO = spread ? symmetrySpread(o, rows, columns) : o;
+	uint64_t bestX = startX;
+	uint64_t bestO = startO;
+
+	for (unsigned int t = SYMMETRY_IDENTITY + 1; t < SYMMETRY_COUNT; t++)
+	{
+		ReversiSymmetry_t transform = (ReversiSymmetry_t) t;
+		if (!symmetryValid(transform, rows, columns))
+		{
+			continue;
+		}
+
+		uint64_t candidateX = spread ?
+				symmetryWord8(startX, rows, columns, transform) :
+				symmetryWord(startX, rows, columns, transform);
+		if (candidateX > bestX)
+		{
+			continue;
+		}
+
+		uint64_t candidateO = spread ?
+				symmetryWord8(startO, rows, columns, transform) :
+				symmetryWord(startO, rows, columns, transform);
+		if (candidateX < bestX || candidateO < bestO)
+		{
+			best = transform;
+			bestX = candidateX;
+			bestO = candidateO;
+		}
+	}
+
+	x = spread ? symmetryPack(bestX, rows, columns) : bestX;
+	o = spread ? symmetryPack(bestO, rows, columns) : bestO;
+	return best;
+}
+
+/**
+ * @brief Computes the canonical disc masks of a position of any size.
+ *
+ * Boards of up to 64 cells go through symmetryCanonicalWords(); larger boards
+ * build every valid variant disc by disc.
+ *
+ * @return The symmetry that maps board to the canonical masks.
+ */
+ReversiSymmetry_t ReversiSymmetry::symmetryCanonicalMasks(
+		const ReversiBoard &board, ReversiMask &x, ReversiMask &o)
+{
+	unsigned int rows = board.boardRows();
+	unsigned int columns = board.boardColumns();
+	unsigned int cells = rows * columns;
+	ReversiSymmetry_t best = SYMMETRY_IDENTITY;
+
+	x = board.boardDiscs('x');
+	o = board.boardDiscs('o');
+	if (cells == 0)
+	{
+		return best;
+	}
+	if (cells <= 64)
+	{
+		uint64_t wordX = x.maskWord(0);
+		uint64_t wordO = o.maskWord(0);
+
+		best = symmetryCanonicalWords(wordX, wordO, rows, columns);
+		x.maskSetWord(0, wordX);
+		o.maskSetWord(0, wordO);
+		return best;
+	}
+
+	ReversiMask candidateX, candidateO;
+	for (unsigned int t = SYMMETRY_IDENTITY + 1; t < SYMMETRY_COUNT; t++)
+	{
+		ReversiSymmetry_t transform = (ReversiSymmetry_t) t;
+		if (!symmetryValid(transform, rows, columns))
+		{
+			continue;
+		}
+
+		symmetryMask(board.boardDiscs('x'), rows, columns, transform,
+				candidateX);
+		int order = symmetryCompare(candidateX, x);
+		if (order > 0)
+		{
+			continue;
+		}
+
+		symmetryMask(board.boardDiscs('o'), rows, columns, transform,
+				candidateO);
+		if (order < 0 || symmetryCompare(candidateO, o) < 0)
+		{
+			best = transform;
+			x = candidateX;
+			o = candidateO;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Computes the canonical form of a position.
+ *
+ * @param board The position.
+ * @param canonical Receives the canonical position; it is resized to the size
+ *        of board if needed, and its history is cleared.
+ * @return The symmetry that maps board to canonical.
+ */
+ReversiSymmetry_t ReversiSymmetry::symmetryCanonical(const ReversiBoard &board,
+		ReversiBoard &canonical)
+{
+	ReversiMask x, o;
+	ReversiSymmetry_t transform = symmetryCanonicalMasks(board, x, o);
+
+	symmetryLoad(canonical, board.boardRows(), board.boardColumns(), x, o,
+			board.boardSideToMove());
+	return transform;
+}
+
+/**
+ * @brief Returns the Zobrist hash of the canonical form of a position.
+ *
+ * Boards of up to 64 cells work on the disc words without copying the masks.
+ *
+ * @param board The position; the side to move is part of the key.
+ * @param transform Receives the symmetry that maps board to its canonical form.
+ * @return The key.
+ */
+uint64_t ReversiSymmetry::symmetryKey(const ReversiBoard &board,
+		ReversiSymmetry_t &transform)
+{
+	unsigned int rows = board.boardRows();
+	unsigned int columns = board.boardColumns();
+	uint64_t key = (board.boardSideToMove() == 'o') ?
+			ReversiZobrist::zobristSide() : 0;
+
+	if (rows * columns == 0 || rows * columns > 64)
+	{
+		ReversiMask x, o;
+
+		transform = symmetryCanonicalMasks(board, x, o);
+		for (unsigned int bit = 0; x.maskNext(bit); bit++)
+		{
+			key ^= ReversiZobrist::zobristCell(bit, 'x');
+		}
+		for (unsigned int bit = 0; o.maskNext(bit); bit++)
+		{
+			key ^= ReversiZobrist::zobristCell(bit, 'o');
+		}
+		return key;
+	}
+
+	uint64_t x = board.boardDiscs('x').maskWord(0);
+	uint64_t o = board.boardDiscs('o').maskWord(0);
+
+	transform = symmetryCanonicalWords(x, o, rows, columns);
+	for (; x; x &= x - 1)
+	{
+		key ^= ReversiZobrist::zobristCell(__builtin_ctzll(x), 'x');
+	}
+	for (; o; o &= o - 1)
+	{
+		key ^= ReversiZobrist::zobristCell(__builtin_ctzll(o), 'o');
+	}
+	return key;
+}
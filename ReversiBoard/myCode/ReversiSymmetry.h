@@ -0,0 +1,178 @@
+/*
+ * ReversiSymmetry.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiSymmetry.h
+ * @brief Declares the board symmetries and the canonical form of a position.
+ *
+ * A square board has 8 symmetries (4 rotations, each optionally mirrored); a
+ * rectangular board keeps only the 4 that do not swap rows and columns. Positions
+ * that are symmetries of each other play the same way, so caches and books can
+ * store one canonical representative: the symmetric variant with the smallest
+ * disc masks ('x' discs first, compared as numbers, then 'o' discs).
+ *
+ * Boards of up to 8x8 are transformed as one 64-bit word with delta swaps (a byte
+ * swap mirrors the rows, three swaps each mirror the columns or transpose). Other
+ * boards of up to 64 cells use row loops, larger boards a loop over the discs.
+ */
+
+#ifndef REVERSISYMMETRY_H_
+#define REVERSISYMMETRY_H_
+
+#include <stdint.h>
+
+#include "global.h"
+#include "ReversiBoard.h"
+
+/**
+ * @enum ReversiSymmetry_t
+ * @brief A symmetry of the board; rows and columns are numbered from the top left.
+ */
+typedef enum
+{
+	SYMMETRY_IDENTITY,       ///< No change.
+	SYMMETRY_ROTATE_90,      ///< Quarter turn clockwise (square boards only).
+	SYMMETRY_ROTATE_180,     ///< Half turn.
+	SYMMETRY_ROTATE_270,     ///< Quarter turn anticlockwise (square boards only).
+	SYMMETRY_MIRROR_ROWS,    ///< Top and bottom swapped.
+	SYMMETRY_MIRROR_COLUMNS, ///< Left and right swapped.
+	SYMMETRY_TRANSPOSE,      ///< Mirrored at the main diagonal (square boards only).
+	SYMMETRY_ANTI_TRANSPOSE, ///< Mirrored at the anti-diagonal (square boards only).
+	SYMMETRY_COUNT           ///< Number of symmetries.
+} ReversiSymmetry_t;
+
+/**
+ * @class ReversiSymmetry
+ * @brief Transforms positions and cells and computes canonical positions and keys.
+ */
+class ReversiSymmetry
+{
+private:
+	/**
+	 * @brief Transforms a mask of a board of up to 8x8 cells stored with 8 bits per row.
+	 */
+	static uint64_t symmetryWord8(uint64_t discs, unsigned int rows,
+			unsigned int columns, ReversiSymmetry_t transform);
+
+	/**
+	 * @brief Transforms a mask of any board size, disc by disc.
+	 */
+	static void symmetryMask(const ReversiMask &discs, unsigned int rows,
+			unsigned int columns, ReversiSymmetry_t transform, ReversiMask &result);
+
+	/**
+	 * @brief Computes the canonical disc masks of a position of any size.
+	 *
+	 * @return The symmetry that maps board to the canonical masks.
+	 */
+	static ReversiSymmetry_t symmetryCanonicalMasks(const ReversiBoard &board,
+			ReversiMask &x, ReversiMask &o);
+
+public:
+	/**
+	 * @brief Checks whether a symmetry maps a board of the given size onto itself.
+	 */
+	static bool symmetryValid(ReversiSymmetry_t transform, unsigned int rows,
+			unsigned int columns)
+	{
+		return rows == columns || transform == SYMMETRY_IDENTITY
+				|| transform == SYMMETRY_ROTATE_180
+				|| transform == SYMMETRY_MIRROR_ROWS
+				|| transform == SYMMETRY_MIRROR_COLUMNS;
+	}
+
+	/**
+	 * @brief Returns the symmetry that undoes a symmetry.
+	 */
+	static ReversiSymmetry_t symmetryInverse(ReversiSymmetry_t transform)
+	{
+		if (transform == SYMMETRY_ROTATE_90)
+		{
+			return SYMMETRY_ROTATE_270;
+		}
+		return (transform == SYMMETRY_ROTATE_270) ? SYMMETRY_ROTATE_90 : transform;
+	}
+
+	/**
+	 * @brief Maps a cell index to the cell it is moved to by a symmetry.
+	 *
+	 * @param index The cell index; values beyond the board (ReversiUndo::PASS)
+	 *        are returned unchanged.
+	 * @param rows Board rows.
+	 * @param columns Board columns.
+	 * @param transform A symmetry valid for the board size.
+	 * @return The cell index after the transform.
+	 */
+	static unsigned int symmetryCell(unsigned int index, unsigned int rows,
+			unsigned int columns, ReversiSymmetry_t transform);
+
+	/**
+	 * @brief Transforms a disc mask of a board with up to 64 cells.
+	 *
+	 * @param discs The mask (bit row * columns + column).
+	 * @param rows Board rows.
+	 * @param columns Board columns (rows * columns must not exceed 64).
+	 * @param transform A symmetry valid for the board size.
+	 * @return The transformed mask.
+	 */
+	static uint64_t symmetryWord(uint64_t discs, unsigned int rows,
+			unsigned int columns, ReversiSymmetry_t transform);
+
+	/**
+	 * @brief Copies a position with a symmetry applied.
+	 *
+	 * @param board The position.
+	 * @param transform The symmetry.
+	 * @param result Receives the transformed position and the side to move; it is
+	 *        resized to the size of board if needed, and its history is cleared.
+	 * @return RC_OK if the operation was successful, RC_ERROR_BAD_PARAM for a
+	 *         symmetry that is not valid for the size.
+	 */
+	static RC_t symmetryApply(const ReversiBoard &board,
+			ReversiSymmetry_t transform, ReversiBoard &result);
+
+	/**
+	 * @brief Replaces two disc masks by their canonical form.
+	 *
+	 * @param x The 'x' discs; replaced by the canonical 'x' discs.
+	 * @param o The 'o' discs; replaced by the canonical 'o' discs.
+	 * @param rows Board rows.
+	 * @param columns Board columns (rows * columns must not exceed 64).
+	 * @return The symmetry that maps the given masks to the canonical ones.
+	 */
+	static ReversiSymmetry_t symmetryCanonicalWords(uint64_t &x, uint64_t &o,
+			unsigned int rows, unsigned int columns);
+
+	/**
+	 * @brief Computes the canonical form of a position.
+	 *
+	 * Moves of the canonical position are mapped back to the position with
+	 * symmetryCell(move, rows, columns, symmetryInverse(transform)).
+	 *
+	 * @param board The position.
+	 * @param canonical Receives the canonical position; it is resized to the size
+	 *        of board if needed, and its history is cleared.
+	 * @return The symmetry that maps board to canonical.
+	 */
+	static ReversiSymmetry_t symmetryCanonical(const ReversiBoard &board,
+			ReversiBoard &canonical);
+
+	/**
+	 * @brief Returns the Zobrist hash of the canonical form of a position.
+	 *
+	 * The key equals boardHash() of the canonical position, so all symmetric
+	 * variants of a position share it. No board is built.
+	 *
+	 * @param board The position; the side to move is part of the key.
+	 * @param transform Receives the symmetry that maps board to its canonical form.
+	 * @return The key.
+	 */
+	static uint64_t symmetryKey(const ReversiBoard &board,
+			ReversiSymmetry_t &transform);
+};
+
+#endif /* REVERSISYMMETRY_H_ */
@@ -0,0 +1,216 @@
+/*
+ * ReversiTransTable.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiTransTable.cpp
+ * @brief Implements the lock-free transposition table.
+ *
+ * Data word layout: bits 0..31 move, 32..47 score, 48..55 depth, 56..57 bound,
+ * 58..63 generation. The check word is the hash XORed with the data word.
+ */
+
+#include <new>
+
+#include "ReversiTransTable.h"
+
+using namespace std;
+
+static const size_t cacheLine = 64;
+
+/**
+ * @brief Constructs a table of (at most) the given size.
+ *
+ * @param megabytes Size of the table in MB (at least one bucket is used).
+ */
+ReversiTransTable::ReversiTransTable(size_t megabytes) :
+		pMemory(0), pBuckets(0), bucketMask(0), generation(0)
+{
+	ttAllocate(megabytes);
+}
+
+/**
+ * @brief Frees the bucket array.
+ */
+ReversiTransTable::~ReversiTransTable()
+{
+	delete[] pMemory;
+}
+
+/**
+ * @brief Allocates the aligned bucket array.
+ *
+ * The array is over-allocated by one cache line and the buckets start at the first
+ * aligned address, so every bucket occupies exactly one cache line.
+ */
+void ReversiTransTable::ttAllocate(size_t megabytes)
+{
+	size_t buckets = 1;
+	while (buckets * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024)
+	{
+		buckets *= 2;
+	}
+
+	pMemory = new char[buckets * sizeof(Bucket) + cacheLine];
+	size_t offset = (cacheLine - ((size_t) pMemory % cacheLine)) % cacheLine;
+	pBuckets = reinterpret_cast<Bucket*>(pMemory + offset);
+	for (size_t i = 0; i < buckets; i++)
+	{
+		new (&pBuckets[i]) Bucket();
+	}
+	bucketMask = buckets - 1;
+	ttClear();
+}
+
+/**
+ * @brief Changes the size of the table and clears it. Not thread-safe.
+ *
+ * @param megabytes Size of the table in MB.
+ * @return RC_OK if the operation was successful.
+ */
+RC_t ReversiTransTable::ttResize(size_t megabytes)
+{
+	delete[] pMemory;
+	ttAllocate(megabytes);
+	return RC_OK;
+}
+
+/**
+ * @brief Removes all entries. Not thread-safe.
+ */
+void ReversiTransTable::ttClear()
+{
+	for (size_t i = 0; i <= bucketMask; i++)
+	{
+		for (unsigned int e = 0; e < BUCKET_ENTRIES; e++)
+		{
+			pBuckets[i].check[e].store(0, memory_order_relaxed);
+			pBuckets[i].data[e].store(0, memory_order_relaxed);
+		}
+	}
+	generation.store(0, memory_order_relaxed);
+}
+
+/**
+ * @brief Starts a new search; entries of older searches are replaced first.
+ */
+void ReversiTransTable::ttNewSearch()
+{
+	generation.store((generation.load(memory_order_relaxed) + 1) & 63,
+			memory_order_relaxed);
+}
+
+/**
+ * @brief Packs the fields of an entry into one 64-bit word.
+ */
+uint64_t ReversiTransTable::ttPack(unsigned int move, int score,
+		unsigned int depth, TTBound_t bound, unsigned int generation)
+{
+	return (uint64_t) move | ((uint64_t) (uint16_t) (int16_t) score << 32)
+			| ((uint64_t) (depth > 255 ? 255 : depth) << 48)
+			| ((uint64_t) bound << 56) | ((uint64_t) generation << 58);
+}
+
+/**
+ * @brief Looks up a position.
+ *
+ * @param hash The Zobrist hash of the position.
+ * @param entry Receives the stored data if the position was found.
+ * @return true if a matching entry was found.
+ */
+bool ReversiTransTable::ttProbe(uint64_t hash, ReversiTTEntry &entry) const
+{
+	const Bucket &bucket = pBuckets[hash & bucketMask];
+
+	for (unsigned int e = 0; e < BUCKET_ENTRIES; e++)
+	{
+		uint64_t data = bucket.data[e].load(memory_order_relaxed);
+		uint64_t check = bucket.check[e].load(memory_order_relaxed);
+
+		if ((check ^ data) == hash && ((data >> 56) & 3) != TT_BOUND_NONE)
+		{
+			entry.move = (unsigned int) data;
+			entry.score = (int16_t) (uint16_t) (data >> 32);
+			entry.depth = (data >> 48) & 255;
+			entry.bound = (TTBound_t) ((data >> 56) & 3);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Stores the result of a search.
+ *
+ * @param hash The Zobrist hash of the position.
+ * @param move The best move (cell index), ReversiUndo::PASS or NO_MOVE.
+ * @param score The score, must fit into 16 bits.
+ * @param depth The remaining depth of the search (capped at 255).
+ * @param bound The kind of the score.
+ */
+void ReversiTransTable::ttStore(uint64_t hash, unsigned int move, int score,
+		unsigned int depth, TTBound_t bound)
+{
+	Bucket &bucket = pBuckets[hash & bucketMask];
+	unsigned int current = generation.load(memory_order_relaxed);
+	unsigned int victim = 0;
+	int victimValue = 1 << 30;
+
+	for (unsigned int e = 0; e < BUCKET_ENTRIES; e++)
+	{
+		uint64_t data = bucket.data[e].load(memory_order_relaxed);
+		uint64_t check = bucket.check[e].load(memory_order_relaxed);
+
+		if ((check ^ data) == hash)
+		{
+			// Same position: keep the old best move if the new result has none
+			if (move == NO_MOVE)
+			{
+				move = (unsigned int) data;
+			}
+			victim = e;
+			break;
+		}
+
+		// Prefer empty entries, then shallow entries of old searches
+		int age = (current - (unsigned int) (data >> 58)) & 63;
+		int value = ((data >> 56) & 3) == TT_BOUND_NONE ?
+				-(1 << 20) : (int) ((data >> 48) & 255) - 8 * age;
+		if (value < victimValue)
+		{
+			victimValue = value;
+			victim = e;
+		}
+	}
+
+	uint64_t data = ttPack(move, score, depth, bound, current);
+	bucket.data[victim].store(data, memory_order_relaxed);
+	bucket.check[victim].store(hash ^ data, memory_order_relaxed);
+}
+
+/**
+ * @brief Estimates the fill level in permille from the first 1000 buckets.
+ */
+unsigned int ReversiTransTable::ttHashfull() const
+{
+	size_t buckets = (bucketMask + 1 < 1000) ? bucketMask + 1 : 1000;
+	size_t used = 0;
+	unsigned int current = generation.load(memory_order_relaxed);
+
+	for (size_t i = 0; i < buckets; i++)
+	{
+		for (unsigned int e = 0; e < BUCKET_ENTRIES; e++)
+		{
+			uint64_t data = pBuckets[i].data[e].load(memory_order_relaxed);
+			if (((data >> 56) & 3) != TT_BOUND_NONE
+					&& (data >> 58) == current)
+			{
+				used++;
+			}
+		}
+	}
+	return (unsigned int) (used * 1000 / (buckets * BUCKET_ENTRIES));
+}
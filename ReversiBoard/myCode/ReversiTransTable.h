@@ -0,0 +1,165 @@
+/*
+ * ReversiTransTable.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiTransTable.h
+ * @brief Declares the shared transposition table for searches on ReversiBoard.
+ *
+ * The table caches search results by Zobrist hash (ReversiBoard::boardHash()). It
+ * is a fixed array of 64-byte buckets, each holding 4 entries, so a probe touches
+ * a single cache line. Several threads may probe and store concurrently without
+ * locks: every entry stores its key XORed with its data, and a probe only accepts
+ * an entry whose two words still match (torn writes are simply misses).
+ */
+
+#ifndef REVERSITRANSTABLE_H_
+#define REVERSITRANSTABLE_H_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "global.h"
+
+/**
+ * @enum TTBound_t
+ * @brief Kind of score stored in a transposition table entry.
+ */
+typedef enum
+{
+	TT_BOUND_NONE, TT_BOUND_UPPER, TT_BOUND_LOWER, TT_BOUND_EXACT,
+} TTBound_t;
+
+/**
+ * @brief The data of a transposition table entry, as returned by ttProbe().
+ */
+struct ReversiTTEntry
+{
+	unsigned int move;  ///< Best move (cell index), ReversiUndo::PASS or NO_MOVE.
+	int score;          ///< Score from the view of the side to move.
+	unsigned int depth; ///< Remaining search depth of the stored result.
+	TTBound_t bound;    ///< Whether the score is exact, a lower or an upper bound.
+};
+
+/**
+ * @class ReversiTransTable
+ * @brief A fixed-size, cache-line aligned, lock-free transposition table.
+ */
+class ReversiTransTable
+{
+public:
+	/**
+	 * @brief Move value of entries without a best move.
+	 */
+	static const unsigned int NO_MOVE = 0xFFFFFFFEu;
+
+	/**
+	 * @brief Number of entries per 64-byte bucket.
+	 */
+	static const unsigned int BUCKET_ENTRIES = 4;
+
+private:
+	/**
+	 * @brief One cache line: the XORed keys and the data words of 4 entries.
+	 */
+	struct Bucket
+	{
+		std::atomic<uint64_t> check[BUCKET_ENTRIES];
+		std::atomic<uint64_t> data[BUCKET_ENTRIES];
+	};
+
+	char *pMemory;
+	Bucket *pBuckets;
+	size_t bucketMask;
+	std::atomic<unsigned int> generation; ///< Age of the running search, read by all threads.
+
+	/**
+	 * @brief Packs the fields of an entry into one 64-bit word.
+	 */
+	static uint64_t ttPack(unsigned int move, int score, unsigned int depth,
+			TTBound_t bound, unsigned int generation);
+
+	/**
+	 * @brief Allocates the aligned bucket array.
+	 */
+	void ttAllocate(size_t megabytes);
+
+	ReversiTransTable(const ReversiTransTable&);
+	ReversiTransTable& operator=(const ReversiTransTable&);
+
+public:
+	/**
+	 * @brief Constructs a table of (at most) the given size.
+	 *
+	 * The number of buckets is rounded down to a power of two.
+	 *
+	 * @param megabytes Size of the table in MB (at least one bucket is used).
+	 */
+	explicit ReversiTransTable(size_t megabytes);
+
+	/**
+	 * @brief Frees the bucket array.
+	 */
+	~ReversiTransTable();
+
+	/**
+	 * @brief Changes the size of the table and clears it. Not thread-safe.
+	 *
+	 * @param megabytes Size of the table in MB.
+	 * @return RC_OK if the operation is successful.
+	 */
+	RC_t ttResize(size_t megabytes);
+
+	/**
+	 * @brief Removes all entries. Not thread-safe.
+	 */
+	void ttClear();
+
+	/**
+	 * @brief Starts a new search; entries of older searches are replaced first.
+	 */
+	void ttNewSearch();
+
+	/**
+	 * @brief Looks up a position.
+	 *
+	 * @param hash The Zobrist hash of the position.
+	 * @param entry Receives the stored data if the position was found.
+	 * @return true if a matching entry was found.
+	 */
+	bool ttProbe(uint64_t hash, ReversiTTEntry &entry) const;
+
+	/**
+	 * @brief Stores the result of a search.
+	 *
+	 * An entry of the same position is overwritten. Otherwise the entry of the
+	 * bucket with the lowest value (shallow depth, old search) is replaced.
+	 *
+	 * @param hash The Zobrist hash of the position.
+	 * @param move The best move (cell index), ReversiUndo::PASS or NO_MOVE.
+	 * @param score The score, must fit into 16 bits.
+	 * @param depth The remaining depth of the search (capped at 255).
+	 * @param bound The kind of the score.
+	 */
+	void ttStore(uint64_t hash, unsigned int move, int score,
+			unsigned int depth, TTBound_t bound);
+
+	/**
+	 * @brief Returns the number of entries of the table.
+	 */
+	size_t ttEntries() const
+	{
+		return (bucketMask + 1) * BUCKET_ENTRIES;
+	}
+
+	/**
+	 * @brief Estimates the fill level in permille from the first 1000 buckets.
+	 */
+	unsigned int ttHashfull() const;
+};
+
+#endif /* REVERSITRANSTABLE_H_ */
@@ -0,0 +1,111 @@
+/*
+ * ReversiUndo.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiUndo.cpp
+ * @brief Implements the per-game undo stack.
+ */
+
+#include "ReversiUndo.h"
+
+using namespace std;
+
+/**
+ * @brief Constructs an empty stack and reserves room for its records.
+ *
+ * The records themselves are built by undoPush(); on boards above 256 cells
+ * every record owns a heap mask, so building all of them up front would cost
+ * one allocation per reserved record.
+ *
+ * @param bits Number of cells of the board.
+ * @param capacity Number of records to reserve.
+ */
+ReversiUndoStack::ReversiUndoStack(unsigned int bits, unsigned int capacity) :
+		bits(bits), top(0)
+{
+	records.reserve(capacity);
+}
+
+/**
+ * @brief Copy constructor, copies the live records and reserves the same capacity.
+ */
+ReversiUndoStack::ReversiUndoStack(const ReversiUndoStack &other) :
+		bits(other.bits), top(other.top)
+{
+	records.reserve(other.records.capacity());
+	records.insert(records.end(), other.records.begin(),
+			other.records.begin() + other.top);
+}
+
+/**
+ * @brief Move constructor, takes over the records of the other stack and leaves it empty.
+ */
+ReversiUndoStack::ReversiUndoStack(ReversiUndoStack &&other) noexcept :
+		bits(other.bits), top(other.top), records(move(other.records))
+{
+	other.top = 0;
+	other.records.clear();
+}
+
+/**
+ * @brief Copy assignment, reuses the records that are already allocated.
+ */
+ReversiUndoStack& ReversiUndoStack::operator=(const ReversiUndoStack &other)
+{
+	if (this != &other)
+	{
+		if (bits != other.bits)
+		{
+			records.clear();
+			bits = other.bits;
+		}
+		for (unsigned int i = 0; i < other.top; i++)
+		{
+			if (i < records.size())
+			{
+				records[i] = other.records[i];
+			}
+			else
+			{
+				records.push_back(other.records[i]);
+			}
+		}
+		top = other.top;
+	}
+	return *this;
+}
+
+/**
+ * @brief Move assignment, takes over the records of the other stack and leaves it empty.
+ */
+ReversiUndoStack& ReversiUndoStack::operator=(ReversiUndoStack &&other)
+{
+	if (this != &other)
+	{
+		bits = other.bits;
+		top = other.top;
+		records = move(other.records);
+		other.top = 0;
+		other.records.clear();
+	}
+	return *this;
+}
+
+/**
+ * @brief Returns a fresh record on top of the stack, to be filled by the caller.
+ *
+ * A record is built the first time its depth is reached; the stack grows beyond
+ * the reserved capacity if needed.
+ */
+ReversiUndo& ReversiUndoStack::undoPush()
+{
+	if (top == records.size())
+	{
+		records.push_back(ReversiUndo(bits));
+	}
+	return records[top++];
+}
@@ -0,0 +1,145 @@
+/*
+ * ReversiUndo.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiUndo.h
+ * @brief Declares the undo record of a move and the per-game undo stack.
+ *
+ * ReversiBoard::makeMove() pushes one record per move; ReversiBoard::unmakeMove()
+ * pops it and restores the previous position. The stack reserves its storage once
+ * per board and keeps the records it has built, so searching a game tree with
+ * make/unmake needs no heap traffic once every depth has been reached.
+ */
+
+#ifndef REVERSIUNDO_H_
+#define REVERSIUNDO_H_
+
+#include <vector>
+
+#include "ReversiMask.h"
+
+/**
+ * @brief Undo record of one move: the placed cell and the flipped discs.
+ */
+struct ReversiUndo
+{
+	/**
+	 * @brief Cell index used for a pass.
+	 */
+	static const unsigned int PASS = 0xFFFFFFFFu;
+
+	unsigned int index; ///< Cell of the placed coin (row * columns + column), or PASS.
+	char coin;          ///< The player who moved ('x' or 'o').
+	char side;          ///< The player to move before the move.
+	uint64_t hash;      ///< Zobrist hash of the position before the move.
+	ReversiMask flips;  ///< Opponent discs flipped by the move.
+	unsigned int count; ///< Number of flipped discs (boards above 64 cells only).
+
+	/**
+	 * @brief Constructs an empty record for a board with the given number of cells.
+	 *
+	 * @param bits Number of cells of the board.
+	 */
+	explicit ReversiUndo(unsigned int bits) :
+			index(PASS), coin('.'), side('.'), hash(0), flips(bits), count(0)
+	{
+	}
+};
+
+/**
+ * @class ReversiUndoStack
+ * @brief A stack of undo records that keeps popped records for reuse.
+ *
+ * Records are built on their first push; records above the top keep their masks,
+ * so pushing after a pop does not allocate. Copies only take over the live
+ * records, moves take over the storage.
+ */
+class ReversiUndoStack
+{
+private:
+	unsigned int bits;
+	unsigned int top;
+	std::vector<ReversiUndo> records;
+
+public:
+	/**
+	 * @brief Constructs an empty stack and reserves room for its records.
+	 *
+	 * @param bits Number of cells of the board.
+	 * @param capacity Number of records to reserve.
+	 */
+	ReversiUndoStack(unsigned int bits, unsigned int capacity);
+
+	/**
+	 * @brief Copy constructor, copies the live records and reserves the same capacity.
+	 */
+	ReversiUndoStack(const ReversiUndoStack &other);
+
+	/**
+	 * @brief Move constructor, takes over the records of the other stack and leaves it empty.
+	 */
+	ReversiUndoStack(ReversiUndoStack &&other) noexcept;
+
+	/**
+	 * @brief Copy assignment, reuses the records that are already allocated.
+	 */
+	ReversiUndoStack& operator=(const ReversiUndoStack &other);
+
+	/**
+	 * @brief Move assignment, takes over the records of the other stack and leaves it empty.
+	 */
+	ReversiUndoStack& operator=(ReversiUndoStack &&other);
+
+	/**
+	 * @brief Returns a fresh record on top of the stack, to be filled by the caller.
+	 */
+	ReversiUndo& undoPush();
+
+	/**
+	 * @brief Removes the top record. The stack must not be empty.
+	 */
+	void undoPop()
+	{
+		top--;
+	}
+
+	/**
+	 * @brief Returns the top record. The stack must not be empty.
+	 */
+	ReversiUndo& undoTop()
+	{
+		return records[top - 1];
+	}
+
+	/**
+	 * @brief Returns the record at a given depth (0 is the first move of the game).
+	 *
+	 * @param position Index of the record, smaller than undoSize().
+	 */
+	const ReversiUndo& undoAt(unsigned int position) const
+	{
+		return records[position];
+	}
+
+	/**
+	 * @brief Returns the number of live records.
+	 */
+	unsigned int undoSize() const
+	{
+		return top;
+	}
+
+	/**
+	 * @brief Removes all records.
+	 */
+	void undoClear()
+	{
+		top = 0;
+	}
+};
+
+#endif /* REVERSIUNDO_H_ */
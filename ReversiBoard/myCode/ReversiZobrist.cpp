@@ -0,0 +1,49 @@
+/*
+ * ReversiZobrist.cpp
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiZobrist.cpp
+ * @brief Generates the Zobrist key tables.
+ */
+
+#include "ReversiZobrist.h"
+
+uint64_t ReversiZobrist::cellKeys[ReversiZobrist::TABLE_CELLS][2];
+uint64_t ReversiZobrist::flipKeys[ReversiZobrist::TABLE_CELLS];
+
+/**
+ * @brief The generator of all keys: splitmix64 applied to a key number.
+ *
+ * Key number 2 * index + color + 1 belongs to a coin of the given color on cell
+ * index; the side key is a separate constant.
+ */
+uint64_t ReversiZobrist::zobristMix(uint64_t value)
+{
+	uint64_t z = value * 0x9E3779B97F4A7C15ULL + 0x5851F42D4C957F2DULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/**
+ * @brief Fills the key tables before main() runs.
+ */
+struct ReversiZobristInit
+{
+	ReversiZobristInit()
+	{
+		for (unsigned int i = 0; i < ReversiZobrist::TABLE_CELLS; i++)
+		{
+			ReversiZobrist::cellKeys[i][0] = ReversiZobrist::zobristMix(2 * i + 1);
+			ReversiZobrist::cellKeys[i][1] = ReversiZobrist::zobristMix(2 * i + 2);
+			ReversiZobrist::flipKeys[i] = ReversiZobrist::cellKeys[i][0]
+					^ ReversiZobrist::cellKeys[i][1];
+		}
+	}
+};
+
+static ReversiZobristInit zobristInit;
@@ -0,0 +1,95 @@
+/*
+ * ReversiZobrist.h
+ *
+ *  Created on: 16-Oct-2026
+ *      Author: Dheeraj Swaroop S M
+ */
+
+/**
+ * @file ReversiZobrist.h
+ * @brief Declares the Zobrist keys used to hash board positions.
+ *
+ * The hash of a position is the XOR of one key per occupied cell (depending on the
+ * coin) and, if 'o' is to move, the side key. The keys are generated from a fixed
+ * seed, so hashes are identical across processes and can be stored in files.
+ */
+
+#ifndef REVERSIZOBRIST_H_
+#define REVERSIZOBRIST_H_
+
+#include <stdint.h>
+
+/**
+ * @class ReversiZobrist
+ * @brief Provides the Zobrist keys of cells and of the side to move.
+ *
+ * Keys of the first TABLE_CELLS cells come from a precomputed table; keys of cells
+ * beyond that (very large boards) are computed on the fly with the same generator.
+ */
+class ReversiZobrist
+{
+public:
+	/**
+	 * @brief Number of cells with precomputed keys (covers boards up to 64x64).
+	 */
+	static const unsigned int TABLE_CELLS = 4096;
+
+private:
+	static uint64_t cellKeys[TABLE_CELLS][2];
+	static uint64_t flipKeys[TABLE_CELLS];
+
+	/**
+	 * @brief The generator of all keys: splitmix64 applied to a key number.
+	 */
+	static uint64_t zobristMix(uint64_t value);
+
+	/**
+	 * @brief Helper whose static instance fills the key tables at startup.
+	 */
+	friend struct ReversiZobristInit;
+
+public:
+	/**
+	 * @brief Returns the key of a coin on a cell.
+	 *
+	 * @param index The cell index (row * columns + column).
+	 * @param coin The coin ('x' or 'o'); '.' returns 0.
+	 */
+	static uint64_t zobristCell(unsigned int index, char coin)
+	{
+		if (coin == '.')
+		{
+			return 0;
+		}
+		unsigned int color = (coin == 'o') ? 1 : 0;
+		if (index < TABLE_CELLS)
+		{
+			return cellKeys[index][color];
+		}
+		return zobristMix(2 * (uint64_t) index + color + 1);
+	}
+
+	/**
+	 * @brief Returns the change of the hash when the coin on a cell is flipped.
+	 *
+	 * @param index The cell index (row * columns + column).
+	 */
+	static uint64_t zobristFlip(unsigned int index)
+	{
+		if (index < TABLE_CELLS)
+		{
+			return flipKeys[index];
+		}
+		return zobristCell(index, 'x') ^ zobristCell(index, 'o');
+	}
+
+	/**
+	 * @brief Returns the key that is XORed into the hash while 'o' is to move.
+	 */
+	static uint64_t zobristSide()
+	{
+		return 0x9E3779B97F4A7C15ULL;
+	}
+};
+
+#endif /* REVERSIZOBRIST_H_ */
@@ -1,6 +1,11 @@
 // Standard (system) header files
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
 
 // Add more standard header files as required
 
@@ -8,21 +13,564 @@ using namespace std;
 
 // Add your project's header files here
 #include "ReversiBoard.h"
+#include "ReversiArchive.h"
+#include "ReversiAsyncEngine.h"
+#include "ReversiBook.h"
 #include "ReversiConsoleView.h"
+#include "ReversiMetrics.h"
+#include "ReversiPatternEval.h"
+#include "ReversiSelfPlay.h"
+#include "ReversiServer.h"
+
+/**
+ * @brief Runs the headless self-play mode and prints its statistics.
+ *
+ * Usage: --selfplay <games> [<rows> <columns>] [--threads <n>] [--seed <s>]
+ *        [--engine x|o|both] [--nodes <n>] [--mcts x|o|both] [--playouts <n>]
+ *        [--random-plies <n>] [--archive <file>] [--weights <file>]
+ *        [--watch <fps>] [--metrics]
+ *
+ * With --watch the final position of the finished games is shown with the
+ * differential console view, at most <fps> times per second. With --metrics
+ * the counters of the rules core are printed in the Prometheus text format
+ * afterwards (all zero unless built with REVERSI_METRICS).
+ */
+static int runSelfPlay(int argc, char *argv[])
+{
+	ReversiSelfPlayConfig config;
+	ReversiArchiveWriter archive;
+	ReversiPatternEval eval;
+	const char *pArchivePath = 0;
+	unsigned int watchFps = 0;
+	bool metrics = false;
+	int positional = 0;
+
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			config.threads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			config.seed = strtoull(argv[++i], 0, 10);
+		}
+		else if (strcmp(argv[i], "--nodes") == 0 && i + 1 < argc)
+		{
+			config.engineNodes = strtoull(argv[++i], 0, 10);
+		}
+		else if (strcmp(argv[i], "--playouts") == 0 && i + 1 < argc)
+		{
+			config.mctsPlayouts = strtoull(argv[++i], 0, 10);
+		}
+		else if (strcmp(argv[i], "--random-plies") == 0 && i + 1 < argc)
+		{
+			config.randomPlies = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--mcts") == 0 && i + 1 < argc)
+		{
+			i++;
+			if (strcmp(argv[i], "x") == 0 || strcmp(argv[i], "both") == 0)
+			{
+				config.playerX = SELFPLAY_MCTS;
+			}
+			if (strcmp(argv[i], "o") == 0 || strcmp(argv[i], "both") == 0)
+			{
+				config.playerO = SELFPLAY_MCTS;
+			}
+		}
+		else if (strcmp(argv[i], "--archive") == 0 && i + 1 < argc)
+		{
+			pArchivePath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--watch") == 0 && i + 1 < argc)
+		{
+			watchFps = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--metrics") == 0)
+		{
+			metrics = true;
+		}
+		else if (strcmp(argv[i], "--weights") == 0 && i + 1 < argc)
+		{
+			if (eval.evalLoad(argv[++i]) != RC_OK)
+			{
+				cerr << "Cannot read " << argv[i] << "." << endl;
+				return 1;
+			}
+			config.pEval = &eval;
+		}
+		else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc)
+		{
+			i++;
+			if (strcmp(argv[i], "x") == 0 || strcmp(argv[i], "both") == 0)
+			{
+				config.playerX = SELFPLAY_ENGINE;
+			}
+			if (strcmp(argv[i], "o") == 0 || strcmp(argv[i], "both") == 0)
+			{
+				config.playerO = SELFPLAY_ENGINE;
+			}
+		}
+		else if (positional == 0)
+		{
+			config.games = strtoull(argv[i], 0, 10);
+			positional++;
+		}
+		else if (positional == 1)
+		{
+			config.rows = atoi(argv[i]);
+			positional++;
+		}
+		else if (positional == 2)
+		{
+			config.columns = atoi(argv[i]);
+			positional++;
+		}
+	}
+
+	ReversiSelfPlay selfPlay(config);
+	ReversiSelfPlayStats stats;
+	ReversiConsoleView view(0);
+	mutex viewMutex;
+
+	if (pArchivePath && archive.archiveCreate(pArchivePath) != RC_OK)
+	{
+		cerr << "Cannot create " << pArchivePath << "." << endl;
+		return 1;
+	}
+	if (watchFps != 0)
+	{
+		view.viewSetMode(VIEW_DIFF);
+		view.viewSetFrameRate(watchFps);
+	}
+	if (pArchivePath || watchFps != 0)
+	{
+		selfPlay.selfPlaySetCallback(
+				[&](uint64_t game, const ReversiBoard &board)
+				{
+					if (pArchivePath)
+					{
+						archive.archiveAppend(board, (uint32_t) game);
+					}
+					// Watching is best effort: a game finishing while another
+					// thread draws is not shown
+					if (watchFps != 0 && viewMutex.try_lock())
+					{
+						view.boardPrint(&board);
+						viewMutex.unlock();
+					}
+				});
+	}
+
+	RC_t rc = selfPlay.selfPlayRun(stats);
+	if (rc == RC_ERROR_BAD_PARAM)
+	{
+		cerr << "Invalid board size or budget." << endl;
+		return 1;
+	}
+	if (rc != RC_OK)
+	{
+		cerr << "A game failed." << endl;
+		return 1;
+	}
+	if (pArchivePath && archive.archiveClose() != RC_OK)
+	{
+		cerr << "Cannot write " << pArchivePath << "." << endl;
+		return 1;
+	}
+
+	cout << stats.games << " games on " << config.rows << "x" << config.columns
+			<< " in " << stats.seconds << " s: " << stats.games / stats.seconds
+			<< " games/s, " << stats.moves / stats.seconds << " moves/s" << endl;
+	cout << "x wins " << stats.winsX << ", o wins " << stats.winsO
+			<< ", draws " << stats.draws << ", passes " << stats.passes << endl;
+	if (metrics)
+	{
+		ReversiMetrics::metricsWritePrometheus(cout);
+	}
+	return 0;
+}
+
+/**
+ * @brief Builds an opening book from the first plies of the games of an archive.
+ *
+ * Usage: --book <archive> <book> [<plies>] [<min count>]
+ */
+static int runBookBuild(int argc, char *argv[])
+{
+	if (argc < 4)
+	{
+		cerr << "Usage: --book <archive> <book> [<plies>] [<min count>]" << endl;
+		return 1;
+	}
+
+	unsigned int plies = (argc > 4) ? atoi(argv[4]) : 16;
+	unsigned int minCount = (argc > 5) ? atoi(argv[5]) : 2;
+	ReversiArchiveReader archive;
+	ReversiBookBuilder builder;
+	size_t entries;
+
+	if (archive.archiveOpen(argv[2]) != RC_OK)
+	{
+		cerr << "Cannot read " << argv[2] << "." << endl;
+		return 1;
+	}
+	if (builder.bookAddArchive(archive, plies) != RC_OK)
+	{
+		cerr << "Damaged game in " << argv[2] << "." << endl;
+		return 1;
+	}
+	if (builder.bookWrite(argv[3], minCount, entries) != RC_OK)
+	{
+		cerr << "Cannot write " << argv[3] << "." << endl;
+		return 1;
+	}
+
+	cout << archive.archiveGames() << " games, " << builder.bookSamples()
+			<< " moves, " << entries << " book entries" << endl;
+	return 0;
+}
+
+/**
+ * @brief Fits the pattern evaluation to the 8x8 games of an archive.
+ *
+ * Usage: --train <archive> <weights> [<epochs>] [<rate>]
+ */
+static int runTrain(int argc, char *argv[])
+{
+	if (argc < 4)
+	{
+		cerr << "Usage: --train <archive> <weights> [<epochs>] [<rate>]" << endl;
+		return 1;
+	}
+
+	unsigned int epochs = (argc > 4) ? atoi(argv[4]) : 4;
+	double rate = (argc > 5) ? atof(argv[5]) : 0.02;
+	ReversiArchiveReader archive;
+	ReversiPatternEval eval;
+	double error;
+
+	if (archive.archiveOpen(argv[2]) != RC_OK)
+	{
+		cerr << "Cannot read " << argv[2] << "." << endl;
+		return 1;
+	}
+	if (eval.evalTrain(archive, epochs, rate, error) != RC_OK)
+	{
+		cerr << "No usable 8x8 games in " << argv[2] << "." << endl;
+		return 1;
+	}
+	if (eval.evalSave(argv[3]) != RC_OK)
+	{
+		cerr << "Cannot write " << argv[3] << "." << endl;
+		return 1;
+	}
+
+	cout << archive.archiveGames() << " games, " << epochs
+			<< " epochs, rms error " << error << " discs" << endl;
+	return 0;
+}
+
+/**
+ * @brief Runs the game server until SIGINT or SIGTERM and prints its statistics.
+ *
+ * Usage: --server [--port <n>] [--unix <path>] [--threads <n>] [--max-cells <n>]
+ *
+ * With --unix alone the server does not listen on TCP.
+ */
+static int runServer(int argc, char *argv[])
+{
+	ReversiServerConfig config;
+	bool portGiven = false;
+
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--port") == 0 && i + 1 < argc)
+		{
+			char *end;
+			unsigned long port = strtoul(argv[++i], &end, 10);
+
+			if (*argv[i] == '\0' || *end != '\0' || port > 65535)
+			{
+				cerr << "Invalid port " << argv[i] << "." << endl;
+				return 1;
+			}
+			config.port = (unsigned short) port;
+			portGiven = true;
+		}
+		else if (strcmp(argv[i], "--unix") == 0 && i + 1 < argc)
+		{
+			config.socketPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			config.threads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--max-cells") == 0 && i + 1 < argc)
+		{
+			config.maxCells = atoi(argv[++i]);
+		}
+		else
+		{
+			cerr << "Usage: --server [--port <n>] [--unix <path>] [--threads <n>]"
+					" [--max-cells <n>]" << endl;
+			return 1;
+		}
+	}
+	config.listenTcp = portGiven || config.socketPath.empty();
+
+	ReversiServer server(config);
+	ReversiServerStats stats;
+
+	// Printed once the sockets are open, so that port 0 shows the bound port
+	function<void()> banner = [&]()
+	{
+		cout << "Serving games";
+		if (config.listenTcp)
+		{
+			cout << " on 127.0.0.1:" << server.serverPort();
+		}
+		if (!config.socketPath.empty())
+		{
+			cout << " on " << config.socketPath;
+		}
+		cout << ", stop with Ctrl+C." << endl;
+	};
+
+	if (server.serverRun(banner) != RC_OK)
+	{
+		cerr << "Cannot start the server." << endl;
+		return 1;
+	}
+
+	server.serverStats(stats);
+	cout << stats.connections << " connections, " << stats.games << " games, "
+			<< stats.moves << " moves, move latency p50 " << stats.p50Micros
+			<< " us, p99 " << stats.p99Micros << " us" << endl;
+	return 0;
+}
+
+/**
+ * @brief Reads a position and a coin of an interactive move.
+ *
+ * Input that cannot be read as two numbers and a coin is skipped up to the end
+ * of the line and reported as the coin '\0'.
+ *
+ * @param x Receives the row.
+ * @param y Receives the column.
+ * @param c Receives the coin.
+ * @return false at the end of the input, true otherwise.
+ */
+static bool readMove(unsigned int &x, unsigned int &y, char &c)
+{
+	cin >> x >> y >> c;
+	cout << endl;
+
+	if (cin.eof())
+	{
+		return false;
+	}
+	if (!cin)
+	{
+		cin.clear();
+		cin.ignore(numeric_limits<streamsize>::max(), '\n');
+		c = '\0';
+	}
+	return true;
+}
+
+/**
+ * @brief Prints the result if neither player can move any more.
+ *
+ * @return true if the game is over.
+ */
+static bool reportGameOver(const ReversiBoard &board)
+{
+	if (!board.boardGameOver())
+	{
+		return false;
+	}
+
+	unsigned int discsX = board.boardCount('x');
+	unsigned int discsO = board.boardCount('o');
+
+	cout << "Game over: x " << discsX << ", o " << discsO << ". ";
+	if (discsX > discsO)
+	{
+		cout << "Player 1 (x) wins." << endl;
+	}
+	else if (discsO > discsX)
+	{
+		cout << "Player 2 (o) wins." << endl;
+	}
+	else
+	{
+		cout << "Draw." << endl;
+	}
+	return true;
+}
+
+/**
+ * @brief Size of the transposition table of the interactive engine.
+ */
+static const size_t ENGINE_TABLE_MB = 64;
+
+/**
+ * @brief Lets the engine make a move of an interactive game and starts pondering.
+ *
+ * If the engine has been pondering on the current position, that search goes on
+ * for the move time; otherwise a new search starts with the table the ponder
+ * search has filled. The caller makes sure the engine has a legal move.
+ *
+ * @param engine The engine.
+ * @param board The game; the side to move is set for the search.
+ * @param coin The engine's coin.
+ * @param moveTime Time per move in milliseconds.
+ * @param ponder Ponder on the opponent's time after the move.
+ */
+static void playEngineMove(ReversiAsyncEngine &engine, ReversiBoard &board,
+		char coin, unsigned int moveTime, bool ponder)
+{
+	ReversiSearchLimits limits;
+	ReversiSearchResult result;
+	bool ponderHit;
+
+	limits.maxTime = moveTime;
+	board.boardSetSideToMove(coin);
+	if (engine.engineGo(board, limits, ponderHit) != RC_OK
+			|| !engine.engineWait(result)
+			|| result.bestMove >= board.boardCells().maskBits())
+	{
+		return;
+	}
+
+	unsigned int row = result.bestMove / board.boardColumns();
+	unsigned int column = result.bestMove % board.boardColumns();
+
+	board.boardSet(row, column, coin);
+	if (coin == 'x')
+	{
+		board.flipOtoX(row, column, coin);
+	}
+	else
+	{
+		board.flipXtoO(row, column, coin);
+	}
+	cout << "Computer (" << coin << ") plays " << row << " " << column
+			<< " (depth " << result.depth << ", " << result.nodes << " nodes"
+			<< (ponderHit ? ", ponder hit" : "") << ")." << endl;
+
+	if (ponder)
+	{
+		board.boardSetSideToMove((coin == 'x') ? 'o' : 'x');
+		engine.enginePonder(board);
+	}
+}
 
 // Main program
-int main()
+int main(int argc, char *argv[])
 {
+	if (argc > 1 && strcmp(argv[1], "--selfplay") == 0)
+	{
+		return runSelfPlay(argc, argv);
+	}
+	if (argc > 1 && strcmp(argv[1], "--book") == 0)
+	{
+		return runBookBuild(argc, argv);
+	}
+	if (argc > 1 && strcmp(argv[1], "--train") == 0)
+	{
+		return runTrain(argc, argv);
+	}
+	if (argc > 1 && strcmp(argv[1], "--server") == 0)
+	{
+		return runServer(argc, argv);
+	}
+
+	// Usage: [--diff] [--engine x|o] [--time <ms>] [--no-ponder] [--weights <file>]
+	// --diff redraws only the changed cells instead of printing the whole board;
+	// --engine lets the computer play one side, pondering while the human thinks
+	bool diff = false;
+	bool ponder = true;
+	char engineCoin = '\0';
+	unsigned int moveTime = 1000;
+	ReversiPatternEval eval;
+	bool weights = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--diff") == 0)
+		{
+			diff = true;
+		}
+		else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc
+				&& (strcmp(argv[i + 1], "x") == 0
+						|| strcmp(argv[i + 1], "o") == 0))
+		{
+			engineCoin = argv[++i][0];
+		}
+		else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc)
+		{
+			moveTime = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--no-ponder") == 0)
+		{
+			ponder = false;
+		}
+		else if (strcmp(argv[i], "--weights") == 0 && i + 1 < argc)
+		{
+			if (eval.evalLoad(argv[++i]) != RC_OK)
+			{
+				cerr << "Cannot read " << argv[i] << "." << endl;
+				return 1;
+			}
+			weights = true;
+		}
+		else
+		{
+			cerr << "Usage: [--diff] [--engine x|o] [--time <ms>] [--no-ponder]"
+					" [--weights <file>]" << endl;
+			return 1;
+		}
+	}
+	if (moveTime == 0)
+	{
+		moveTime = 1;
+	}
+
+	unique_ptr<ReversiAsyncEngine> pEngine;
+	if (engineCoin != '\0')
+	{
+		pEngine.reset(new ReversiAsyncEngine(ENGINE_TABLE_MB));
+		if (weights)
+		{
+			pEngine->engineSetEvaluator(&eval);
+		}
+	}
+
 	cout << "ReversiBoard started." << endl << endl;
 
 	unsigned int rows, columns;
 
 	cout << "Please enter the size (x,y) of the game: " << endl;
-	cin >> rows >> columns;
+	if (!(cin >> rows >> columns))
+	{
+		return 0;
+	}
+	if (!ReversiBoard::boardSupports(rows, columns))
+	{
+		cerr << "Invalid board size." << endl;
+		return 1;
+	}
 
 	ReversiBoard r1(rows, columns);
 
 	ReversiConsoleView rv(&r1);
+	if (diff)
+	{
+		rv.viewSetMode(VIEW_DIFF);
+	}
 
 	r1.boardInitialState(rows, columns);
 	rv.boardPrint(&r1);
@@ -32,11 +580,27 @@ int main()
 
 	while (true)
 	{
-		while (true)
+		if (reportGameOver(r1))
+		{
+			return 0;
+		}
+		if (!r1.boardHasMoves('x'))
+		{
+			cout << "Player 1 (x) has no valid move and passes." << endl;
+		}
+		if (engineCoin == 'x' && r1.boardHasMoves('x'))
+		{
+			playEngineMove(*pEngine, r1, 'x', moveTime, ponder);
+			rv.boardPrint(&r1);
+		}
+
+		while (engineCoin != 'x' && r1.boardHasMoves('x'))
 		{
 			cout << "Player 1 (x): Enter a position (x, y) and a coin: ";
-			cin >> x >> y >> c;
-			cout << endl;
+			if (!readMove(x, y, c))
+			{
+				return 0;
+			}
 
 			// Check if the entered position and coin create a valid move
 			if (c == 'x')
@@ -62,12 +626,27 @@ int main()
 			}
 		}
 
-		while (true)
+		if (reportGameOver(r1))
+		{
+			return 0;
+		}
+		if (!r1.boardHasMoves('o'))
 		{
+			cout << "Player 2 (o) has no valid move and passes." << endl;
+		}
+		if (engineCoin == 'o' && r1.boardHasMoves('o'))
+		{
+			playEngineMove(*pEngine, r1, 'o', moveTime, ponder);
+			rv.boardPrint(&r1);
+		}
 
+		while (engineCoin != 'o' && r1.boardHasMoves('o'))
+		{
 			cout << "Player 2 (o): Enter a position (x, y) and a coin: ";
-			cin >> x >> y >> c;
-			cout << endl;
+			if (!readMove(x, y, c))
+			{
+				return 0;
+			}
 
 			// Check if the entered position and coin create a valid move
 			if (c == 'o')